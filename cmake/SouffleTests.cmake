@@ -289,10 +289,11 @@ endfunction()
 # name normalization and links in libsouffle
 function(SOUFFLE_ADD_BINARY_TEST TEST_NAME CATEGORY)
     # PARAM_SOUFFLE_HEADERS_ONLY - don't depend on compiling `libsouffle`; saves time and allows independent tests
+    # PARAM_SEQUENTIAL - build a `_seq` variant without OpenMP; requires SOUFFLE_HEADERS_ONLY
     cmake_parse_arguments(
         PARSE_ARGV 2
         PARAM
-        "SOUFFLE_HEADERS_ONLY" # Options
+        "SOUFFLE_HEADERS_ONLY;SEQUENTIAL" # Options
         "" #Single valued options
         "" #Multi-value options
     )
@@ -301,6 +302,9 @@ function(SOUFFLE_ADD_BINARY_TEST TEST_NAME CATEGORY)
     # Keep the file name the same (for now) but rename the rest
     string(REGEX REPLACE "^test_" "" SHORT_TEST_NAME ${TEST_NAME})
     string(REGEX REPLACE "_test$" "" SHORT_TEST_NAME ${SHORT_TEST_NAME})
+    if (PARAM_SEQUENTIAL)
+        string(APPEND SHORT_TEST_NAME "_seq")
+    endif()
     set(TARGET_NAME "test_${SHORT_TEST_NAME}")
 
     add_executable(${TARGET_NAME} ${TEST_NAME}.cpp)
@@ -313,7 +317,7 @@ function(SOUFFLE_ADD_BINARY_TEST TEST_NAME CATEGORY)
         get_target_property(SOUFFLE_COMPILE_OPTS libsouffle COMPILE_OPTIONS)
         get_target_property(SOUFFLE_INCLUDE_DIRS libsouffle INTERFACE_INCLUDE_DIRECTORIES)
 
-        if (OPENMP_FOUND)
+        if (OPENMP_FOUND AND NOT PARAM_SEQUENTIAL)
           target_link_libraries(${TARGET_NAME} PRIVATE OpenMP::OpenMP_CXX)
         endif()
 
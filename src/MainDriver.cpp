@@ -77,6 +77,7 @@
 #include "ram/transform/Conditional.h"
 #include "ram/transform/EliminateDuplicates.h"
 #include "ram/transform/ExpandFilter.h"
+#include "ram/transform/HashJoin.h"
 #include "ram/transform/HoistAggregate.h"
 #include "ram/transform/HoistConditions.h"
 #include "ram/transform/IfConversion.h"
@@ -541,6 +542,9 @@ Own<ram::transform::Transformer> ramTransformerSequence(Global& glb) {
             mk<ExpandFilterTransformer>(), mk<HoistConditionsTransformer>(),
             mk<CollapseFiltersTransformer>(), mk<EliminateDuplicatesTransformer>(),
             mk<ReorderConditionsTransformer>(), mk<LoopTransformer>(mk<ReorderFilterBreak>()),
+            mk<ConditionalTransformer>(
+                    [&]() -> bool { return glb.config().has("hash-joins"); },
+                    mk<HashJoinTransformer>()),
             mk<ConditionalTransformer>(
                     // job count of 0 means all cores are used.
                     [&]() -> bool { return std::stoi(glb.config().get("jobs")) != 1; },
@@ -635,6 +639,9 @@ std::vector<MainOption> getMainOptions() {
     // clang-format off
   std::vector<MainOption> options{
       {"", 0, "", "", false, ""},
+      {"adaptive-joins", nextOptChar++, "", "", false,
+          "Choose the join order of recursive rules in each iteration based on the sizes of the "
+          "relations."},
       {"auto-schedule", 'a', "FILE", "", false,
           "Use profile auto-schedule <FILE> for auto-scheduling."},
       {"compile", 'c', "", "", false,
@@ -644,6 +651,8 @@ std::vector<MainOption> getMainOptions() {
           "Generate C++ source code in multiple files, compile to a binary executable, then "
           "run this "
           "executable."},
+      {"compress-leaves", nextOptChar++, "", "", false,
+          "Share the components common to the tuples of a btree leaf in relations of arity 6 and above."},
       {"debug-report", 'r', "FILE", "", false,
           "Write HTML debug report to <FILE>."},
       {"disable-transformers", 'z', "TRANSFORMERS", "", false,
@@ -652,7 +661,7 @@ std::vector<MainOption> getMainOptions() {
           "Generate C++ source code, written to <FILE>, and compile this to a "
           "binary executable (without executing it)."},
       {"eager-eval", nextOptChar++, "", "", false,
-          "Use non-batching evaluation mode (NB: applied only if compiling)."},
+          "Use non-batching evaluation mode."},
       {"record-work", nextOptChar++, "", "", false,
            "Record the amount of work performed during evaluation (NB: applied only if compiling)."},
       {"emit-statistics", nextOptChar++, "", "", false,
@@ -668,6 +677,8 @@ std::vector<MainOption> getMainOptions() {
       {"generate-namespace", 'N', "NS", "", false,
        "The namespace of generated C++ source code. Empty name denotes the anonymous "
        "namespace."},
+      {"hash-joins", nextOptChar++, "", "", false,
+          "Join non-recursive rules through hash tables instead of indexes needed by no other search."},
       {"help", 'h', "", "", false,
           "Display this help message."},
       {"include-dir", 'I', "DIR", ".", true,
@@ -677,6 +688,8 @@ std::vector<MainOption> getMainOptions() {
       {"jobs", 'j', "N", "1", false,
           "Run interpreter/compiler in parallel using N threads, N=auto for system "
           "default."},
+      {"leapfrog-joins", nextOptChar++, "", "", false,
+          "Intersect the variables shared by the atoms of cyclic rule bodies using leapfrog joins."},
       {"legacy", nextOptChar++, "", "", false,
           "Enable legacy support."},
       {"libraries", 'l', "FILE", "", true,
@@ -699,6 +712,8 @@ std::vector<MainOption> getMainOptions() {
           "Disable warnings."},
       {"output-dir", 'D', "DIR", ".", false,
           "Specify directory for output files. If <DIR> is `-` then stdout is used."},
+      {"parallel-strata", nextOptChar++, "", "", false,
+          "Evaluate independent strata concurrently (NB: applied only if interpreting)."},
       {"parse-errors", nextOptChar++, "", "", false,
           "Show parsing errors, if any, then exit."},
       {"pragma", 'P', "OPTIONS", "", true,
@@ -724,6 +739,9 @@ std::vector<MainOption> getMainOptions() {
               "\ttransformed-ast\n"
               "\ttransformed-ram\n"
               "\ttype-analysis"},
+      {"statistics-error", nextOptChar++, "E", "", false,
+          "Estimate the statistics of emit-statistics from samples with standard error E "
+          "instead of full scans (NB: applied only if interpreting)."},
       {"swig", 's', "LANG", "", false,
           "Generate SWIG interface for given language. The values <LANG> accepts is java and "
           "python. "},
@@ -848,6 +866,18 @@ int main(Global& glb, const char* souffle_executable) {
                 throw std::runtime_error("must be profiling to use emit-statistics");
         }
 
+        if (glb.config().has("statistics-error")) {
+            if (!glb.config().has("emit-statistics")) {
+                throw std::runtime_error("must emit statistics to use statistics-error");
+            }
+            const std::string& error = glb.config().get("statistics-error");
+            char* end = nullptr;
+            const double value = std::strtod(error.c_str(), &end);
+            if (error.empty() || *end != '\0' || !(value > 0 && value < 1)) {
+                throw std::runtime_error("statistics error must be a number between 0 and 1");
+            }
+        }
+
     } catch (std::exception& e) {
         std::cerr << e.what() << std::endl;
         exit(EXIT_FAILURE);
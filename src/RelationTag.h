@@ -36,6 +36,9 @@ enum class RelationTag {
     BTREE,         // use btree data-structure
     BTREE_DELETE,  // use btree_delete data-structure
     EQREL,         // use union data-structure
+    LATTICE_MIN,   // use btree data-structure joining the last column by min
+    LATTICE_MAX,   // use btree data-structure joining the last column by max
+    COMPRESSED,    // use sorted array with narrowed columns
 };
 
 /** Space of qualifiers that a relation can have */
@@ -60,6 +63,9 @@ enum class RelationRepresentation {
     EQREL,         // use union data-structure
     PROVENANCE,    // use custom btree data-structure with provenance extras
     INFO,          // info relation for provenance
+    LATTICE_MIN,   // use btree data-structure joining the last column by min
+    LATTICE_MAX,   // use btree data-structure joining the last column by max
+    COMPRESSED,    // use sorted array with narrowed columns
 };
 
 /**
@@ -70,11 +76,23 @@ inline bool isRelationRepresentationTag(const RelationTag& tag) {
         case RelationTag::BRIE:
         case RelationTag::BTREE:
         case RelationTag::BTREE_DELETE:
-        case RelationTag::EQREL: return true;
+        case RelationTag::EQREL:
+        case RelationTag::LATTICE_MIN:
+        case RelationTag::LATTICE_MAX:
+        case RelationTag::COMPRESSED: return true;
         default: return false;
     }
 }
 
+/**
+ * Check if a given relation representation is a lattice, storing a single tuple per value of
+ * its leading (key) columns, whose last column is joined in place by min or max.
+ */
+inline bool isLatticeRepresentation(const RelationRepresentation& representation) {
+    return representation == RelationRepresentation::LATTICE_MIN ||
+           representation == RelationRepresentation::LATTICE_MAX;
+}
+
 /**
  * Check if a given relation tag is a relation qualifier.
  */
@@ -120,6 +138,9 @@ inline RelationRepresentation getRelationRepresentationFromTag(const RelationTag
         case RelationTag::BTREE: return RelationRepresentation::BTREE;
         case RelationTag::BTREE_DELETE: return RelationRepresentation::BTREE_DELETE;
         case RelationTag::EQREL: return RelationRepresentation::EQREL;
+        case RelationTag::LATTICE_MIN: return RelationRepresentation::LATTICE_MIN;
+        case RelationTag::LATTICE_MAX: return RelationRepresentation::LATTICE_MAX;
+        case RelationTag::COMPRESSED: return RelationRepresentation::COMPRESSED;
         default: fatal("invalid relation tag");
     }
 
@@ -141,6 +162,9 @@ inline std::ostream& operator<<(std::ostream& os, RelationTag qualifier) {
         case RelationTag::BTREE: return os << "btree";
         case RelationTag::BTREE_DELETE: return os << "btree_delete";
         case RelationTag::EQREL: return os << "eqrel";
+        case RelationTag::LATTICE_MIN: return os << "lattice(min)";
+        case RelationTag::LATTICE_MAX: return os << "lattice(max)";
+        case RelationTag::COMPRESSED: return os << "compressed";
     }
 
     UNREACHABLE_BAD_CASE_ANALYSIS
@@ -170,6 +194,9 @@ inline std::ostream& operator<<(std::ostream& os, RelationRepresentation represe
         case RelationRepresentation::EQREL: return os << "eqrel";
         case RelationRepresentation::PROVENANCE: return os << "provenance";
         case RelationRepresentation::INFO: return os << "info";
+        case RelationRepresentation::LATTICE_MIN: return os << "lattice(min)";
+        case RelationRepresentation::LATTICE_MAX: return os << "lattice(max)";
+        case RelationRepresentation::COMPRESSED: return os << "compressed";
         case RelationRepresentation::DEFAULT: return os;
     }
 
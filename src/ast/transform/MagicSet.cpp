@@ -168,6 +168,13 @@ std::set<QualifiedName> MagicSetTransformer::getWeaklyIgnoredRelations(const Tra
         }
     }
 
+    // - Any lattice relation, as its tuples are replaced by joined ones
+    for (auto* rel : program.getRelations()) {
+        if (isLatticeRepresentation(rel->getRepresentation())) {
+            weaklyIgnoredRelations.insert(rel->getQualifiedName());
+        }
+    }
+
     // - Any relation with execution plans
     for (auto* clause : program.getClauses()) {
         if (clause->getExecutionPlan() != nullptr) {
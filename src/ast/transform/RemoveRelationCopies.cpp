@@ -56,6 +56,10 @@ bool RemoveRelationCopiesTransformer::removeRelationCopies(TranslationUnit& tran
         if (rel->getRepresentation() == RelationRepresentation::EQREL) {
             continue;
         }
+        // skip lattice relations (which join the values of their copies)
+        if (isLatticeRepresentation(rel->getRepresentation())) {
+            continue;
+        }
         const auto& clauses = program.getClauses(*rel);
         if (!ioType.isIO(rel) && clauses.size() == 1u) {
             // .. of shape r(x,y,..) :- s(x,y,..)
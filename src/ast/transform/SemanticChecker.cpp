@@ -660,6 +660,52 @@ void SemanticCheckerImpl::checkRelation(const Relation& relation) {
                 relation.getSrcLoc());
     }
 
+    // check compressed relations, whose columns are narrowed to the values loaded into them
+    if (relation.getRepresentation() == RelationRepresentation::COMPRESSED &&
+            !program.getClauses(relation).empty()) {
+        report.addError("Compressed relation " + toString(relation.getQualifiedName()) +
+                                " cannot have rules or facts, it may only be loaded",
+                relation.getSrcLoc());
+    }
+
+    // check lattice relations, joining their last column in place
+    if (isLatticeRepresentation(relation.getRepresentation())) {
+        const std::string name = toString(relation.getQualifiedName());
+        const auto& attributes = relation.getAttributes();
+        const auto& typeName = attributes.empty() ? QualifiedName() : attributes.back()->getTypeName();
+        if (!typeEnv.isType(typeName) || !isOfKind(typeEnv.getType(typeName), TypeAttribute::Signed)) {
+            report.addError("Last attribute of lattice relation " + name + " must be a number",
+                    relation.getSrcLoc());
+        }
+        if (!relation.getFunctionalDependencies().empty()) {
+            report.addError(
+                    "Lattice relation " + name + " cannot have functional dependencies", relation.getSrcLoc());
+        }
+        if (relation.hasQualifier(RelationQualifier::INLINE)) {
+            report.addError("Lattice relation " + name + " cannot be inlined", relation.getSrcLoc());
+        }
+        if (tu.global().config().has("provenance")) {
+            report.addError("Lattice relation " + name + " is not supported with provenance",
+                    relation.getSrcLoc());
+        }
+
+        // indexes only cover the leading columns, hence a negated lattice value requires all of them
+        visit(program, [&](const Negation& neg) {
+            const auto* atom = neg.getAtom();
+            if (atom->getQualifiedName() != relation.getQualifiedName() || atom->getArity() == 0) {
+                return;
+            }
+            const auto args = atom->getArguments();
+            if (!isA<UnnamedVariable>(args.back()) &&
+                    std::any_of(args.begin(), args.end() - 1,
+                            [](const Argument* arg) { return isA<UnnamedVariable>(arg); })) {
+                report.addError("Negated lattice relation " + name +
+                                        " with a bound last argument requires all other arguments",
+                        neg.getSrcLoc());
+            }
+        });
+    }
+
     // start with declaration
     checkRelationDeclaration(relation);
 
@@ -17,6 +17,7 @@
 #include "ast2ram/seminaive/ClauseTranslator.h"
 #include "Global.h"
 #include "LogStatement.h"
+#include "RelationTag.h"
 #include "ast/Aggregator.h"
 #include "ast/BranchInit.h"
 #include "ast/Clause.h"
@@ -31,6 +32,7 @@
 #include "ast/SubsumptiveClause.h"
 #include "ast/UnnamedVariable.h"
 #include "ast/analysis/Functor.h"
+#include "ast/utility/BindingStore.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
 #include "ast2ram/utility/Location.h"
@@ -38,6 +40,7 @@
 #include "ast2ram/utility/TranslatorContext.h"
 #include "ast2ram/utility/Utils.h"
 #include "ast2ram/utility/ValueIndex.h"
+#include "ram/AdaptiveQuery.h"
 #include "ram/Aggregate.h"
 #include "ram/Break.h"
 #include "ram/Constraint.h"
@@ -50,6 +53,8 @@
 #include "ram/GuardedInsert.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicAggregator.h"
+#include "ram/LeapfrogInput.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
@@ -59,18 +64,77 @@
 #include "ram/SignedConstant.h"
 #include "ram/StringConstant.h"
 #include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
 #include "ram/UnpackRecord.h"
 #include "ram/UnsignedConstant.h"
 #include "ram/UserDefinedAggregator.h"
 #include "ram/utility/Utils.h"
 #include "souffle/TypeAttribute.h"
 #include "souffle/utility/StringUtil.h"
+#include <algorithm>
 #include <map>
+#include <set>
 #include <unordered_set>
 #include <vector>
 
 namespace souffle::ast2ram::seminaive {
 
+namespace {
+/**
+ * Determines whether the hypergraph formed by the variables of the given atoms is cyclic, using
+ * the GYO reduction: variables occurring in a single atom and atoms whose variables are covered
+ * by another atom are removed until nothing changes. The hypergraph is acyclic iff at most one
+ * atom remains.
+ */
+bool isCyclic(const std::vector<ast::Atom*>& atoms) {
+    std::vector<std::set<std::string>> edges;
+    for (const auto* atom : atoms) {
+        std::set<std::string> vars;
+        visit(*atom, [&](const ast::Variable& var) { vars.insert(var.getName()); });
+        edges.push_back(std::move(vars));
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        // remove variables of a single atom
+        std::map<std::string, std::size_t> occurrences;
+        for (const auto& edge : edges) {
+            for (const auto& var : edge) {
+                occurrences[var]++;
+            }
+        }
+        for (auto& edge : edges) {
+            for (auto it = edge.begin(); it != edge.end();) {
+                if (occurrences[*it] == 1) {
+                    it = edge.erase(it);
+                    changed = true;
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        // remove atoms covered by another atom
+        for (std::size_t i = 0; i < edges.size();) {
+            bool covered = false;
+            for (std::size_t j = 0; j < edges.size() && !covered; j++) {
+                covered = i != j && std::includes(edges[j].begin(), edges[j].end(), edges[i].begin(),
+                                            edges[i].end());
+            }
+            if (covered) {
+                edges.erase(edges.begin() + i);
+                changed = true;
+            } else {
+                i++;
+            }
+        }
+    }
+    return edges.size() > 1;
+}
+}  // namespace
+
 ClauseTranslator::ClauseTranslator(const TranslatorContext& context, TranslationMode mode)
         : ast2ram::ClauseTranslator(context, mode), valueIndex(mk<ValueIndex>()) {}
 
@@ -112,8 +176,9 @@ Own<ram::Statement> ClauseTranslator::translateRecursiveClause(
             [&](auto* atom) { return contains(scc, context.getProgram()->getRelation(*atom)); });
     this->version = version;
 
-    // Translate the resultant clause as would be done normally
-    Own<ram::Statement> rule = translateNonRecursiveClause(clause);
+    // Translate the resultant clause as would be done normally, or once per join order if adaptive
+    Own<ram::Statement> rule =
+            isAdaptive(clause) ? createAdaptiveRuleQuery(clause) : translateNonRecursiveClause(clause);
 
     // Add logging
     if (context.getGlobal()->config().has("profile")) {
@@ -308,6 +373,38 @@ Own<ram::Operation> ClauseTranslator::addAdtUnpack(
     return op;
 }
 
+Own<ram::Operation> ClauseTranslator::addLeapfrogJoin(Own<ram::Operation> op, const ast::Variable* var,
+        const ast::Clause& clause, std::size_t curLevel) const {
+    std::vector<const ast::Atom*> atoms;
+    for (std::size_t i = curLevel + 1; i < operators.size(); i++) {
+        if (const auto* atom = as<ast::Atom>(operators.at(i))) {
+            atoms.push_back(atom);
+        }
+    }
+
+    // the inputs are restricted by the arguments bound before the join
+    VecOwn<ram::LeapfrogInput> inputs;
+    for (const auto& [atom, column] : getLeapfrogInputs(atoms, var->getName())) {
+        const auto& args = atom->getArguments();
+        VecOwn<ram::Expression> values;
+        for (std::size_t i = 0; i < args.size(); i++) {
+            const auto* arg = args.at(i);
+            bool bound = isA<ast::Constant>(arg);
+            if (const auto* argVar = as<ast::Variable>(arg)) {
+                bound = valueIndex->isDefined(argVar->getName()) &&
+                        valueIndex->getDefinitionPoint(argVar->getName()).identifier < curLevel;
+            }
+            if (i != column && bound) {
+                values.push_back(context.translateValue(*valueIndex, arg));
+            } else {
+                values.push_back(mk<ram::UndefValue>());
+            }
+        }
+        inputs.push_back(mk<ram::LeapfrogInput>(getClauseAtomName(clause, atom), column, std::move(values)));
+    }
+    return mk<ram::LeapfrogJoin>(curLevel, std::move(inputs), std::move(op));
+}
+
 Own<ram::Operation> ClauseTranslator::addVariableIntroductions(
         const ast::Clause& clause, Own<ram::Operation> op) {
     for (std::size_t p = operators.size(); p > 0; p--) {
@@ -319,6 +416,9 @@ Own<ram::Operation> ClauseTranslator::addVariableIntroductions(
         } else if (const auto* rec = as<ast::RecordInit>(curOp)) {
             // add record arguments through an unpack
             op = addRecordUnpack(std::move(op), rec, i);
+        } else if (const auto* var = as<ast::Variable>(curOp)) {
+            // add the values shared by the later atoms through a leapfrog join
+            op = addLeapfrogJoin(std::move(op), var, clause, i);
         } else if (const auto* adt = as<ast::BranchInit>(curOp)) {
             // add adt arguments through an unpack
             op = addAdtUnpack(std::move(op), adt, i);
@@ -470,6 +570,17 @@ Own<ram::Operation> ClauseTranslator::addNegatedDeltaAtom(
     // else, we construct the atom and create a negation
     VecOwn<ram::Expression> values;
     auto args = atom->getArguments();
+
+    // lattices are only searched by their leading columns; as the filter merely avoids deriving a tuple
+    // twice, it is dropped if it would constrain the lattice column without all leading columns
+    const auto* relation = context.getProgram()->getRelation(*atom);
+    if (isLatticeRepresentation(relation->getRepresentation()) &&
+            !isA<ast::UnnamedVariable>(args[arity - 1]) &&
+            std::any_of(args.begin(), args.end() - 1,
+                    [](const ast::Argument* arg) { return isA<ast::UnnamedVariable>(arg); })) {
+        return op;
+    }
+
     for (std::size_t i = 0; i < arity; i++) {
         values.push_back(context.translateValue(*valueIndex, args[i]));
     }
@@ -662,7 +773,14 @@ Own<ram::Condition> ClauseTranslator::getFunctionalDependencies(const ast::Claus
 }
 
 std::vector<ast::Atom*> ClauseTranslator::getAtomOrdering(const ast::Clause& clause) const {
-    auto atoms = ast::getBodyLiterals<ast::Atom>(clause);
+    return reorderAtoms(ast::getBodyLiterals<ast::Atom>(clause), getAtomReordering(clause));
+}
+
+std::vector<std::size_t> ClauseTranslator::getAtomReordering(const ast::Clause& clause) const {
+    // stick to the imposed order if we have one
+    if (!atomOrder.empty()) {
+        return atomOrder;
+    }
 
     // stick to the plan if we have one set
     auto* plan = clause.getExecutionPlan();
@@ -674,16 +792,132 @@ std::vector<ast::Atom*> ClauseTranslator::getAtomOrdering(const ast::Clause& cla
             std::vector<std::size_t> newOrder(order->getOrder().size());
             std::transform(order->getOrder().begin(), order->getOrder().end(), newOrder.begin(),
                     [](std::size_t i) -> std::size_t { return i - 1; });
-            return reorderAtoms(atoms, newOrder);
+            return newOrder;
         }
     }
 
     std::vector<std::string> atomNames;
-    for (auto* atom : atoms) {
+    for (auto* atom : ast::getBodyLiterals<ast::Atom>(clause)) {
         atomNames.push_back(getClauseAtomName(clause, atom));
     }
-    auto newOrder = context.getSipsMetric()->getReordering(&clause, atomNames);
-    return reorderAtoms(atoms, newOrder);
+    return context.getSipsMetric()->getReordering(&clause, atomNames);
+}
+
+bool ClauseTranslator::isAdaptive(const ast::Clause& clause) const {
+    const auto& config = context.getGlobal()->config();
+    if (!config.has("adaptive-joins") || config.has("eager-eval") || config.has("provenance")) {
+        return false;
+    }
+    if (mode != DEFAULT || !isRecursive() || !atomOrder.empty() || !isRule(clause)) {
+        return false;
+    }
+
+    // user-defined plans take precedence
+    const auto* plan = clause.getExecutionPlan();
+    if (plan != nullptr && contains(plan->getOrders(), version)) {
+        return false;
+    }
+    return ast::getBodyLiterals<ast::Atom>(clause).size() > 1;
+}
+
+Own<ram::Statement> ClauseTranslator::createAdaptiveRuleQuery(const ast::Clause& clause) const {
+    const auto atoms = ast::getBodyLiterals<ast::Atom>(clause);
+    auto isScanned = [](const ast::Atom* atom) {
+        return any_of(atom->getArguments(),
+                [](const ast::Argument* arg) { return !isA<ast::UnnamedVariable>(arg); });
+    };
+
+    // The order chosen by the SIPS metric comes first, followed by the orders
+    // starting with each of the other atoms and joining the rest as before
+    const auto sipsOrder = getAtomReordering(clause);
+    std::vector<std::vector<std::size_t>> orders;
+    for (std::size_t i = 0; i < sipsOrder.size(); i++) {
+        if (i > 0 && !isScanned(atoms[sipsOrder[i]])) {
+            continue;
+        }
+        std::vector<std::size_t> order{sipsOrder[i]};
+        for (std::size_t j = 0; j < sipsOrder.size(); j++) {
+            if (j != i) {
+                order.push_back(sipsOrder[j]);
+            }
+        }
+        orders.push_back(std::move(order));
+    }
+
+    VecOwn<ram::Statement> alternatives;
+    std::vector<ram::AdaptiveQuery::Plan> plans;
+    for (const auto& order : orders) {
+        ClauseTranslator translator(context, mode);
+        translator.version = version;
+        translator.sccAtoms = sccAtoms;
+        translator.atomOrder = order;
+        alternatives.push_back(translator.createRamRuleQuery(clause));
+
+        // estimate the fan-out of each scan by its unbound arguments
+        ast::BindingStore bindingStore(&clause);
+        ram::AdaptiveQuery::Plan plan;
+        for (std::size_t idx : order) {
+            const auto* atom = atoms[idx];
+            const auto& args = atom->getArguments();
+            double exponent = 0;
+            if (isScanned(atom)) {
+                exponent = 1.0 - static_cast<double>(bindingStore.numBoundArguments(atom)) / args.size();
+            }
+            plan.emplace_back(getClauseAtomName(clause, atom), exponent);
+            for (const auto* arg : args) {
+                if (const auto* var = as<ast::Variable>(arg)) {
+                    bindingStore.bindVariableStrongly(var->getName());
+                }
+            }
+        }
+        plans.push_back(std::move(plan));
+    }
+
+    if (alternatives.size() == 1) {
+        return std::move(alternatives.front());
+    }
+    return mk<ram::AdaptiveQuery>(std::move(alternatives), std::move(plans));
+}
+
+bool ClauseTranslator::isLeapfrog(const ast::Clause& clause) const {
+    const auto& config = context.getGlobal()->config();
+    if (!config.has("leapfrog-joins") || config.has("provenance") || mode != DEFAULT) {
+        return false;
+    }
+    return isCyclic(ast::getBodyLiterals<ast::Atom>(clause));
+}
+
+std::vector<std::pair<const ast::Atom*, std::size_t>> ClauseTranslator::getLeapfrogInputs(
+        const std::vector<const ast::Atom*>& atoms, const std::string& varName) const {
+    std::vector<std::pair<const ast::Atom*, std::size_t>> inputs;
+    for (const auto* atom : atoms) {
+        // only the btree and compressed indexes are ordered by the values of a column following a
+        // prefix
+        const auto* relation = context.getProgram()->getRelation(*atom);
+        auto representation = relation->getRepresentation();
+        if (representation != RelationRepresentation::DEFAULT &&
+                representation != RelationRepresentation::BTREE &&
+                representation != RelationRepresentation::BTREE_DELETE &&
+                representation != RelationRepresentation::COMPRESSED) {
+            continue;
+        }
+
+        // join on the first occurrence of the variable, unless it is a float whose equality
+        // differs from the identity of its representation
+        const auto& args = atom->getArguments();
+        for (std::size_t i = 0; i < args.size(); i++) {
+            const auto* var = as<ast::Variable>(args.at(i));
+            if (var == nullptr || var->getName() != varName) {
+                continue;
+            }
+            const auto& type = relation->getAttributes().at(i)->getTypeName();
+            if (context.getAttributeTypeQualifier(type)[0] != 'f') {
+                inputs.emplace_back(atom, i);
+            }
+            break;
+        }
+    }
+    return inputs;
 }
 
 std::size_t ClauseTranslator::addOperatorLevel(const ast::Node* node) {
@@ -746,10 +980,31 @@ void ClauseTranslator::indexGenerator(const ast::Argument& arg) {
 }
 
 void ClauseTranslator::indexAtoms(const ast::Clause& clause) {
-    for (const auto* atom : getAtomOrdering(clause)) {
+    const auto atoms = getAtomOrdering(clause);
+    const bool leapfrog = isLeapfrog(clause);
+    std::set<std::string> boundVars;
+    for (std::size_t i = 0; i < atoms.size(); i++) {
+        const auto* atom = atoms[i];
+
+        // intersect the unbound variables of the atom shared with later atoms first
+        if (leapfrog) {
+            const std::vector<const ast::Atom*> remaining(atoms.begin() + i, atoms.end());
+            for (const auto* arg : atom->getArguments()) {
+                const auto* var = as<ast::Variable>(arg);
+                if (var == nullptr || contains(boundVars, var->getName()) ||
+                        getLeapfrogInputs(remaining, var->getName()).size() < 2) {
+                    continue;
+                }
+                std::size_t joinLevel = addOperatorLevel(var);
+                valueIndex->addVarReference(var->getName(), joinLevel, 0);
+                boundVars.insert(var->getName());
+            }
+        }
+
         // give the atom the current level
         std::size_t scanLevel = addOperatorLevel(atom);
         indexNodeArguments(scanLevel, atom->getArguments());
+        visit(*atom, [&](const ast::Variable& var) { boundVars.insert(var.getName()); });
     }
 }
 
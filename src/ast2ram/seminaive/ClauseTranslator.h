@@ -20,6 +20,8 @@
 #include "souffle/RamTypes.h"
 #include "souffle/utility/ContainerUtil.h"
 #include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace souffle::ast {
@@ -33,6 +35,7 @@ class IntrinsicFunctor;
 class Node;
 class RecordInit;
 class Relation;
+class Variable;
 }  // namespace souffle::ast
 
 namespace souffle::ram {
@@ -63,6 +66,9 @@ protected:
     std::size_t version{0};
     std::vector<ast::Atom*> sccAtoms{};
 
+    /** Imposed order of the body atoms, overriding plans and the SIPS metric if not empty */
+    std::vector<std::size_t> atomOrder{};
+
     bool isRecursive() const;
 
     std::string getClauseString(const ast::Clause& clause) const;
@@ -84,6 +90,16 @@ protected:
     virtual Own<ram::Condition> createCondition(const ast::Clause& clause) const;
 
     std::vector<ast::Atom*> getAtomOrdering(const ast::Clause& clause) const;
+    std::vector<std::size_t> getAtomReordering(const ast::Clause& clause) const;
+
+    /** Adaptive join ordering */
+    bool isAdaptive(const ast::Clause& clause) const;
+    Own<ram::Statement> createAdaptiveRuleQuery(const ast::Clause& clause) const;
+
+    /** Leapfrog joins */
+    bool isLeapfrog(const ast::Clause& clause) const;
+    std::vector<std::pair<const ast::Atom*, std::size_t>> getLeapfrogInputs(
+            const std::vector<const ast::Atom*>& atoms, const std::string& varName) const;
 
     /** Indexing */
     void indexClause(const ast::Clause& clause);
@@ -109,6 +125,8 @@ protected:
             Own<ram::Operation> op, const ast::RecordInit* rec, std::size_t curLevel) const;
     Own<ram::Operation> addAdtUnpack(
             Own<ram::Operation> op, const ast::BranchInit* adt, std::size_t curLevel) const;
+    Own<ram::Operation> addLeapfrogJoin(Own<ram::Operation> op, const ast::Variable* var,
+            const ast::Clause& clause, std::size_t curLevel) const;
 
     /** Helper methods */
     Own<ram::Operation> addConstantConstraints(
@@ -44,6 +44,7 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
 #include "ram/Negation.h"
 #include "ram/Parallel.h"
@@ -253,12 +254,7 @@ Own<ram::Statement> UnitTranslator::generateMergeRelations(
     if (rel->getRepresentation() == RelationRepresentation::EQREL) {
         return mk<ram::MergeExtend>(destRelation, srcRelation);
     }
-    for (std::size_t i = 0; i < rel->getArity(); i++) {
-        values.push_back(mk<ram::TupleElement>(0, i));
-    }
-    auto insertion = mk<ram::Insert>(destRelation, std::move(values));
-    auto stmt = mk<ram::Query>(mk<ram::Scan>(srcRelation, 0, std::move(insertion)));
-    return stmt;
+    return mk<ram::Merge>(destRelation, srcRelation);
 }
 
 Own<ram::Statement> UnitTranslator::translateRecursiveClauses(
@@ -467,7 +463,23 @@ Own<ram::Statement> UnitTranslator::generateStratumTableUpdates(const ast::Relat
 
         // swap new and and delta relation and clear new relation afterwards (if not a subsumptive relation)
         Own<ram::Statement> updateRelTable;
-        if (!context->hasSubsumptiveClause(rel->getQualifiedName())) {
+        if (isLatticeRepresentation(rel->getRepresentation())) {
+            // lattice relations join @new into the main relation in place; the tuples of @new still present
+            // afterwards are exactly those that improved the main relation, and they form the next @delta
+            VecOwn<ram::Expression> values;
+            VecOwn<ram::Expression> values2;
+            for (std::size_t i = 0; i < rel->getArity(); i++) {
+                values.push_back(mk<ram::TupleElement>(0, i));
+                values2.push_back(mk<ram::TupleElement>(0, i));
+            }
+            auto insertion = mk<ram::Insert>(deltaRelation, std::move(values));
+            auto filtered = mk<ram::Filter>(
+                    mk<ram::ExistenceCheck>(mainRelation, std::move(values2)), std::move(insertion));
+            updateRelTable = mk<ram::Sequence>(generateMergeRelations(rel, mainRelation, newRelation),
+                    mk<ram::Clear>(deltaRelation),
+                    mk<ram::Query>(mk<ram::Scan>(newRelation, 0, std::move(filtered))),
+                    mk<ram::Clear>(newRelation));
+        } else if (!context->hasSubsumptiveClause(rel->getQualifiedName())) {
             updateRelTable = mk<ram::Sequence>(generateMergeRelations(rel, mainRelation, newRelation),
                     mk<ram::Swap>(deltaRelation, newRelation), mk<ram::Clear>(newRelation));
         } else {
@@ -703,6 +715,25 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
             translationUnit.getAnalysis<ast::analysis::TopologicallySortedSCCGraphAnalysis>().order();
     VecOwn<ram::Statement> res;
 
+    // Strata that are consecutive in the topological order and independent of each other
+    // are invoked within a single parallel block
+    const bool parallelStrata = glb->config().has("parallel-strata") && !glb->config().has("eager-eval");
+    VecOwn<ram::Statement> independentCalls;
+    ast::RelationSet independentRelations;
+    ast::RelationSet independentReads;
+    ast::RelationSet independentExpired;
+    auto flushIndependentCalls = [&]() {
+        if (independentCalls.size() == 1) {
+            appendStmt(res, std::move(independentCalls.front()));
+        } else if (!independentCalls.empty()) {
+            appendStmt(res, mk<ram::Parallel>(std::move(independentCalls)));
+        }
+        independentCalls.clear();
+        independentRelations.clear();
+        independentReads.clear();
+        independentExpired.clear();
+    };
+
     // Create subroutines for each SCC according to topological order
     for (std::size_t i = 0; i < sccOrdering.size(); i++) {
         // Generate the main stratum code
@@ -719,8 +750,28 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
         addRamSubroutine(stratumID, std::move(stratum));
 
         // invoke the strata
-        appendStmt(res, mk<ram::Call>("stratum_" + stratumID));
+        if (!parallelStrata) {
+            appendStmt(res, mk<ram::Call>("stratum_" + stratumID));
+            continue;
+        }
+
+        // A stratum may join the current parallel block if it does not read a relation computed by the
+        // block, and no relation read by one side is cleared by the other side.
+        const auto& sccRelations = context->getRelationsInSCC(sccOrdering.at(i));
+        const auto sccReads = context->getExternalPredecessorRelations(sccOrdering.at(i));
+        auto intersects = [](const ast::RelationSet& lhs, const ast::RelationSet& rhs) {
+            return any_of(lhs, [&](const ast::Relation* rel) { return contains(rhs, rel); });
+        };
+        if (intersects(sccReads, independentRelations) || intersects(sccReads, independentExpired) ||
+                intersects(expiredRelations, independentReads)) {
+            flushIndependentCalls();
+        }
+        appendStmt(independentCalls, mk<ram::Call>("stratum_" + stratumID));
+        independentRelations.insert(sccRelations.begin(), sccRelations.end());
+        independentReads.insert(sccReads.begin(), sccReads.end());
+        independentExpired.insert(expiredRelations.begin(), expiredRelations.end());
     }
+    flushIndependentCalls();
 
     // Add main timer if profiling
     if (!res.empty() && glb->config().has("profile")) {
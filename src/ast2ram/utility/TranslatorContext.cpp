@@ -146,6 +146,10 @@ ast::RelationSet TranslatorContext::getOutputRelationsInSCC(std::size_t scc) con
     return sccGraph->getInternalOutputRelations(scc);
 }
 
+ast::RelationSet TranslatorContext::getExternalPredecessorRelations(std::size_t scc) const {
+    return sccGraph->getExternalPredecessorRelations(scc);
+}
+
 VecOwn<ram::Statement> TranslatorContext::getRecursiveJoinSizeStatementsInSCC(std::size_t scc) const {
     VecOwn<ram::Statement> res;
     for (auto&& s : joinSizeAnalysis->getJoinSizeStatementsInSCC(scc)) {
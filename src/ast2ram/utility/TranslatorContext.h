@@ -108,6 +108,7 @@ public:
     ast::RelationSet getRelationsInSCC(std::size_t scc) const;
     ast::RelationSet getInputRelationsInSCC(std::size_t scc) const;
     ast::RelationSet getOutputRelationsInSCC(std::size_t scc) const;
+    ast::RelationSet getExternalPredecessorRelations(std::size_t scc) const;
 
     /** JoinSize methods */
     VecOwn<ram::Statement> getRecursiveJoinSizeStatementsInSCC(std::size_t scc) const;
@@ -25,11 +25,13 @@
 #include "souffle/datastructure/Brie.h"
 #include "souffle/datastructure/ConcurrentCache.h"
 #include "souffle/datastructure/EqRel.h"
+#include "souffle/datastructure/HashJoinTable.h"
 #include "souffle/datastructure/Info.h"
 #include "souffle/datastructure/Nullaries.h"
 #include "souffle/datastructure/RecordTableImpl.h"
 #include "souffle/datastructure/SymbolTableImpl.h"
 #include "souffle/datastructure/Table.h"
+#include "souffle/io/BackgroundWriter.h"
 #include "souffle/io/IOSystem.h"
 #include "souffle/io/WriteStream.h"
 #include "souffle/utility/EvaluatorUtil.h"
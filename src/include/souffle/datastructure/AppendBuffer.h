@@ -0,0 +1,147 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file AppendBuffer.h
+ *
+ * A buffer collecting the tuples of relations that are only written while computed.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A buffer of elements appended concurrently, where each thread lane appends to its own
+ * vector. Appending neither searches for duplicates nor keeps the elements ordered; the
+ * elements are handed over at once, sorted and free of duplicates, when no thread appends
+ * any more.
+ *
+ * The lanes are sorted in parallel and their sorted runs merged pairwise, such that draining
+ * a buffer of n elements takes O(n log n) work on all threads.
+ */
+template <typename T>
+class AppendBuffer {
+public:
+    AppendBuffer() : lanes(static_cast<std::size_t>(MAX_THREADS)), buffers(lanes.lanes()) {}
+
+    AppendBuffer(const AppendBuffer&) = delete;
+    AppendBuffer& operator=(const AppendBuffer&) = delete;
+
+    /** Appends the given element to the lane of the calling thread. Thread safe. */
+    void append(const T& value) {
+        auto guard = lanes.guard();
+        buffers[lanes.threadLane()].elements.push_back(value);
+        if (!pending.load(std::memory_order_relaxed)) {
+            pending.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    /** Tests whether no element has been appended since the buffer was last drained. */
+    bool empty() const {
+        return !pending.load(std::memory_order_relaxed);
+    }
+
+    /** Obtains the number of buffered elements, including duplicates. Not thread safe. */
+    std::size_t size() const {
+        std::size_t res = 0;
+        for (const auto& cur : buffers) {
+            res += cur.elements.size();
+        }
+        return res;
+    }
+
+    /**
+     * Removes all elements from this buffer and returns them sorted by the given order,
+     * keeping a single element of each class of equivalent elements. Not thread safe.
+     */
+    template <typename Less>
+    std::vector<T> drain(const Less& less) {
+        std::vector<T> res;
+        if (empty()) {
+            return res;
+        }
+        const auto duplicate = [&](const T& a, const T& b) { return !less(a, b); };
+
+        // sort the lanes independently
+        const int numLanes = static_cast<int>(buffers.size());
+        PARALLEL_START
+            pfor(int i = 0; i < numLanes; ++i) {
+                auto& cur = buffers[i].elements;
+                std::sort(cur.begin(), cur.end(), less);
+                cur.erase(std::unique(cur.begin(), cur.end(), duplicate), cur.end());
+            }
+        PARALLEL_END
+
+        // concatenate the sorted runs
+        std::vector<std::size_t> bounds{0};
+        for (const auto& cur : buffers) {
+            if (!cur.elements.empty()) {
+                bounds.push_back(bounds.back() + cur.elements.size());
+            }
+        }
+        res.reserve(bounds.back());
+        for (auto& cur : buffers) {
+            res.insert(res.end(), cur.elements.begin(), cur.elements.end());
+            cur.elements.clear();
+        }
+
+        // merge adjacent runs pairwise until a single run is left
+        const std::size_t numRuns = bounds.size() - 1;
+        for (std::size_t width = 1; width < numRuns; width *= 2) {
+            const int numPairs = static_cast<int>((numRuns + 2 * width - 1) / (2 * width));
+            PARALLEL_START
+                pfor(int k = 0; k < numPairs; ++k) {
+                    const std::size_t first = 2 * width * static_cast<std::size_t>(k);
+                    const std::size_t mid = std::min(first + width, numRuns);
+                    const std::size_t last = std::min(first + 2 * width, numRuns);
+                    if (mid < last) {
+                        std::inplace_merge(res.begin() + bounds[first], res.begin() + bounds[mid],
+                                res.begin() + bounds[last], less);
+                    }
+                }
+            PARALLEL_END
+        }
+
+        // drop elements contained in several lanes
+        res.erase(std::unique(res.begin(), res.end(), duplicate), res.end());
+        pending.store(false, std::memory_order_relaxed);
+        return res;
+    }
+
+    /** Discards all elements of this buffer. Not thread safe. */
+    void clear() {
+        for (auto& cur : buffers) {
+            cur.elements.clear();
+        }
+        pending.store(false, std::memory_order_relaxed);
+    }
+
+private:
+    // the elements of a lane, kept on a cache line of their own
+    struct alignas(hardware_destructive_interference_size) Lane {
+        std::vector<T> elements;
+    };
+
+    ConcurrentLanes lanes;
+
+    std::vector<Lane> buffers;
+
+    // set once an element has been appended, making the emptiness test independent of the lanes
+    std::atomic<bool> pending{false};
+};
+
+}  // end namespace souffle
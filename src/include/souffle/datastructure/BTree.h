@@ -18,6 +18,7 @@
 #pragma once
 
 #include "souffle/datastructure/BTreeUtil.h"
+#include "souffle/datastructure/NodeArena.h"
 #include "souffle/utility/CacheUtil.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
@@ -28,10 +29,12 @@
 #include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <typeinfo>
+#include <utility>
 #include <vector>
 
 namespace souffle {
@@ -47,11 +50,14 @@ namespace detail {
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
  * @tparam isSet        .. true = set, false = multiset
+ * @tparam Statistics   .. the statistics maintained on the stored elements
+ * @tparam Compression  .. the layout of the keys stored in leaf nodes
  */
 template <typename Key, typename Comparator,
         typename Allocator,  // is ignored so far - TODO: add support
         unsigned blockSize, typename SearchStrategy, bool isSet, typename WeakComparator = Comparator,
-        typename Updater = detail::updater<Key>>
+        typename Updater = detail::updater<Key>, typename Statistics = detail::no_statistics<Key>,
+        typename Compression = detail::no_compression<Key>>
 class btree {
 public:
     class iterator;
@@ -95,8 +101,24 @@ protected:
         upd.update(old_k, new_k);
     }
 
+    // whether the present element old_k is to be updated by the weakly equal element new_k
+    bool updates(const Key& old_k, const Key& new_k) const {
+        if constexpr (detail::is_selective_updater<Updater, Key>::value) {
+            return upd.updates(old_k, new_k);
+        } else {
+            return typeid(Comparator) != typeid(WeakComparator) && less(new_k, old_k);
+        }
+    }
+
     /* -------------- the node type ----------------- */
 
+    // whether the keys of leaf nodes are stored compressed
+    static constexpr bool compressed = Compression::enabled;
+
+    // compressed leaves are searched by the full order, which needs to order weakly equal keys
+    static_assert(!compressed || std::is_same_v<Comparator, WeakComparator>,
+            "compressed leaves do not support weak comparators");
+
     using size_type = std::size_t;
     using field_index_type = uint8_t;
     using lock_type = OptimisticReadWriteLock;
@@ -179,25 +201,114 @@ protected:
          */
         static constexpr std::size_t maxKeys = (desiredNumKeys > 3) ? desiredNumKeys : 3;
 
-        // the keys stored in this node
+        /**
+         * The maximum number of keys of leaf nodes, exceeding maxKeys if leaves are compressed.
+         * It is limited by the range of positions within a node.
+         */
+        static constexpr std::size_t maxLeafKeys =
+                compressed ? std::min<std::size_t>(Compression::capacity(maxKeys), 255) : maxKeys;
+
+        // the keys stored in this node, or their encoding in compressed leaves
         Key keys[maxKeys];
 
         // a simple constructor
         node(bool inner) : base(inner) {}
 
+        // the type of keys obtained from nodes, decoded ones in case of compressed leaves
+        using key_ref = std::conditional_t<compressed, Key, const Key&>;
+
+        /**
+         * Obtains the key at the given position of this node.
+         */
+        key_ref getKey(size_type i) const {
+            if constexpr (compressed) {
+                if (this->isLeaf()) {
+                    return Compression::decode(keys, maxKeys, static_cast<const leaf_node*>(this)->shared, i);
+                }
+            }
+            return keys[i];
+        }
+
+        /**
+         * Replaces the keys of this node by the given keys, which have to fit.
+         */
+        void setKeys(const Key* src, size_type n) {
+            if constexpr (compressed) {
+                if (this->isLeaf()) {
+                    assert(n <= maxLeafKeys);
+                    auto& shared = static_cast<leaf_node*>(this)->shared;
+                    shared = Compression::common(src, n);
+                    assert(n <= Compression::capacity(shared, maxKeys));
+                    Compression::encode(keys, shared, src, n);
+                    this->numElements = n;
+                    return;
+                }
+            }
+            assert(n <= maxKeys);
+            std::copy(src, src + n, keys);
+            this->numElements = n;
+        }
+
+        /**
+         * Determines whether the given key can be added to this leaf without splitting it.
+         */
+        bool canInsert(const Key& k) const {
+            if constexpr (compressed) {
+                auto shared = Compression::agreeing(keys, static_cast<const leaf_node*>(this)->shared, k);
+                return this->numElements < std::min(maxLeafKeys, Compression::capacity(shared, maxKeys));
+            }
+            return this->numElements < maxKeys;
+        }
+
         /**
-         * A deep-copy operation creating a clone of this node.
+         * Obtains the position of the first key of this leaf not ordered before the given key,
+         * or after it if inclusive is set.
          */
-        node* clone() const {
+        template <bool inclusive, typename Comp>
+        size_type bound(const Key& k, Comp& comp) const {
+            if constexpr (compressed) {
+                // a binary search decoding the probed keys
+                size_type a = 0;
+                size_type b = std::min<size_type>(static_cast<size_type>(this->numElements), maxLeafKeys);
+                while (a < b) {
+                    size_type mid = a + (b - a) / 2;
+                    auto cur = getKey(mid);
+                    if (inclusive ? !comp.less(k, cur) : comp.less(cur, k)) {
+                        a = mid + 1;
+                    } else {
+                        b = mid;
+                    }
+                }
+                return a;
+            }
+            auto a = &keys[0];
+            auto b = &keys[this->numElements];
+            return (inclusive ? search.upper_bound(k, a, b, comp) : search.lower_bound(k, a, b, comp)) - a;
+        }
+
+        /**
+         * A deep-copy operation creating a clone of this node within the given arena.
+         */
+        node* clone(NodeArena& arena) const {
             // create a clone of this node
-            node* res = (this->isInner()) ? static_cast<node*>(new inner_node())
-                                          : static_cast<node*>(new leaf_node());
+            node* res = (this->isInner()) ? static_cast<node*>(createNode<inner_node>(arena))
+                                          : static_cast<node*>(createNode<leaf_node>(arena));
 
             // copy basic fields
             res->position = this->position;
             res->numElements = this->numElements;
 
-            for (size_type i = 0; i < this->numElements; ++i) {
+            // compressed leaves are copied including their encoding
+            size_type numKeys = this->numElements;
+            if constexpr (compressed) {
+                if (this->isLeaf()) {
+                    auto shared = static_cast<const leaf_node*>(this)->shared;
+                    static_cast<leaf_node*>(res)->shared = shared;
+                    numKeys = Compression::storage(shared, numKeys);
+                }
+            }
+
+            for (size_type i = 0; i < numKeys; ++i) {
                 res->keys[i] = this->keys[i];
             }
 
@@ -209,7 +320,7 @@ protected:
             // copy child nodes recursively
             auto* ires = (inner_node*)res;
             for (size_type i = 0; i <= this->numElements; ++i) {
-                ires->children[i] = this->getChild(i)->clone();
+                ires->children[i] = this->getChild(i)->clone(arena);
                 ires->children[i]->parent = res;
             }
 
@@ -347,23 +458,35 @@ protected:
          * @param idx  .. the position of the insert causing the split
          */
 #ifdef IS_PARALLEL
-        void split(node** root, lock_type& root_lock, int idx, std::vector<node*>& locked_nodes) {
+        void split(node** root, lock_type& root_lock, NodeArena& arena, int idx,
+                std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(!this->parent || this->parent->lock.is_write_locked());
             assert((this->parent != nullptr) || root_lock.is_write_locked());
             assert(this->isLeaf() || souffle::contains(locked_nodes, this));
             assert(!this->parent || souffle::contains(locked_nodes, const_cast<node*>(this->parent)));
 #else
-        void split(node** root, lock_type& root_lock, int idx) {
+        void split(node** root, lock_type& root_lock, NodeArena& arena, int idx) {
+#endif
+            if constexpr (compressed) {
+                if (this->isLeaf()) {
+#ifdef IS_PARALLEL
+                    split_compressed_leaf(root, root_lock, arena, locked_nodes);
+#else
+                    split_compressed_leaf(root, root_lock, arena);
 #endif
+                    return;
+                }
+            }
+
             assert(this->numElements == maxKeys);
 
             // get middle element
             int split_point = getSplitPoint(idx);
 
             // create a new sibling node
-            node* sibling = (this->inner) ? static_cast<node*>(new inner_node())
-                                          : static_cast<node*>(new leaf_node());
+            node* sibling = (this->inner) ? static_cast<node*>(createNode<inner_node>(arena))
+                                          : static_cast<node*>(createNode<leaf_node>(arena));
 
 #ifdef IS_PARALLEL
             // lock sibling
@@ -393,9 +516,54 @@ protected:
 
             // update parent
 #ifdef IS_PARALLEL
-            grow_parent(root, root_lock, sibling, locked_nodes);
+            grow_parent(root, root_lock, arena, sibling, keys[this->numElements], locked_nodes);
 #else
-            grow_parent(root, root_lock, sibling);
+            grow_parent(root, root_lock, arena, sibling, keys[this->numElements]);
+#endif
+        }
+
+        /**
+         * Splits this compressed leaf, re-encoding the keys of both halves. The keys
+         * of the halves may share more components than before, so the halves may
+         * accommodate even more keys.
+         */
+#ifdef IS_PARALLEL
+        void split_compressed_leaf(
+                node** root, lock_type& root_lock, NodeArena& arena, std::vector<node*>& locked_nodes) {
+#else
+        void split_compressed_leaf(node** root, lock_type& root_lock, NodeArena& arena) {
+#endif
+            // splitting requires at least three keys, which any leaf accommodates
+            size_type n = this->numElements;
+            assert(n >= 3);
+
+            // decode the keys of this leaf
+            Key buffer[maxLeafKeys];
+            for (size_type i = 0; i < n; ++i) {
+                buffer[i] = getKey(i);
+            }
+
+            // get middle element, biased towards the end as of getSplitPoint
+            size_type split_point = std::min(3 * n / 4, n - 2);
+
+            // create a new sibling node
+            node* sibling = createNode<leaf_node>(arena);
+
+#ifdef IS_PARALLEL
+            // lock sibling
+            sibling->lock.start_write();
+            locked_nodes.push_back(sibling);
+#endif
+
+            // distribute keys among this node and the sibling
+            sibling->setKeys(buffer + split_point + 1, n - split_point - 1);
+            this->setKeys(buffer, split_point);
+
+            // update parent
+#ifdef IS_PARALLEL
+            grow_parent(root, root_lock, arena, sibling, buffer[split_point], locked_nodes);
+#else
+            grow_parent(root, root_lock, arena, sibling, buffer[split_point]);
 #endif
         }
 
@@ -412,16 +580,29 @@ protected:
          */
         // TODO: remove root_lock ... no longer needed
 #ifdef IS_PARALLEL
-        int rebalance_or_split(node** root, lock_type& root_lock, int idx, std::vector<node*>& locked_nodes) {
+        int rebalance_or_split(node** root, lock_type& root_lock, NodeArena& arena, int idx,
+                std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(!this->parent || this->parent->lock.is_write_locked());
             assert((this->parent != nullptr) || root_lock.is_write_locked());
             assert(this->isLeaf() || souffle::contains(locked_nodes, this));
             assert(!this->parent || souffle::contains(locked_nodes, const_cast<node*>(this->parent)));
 #else
-        int rebalance_or_split(node** root, lock_type& root_lock, int idx) {
+        int rebalance_or_split(node** root, lock_type& root_lock, NodeArena& arena, int idx) {
 #endif
 
+            // compressed leaves are not re-balanced, as the capacity of their siblings varies
+            if constexpr (compressed) {
+                if (this->isLeaf()) {
+#ifdef IS_PARALLEL
+                    split(root, root_lock, arena, idx, locked_nodes);
+#else
+                    split(root, root_lock, arena, idx);
+#endif
+                    return 0;
+                }
+            }
+
             // this node is full ... and needs some space
             assert(this->numElements == maxKeys);
 
@@ -437,7 +618,7 @@ protected:
                 // lock access to left sibling
                 if (!left->lock.try_start_write()) {
                     // left node is currently updated => skip balancing and split
-                    split(root, root_lock, idx, locked_nodes);
+                    split(root, root_lock, arena, idx, locked_nodes);
                     return 0;
                 }
 #endif
@@ -510,9 +691,9 @@ protected:
 
             // Option B) split node
 #ifdef IS_PARALLEL
-            split(root, root_lock, idx, locked_nodes);
+            split(root, root_lock, arena, idx, locked_nodes);
 #else
-            split(root, root_lock, idx);
+            split(root, root_lock, arena, idx);
 #endif
             return 0;  // = no re-balancing
         }
@@ -520,30 +701,33 @@ protected:
     private:
         /**
          * Inserts a new sibling into the parent of this node utilizing
-         * the last key of this node as a separation key. (for internal
-         * use only)
+         * the given key, removed from this node, as a separation key.
+         * (for internal use only)
          *
          * @param root .. a pointer to the root-pointer of the containing tree
          * @param sibling .. the new right-sibling to be add to the parent node
+         * @param separator .. the key separating this node and the sibling
          */
 #ifdef IS_PARALLEL
-        void grow_parent(node** root, lock_type& root_lock, node* sibling, std::vector<node*>& locked_nodes) {
+        void grow_parent(node** root, lock_type& root_lock, NodeArena& arena, node* sibling,
+                const Key& separator, std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(!this->parent || this->parent->lock.is_write_locked());
             assert((this->parent != nullptr) || root_lock.is_write_locked());
             assert(this->isLeaf() || souffle::contains(locked_nodes, this));
             assert(!this->parent || souffle::contains(locked_nodes, const_cast<node*>(this->parent)));
 #else
-        void grow_parent(node** root, lock_type& root_lock, node* sibling) {
+        void grow_parent(
+                node** root, lock_type& root_lock, NodeArena& arena, node* sibling, const Key& separator) {
 #endif
 
             if (this->parent == nullptr) {
                 assert(*root == this);
 
                 // create a new root node
-                auto* new_root = new inner_node();
+                auto* new_root = createNode<inner_node>(arena);
                 new_root->numElements = 1;
-                new_root->keys[0] = keys[this->numElements];
+                new_root->keys[0] = separator;
 
                 new_root->children[0] = this;
                 new_root->children[1] = sibling;
@@ -562,10 +746,9 @@ protected:
                 auto pos = this->position;
 
 #ifdef IS_PARALLEL
-                parent->insert_inner(
-                        root, root_lock, pos, this, keys[this->numElements], sibling, locked_nodes);
+                parent->insert_inner(root, root_lock, arena, pos, this, separator, sibling, locked_nodes);
 #else
-                parent->insert_inner(root, root_lock, pos, this, keys[this->numElements], sibling);
+                parent->insert_inner(root, root_lock, arena, pos, this, separator, sibling);
 #endif
             }
         }
@@ -579,13 +762,13 @@ protected:
          * @param newNode .. the new right-child of the inserted key
          */
 #ifdef IS_PARALLEL
-        void insert_inner(node** root, lock_type& root_lock, unsigned pos, node* predecessor, const Key& key,
-                node* newNode, std::vector<node*>& locked_nodes) {
+        void insert_inner(node** root, lock_type& root_lock, NodeArena& arena, unsigned pos,
+                node* predecessor, const Key& key, node* newNode, std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(souffle::contains(locked_nodes, this));
 #else
-        void insert_inner(node** root, lock_type& root_lock, unsigned pos, node* predecessor, const Key& key,
-                node* newNode) {
+        void insert_inner(node** root, lock_type& root_lock, NodeArena& arena, unsigned pos,
+                node* predecessor, const Key& key, node* newNode) {
 #endif
 
             // check capacity
@@ -598,9 +781,9 @@ protected:
 
                 // split this node
 #ifdef IS_PARALLEL
-                pos -= rebalance_or_split(root, root_lock, pos, locked_nodes);
+                pos -= rebalance_or_split(root, root_lock, arena, pos, locked_nodes);
 #else
-                pos -= rebalance_or_split(root, root_lock, pos);
+                pos -= rebalance_or_split(root, root_lock, arena, pos);
 #endif
 
                 // complete insertion within new sibling if necessary
@@ -625,9 +808,9 @@ protected:
                     }
 
                     pos = (i > static_cast<unsigned>(other->numElements)) ? 0 : static_cast<unsigned>(i);
-                    other->insert_inner(root, root_lock, pos, predecessor, key, newNode, locked_nodes);
+                    other->insert_inner(root, root_lock, arena, pos, predecessor, key, newNode, locked_nodes);
 #else
-                    other->insert_inner(root, root_lock, pos, predecessor, key, newNode);
+                    other->insert_inner(root, root_lock, arena, pos, predecessor, key, newNode);
 #endif
                     return;
                 }
@@ -665,7 +848,7 @@ protected:
 
             // print the keys
             for (unsigned i = 0; i < this->numElements; i++) {
-                out << keys[i];
+                out << getKey(i);
                 if (i != this->numElements - 1) {
                     out << ",";
                 }
@@ -785,7 +968,7 @@ protected:
             bool valid = true;
 
             // check fill-state
-            if (this->numElements > maxKeys) {
+            if (this->numElements > (this->inner ? maxKeys : maxLeafKeys)) {
                 std::cout << "Node with " << this->numElements << "/" << maxKeys << " encountered!\n";
                 valid = false;
             }
@@ -812,26 +995,26 @@ protected:
 
                     // check parent key
                     if (valid && this->position != 0 &&
-                            !(comp(this->parent->keys[this->position - 1], keys[0]) < ((isSet) ? 0 : 1))) {
+                            !(comp(this->parent->keys[this->position - 1], getKey(0)) < ((isSet) ? 0 : 1))) {
                         std::cout << "Left parent key not lower bound!\n";
                         std::cout << "   Node:     " << this << "\n";
                         std::cout << "   Parent:   " << this->parent << "\n";
                         std::cout << "   Position: " << ((int)this->position) << "\n";
                         std::cout << "   Key:   " << (this->parent->keys[this->position]) << "\n";
-                        std::cout << "   Lower: " << (keys[0]) << "\n";
+                        std::cout << "   Lower: " << getKey(0) << "\n";
                         valid = false;
                     }
 
                     // check parent key
                     if (valid && this->position != this->parent->numElements &&
-                            !(comp(keys[this->numElements - 1], this->parent->keys[this->position]) <
+                            !(comp(getKey(this->numElements - 1), this->parent->keys[this->position]) <
                                     ((isSet) ? 0 : 1))) {
                         std::cout << "Right parent key not lower bound!\n";
                         std::cout << "   Node:     " << this << "\n";
                         std::cout << "   Parent:   " << this->parent << "\n";
                         std::cout << "   Position: " << ((int)this->position) << "\n";
                         std::cout << "   Key:   " << (this->parent->keys[this->position]) << "\n";
-                        std::cout << "   Upper: " << (keys[0]) << "\n";
+                        std::cout << "   Upper: " << getKey(0) << "\n";
                         valid = false;
                     }
                 }
@@ -840,10 +1023,10 @@ protected:
             // check element order
             if (this->numElements > 0) {
                 for (unsigned i = 0; i < this->numElements - 1; i++) {
-                    if (valid && !(comp(keys[i], keys[i + 1]) < ((isSet) ? 0 : 1))) {
+                    if (valid && !(comp(getKey(i), getKey(i + 1)) < ((isSet) ? 0 : 1))) {
                         std::cout << "Element order invalid!\n";
-                        std::cout << " @" << this << " key " << i << " is " << keys[i] << " vs "
-                                  << keys[i + 1] << "\n";
+                        std::cout << " @" << this << " key " << i << " is " << getKey(i) << " vs "
+                                  << getKey(i + 1) << "\n";
                         valid = false;
                     }
                 }
@@ -866,42 +1049,61 @@ protected:
      * of child pointers.
      */
     struct inner_node : public node {
-        // references to child nodes owned by this node
+        // references to child nodes, held by the arena of the tree
         node* children[node::maxKeys + 1];
 
         // a simple default constructor initializing member fields
         inner_node() : node(true) {}
-
-        // clear up child nodes recursively
-        ~inner_node() {
-            for (unsigned i = 0; i <= this->numElements; ++i) {
-                if (children[i] != nullptr) {
-                    if (children[i]->isLeaf()) {
-                        delete static_cast<leaf_node*>(children[i]);
-                    } else {
-                        delete static_cast<inner_node*>(children[i]);
-                    }
-                }
-            }
-        }
     };
 
     /**
      * The data type representing leaf nodes of the b-tree. It does not
-     * add any capabilities to the generic node type.
+     * add any capabilities to the generic node type, besides the state of
+     * compressed leaves. Compressed leaves are aligned to cache lines, such
+     * that scanning them touches as few lines as possible.
      */
-    struct leaf_node : public node {
+    struct alignas(compressed ? 64 : alignof(node)) leaf_node : public node, public Compression::leaf_state {
         // a simple default constructor initializing member fields
         leaf_node() : node(false) {}
     };
 
+    // creates a node of the given type within the given arena
+    template <typename Node>
+    static Node* createNode(NodeArena& arena) {
+        return new (arena.allocate(sizeof(Node), alignof(Node))) Node();
+    }
+
+    // destructs the given node and its sub-tree, without releasing their memory
+    static void destroy(node* cur) {
+        if (cur->isLeaf()) {
+            static_cast<leaf_node*>(cur)->~leaf_node();
+            return;
+        }
+        auto* inner = static_cast<inner_node*>(cur);
+        for (size_type i = 0; i <= inner->numElements; ++i) {
+            destroy(inner->children[i]);
+        }
+        inner->~inner_node();
+    }
+
     // ------------------- iterators ------------------------
 
+    // the key decoded by an iterator referencing a compressed leaf
+    struct decoded_key {
+        mutable Key decoded;
+    };
+
+    struct no_decoded_key {};
+
 public:
     /**
      * The iterator type to be utilized for scanning through btree instances.
+     * Iterators over compressed leaves provide a reference to a decoded copy
+     * of the current key, valid until the iterator is dereferenced again.
      */
-    class iterator {
+    class iterator : private std::conditional_t<compressed, decoded_key, no_decoded_key> {
+        using decoded_base = std::conditional_t<compressed, decoded_key, no_decoded_key>;
+
         // a pointer to the node currently referred to
         node const* cur;
 
@@ -922,7 +1124,7 @@ public:
         iterator(node const* cur, field_index_type pos) : cur(cur), pos(pos) {}
 
         // a copy constructor
-        iterator(const iterator& other) : cur(other.cur), pos(other.pos) {}
+        iterator(const iterator& other) : decoded_base(other), cur(other.cur), pos(other.pos) {}
 
         // an assignment operator
         iterator& operator=(const iterator& other) {
@@ -943,6 +1145,12 @@ public:
 
         // the deref operator as required by the iterator concept
         const Key& operator*() const {
+            if constexpr (compressed) {
+                if (cur->isLeaf()) {
+                    this->decoded = cur->getKey(pos);
+                    return this->decoded;
+                }
+            }
             return cur->keys[pos];
         }
 
@@ -1038,6 +1246,9 @@ protected:
     // a pointer to the left-most node of this tree (initial note for iteration)
     leaf_node* leftmost;
 
+    // the arena holding the nodes of this tree
+    std::unique_ptr<NodeArena> arena;
+
     /* -------------- operator hint statistics ----------------- */
 
     // an aggregation of statistical values of the hint utilization
@@ -1058,6 +1269,9 @@ protected:
     // the hint statistic of this b-tree instance
     mutable hint_statistics hint_stats;
 
+    // the statistics on the elements of this b-tree instance
+    Statistics stats;
+
 public:
     // the maximum number of keys stored per node
     static constexpr std::size_t max_keys_per_node = node::maxKeys;
@@ -1066,23 +1280,29 @@ public:
 
     // the default constructor creating an empty tree
     btree(Comparator comp = Comparator(), WeakComparator weak_comp = WeakComparator())
-            : comp(std::move(comp)), weak_comp(std::move(weak_comp)), root(nullptr), leftmost(nullptr) {}
+            : comp(std::move(comp)), weak_comp(std::move(weak_comp)), root(nullptr), leftmost(nullptr),
+              arena(std::make_unique<NodeArena>()) {}
 
     // a constructor creating a tree from the given iterator range
     template <typename Iter>
-    btree(const Iter& a, const Iter& b) : root(nullptr), leftmost(nullptr) {
+    btree(const Iter& a, const Iter& b)
+            : root(nullptr), leftmost(nullptr), arena(std::make_unique<NodeArena>()) {
         insert(a, b);
     }
 
     // a move constructor
     btree(btree&& other)
-            : comp(other.comp), weak_comp(other.weak_comp), root(other.root), leftmost(other.leftmost) {
+            : comp(other.comp), weak_comp(other.weak_comp), root(other.root), leftmost(other.leftmost),
+              arena(std::exchange(other.arena, std::make_unique<NodeArena>())), stats(other.stats) {
         other.root = nullptr;
         other.leftmost = nullptr;
+        other.stats.clear();
     }
 
     // a copy constructor
-    btree(const btree& set) : comp(set.comp), weak_comp(set.weak_comp), root(nullptr), leftmost(nullptr) {
+    btree(const btree& set)
+            : comp(set.comp), weak_comp(set.weak_comp), root(nullptr), leftmost(nullptr),
+              arena(std::make_unique<NodeArena>()) {
         // use assignment operator for a deep copy
         *this = set;
     }
@@ -1092,7 +1312,8 @@ protected:
      * An internal constructor enabling the specific creation of a tree
      * based on internal parameters.
      */
-    btree(size_type /* size */, node* root, leaf_node* leftmost) : root(root), leftmost(leftmost) {}
+    btree(size_type /* size */, node* root, leaf_node* leftmost)
+            : root(root), leftmost(leftmost), arena(std::make_unique<NodeArena>()) {}
 
 public:
     // the destructor freeing all contained nodes
@@ -1112,6 +1333,42 @@ public:
         return (root) ? root->countEntries() : 0;
     }
 
+    // whether this tree maintains the number of distinct prefixes of its elements
+    static constexpr bool has_prefix_statistics = Statistics::enabled;
+
+    // whether this tree can be built in bulk from sorted elements, see bulk_load
+    static constexpr bool has_bulk_load = true;
+
+    /**
+     * Obtains the (approximate) number of distinct prefixes of the given length
+     * among the elements of this tree; requires has_prefix_statistics.
+     */
+    size_type getDistinctPrefixes(size_type length) const {
+        return stats.distinct(length);
+    }
+
+    /**
+     * Starts maintaining the number of distinct prefixes of the elements of this tree,
+     * accounting for the elements present; requires has_prefix_statistics, not thread safe.
+     */
+    void enablePrefixStatistics() {
+        if (stats.active()) {
+            return;
+        }
+        stats.enable();
+        Key pred{};
+        for (auto it = begin(); it != end(); ++it) {
+            const Key cur = *it;
+            stats.inserted((it == begin()) ? nullptr : &pred, cur, nullptr);
+            pred = cur;
+        }
+    }
+
+    // whether the number of distinct prefixes of the elements of this tree is maintained
+    bool hasPrefixStatistics() const {
+        return stats.active();
+    }
+
     /**
      * Inserts the given key into this tree.
      */
@@ -1142,10 +1399,10 @@ public:
             }
 
             // create new node
-            leftmost = new leaf_node();
-            leftmost->numElements = 1;
-            leftmost->keys[0] = k;
+            leftmost = createNode<leaf_node>(*arena);
+            leftmost->setKeys(&k, 1);
             root = leftmost;
+            stats.inserted(nullptr, k, nullptr);
 
             // operation complete => we can release the root lock
             root_lock.end_write();
@@ -1225,7 +1482,7 @@ public:
                     }
 
                     // update provenance information
-                    if (typeid(Comparator) != typeid(WeakComparator) && less(k, *pos)) {
+                    if (updates(*pos, k)) {
                         if (!cur->lock.try_upgrade_to_write(cur_lease)) {
                             // start again
                             return insert(k, hints);
@@ -1265,14 +1522,10 @@ public:
 
             // -- insert node in leaf node --
 
-            auto a = &(cur->keys[0]);
-            auto b = &(cur->keys[cur->numElements]);
-
-            auto pos = search.upper_bound(k, a, b, weak_comp);
-            auto idx = pos - a;
+            auto idx = static_cast<std::ptrdiff_t>(cur->template bound<true>(k, weak_comp));
 
             // early exit for sets
-            if (isSet && pos != a && weak_equal(*(pos - 1), k)) {
+            if (isSet && idx > 0 && weak_equal(cur->getKey(idx - 1), k)) {
                 // validate result
                 if (!cur->lock.validate(cur_lease)) {
                     // start over again
@@ -1280,12 +1533,12 @@ public:
                 }
 
                 // update provenance information
-                if (typeid(Comparator) != typeid(WeakComparator) && less(k, *(pos - 1))) {
+                if (updates(cur->keys[idx - 1], k)) {
                     if (!cur->lock.try_upgrade_to_write(cur_lease)) {
                         // start again
                         return insert(k, hints);
                     }
-                    update(*(pos - 1), k);
+                    update(cur->keys[idx - 1], k);
                     cur->lock.end_write();
                     return true;
                 }
@@ -1301,7 +1554,7 @@ public:
                 return insert(k, hints);
             }
 
-            if (cur->numElements >= node::maxKeys) {
+            if (!cur->canInsert(k)) {
                 // -- lock parents --
                 auto priv = cur;
                 auto parent = priv->parent;
@@ -1341,7 +1594,7 @@ public:
                 // split this node
                 auto old_root = root;
                 idx -= cur->rebalance_or_split(
-                        const_cast<node**>(&root), root_lock, static_cast<int>(idx), parents);
+                        const_cast<node**>(&root), root_lock, *arena, static_cast<int>(idx), parents);
 
                 // release parent lock
                 for (auto it = parents.rbegin(); it != parents.rend(); ++it) {
@@ -1359,8 +1612,8 @@ public:
                     }
                 }
 
-                // insert element in right fragment
-                if (((size_type)idx) > cur->numElements) {
+                // insert element in right fragment, or retry if a compressed leaf still lacks space
+                if (((size_type)idx) > cur->numElements || !cur->canInsert(k)) {
                     // release current lock
                     cur->lock.end_write();
 
@@ -1370,16 +1623,9 @@ public:
             }
 
             // ok - no split necessary
-            assert(cur->numElements < node::maxKeys && "Split required!");
-
-            // move keys
-            for (int j = static_cast<int>(cur->numElements); j > static_cast<int>(idx); --j) {
-                cur->keys[j] = cur->keys[j - 1];
-            }
+            assert(cur->canInsert(k) && "Split required!");
 
-            // insert new element
-            cur->keys[idx] = k;
-            cur->numElements++;
+            insert_into_leaf(cur, idx, k);
 
             // release lock on current node
             cur->lock.end_write();
@@ -1393,10 +1639,10 @@ public:
         // special handling for inserting first element
         if (empty()) {
             // create new node
-            leftmost = new leaf_node();
-            leftmost->numElements = 1;
-            leftmost->keys[0] = k;
+            leftmost = createNode<leaf_node>(*arena);
+            leftmost->setKeys(&k, 1);
             root = leftmost;
+            stats.inserted(nullptr, k, nullptr);
 
             hints.last_insert.access(leftmost);
 
@@ -1432,7 +1678,7 @@ public:
                 // early exit for sets
                 if (isSet && pos != b && weak_equal(*pos, k)) {
                     // update provenance information
-                    if (typeid(Comparator) != typeid(WeakComparator) && less(k, *pos)) {
+                    if (updates(*pos, k)) {
                         update(*pos, k);
                         return true;
                     }
@@ -1449,45 +1695,39 @@ public:
 
             // -- insert node in leaf node --
 
-            auto a = &(cur->keys[0]);
-            auto b = &(cur->keys[cur->numElements]);
-
-            auto pos = search.upper_bound(k, a, b, weak_comp);
-            auto idx = pos - a;
+            auto idx = static_cast<std::ptrdiff_t>(cur->template bound<true>(k, weak_comp));
 
             // early exit for sets
-            if (isSet && pos != a && weak_equal(*(pos - 1), k)) {
+            if (isSet && idx > 0 && weak_equal(cur->getKey(idx - 1), k)) {
                 // update provenance information
-                if (typeid(Comparator) != typeid(WeakComparator) && less(k, *(pos - 1))) {
-                    update(*(pos - 1), k);
+                if (updates(cur->keys[idx - 1], k)) {
+                    update(cur->keys[idx - 1], k);
                     return true;
                 }
 
                 return false;
             }
 
-            if (cur->numElements >= node::maxKeys) {
+            if (!cur->canInsert(k)) {
                 // split this node
-                idx -= cur->rebalance_or_split(&root, root_lock, static_cast<int>(idx));
+                idx -= cur->rebalance_or_split(&root, root_lock, *arena, static_cast<int>(idx));
 
                 // insert element in right fragment
                 if (((size_type)idx) > cur->numElements) {
                     idx -= cur->numElements + 1;
                     cur = cur->parent->getChild(cur->position + 1);
                 }
+
+                // a compressed leaf may still lack space if the new key shares fewer components
+                if (!cur->canInsert(k)) {
+                    return insert(k, hints);
+                }
             }
 
             // ok - no split necessary
-            assert(cur->numElements < node::maxKeys && "Split required!");
-
-            // move keys
-            for (int j = static_cast<int>(cur->numElements); j > idx; --j) {
-                cur->keys[j] = cur->keys[j - 1];
-            }
+            assert(cur->canInsert(k) && "Split required!");
 
-            // insert new element
-            cur->keys[idx] = k;
-            cur->numElements++;
+            insert_into_leaf(cur, idx, k);
 
             // remember last insertion position
             hints.last_insert.access(cur);
@@ -1511,6 +1751,54 @@ public:
         }
     }
 
+    /**
+     * Inserts the given range of elements, sorted by the order of this tree, in bulk.
+     * Unless the range is small compared to this tree, below about 1/log2(size()) of
+     * its size, the tree is rebuilt bottom-up from the merge of its elements and the
+     * range, filling each node up to the given fraction of its capacity. Not thread safe.
+     *
+     * @param a, b .. the range of elements to be inserted
+     * @param fillFactor .. the filling rate of the created nodes, within (0,1]
+     */
+    template <typename Iter>
+    void bulk_load(const Iter& a, const Iter& b, double fillFactor = 1.0) {
+        assert(0 < fillFactor && fillFactor <= 1 && "Invalid fill factor!");
+
+        // elements weakly equal to present ones need to be merged by the updater
+        if constexpr (!std::is_same_v<Comparator, WeakComparator>) {
+            insert(a, b);
+            return;
+        }
+        assert(std::is_sorted(a, b, [&](const Key& x, const Key& y) { return less(x, y); }));
+
+        // rebuilding this tree takes a step per element, while inserting takes a descent of
+        // about log2(present) steps per inserted element; small ranges are inserted
+        const auto length = static_cast<size_type>(std::distance(a, b));
+        const size_type present = size();
+        size_type depth = 1;
+        for (size_type n = present; n > 1; n >>= 1) {
+            ++depth;
+        }
+        if (length == 0 || length * depth < present) {
+            insert(a, b);
+            return;
+        }
+
+        // merge the elements of this tree and the range
+        std::vector<Key> keys;
+        keys.reserve(present + length);
+        std::merge(begin(), end(), a, b, std::back_inserter(keys),
+                [&](const Key& x, const Key& y) { return less(x, y); });
+        if (isSet) {
+            keys.erase(std::unique(keys.begin(), keys.end(),
+                               [&](const Key& x, const Key& y) { return equal(x, y); }),
+                    keys.end());
+        }
+
+        clear();
+        build(keys, fillFactor);
+    }
+
     // Obtains an iterator referencing the first element of the tree.
     iterator begin() const {
         return iterator(leftmost, 0);
@@ -1595,6 +1883,16 @@ public:
         // an iterative implementation (since 2/7 faster than recursive)
 
         while (true) {
+            if constexpr (compressed) {
+                if (cur->isLeaf()) {
+                    hints.last_find_end.access(cur);
+                    auto idx = cur->template bound<false>(k, comp);
+                    return (idx < cur->numElements && equal(cur->getKey(idx), k))
+                                   ? iterator(cur, static_cast<field_index_type>(idx))
+                                   : end();
+                }
+            }
+
             auto a = &(cur->keys[0]);
             auto b = &(cur->keys[cur->numElements]);
 
@@ -1653,6 +1951,14 @@ public:
 
         iterator res = end();
         while (true) {
+            if constexpr (compressed) {
+                if (cur->isLeaf()) {
+                    hints.last_lower_bound_end.access(cur);
+                    auto idx = cur->template bound<false>(k, comp);
+                    return (idx < cur->numElements) ? iterator(cur, static_cast<field_index_type>(idx)) : res;
+                }
+            }
+
             auto a = &(cur->keys[0]);
             auto b = &(cur->keys[cur->numElements]);
 
@@ -1714,6 +2020,14 @@ public:
 
         iterator res = end();
         while (true) {
+            if constexpr (compressed) {
+                if (cur->isLeaf()) {
+                    hints.last_upper_bound_end.access(cur);
+                    auto idx = cur->template bound<true>(k, comp);
+                    return (idx < cur->numElements) ? iterator(cur, static_cast<field_index_type>(idx)) : res;
+                }
+            }
+
             auto a = &(cur->keys[0]);
             auto b = &(cur->keys[cur->numElements]);
 
@@ -1734,18 +2048,20 @@ public:
     }
 
     /**
-     * Clears this tree.
+     * Clears this tree, releasing the memory of all of its nodes at once.
      */
     void clear() {
-        if (root != nullptr) {
-            if (root->isLeaf()) {
-                delete static_cast<leaf_node*>(root);
-            } else {
-                delete static_cast<inner_node*>(root);
+        // nodes only need to be visited if they have to be destructed
+        if constexpr (!std::is_trivially_destructible_v<leaf_node> ||
+                      !std::is_trivially_destructible_v<inner_node>) {
+            if (root != nullptr) {
+                destroy(root);
             }
         }
+        arena->clear();
         root = nullptr;
         leftmost = nullptr;
+        stats.clear();
     }
 
     /**
@@ -1757,6 +2073,8 @@ public:
         // swap the content
         std::swap(root, other.root);
         std::swap(leftmost, other.leftmost);
+        std::swap(arena, other.arena);
+        stats.swap(other.stats);
     }
 
     // Implementation of the assignment operation for trees.
@@ -1766,6 +2084,9 @@ public:
             return *this;
         }
 
+        // drop the current content
+        clear();
+
         // create a deep-copy of the content of the other tree
         // shortcut for empty sets
         if (other.empty()) {
@@ -1773,7 +2094,7 @@ public:
         }
 
         // clone content (deep copy)
-        root = other.root->clone();
+        root = other.root->clone(*arena);
 
         // update leftmost reference
         auto tmp = root;
@@ -1782,6 +2103,13 @@ public:
         }
         leftmost = static_cast<leaf_node*>(tmp);
 
+        // the statistics of this tree remain maintained, if they were
+        const bool maintained = stats.active();
+        stats = other.stats;
+        if (maintained) {
+            enablePrefixStatistics();
+        }
+
         // done
         return *this;
     }
@@ -1860,6 +2188,7 @@ public:
         out << "  Size of leaf node:  " << sizeof(leaf_node) << "\n";
         out << "  Size of Key:        " << sizeof(Key) << "\n";
         out << "  max keys / node:  " << node::maxKeys << "\n";
+        out << "  max keys / leaf:  " << node::maxLeafKeys << "\n";
         out << "  avg keys / node:  " << (size() / (double)nodes) << "\n";
         out << "  avg filling rate: " << ((size() / (double)nodes) / node::maxKeys) << "\n";
         out << " ---------------------------------\n";
@@ -1903,20 +2232,148 @@ public:
             return R();
         }
 
-        // resolve tree recursively
-        auto root = buildSubTree(a, b - 1);
+        // resolve tree recursively, within the arena of the result
+        R res;
+        res.root = buildSubTree(*res.arena, a, b - 1);
 
         // find leftmost node
-        node* leftmost = root;
+        node* leftmost = res.root;
         while (!leftmost->isLeaf()) {
             leftmost = leftmost->getChild(0);
         }
-
-        // build result
-        return R(b - a, root, static_cast<leaf_node*>(leftmost));
+        res.leftmost = static_cast<leaf_node*>(leftmost);
+        return res;
     }
 
 protected:
+    /**
+     * Inserts the given key at the given position of the given leaf, which
+     * has to have space for it.
+     */
+    void insert_into_leaf(node* cur, std::ptrdiff_t idx, const Key& k) {
+        auto n = static_cast<std::ptrdiff_t>(cur->numElements);
+
+        if constexpr (compressed) {
+            // decode the keys, add the new element and re-encode them
+            Key buffer[node::maxLeafKeys];
+            for (std::ptrdiff_t i = 0; i < n; ++i) {
+                buffer[(i < idx) ? i : i + 1] = cur->getKey(i);
+            }
+            buffer[idx] = k;
+
+            stats.inserted((idx > 0) ? &buffer[idx - 1] : nullptr, k, (idx < n) ? &buffer[idx + 1] : nullptr);
+            cur->setKeys(buffer, n + 1);
+            return;
+        }
+
+        // account for the new element and its neighbours within this leaf
+        stats.inserted((idx > 0) ? &cur->keys[idx - 1] : nullptr, k, (idx < n) ? &cur->keys[idx] : nullptr);
+
+        // move keys
+        for (auto j = n; j > idx; --j) {
+            cur->keys[j] = cur->keys[j - 1];
+        }
+
+        // insert new element
+        cur->keys[idx] = k;
+        cur->numElements++;
+    }
+
+    /**
+     * Builds this empty tree bottom-up from the given sorted, duplicate-free keys.
+     * Nodes are filled up to the given fraction of their capacity, and neighbouring
+     * nodes are separated by the key in between them.
+     */
+    void build(const std::vector<Key>& keys, double fillFactor) {
+        assert(empty());
+        const size_type n = keys.size();
+        if (n == 0) {
+            return;
+        }
+
+        // the number of keys of a node of the given capacity, enabling it to be split
+        auto filled = [&](size_type capacity) {
+            return std::max<size_type>(2, static_cast<size_type>(capacity * fillFactor));
+        };
+
+        // the number of entries of a node, leaving at least two entries for its right neighbour
+        auto take = [](size_type desired, size_type remaining) {
+            return (desired < remaining) ? std::min(desired, remaining - 2) : remaining;
+        };
+
+        // create the leaves, recording the positions of the keys separating them
+        std::vector<node*> level;
+        std::vector<size_type> separators;
+        for (size_type i = 0; i < n;) {
+            const size_type count = take(filled(leafCapacity(keys, i)), n - i);
+            node* leaf = createNode<leaf_node>(*arena);
+            leaf->setKeys(&keys[i], count);
+            level.push_back(leaf);
+            i += count;
+            if (i < n) {
+                separators.push_back(i++);
+            }
+        }
+        leftmost = static_cast<leaf_node*>(level.front());
+
+        // create the levels of inner nodes, until a single root remains
+        const size_type numChildren = filled(node::maxKeys) + 1;
+        while (level.size() > 1) {
+            std::vector<node*> parents;
+            std::vector<size_type> parentSeparators;
+            for (size_type i = 0; i < level.size();) {
+                const size_type count = take(numChildren, level.size() - i);
+                auto* inner = createNode<inner_node>(*arena);
+                inner->numElements = count - 1;
+                for (size_type j = 0; j < count; ++j) {
+                    node* child = level[i + j];
+                    child->parent = inner;
+                    child->position = static_cast<field_index_type>(j);
+                    inner->children[j] = child;
+                    if (j + 1 < count) {
+                        inner->keys[j] = keys[separators[i + j]];
+                    }
+                }
+                parents.push_back(inner);
+                i += count;
+                if (i < level.size()) {
+                    parentSeparators.push_back(separators[i - 1]);
+                }
+            }
+            level.swap(parents);
+            separators.swap(parentSeparators);
+        }
+        root = level.front();
+
+        if constexpr (Statistics::enabled) {
+            for (size_type i = 0; i < n; ++i) {
+                stats.inserted((i == 0) ? nullptr : &keys[i - 1], keys[i], nullptr);
+            }
+        }
+    }
+
+    /**
+     * Determines the number of the given keys, starting at the given position, fitting
+     * into a single leaf.
+     */
+    static size_type leafCapacity(const std::vector<Key>& keys, size_type i) {
+        if constexpr (compressed) {
+            // fewer keys share more components, so the number of fitting keys is found by bisection
+            size_type hi = std::min<size_type>(node::maxLeafKeys, keys.size() - i);
+            size_type lo = std::min<size_type>(node::maxKeys, hi);
+            while (lo < hi) {
+                size_type mid = lo + (hi - lo + 1) / 2;
+                if (mid <= Compression::capacity(Compression::common(&keys[i], mid), node::maxKeys)) {
+                    lo = mid;
+                } else {
+                    hi = mid - 1;
+                }
+            }
+            return lo;
+        }
+        return node::maxKeys;
+    }
+
     /**
      * Determines whether the range covered by the given node is also
      * covering the given key value.
@@ -1924,10 +2381,11 @@ protected:
     bool covers(const node* node, const Key& k) const {
         if (isSet) {
             // in sets we can include the ends as covered elements
-            return !node->isEmpty() && !less(k, node->keys[0]) && !less(node->keys[node->numElements - 1], k);
+            return !node->isEmpty() && !less(k, node->getKey(0)) &&
+                   !less(node->getKey(node->numElements - 1), k);
         }
         // in multi-sets the ends may not be completely covered
-        return !node->isEmpty() && less(node->keys[0], k) && less(k, node->keys[node->numElements - 1]);
+        return !node->isEmpty() && less(node->getKey(0), k) && less(k, node->getKey(node->numElements - 1));
     }
 
     /**
@@ -1937,12 +2395,12 @@ protected:
     bool weak_covers(const node* node, const Key& k) const {
         if (isSet) {
             // in sets we can include the ends as covered elements
-            return !node->isEmpty() && !weak_less(k, node->keys[0]) &&
-                   !weak_less(node->keys[node->numElements - 1], k);
+            return !node->isEmpty() && !weak_less(k, node->getKey(0)) &&
+                   !weak_less(node->getKey(node->numElements - 1), k);
         }
         // in multi-sets the ends may not be completely covered
-        return !node->isEmpty() && weak_less(node->keys[0], k) &&
-               weak_less(k, node->keys[node->numElements - 1]);
+        return !node->isEmpty() && weak_less(node->getKey(0), k) &&
+               weak_less(k, node->getKey(node->numElements - 1));
     }
 
 private:
@@ -1952,12 +2410,12 @@ private:
      */
     bool coversUpperBound(const node* node, const Key& k) const {
         // ignore edges
-        return !node->isEmpty() && !less(k, node->keys[0]) && less(k, node->keys[node->numElements - 1]);
+        return !node->isEmpty() && !less(k, node->getKey(0)) && less(k, node->getKey(node->numElements - 1));
     }
 
     // Utility function for the load operation above.
     template <typename Iter>
-    static node* buildSubTree(const Iter& a, const Iter& b) {
+    static node* buildSubTree(NodeArena& arena, const Iter& a, const Iter& b) {
         const int N = node::maxKeys;
 
         // divide range in N+1 sub-ranges
@@ -1966,7 +2424,16 @@ private:
         // terminal case: length is less then maxKeys
         if (length <= N) {
             // create a leaf node
-            node* res = new leaf_node();
+            node* res = createNode<leaf_node>(arena);
+
+            // compressed leaves are encoded from a copy of the keys
+            if constexpr (compressed) {
+                Key buffer[node::maxKeys];
+                std::copy(a, a + length, buffer);
+                res->setKeys(buffer, length);
+                return res;
+            }
+
             res->numElements = length;
 
             for (int i = 0; i < length; ++i) {
@@ -1986,7 +2453,7 @@ private:
         }
 
         // create inner node
-        node* res = new inner_node();
+        node* res = createNode<inner_node>(arena);
         res->numElements = numKeys;
 
         Iter c = a;
@@ -1995,7 +2462,7 @@ private:
             res->keys[i] = c[step];
 
             // get sub-tree
-            auto child = buildSubTree(c, c + (step - 1));
+            auto child = buildSubTree(arena, c, c + (step - 1));
             child->parent = res;
             child->position = i;
             res->getChildren()[i] = child;
@@ -2004,7 +2471,7 @@ private:
         }
 
         // and the remaining part
-        auto child = buildSubTree(c, b);
+        auto child = buildSubTree(arena, c, b);
         child->parent = res;
         child->position = numKeys;
         res->getChildren()[numKeys] = child;
@@ -2016,9 +2483,9 @@ private:
 
 // Instantiation of static member search.
 template <typename Key, typename Comparator, typename Allocator, unsigned blockSize, typename SearchStrategy,
-        bool isSet, typename WeakComparator, typename Updater>
-const SearchStrategy
-        btree<Key, Comparator, Allocator, blockSize, SearchStrategy, isSet, WeakComparator, Updater>::search;
+        bool isSet, typename WeakComparator, typename Updater, typename Statistics, typename Compression>
+const SearchStrategy btree<Key, Comparator, Allocator, blockSize, SearchStrategy, isSet, WeakComparator,
+        Updater, Statistics, Compression>::search;
 
 }  // end namespace detail
 
@@ -2030,19 +2497,23 @@ const SearchStrategy
  * @tparam Allocator     .. utilized for allocating memory for required nodes
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
+ * @tparam Statistics   .. the statistics maintained on the stored elements
+ * @tparam Compression  .. the layout of the keys stored in leaf nodes
  */
 template <typename Key, typename Comparator = detail::comparator<Key>,
         typename Allocator = std::allocator<Key>,  // is ignored so far
         unsigned blockSize = 256,
         typename SearchStrategy = typename souffle::detail::default_strategy<Key>::type,
-        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>>
+        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>,
+        typename Statistics = souffle::detail::no_statistics<Key>,
+        typename Compression = souffle::detail::no_compression<Key>>
 class btree_set : public souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, true,
-                          WeakComparator, Updater> {
+                          WeakComparator, Updater, Statistics, Compression> {
     using super = souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, true,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, Statistics, Compression>;
 
     friend class souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, true,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, Statistics, Compression>;
 
 public:
     /**
@@ -2092,19 +2563,23 @@ public:
  * @tparam Allocator     .. utilized for allocating memory for required nodes
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
+ * @tparam Statistics   .. the statistics maintained on the stored elements
+ * @tparam Compression  .. the layout of the keys stored in leaf nodes
  */
 template <typename Key, typename Comparator = detail::comparator<Key>,
         typename Allocator = std::allocator<Key>,  // is ignored so far
         unsigned blockSize = 256,
         typename SearchStrategy = typename souffle::detail::default_strategy<Key>::type,
-        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>>
+        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>,
+        typename Statistics = souffle::detail::no_statistics<Key>,
+        typename Compression = souffle::detail::no_compression<Key>>
 class btree_multiset : public souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy,
-                               false, WeakComparator, Updater> {
+                               false, WeakComparator, Updater, Statistics, Compression> {
     using super = souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, false,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, Statistics, Compression>;
 
     friend class souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, false,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, Statistics, Compression>;
 
 public:
     /**
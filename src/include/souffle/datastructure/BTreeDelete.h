@@ -48,11 +48,12 @@ namespace detail {
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
  * @tparam isSet        .. true = set, false = multiset
+ * @tparam Statistics   .. the statistics maintained on the stored elements
  */
 template <typename Key, typename Comparator,
         typename Allocator,  // is ignored so far - TODO: add support
         unsigned blockSize, typename SearchStrategy, bool isSet, typename WeakComparator = Comparator,
-        typename Updater = detail::updater<Key>>
+        typename Updater = detail::updater<Key>, typename Statistics = detail::no_statistics<Key>>
 class btree_delete {
 public:
     class iterator;
@@ -906,7 +907,7 @@ public:
      */
     class iterator {
         friend class souffle::detail::btree_delete<Key, Comparator, Allocator, blockSize, SearchStrategy,
-                true, WeakComparator, Updater>;
+                true, WeakComparator, Updater, Statistics>;
 
         // a pointer to the node currently referred to
         // node const* cur;
@@ -1022,9 +1023,13 @@ public:
                             cur = cur->getParent();
                         } while (cur && pos == 0);
 
-                        // If we were at the beginning of the tree, reset the iterator
+                        // If we were at the beginning of the tree, reset the iterator,
+                        // otherwise the predecessor is the separator left of the child
                         if (!cur) {
                             cur = temp;
+                            pos = 0;
+                        } else {
+                            --pos;
                         }
                     }
                 }
@@ -1090,6 +1095,11 @@ protected:
     // a pointer to the left-most node of this tree (initial note for iteration)
     leaf_node* leftmost;
 
+#ifdef IS_PARALLEL
+    // the lanes of the threads updating this tree, all held by erasures restructuring it
+    ConcurrentLanes update_lanes{static_cast<std::size_t>(MAX_THREADS)};
+#endif
+
     /* -------------- operator hint statistics ----------------- */
 
     // an aggregation of statistical values of the hint utilization
@@ -1110,6 +1120,9 @@ protected:
     // the hint statistic of this b-tree instance
     mutable hint_statistics hint_stats;
 
+    // the statistics on the elements of this b-tree instance
+    Statistics stats;
+
 public:
     // the maximum number of keys stored per node
     static constexpr std::size_t max_keys_per_node = node::maxKeys;
@@ -1128,9 +1141,11 @@ public:
 
     // a move constructor
     btree_delete(btree_delete&& other)
-            : comp(other.comp), weak_comp(other.weak_comp), root(other.root), leftmost(other.leftmost) {
+            : comp(other.comp), weak_comp(other.weak_comp), root(other.root), leftmost(other.leftmost),
+              stats(other.stats) {
         other.root = nullptr;
         other.leftmost = nullptr;
+        other.stats.clear();
     }
 
     // a copy constructor
@@ -1165,6 +1180,39 @@ public:
         return (root) ? root->countEntries() : 0;
     }
 
+    // whether this tree maintains the number of distinct prefixes of its elements
+    static constexpr bool has_prefix_statistics = Statistics::enabled;
+
+    /**
+     * Obtains the (approximate) number of distinct prefixes of the given length
+     * among the elements of this tree; requires has_prefix_statistics.
+     */
+    size_type getDistinctPrefixes(size_type length) const {
+        return stats.distinct(length);
+    }
+
+    /**
+     * Starts maintaining the number of distinct prefixes of the elements of this tree,
+     * accounting for the elements present; requires has_prefix_statistics, not thread safe.
+     */
+    void enablePrefixStatistics() {
+        if (stats.active()) {
+            return;
+        }
+        stats.enable();
+        Key pred{};
+        for (auto it = begin(); it != end(); ++it) {
+            const Key cur = *it;
+            stats.inserted((it == begin()) ? nullptr : &pred, cur, nullptr);
+            pred = cur;
+        }
+    }
+
+    // whether the number of distinct prefixes of the elements of this tree is maintained
+    bool hasPrefixStatistics() const {
+        return stats.active();
+    }
+
     /**
      * Inserts the given key into this tree.
      */
@@ -1178,7 +1226,143 @@ public:
      */
     bool insert(const Key& k, operation_hints& hints) {
 #ifdef IS_PARALLEL
+        // exclude erasures restructuring this tree
+        auto guard = update_lanes.guard();
+        return insert_shared(k, hints);
+#else
+        // special handling for inserting first element
+        if (empty()) {
+            // create new node
+            leftmost = new leaf_node();
+            leftmost->numElements = 1;
+            leftmost->keys[0] = k;
+            root = leftmost;
+            stats.inserted(nullptr, k, nullptr);
+
+            hints.last_insert.access(leftmost);
+
+            return true;
+        }
+
+        // insert using iterative implementation
+        node* cur = root;
+
+        auto checkHints = [&](node* last_insert) {
+            if (!last_insert) return false;
+            if (!weak_covers(last_insert, k)) return false;
+            cur = last_insert;
+            return true;
+        };
+
+        // test last insert
+        if (hints.last_insert.any(checkHints)) {
+            hint_stats.inserts.addHit();
+        } else {
+            hint_stats.inserts.addMiss();
+        }
+
+        while (true) {
+            // handle inner nodes
+            if (cur->inner) {
+                auto a = &(cur->keys[0]);
+                auto b = &(cur->keys[cur->numElements]);
+
+                auto pos = search.lower_bound(k, a, b, weak_comp);
+                auto idx = pos - a;
+
+                // early exit for sets
+                if (isSet && pos != b && weak_equal(*pos, k)) {
+                    // update provenance information
+                    if (typeid(Comparator) != typeid(WeakComparator) && less(k, *pos)) {
+                        update(*pos, k);
+                        return true;
+                    }
+
+                    return false;
+                }
 
+                cur = cur->getChild(idx);
+                continue;
+            }
+
+            // the rest is for leaf nodes
+            assert(!cur->inner);
+
+            // -- insert node in leaf node --
+
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+
+            auto pos = search.upper_bound(k, a, b, weak_comp);
+            auto idx = pos - a;
+
+            // early exit for sets
+            if (isSet && pos != a && weak_equal(*(pos - 1), k)) {
+                // update provenance information
+                if (typeid(Comparator) != typeid(WeakComparator) && less(k, *(pos - 1))) {
+                    update(*(pos - 1), k);
+                    return true;
+                }
+
+                return false;
+            }
+
+            if (cur->numElements >= node::maxKeys) {
+                // split this node
+                idx -= cur->rebalance_or_split(&root, root_lock, static_cast<int>(idx));
+
+                // insert element in right fragment
+                if (((size_type)idx) > cur->numElements) {
+                    idx -= cur->numElements + 1;
+                    cur = cur->parent->getChild(cur->position + 1);
+                }
+            }
+
+            // ok - no split necessary
+            assert(cur->numElements < node::maxKeys && "Split required!");
+
+            // account for the new element and its neighbours within this leaf
+            stats.inserted((idx > 0) ? &cur->keys[idx - 1] : nullptr, k,
+                    (static_cast<size_type>(idx) < cur->numElements) ? &cur->keys[idx] : nullptr);
+
+            // move keys
+            for (int j = static_cast<int>(cur->numElements); j > idx; --j) {
+                cur->keys[j] = cur->keys[j - 1];
+            }
+
+            // insert new element
+            cur->keys[idx] = k;
+            cur->numElements++;
+
+            // remember last insertion position
+            hints.last_insert.access(cur);
+
+            return true;
+        }
+#endif
+    }
+
+    /**
+     * Inserts the given range of elements into this tree.
+     */
+    template <typename Iter>
+    void insert(const Iter& a, const Iter& b) {
+        // TODO: improve this beyond a naive insert
+        operation_hints hints;
+        // a naive insert so far .. seems to work fine
+        for (auto it = a; it != b; ++it) {
+            // use insert with hint
+            insert(*it, hints);
+        }
+    }
+
+private:
+#ifdef IS_PARALLEL
+    /**
+     * Inserts the given key into this tree, while holding the update lane
+     * of the current thread.
+     */
+    bool insert_shared(const Key& k, operation_hints& hints) {
         // special handling for inserting first element
         while (root == nullptr) {
             // try obtaining root-lock
@@ -1199,6 +1383,7 @@ public:
             leftmost->numElements = 1;
             leftmost->keys[0] = k;
             root = leftmost;
+            stats.inserted(nullptr, k, nullptr);
 
             // operation complete => we can release the root lock
             root_lock.end_write();
@@ -1274,14 +1459,14 @@ public:
                     // validate results
                     if (!cur->lock.validate(cur_lease)) {
                         // start over again
-                        return insert(k, hints);
+                        return insert_shared(k, hints);
                     }
 
                     // update provenance information
                     if (typeid(Comparator) != typeid(WeakComparator) && less(k, *pos)) {
                         if (!cur->lock.try_upgrade_to_write(cur_lease)) {
                             // start again
-                            return insert(k, hints);
+                            return insert_shared(k, hints);
                         }
                         update(*pos, k);
                         cur->lock.end_write();
@@ -1301,7 +1486,7 @@ public:
                 // check whether there was a write
                 if (!cur->lock.end_read(cur_lease)) {
                     // start over
-                    return insert(k, hints);
+                    return insert_shared(k, hints);
                 }
 
                 // go to next
@@ -1329,14 +1514,14 @@ public:
                 // validate result
                 if (!cur->lock.validate(cur_lease)) {
                     // start over again
-                    return insert(k, hints);
+                    return insert_shared(k, hints);
                 }
 
                 // update provenance information
                 if (typeid(Comparator) != typeid(WeakComparator) && less(k, *(pos - 1))) {
                     if (!cur->lock.try_upgrade_to_write(cur_lease)) {
                         // start again
-                        return insert(k, hints);
+                        return insert_shared(k, hints);
                     }
                     update(*(pos - 1), k);
                     cur->lock.end_write();
@@ -1351,7 +1536,7 @@ public:
             if (!cur->lock.try_upgrade_to_write(cur_lease)) {
                 // something has changed => restart
                 hints.last_insert.access(cur);
-                return insert(k, hints);
+                return insert_shared(k, hints);
             }
 
             if (cur->numElements >= node::maxKeys) {
@@ -1418,13 +1603,17 @@ public:
                     cur->lock.end_write();
 
                     // insert in sibling
-                    return insert(k, hints);
+                    return insert_shared(k, hints);
                 }
             }
 
             // ok - no split necessary
             assert(cur->numElements < node::maxKeys && "Split required!");
 
+            // account for the new element and its neighbours within this leaf
+            stats.inserted((idx > 0) ? &cur->keys[idx - 1] : nullptr, k,
+                    (static_cast<size_type>(idx) < cur->numElements) ? &cur->keys[idx] : nullptr);
+
             // move keys
             for (int j = static_cast<int>(cur->numElements); j > static_cast<int>(idx); --j) {
                 cur->keys[j] = cur->keys[j - 1];
@@ -1441,158 +1630,202 @@ public:
             hints.last_insert.access(cur);
             return true;
         }
+    }
+#endif
 
-#else
-        // special handling for inserting first element
-        if (empty()) {
-            // create new node
-            leftmost = new leaf_node();
-            leftmost->numElements = 1;
-            leftmost->keys[0] = k;
-            root = leftmost;
+public:
 
-            hints.last_insert.access(leftmost);
+    /**
+     * Compute the number of instances of a key in the tree
+     */
+    size_type get_count(const Key& k) const {
+        if (empty()) {
+            return 0;
+        }
+        if (isSet) {
+            auto iter = internal_find(k);
+            if (iter != end()) {
+                return 1;
+            } else {
+                return 0;
+            }
+        } else {
+            auto lower_iter = internal_lower_bound(k);
+            if (lower_iter != end() && equal(*lower_iter, k)) {
+                return std::distance(lower_iter, internal_upper_bound(k));
+            } else {
+                return 0;
+            }
+        }
+    }
 
-            return true;
+    /**
+     * Erase the given key from the tree.
+     * Return the number of erased keys.
+     *
+     * Keys may be erased concurrently with each other and with insertions. Keys of sets
+     * are removed from their leaf alone where possible; erasures requiring to restructure
+     * the tree exclude all other updates.
+     */
+    size_type erase(const Key& k) {
+#ifdef IS_PARALLEL
+        if constexpr (isSet) {
+            auto guard = update_lanes.guard();
+            size_type res = 0;
+            if (erase_from_leaf(k, res)) {
+                return res;
+            }
         }
 
-        // insert using iterative implementation
-        node* cur = root;
+        // lock all update lanes
+        const auto lane = update_lanes.threadLane();
+        update_lanes.lock(lane);
+        update_lanes.beforeLockAllBut(lane);
+        update_lanes.lockAllBut(lane);
 
-        auto checkHints = [&](node* last_insert) {
-            if (!last_insert) return false;
-            if (!weak_covers(last_insert, k)) return false;
-            cur = last_insert;
-            return true;
-        };
+        size_type res = erase_exclusive(k);
 
-        // test last insert
-        if (hints.last_insert.any(checkHints)) {
-            hint_stats.inserts.addHit();
-        } else {
-            hint_stats.inserts.addMiss();
-        }
+        update_lanes.unlockAllBut(lane);
+        update_lanes.beforeUnlockAllBut(lane);
+        update_lanes.unlock(lane);
+        return res;
+#else
+        return erase_exclusive(k);
+#endif
+    }
 
-        while (true) {
-            // handle inner nodes
-            if (cur->inner) {
-                auto a = &(cur->keys[0]);
-                auto b = &(cur->keys[cur->numElements]);
+    /**
+     * Erase the key pointed to by the iterator.
+     * Advance the iterator to the next position.
+     * Not thread safe.
+     */
+    void erase(iterator& iter) {
+        erase_at(iter);
+    }
 
-                auto pos = search.lower_bound(k, a, b, weak_comp);
-                auto idx = pos - a;
+private:
+#ifdef IS_PARALLEL
+    /**
+     * Attempts to erase the given key from a set by only updating the leaf holding it,
+     * while holding the update lane of the current thread. Fails if the key is stored
+     * in an inner node or its leaf would become too small, requiring to restructure
+     * the tree.
+     *
+     * @param k .. the key to be erased
+     * @param res .. set to the number of erased keys on success
+     */
+    bool erase_from_leaf(const Key& k, size_type& res) {
+        // trees only become empty when being restructured
+        if (root == nullptr) {
+            res = 0;
+            return true;
+        }
 
-                // early exit for sets
-                if (isSet && pos != b && weak_equal(*pos, k)) {
-                    // update provenance information
-                    if (typeid(Comparator) != typeid(WeakComparator) && less(k, *pos)) {
-                        update(*pos, k);
-                        return true;
-                    }
+        node* cur = nullptr;
+        lock_type::Lease cur_lease;
+        do {
+            // get root - access lock
+            auto root_lease = root_lock.start_read();
 
-                    return false;
-                }
+            // start with root
+            cur = root;
 
-                cur = cur->getChild(idx);
-                continue;
-            }
+            // get lease of the next node to be accessed
+            cur_lease = cur->lock.start_read();
 
-            // the rest is for leaf nodes
-            assert(!cur->inner);
+            // check validity of root pointer
+            if (root_lock.end_read(root_lease)) {
+                break;
+            }
 
-            // -- insert node in leaf node --
+        } while (true);
 
+        // navigate to the leaf covering the key
+        while (cur->inner) {
             auto a = &(cur->keys[0]);
             auto b = &(cur->keys[cur->numElements]);
 
-            auto pos = search.upper_bound(k, a, b, weak_comp);
-            auto idx = pos - a;
+            auto pos = search.lower_bound(k, a, b, comp);
 
-            // early exit for sets
-            if (isSet && pos != a && weak_equal(*(pos - 1), k)) {
-                // update provenance information
-                if (typeid(Comparator) != typeid(WeakComparator) && less(k, *(pos - 1))) {
-                    update(*(pos - 1), k);
-                    return true;
+            // keys of inner nodes are only erased when restructuring the tree
+            if (pos != b && equal(*pos, k)) {
+                if (!cur->lock.validate(cur_lease)) {
+                    // start over
+                    return erase_from_leaf(k, res);
                 }
-
                 return false;
             }
 
-            if (cur->numElements >= node::maxKeys) {
-                // split this node
-                idx -= cur->rebalance_or_split(&root, root_lock, static_cast<int>(idx));
-
-                // insert element in right fragment
-                if (((size_type)idx) > cur->numElements) {
-                    idx -= cur->numElements + 1;
-                    cur = cur->parent->getChild(cur->position + 1);
-                }
-            }
+            // get next pointer
+            auto next = cur->getChild(pos - a);
 
-            // ok - no split necessary
-            assert(cur->numElements < node::maxKeys && "Split required!");
+            // get lease on next level
+            auto next_lease = next->lock.start_read();
 
-            // move keys
-            for (int j = static_cast<int>(cur->numElements); j > idx; --j) {
-                cur->keys[j] = cur->keys[j - 1];
+            // check whether there was a write
+            if (!cur->lock.end_read(cur_lease)) {
+                // start over
+                return erase_from_leaf(k, res);
             }
 
-            // insert new element
-            cur->keys[idx] = k;
-            cur->numElements++;
+            // go to next
+            cur = next;
+            cur_lease = next_lease;
+        }
 
-            // remember last insertion position
-            hints.last_insert.access(cur);
+        auto a = &(cur->keys[0]);
+        auto b = &(cur->keys[cur->numElements]);
 
+        auto pos = search.lower_bound(k, a, b, comp);
+
+        // the key is not present
+        if (pos == b || !equal(*pos, k)) {
+            if (!cur->lock.validate(cur_lease)) {
+                // start over
+                return erase_from_leaf(k, res);
+            }
+            res = 0;
             return true;
         }
-#endif
-    }
 
-    /**
-     * Inserts the given range of elements into this tree.
-     */
-    template <typename Iter>
-    void insert(const Iter& a, const Iter& b) {
-        // TODO: improve this beyond a naive insert
-        operation_hints hints;
-        // a naive insert so far .. seems to work fine
-        for (auto it = a; it != b; ++it) {
-            // use insert with hint
-            insert(*it, hints);
+        // upgrade to write-permission
+        if (!cur->lock.try_upgrade_to_write(cur_lease)) {
+            // something has changed => restart
+            return erase_from_leaf(k, res);
         }
-    }
 
-    /**
-     * Compute the number of instances of a key in the tree
-     */
-    size_type get_count(const Key& k) const {
-        if (empty()) {
-            return 0;
+        // the leaf must not become too small; whether it is the root only changes when
+        // restructuring the tree
+        const size_type n = cur->numElements;
+        if (n <= ((cur->parent == nullptr) ? 1 : node::minKeys)) {
+            cur->lock.abort_write();
+            return false;
         }
-        if (isSet) {
-            auto iter = internal_find(k);
-            if (iter != end()) {
-                return 1;
-            } else {
-                return 0;
-            }
-        } else {
-            auto lower_iter = internal_lower_bound(k);
-            if (lower_iter != end() && equal(*lower_iter, k)) {
-                return std::distance(lower_iter, internal_upper_bound(k));
-            } else {
-                return 0;
-            }
+
+        // account for the removed element and its neighbours within this leaf
+        const auto idx = static_cast<size_type>(pos - a);
+        stats.erased((idx > 0) ? &cur->keys[idx - 1] : nullptr, k,
+                (idx + 1 < n) ? &cur->keys[idx + 1] : nullptr);
+
+        // move keys
+        for (size_type i = idx + 1; i < n; ++i) {
+            cur->keys[i - 1] = cur->keys[i];
         }
+        cur->numElements--;
+
+        // release lock on current node
+        cur->lock.end_write();
+
+        res = 1;
+        return true;
     }
+#endif
 
     /**
-     * Erase the given key from the tree.
+     * Erase the given key from the tree, excluding any concurrent updates.
      * Return the number of erased keys.
      */
-    size_type erase(const Key& k) {
+    size_type erase_exclusive(const Key& k) {
         if (empty()) {
             return 0;
         }
@@ -1602,7 +1835,7 @@ public:
                 // Key not found
                 return 0;
             } else {
-                erase(iter);
+                erase_at(iter);
                 return 1;
             }
         } else {
@@ -1610,7 +1843,7 @@ public:
             if (lower_iter != end() && equal(*lower_iter, k)) {
                 size_type count = std::distance(lower_iter, internal_upper_bound(k));
                 for (size_type i = 0; i < count; i++) {
-                    erase(lower_iter);
+                    erase_at(lower_iter);
                 }
                 return count;
             } else {
@@ -1623,7 +1856,20 @@ public:
      * Erase the key pointed to by the iterator.
      * Advance the iterator to the next position.
      */
-    void erase(iterator& iter) {
+    void erase_at(iterator& iter) {
+        if constexpr (Statistics::enabled) {
+            // account for the removed element and its neighbours
+            iterator succ(iter);
+            ++succ;
+            const Key* pred = nullptr;
+            if (iter != begin()) {
+                iterator prev(iter);
+                --prev;
+                pred = &*prev;
+            }
+            stats.erased(pred, *iter, (succ != end()) ? &*succ : nullptr);
+        }
+
         bool internal_delete = false;
         // @julienhenry
         // iter.cur->lock.start_write();
@@ -1703,7 +1949,6 @@ public:
         // iter.cur->lock.end_write(); //@julienhenry
     }
 
-private:
     /**
      * Find the given key in a non-empty tree.
      * If found, return an iterator pointing to the key.
@@ -2307,6 +2552,7 @@ public:
         }
         root = nullptr;
         leftmost = nullptr;
+        stats.clear();
     }
 
     /**
@@ -2318,6 +2564,7 @@ public:
         // swap the content
         std::swap(root, other.root);
         std::swap(leftmost, other.leftmost);
+        stats.swap(other.stats);
     }
 
     // Implementation of the assignment operation for trees.
@@ -2343,6 +2590,13 @@ public:
         }
         leftmost = static_cast<leaf_node*>(tmp);
 
+        // the statistics of this tree remain maintained, if they were
+        const bool maintained = stats.active();
+        stats = other.stats;
+        if (maintained) {
+            enablePrefixStatistics();
+        }
+
         // done
         return *this;
     }
@@ -2474,7 +2728,8 @@ public:
         }
 
         // build result
-        return R(b - a, root, static_cast<leaf_node*>(leftmost));
+        R res(b - a, root, static_cast<leaf_node*>(leftmost));
+        return res;
     }
 
 protected:
@@ -2577,9 +2832,9 @@ private:
 
 // Instantiation of static member search.
 template <typename Key, typename Comparator, typename Allocator, unsigned blockSize, typename SearchStrategy,
-        bool isSet, typename WeakComparator, typename Updater>
+        bool isSet, typename WeakComparator, typename Updater, typename Statistics>
 const SearchStrategy btree_delete<Key, Comparator, Allocator, blockSize, SearchStrategy, isSet,
-        WeakComparator, Updater>::search;
+        WeakComparator, Updater, Statistics>::search;
 
 }  // end namespace detail
 
@@ -2591,19 +2846,21 @@ const SearchStrategy btree_delete<Key, Comparator, Allocator, blockSize, SearchS
  * @tparam Allocator     .. utilized for allocating memory for required nodes
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
+ * @tparam Statistics   .. the statistics maintained on the stored elements
  */
 template <typename Key, typename Comparator = detail::comparator<Key>,
         typename Allocator = std::allocator<Key>,  // is ignored so far
         unsigned blockSize = 256,
         typename SearchStrategy = typename souffle::detail::default_strategy<Key>::type,
-        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>>
+        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>,
+        typename Statistics = souffle::detail::no_statistics<Key>>
 class btree_delete_set : public souffle::detail::btree_delete<Key, Comparator, Allocator, blockSize,
-                                 SearchStrategy, true, WeakComparator, Updater> {
+                                 SearchStrategy, true, WeakComparator, Updater, Statistics> {
     using super = souffle::detail::btree_delete<Key, Comparator, Allocator, blockSize, SearchStrategy, true,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, Statistics>;
 
     friend class souffle::detail::btree_delete<Key, Comparator, Allocator, blockSize, SearchStrategy, true,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, Statistics>;
 
 public:
     /**
@@ -2654,19 +2911,21 @@ public:
  * @tparam Allocator     .. utilized for allocating memory for required nodes
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
+ * @tparam Statistics   .. the statistics maintained on the stored elements
  */
 template <typename Key, typename Comparator = detail::comparator<Key>,
         typename Allocator = std::allocator<Key>,  // is ignored so far
         unsigned blockSize = 256,
         typename SearchStrategy = typename souffle::detail::default_strategy<Key>::type,
-        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>>
+        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>,
+        typename Statistics = souffle::detail::no_statistics<Key>>
 class btree_delete_multiset : public souffle::detail::btree_delete<Key, Comparator, Allocator, blockSize,
-                                      SearchStrategy, false, WeakComparator, Updater> {
+                                      SearchStrategy, false, WeakComparator, Updater, Statistics> {
     using super = souffle::detail::btree_delete<Key, Comparator, Allocator, blockSize, SearchStrategy, false,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, Statistics>;
 
     friend class souffle::detail::btree_delete<Key, Comparator, Allocator, blockSize, SearchStrategy, false,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, Statistics>;
 
 public:
     /**
@@ -16,7 +16,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
 
 namespace souffle {
 
@@ -46,6 +59,19 @@ struct comparator {
     }
 };
 
+/**
+ * Obtains the number of leading components of keys that a comparator orders
+ * lexicographically by their signed values, first component first, or 0 if
+ * it is not known to do so. Comparators declare this order by a static
+ * member lexicographic_signed_arity.
+ */
+template <typename Comp, typename = void>
+struct lexicographic_signed_arity : public std::integral_constant<std::size_t, 0> {};
+
+template <typename Comp>
+struct lexicographic_signed_arity<Comp, std::void_t<decltype(Comp::lexicographic_signed_arity)>>
+        : public std::integral_constant<std::size_t, Comp::lexicographic_signed_arity> {};
+
 // ---------- search strategies --------------
 
 /**
@@ -188,6 +214,254 @@ struct binary_search : public search_strategy {
     }
 };
 
+/**
+ * A search strategy comparing the keys of b-tree nodes using SIMD instructions.
+ *
+ * It applies to keys that are arrays of one to four signed 32-bit integers,
+ * ordered lexicographically by all their components (see
+ * lexicographic_signed_arity).
+ * Nodes of keys of arity one, and of arity two if AVX2 or SSE4.2 is available,
+ * are scanned several keys at a time for the first key not less than the
+ * searched one. Keys of larger arities are binary searched, comparing all
+ * components of a key at once. Any other key, comparator or target falls
+ * back to the binary search strategy.
+ */
+struct simd_search : public search_strategy {
+    /**
+     * Required user-defined default constructor.
+     */
+    simd_search() = default;
+
+    /**
+     * Obtains an iterator pointing to some element within the given
+     * range that is equal to the given key, if available. If no such
+     * element is present, a reference to the first element not less than
+     * the given key will be returned.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    Iter operator()(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (vectorized<Key, Iter, Comp>()) {
+            return lower_bound(k, a, b, comp);
+        } else {
+            return binary_search()(k, a, b, comp);
+        }
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * is not less than the given key.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    Iter lower_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (vectorized<Key, Iter, Comp>()) {
+            return a + count<std::tuple_size<Key>::value, false>(components(&k), components(a), b - a);
+        } else {
+            return binary_search().lower_bound(k, a, b, comp);
+        }
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * such that the given key is less than the referenced element.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    Iter upper_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (vectorized<Key, Iter, Comp>()) {
+            return a + count<std::tuple_size<Key>::value, true>(components(&k), components(a), b - a);
+        } else {
+            return binary_search().upper_bound(k, a, b, comp);
+        }
+    }
+
+private:
+    template <typename Key, typename Comp>
+    struct is_simd_key : public std::false_type {};
+
+    template <typename T, std::size_t N, typename Comp>
+    struct is_simd_key<std::array<T, N>, Comp>
+            : public std::bool_constant<std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4 &&
+                                        1 <= N && N <= 4 && lexicographic_signed_arity<Comp>::value == N> {};
+
+    /** Whether searching the given range of keys is vectorized */
+    template <typename Key, typename Iter, typename Comp>
+    static constexpr bool vectorized() {
+#ifdef __SSE2__
+        return is_simd_key<Key, std::remove_cv_t<Comp>>::value && std::is_pointer_v<Iter> &&
+               std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Iter>>, Key>;
+#else
+        return false;
+#endif
+    }
+
+    /** Views a key of 32-bit components as the sequence of its components */
+    template <typename Key>
+    static const std::int32_t* components(const Key* key) {
+        return reinterpret_cast<const std::int32_t*>(key);
+    }
+
+#ifdef __SSE2__
+    /**
+     * Counts the leading keys of arity N in the given sequence of n keys that
+     * are less than the key k, or not greater than k if inclusive is set.
+     */
+    template <std::size_t N, bool inclusive>
+    static std::ptrdiff_t count(const std::int32_t* k, const std::int32_t* keys, std::ptrdiff_t n) {
+        if constexpr (N == 1) {
+            std::ptrdiff_t i = 0;
+#ifdef __AVX2__
+            const __m256i kv = _mm256_set1_epi32(k[0]);
+            for (; i + 8 <= n; i += 8) {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+                const int stop = inclusive ? mask(_mm256_cmpgt_epi32(x, kv))
+                                           : ~mask(_mm256_cmpgt_epi32(kv, x)) & 0xff;
+                if (stop != 0) {
+                    return i + __builtin_ctz(stop);
+                }
+            }
+#endif
+            const __m128i kv4 = _mm_set1_epi32(k[0]);
+            for (; i + 4 <= n; i += 4) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+                const int stop =
+                        inclusive ? mask(_mm_cmpgt_epi32(x, kv4)) : ~mask(_mm_cmpgt_epi32(kv4, x)) & 0xf;
+                if (stop != 0) {
+                    return i + __builtin_ctz(stop);
+                }
+            }
+            for (; i < n; ++i) {
+                if (inclusive ? keys[i] > k[0] : keys[i] >= k[0]) {
+                    return i;
+                }
+            }
+            return n;
+        }
+#if defined(__AVX2__) || defined(__SSE4_2__)
+        else if constexpr (N == 2) {
+            // compare pairs as 64-bit integers, see widen
+            const std::int64_t kw = widen(k);
+            std::ptrdiff_t i = 0;
+#ifdef __AVX2__
+            const __m256i kv = _mm256_set1_epi64x(kw);
+            const __m256i bias = _mm256_set1_epi64x(0x80000000);
+            for (; i + 4 <= n; i += 4) {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + 2 * i));
+                x = _mm256_xor_si256(_mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)), bias);
+                const int stop = inclusive ? mask64(_mm256_cmpgt_epi64(x, kv))
+                                           : ~mask64(_mm256_cmpgt_epi64(kv, x)) & 0xf;
+                if (stop != 0) {
+                    return i + __builtin_ctz(stop);
+                }
+            }
+#else
+            const __m128i kv = _mm_set1_epi64x(kw);
+            const __m128i bias = _mm_set1_epi64x(0x80000000);
+            for (; i + 2 <= n; i += 2) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + 2 * i));
+                x = _mm_xor_si128(_mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)), bias);
+                const int stop =
+                        inclusive ? mask64(_mm_cmpgt_epi64(x, kv)) : ~mask64(_mm_cmpgt_epi64(kv, x)) & 0x3;
+                if (stop != 0) {
+                    return i + __builtin_ctz(stop);
+                }
+            }
+#endif
+            for (; i < n; ++i) {
+                const std::int64_t x = widen(keys + 2 * i);
+                if (inclusive ? x > kw : x >= kw) {
+                    return i;
+                }
+            }
+            return n;
+        }
+#endif
+        else {
+            // binary search comparing all components of a key at once
+            const __m128i kv = load<N>(k);
+            std::ptrdiff_t a = 0;
+            std::ptrdiff_t len = n;
+            while (len > 0) {
+                auto step = len >> 1;
+                auto c = a + step;
+                auto r = compare<N>(keys + c * N, kv);
+                if (inclusive ? r <= 0 : r < 0) {
+                    a = c + 1;
+                    len -= step + 1;
+                } else {
+                    len = step;
+                }
+            }
+            return a;
+        }
+    }
+
+    /**
+     * Maps a pair of signed 32-bit integers to a 64-bit integer, preserving
+     * their lexicographical order.
+     */
+    static std::int64_t widen(const std::int32_t* key) {
+        const auto high = static_cast<std::uint64_t>(static_cast<std::uint32_t>(key[0])) << 32;
+        const auto low = static_cast<std::uint32_t>(key[1]) ^ 0x80000000u;
+        return static_cast<std::int64_t>(high | low);
+    }
+
+    /** Loads a key of arity N into the lower lanes of a vector, zeroing the others */
+    template <std::size_t N>
+    static __m128i load(const std::int32_t* key) {
+        if constexpr (N == 2) {
+            return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(key));
+        } else if constexpr (N == 3) {
+            return _mm_unpacklo_epi64(
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(key)), _mm_cvtsi32_si128(key[2]));
+        } else {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+        }
+    }
+
+    /**
+     * Compares a key of arity N with the loaded key kv, returning a negative
+     * value if it is less, a positive value if it is greater, and 0 otherwise.
+     */
+    template <std::size_t N>
+    static int compare(const std::int32_t* key, __m128i kv) {
+        const __m128i x = load<N>(key);
+        const int lt = mask(_mm_cmplt_epi32(x, kv));
+        const int gt = mask(_mm_cmpgt_epi32(x, kv));
+        // the first differing component decides
+        const int diff = lt | gt;
+        const int first = diff & -diff;
+        return (gt & first) - (lt & first);
+    }
+
+    /** Collects the sign bits of the 32-bit lanes of a vector */
+    static int mask(__m128i v) {
+        return _mm_movemask_ps(_mm_castsi128_ps(v));
+    }
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+    /** Collects the sign bits of the 64-bit lanes of a vector */
+    static int mask64(__m128i v) {
+        return _mm_movemask_pd(_mm_castsi128_pd(v));
+    }
+#endif
+
+#ifdef __AVX2__
+    /** Collects the sign bits of the 32-bit lanes of a vector */
+    static int mask(__m256i v) {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(v));
+    }
+
+    /** Collects the sign bits of the 64-bit lanes of a vector */
+    static int mask64(__m256i v) {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(v));
+    }
+#endif
+#else
+    // never instantiated, searches are not vectorized without SSE2
+    template <std::size_t N, bool inclusive>
+    static std::ptrdiff_t count(const std::int32_t* k, const std::int32_t* keys, std::ptrdiff_t n);
+#endif
+};
+
 // ---------- search strategies selection --------------
 
 /**
@@ -201,6 +475,7 @@ struct strategy_selection {
 
 struct linear : public strategy_selection<linear_search> {};
 struct binary : public strategy_selection<binary_search> {};
+struct simd : public strategy_selection<simd_search> {};
 
 // by default every key utilizes binary search
 template <typename Key>
@@ -212,6 +487,10 @@ struct default_strategy<int> : public linear {};
 template <typename... Ts>
 struct default_strategy<std::tuple<Ts...>> : public linear {};
 
+// arrays of integers, e.g. tuples, utilize SIMD instructions where possible
+template <typename T, std::size_t N>
+struct default_strategy<std::array<T, N>> : public simd {};
+
 /**
  * The default non-updater
  */
@@ -220,5 +499,311 @@ struct updater {
     void update(T& /* old_t */, const T& /* new_t */) {}
 };
 
+/**
+ * Determines whether an updater selects itself the present elements it updates by an
+ * `updates(old_t, new_t)` member. Otherwise present elements are updated by elements ordered
+ * before them, see btree::updates.
+ */
+template <typename Updater, typename T, typename = void>
+struct is_selective_updater : std::false_type {};
+
+template <typename Updater, typename T>
+struct is_selective_updater<Updater, T,
+        std::void_t<decltype(std::declval<const Updater&>().updates(
+                std::declval<const T&>(), std::declval<const T&>()))>> : std::true_type {};
+
+// ---------- statistics --------------
+
+/**
+ * The default statistics of a b-tree, maintaining nothing.
+ */
+template <typename Key>
+struct no_statistics {
+    static constexpr bool enabled = false;
+
+    void enable() {}
+    bool active() const {
+        return false;
+    }
+    void inserted(const Key* /* pred */, const Key& /* k */, const Key* /* succ */) {}
+    void erased(const Key* /* pred */, const Key& /* k */, const Key* /* succ */) {}
+    std::size_t distinct(std::size_t /* length */) const {
+        return 0;
+    }
+    void clear() {}
+    void swap(no_statistics& /* other */) {}
+};
+
+/**
+ * Maintains the number of distinct prefixes of the keys of a b-tree, assuming the
+ * comparator orders keys lexicographically by their components.
+ *
+ * A key changes the number of distinct prefixes of a length exceeding the longest
+ * prefix it shares with its neighbours, hence a histogram over that length suffices.
+ * Neighbours are only looked up within the affected leaf, so keys inserted at the
+ * boundary of a leaf may be counted as new prefixes; the counts are approximate.
+ *
+ * Nothing is maintained until the statistics are enabled. Every thread then counts
+ * into a histogram of its own, occupying its own cache lines, and the histograms are
+ * only summed up when the number of distinct prefixes is requested.
+ */
+template <typename Key>
+struct prefix_statistics {
+    static constexpr bool enabled = true;
+    static constexpr std::size_t arity = std::tuple_size<Key>::value;
+
+    prefix_statistics() = default;
+    prefix_statistics(const prefix_statistics& other) {
+        *this = other;
+    }
+
+    prefix_statistics& operator=(const prefix_statistics& other) {
+        if (this == &other) {
+            return *this;
+        }
+        lanes.reset();
+        numLanes = 0;
+        if (other.active()) {
+            enable();
+            for (std::size_t i = 0; i <= arity; ++i) {
+                lanes[0].counts[i].store(other.total(i), std::memory_order_relaxed);
+            }
+        }
+        return *this;
+    }
+
+    /** Starts maintaining the statistics, to be called before keys are inserted. */
+    void enable() {
+        if (!active()) {
+            numLanes = std::max(1u, std::thread::hardware_concurrency());
+            lanes = std::make_unique<lane[]>(numLanes);
+        }
+    }
+
+    bool active() const {
+        return lanes != nullptr;
+    }
+
+    void inserted(const Key* pred, const Key& k, const Key* succ) {
+        if (active()) {
+            local().counts[common(pred, k, succ)].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void erased(const Key* pred, const Key& k, const Key* succ) {
+        if (active()) {
+            local().counts[common(pred, k, succ)].fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /** Obtains the number of distinct prefixes of the given length. */
+    std::size_t distinct(std::size_t length) const {
+        std::int64_t res = 0;
+        for (std::size_t i = 0; i < length && i <= arity; ++i) {
+            res += total(i);
+        }
+        return res < 0 ? 0 : static_cast<std::size_t>(res);
+    }
+
+    void clear() {
+        for (std::size_t l = 0; l < numLanes; ++l) {
+            for (auto& cur : lanes[l].counts) {
+                cur.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void swap(prefix_statistics& other) {
+        std::swap(lanes, other.lanes);
+        std::swap(numLanes, other.numLanes);
+    }
+
+private:
+    // the number of keys by the length of the longest prefix shared with a neighbour
+    struct alignas(64) lane {
+        std::array<std::atomic<std::int64_t>, arity + 1> counts{};
+    };
+
+    std::unique_ptr<lane[]> lanes;
+    std::size_t numLanes = 0;
+
+    /** Obtains the histogram of the calling thread; threads are assigned lanes round robin. */
+    lane& local() {
+        static std::atomic<std::size_t> nextThread{0};
+        thread_local const std::size_t thread = nextThread++;
+        return lanes[thread % numLanes];
+    }
+
+    std::int64_t total(std::size_t length) const {
+        std::int64_t res = 0;
+        for (std::size_t l = 0; l < numLanes; ++l) {
+            res += lanes[l].counts[length].load(std::memory_order_relaxed);
+        }
+        return res;
+    }
+
+    static std::size_t common(const Key& a, const Key& b) {
+        std::size_t i = 0;
+        while (i < arity && a[i] == b[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    static std::size_t common(const Key* pred, const Key& k, const Key* succ) {
+        std::size_t res = pred ? common(*pred, k) : 0;
+        if (succ && res < arity) {
+            res = std::max(res, common(k, *succ));
+        }
+        return res;
+    }
+};
+
+// ---------- leaf compression --------------
+
+/**
+ * The default layout of b-tree leaves, storing every key in full.
+ */
+template <typename Key>
+struct no_compression {
+    static constexpr bool enabled = false;
+
+    // leaves maintain no additional state
+    struct leaf_state {};
+
+    static constexpr std::size_t capacity(std::size_t numKeys) {
+        return numKeys;
+    }
+};
+
+/**
+ * A layout of b-tree leaves for keys being arrays of integers, storing the components
+ * shared by all keys of a leaf only once, followed by the remaining components of each
+ * key. The keys of a leaf of a lexicographically ordered tree share at least their
+ * common prefix, so leaves of wide keys hold considerably more keys in the same space.
+ *
+ * The encoding is placed in the key storage of the leaf, viewed as an array of words,
+ * while the shared components are recorded by a bit mask within the leaf. Components
+ * beyond the width of the mask are never shared.
+ */
+template <typename Key>
+struct prefix_compression {
+    static constexpr bool enabled = true;
+
+    using value_type = typename Key::value_type;
+    using mask_type = std::uint64_t;
+
+    static constexpr std::size_t arity = std::tuple_size<Key>::value;
+    static constexpr std::size_t width = std::min<std::size_t>(arity, 64);
+
+    static_assert(arity > 0 && sizeof(Key) == arity * sizeof(value_type), "keys must be arrays of words");
+
+    // leaves record their shared components
+    struct leaf_state {
+        mask_type shared = 0;
+    };
+
+    /** Obtains the maximum number of keys encoded in the storage of the given number of keys. */
+    static constexpr std::size_t capacity(std::size_t numKeys) {
+        // at least one component is distinct between the keys of a set
+        return numKeys * arity - (arity - 1);
+    }
+
+    /** Obtains the number of keys encoded in the given storage if the given components are shared. */
+    static std::size_t capacity(mask_type shared, std::size_t numKeys) {
+        const std::size_t c = count(shared);
+        return (c == arity) ? capacity(numKeys) : (numKeys * arity - c) / (arity - c);
+    }
+
+    /** Obtains the number of keys of storage occupied by the encoding of n keys. */
+    static std::size_t storage(mask_type shared, std::size_t n) {
+        const std::size_t c = count(shared);
+        return (n == 0) ? 0 : (c + n * (arity - c) + arity - 1) / arity;
+    }
+
+    /** Obtains the components shared by all of the given keys, none for an empty range. */
+    static mask_type common(const Key* keys, std::size_t n) {
+        if (n == 0) {
+            return 0;
+        }
+        mask_type res = 0;
+        for (std::size_t j = 0; j < width; ++j) {
+            std::size_t i = 1;
+            while (i < n && keys[i][j] == keys[0][j]) {
+                ++i;
+            }
+            if (i == n) {
+                res |= mask_type(1) << j;
+            }
+        }
+        return res;
+    }
+
+    /** Obtains those of the shared components of an encoding the given key agrees with. */
+    static mask_type agreeing(const Key* storage, mask_type shared, const Key& k) {
+        const auto* words = reinterpret_cast<const value_type*>(storage);
+        std::size_t s = 0;
+        for (std::size_t j = 0; j < width; ++j) {
+            mask_type bit = mask_type(1) << j;
+            if ((shared & bit) && words[s++] != k[j]) {
+                shared &= ~bit;
+            }
+        }
+        return shared;
+    }
+
+    /** Encodes the given keys, sharing the given components, in the given storage. */
+    static void encode(Key* storage, mask_type shared, const Key* keys, std::size_t n) {
+        auto* words = reinterpret_cast<value_type*>(storage);
+        if (n == 0) {
+            return;
+        }
+        for (std::size_t j = 0; j < width; ++j) {
+            if (shared & (mask_type(1) << j)) {
+                *words++ = keys[0][j];
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < arity; ++j) {
+                if (!isShared(shared, j)) {
+                    *words++ = keys[i][j];
+                }
+            }
+        }
+    }
+
+    /**
+     * Decodes the i-th key of the encoding in the given storage of the given number of keys.
+     * Positions beyond the storage, as of concurrently modified leaves, yield arbitrary keys.
+     */
+    static Key decode(const Key* storage, std::size_t numKeys, mask_type shared, std::size_t i) {
+        const auto* words = reinterpret_cast<const value_type*>(storage);
+        const std::size_t c = count(shared);
+        const std::size_t stride = arity - c;
+        Key res{};
+        if (c + (i + 1) * stride > numKeys * arity) {
+            return res;
+        }
+        const value_type* row = words + c + i * stride;
+        for (std::size_t j = 0; j < arity; ++j) {
+            res[j] = isShared(shared, j) ? *words++ : *row++;
+        }
+        return res;
+    }
+
+private:
+    static bool isShared(mask_type shared, std::size_t j) {
+        return j < width && (shared & (mask_type(1) << j));
+    }
+
+    static std::size_t count(mask_type shared) {
+        std::size_t res = 0;
+        for (; shared != 0; shared &= shared - 1) {
+            ++res;
+        }
+        return res;
+    }
+};
+
 }  // end of namespace detail
 }  // end of namespace souffle
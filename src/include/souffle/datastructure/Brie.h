@@ -27,6 +27,7 @@
 #pragma once
 
 #include "souffle/RamTypes.h"
+#include "souffle/datastructure/NodeArena.h"
 #include "souffle/utility/CacheUtil.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
@@ -42,6 +43,7 @@
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -396,37 +398,76 @@ private:
         volatile RootInfo synced;  // for synchronized operations
     };
 
-public:
+    // the arena owned by this array, if it does not share the arena of an enclosing structure
+    std::unique_ptr<NodeArena> ownedArena;
+
+    // the arena holding the nodes of this array
+    NodeArena* arena;
+
     /**
-     * A default constructor creating an empty sparse array.
+     * Creates an empty sparse array allocating its nodes from the given arena, or from an
+     * arena of its own if none is given.
      */
-    SparseArray() : unsynced(RootInfo{nullptr, 0, 0, nullptr, std::numeric_limits<index_type>::max()}) {}
+    explicit SparseArray(NodeArena* shared)
+            : unsynced(RootInfo{nullptr, 0, 0, nullptr, std::numeric_limits<index_type>::max()}),
+              ownedArena(shared ? nullptr : std::make_unique<NodeArena>()),
+              arena(shared ? shared : ownedArena.get()) {}
 
     /**
-     * A copy constructor for sparse arrays. It creates a deep
-     * copy of the data structure maintained by the handed in
-     * array instance.
+     * Creates a deep copy of the given array, allocating its nodes from the given arena, or
+     * from an arena of its own if none is given.
      */
-    SparseArray(const SparseArray& other)
-            : unsynced(RootInfo{clone(other.unsynced.root, other.unsynced.levels), other.unsynced.levels,
-                      other.unsynced.offset, nullptr, other.unsynced.firstOffset}) {
+    SparseArray(const SparseArray& other, NodeArena* shared) : SparseArray(shared) {
+        unsynced.root = clone(other.unsynced.root, other.unsynced.levels);
+        unsynced.levels = other.unsynced.levels;
+        unsynced.offset = other.unsynced.offset;
+        unsynced.firstOffset = other.unsynced.firstOffset;
         if (unsynced.root) {
             unsynced.root->parent = nullptr;
             unsynced.first = findFirst(unsynced.root, unsynced.levels);
         }
     }
 
+public:
+    /**
+     * A default constructor creating an empty sparse array owning the arena of its nodes.
+     */
+    SparseArray() : SparseArray(nullptr) {}
+
+    /**
+     * Creates an empty sparse array allocating its nodes from the given arena, which is
+     * shared with an enclosing data structure and has to outlive this array.
+     */
+    explicit SparseArray(NodeArena& arena) : SparseArray(&arena) {}
+
+    /**
+     * A copy constructor for sparse arrays. It creates a deep
+     * copy of the data structure maintained by the handed in
+     * array instance.
+     */
+    SparseArray(const SparseArray& other) : SparseArray(other, nullptr) {}
+
+    /**
+     * Creates a deep copy of the given array within the given shared arena.
+     */
+    SparseArray(const SparseArray& other, NodeArena& arena) : SparseArray(other, &arena) {}
+
     /**
      * A r-value based copy constructor for sparse arrays. It
      * takes over ownership of the structure maintained by the
-     * handed in array.
+     * handed in array, including its arena.
      */
     SparseArray(SparseArray&& other)
             : unsynced(RootInfo{other.unsynced.root, other.unsynced.levels, other.unsynced.offset,
-                      other.unsynced.first, other.unsynced.firstOffset}) {
+                      other.unsynced.first, other.unsynced.firstOffset}),
+              ownedArena(std::move(other.ownedArena)), arena(other.arena) {
         other.unsynced.root = nullptr;
         other.unsynced.levels = 0;
         other.unsynced.first = nullptr;
+        if (ownedArena) {
+            other.ownedArena = std::make_unique<NodeArena>();
+            other.arena = other.ownedArena.get();
+        }
     }
 
     /**
@@ -467,8 +508,19 @@ public:
      * from a r-value reference to a sparse array.
      */
     SparseArray& operator=(SparseArray&& other) {
+        if (this == &other) return *this;
+
+        // nodes can only be handed over within an arena, or together with it
+        if (arena != other.arena && !(ownedArena && other.ownedArena)) {
+            return *this = other;
+        }
+
         // clean this one
         clean();
+        if (arena != other.arena) {
+            std::swap(ownedArena, other.ownedArena);
+            std::swap(arena, other.arena);
+        }
 
         // harvest content
         unsynced.root = other.unsynced.root;
@@ -549,6 +601,21 @@ public:
         return res;
     }
 
+    /**
+     * Obtains the arena holding the nodes of this array.
+     */
+    NodeArena& getArena() const {
+        return *arena;
+    }
+
+    /**
+     * Determines whether this array owns its arena, rather than sharing it with an enclosing
+     * data structure.
+     */
+    bool ownsArena() const {
+        return ownedArena != nullptr;
+    }
+
     /**
      * Resets the content of this array to default values for each contained
      * element.
@@ -811,7 +878,7 @@ private:
             }
 
             // somebody else was faster => use standard insertion procedure
-            delete info.root;
+            deleteNode(info.root);
 
             // retrieve new root info
             info = getRootInfo();
@@ -854,7 +921,7 @@ private:
                 // try to update next
                 if (!aNext.compare_exchange_strong(next, newNext)) {
                     // some other thread was faster => use updated next
-                    delete newNext;
+                    deleteNode(newNext);
                 } else {
                     // the locally created next is the new next
                     next = newNext;
@@ -987,7 +1054,7 @@ private:
      * @param src the node to be cloned
      * @param levels the height of the cloned node
      */
-    static void merge(const Node* parent, Node*& trg, const Node* src, int levels) {
+    void merge(const Node* parent, Node*& trg, const Node* src, int levels) {
         // if other side is null => done
         if (src == nullptr) {
             return;
@@ -1006,9 +1073,8 @@ private:
 
         // the leaf-node step
         if (levels == 0) {
-            merge_op merg;
             for (int i = 0; i < NUM_CELLS; ++i) {
-                trg->cell[i].value = merg(trg->cell[i].value, src->cell[i].value);
+                trg->cell[i].value = mergeValues(trg->cell[i].value, src->cell[i].value);
             }
             return;
         }
@@ -1313,28 +1379,65 @@ private:
     /**
      * Creates new nodes and initializes them with 0.
      */
-    static Node* newNode() {
-        return new Node();
+    Node* newNode() {
+        return new (arena->allocate(sizeof(Node), alignof(Node))) Node();
+    }
+
+    /**
+     * Returns a node to the arena for being recycled.
+     */
+    void deleteNode(Node* node) {
+        node->~Node();
+        arena->deallocate(node, sizeof(Node), alignof(Node));
+    }
+
+    /**
+     * Copies a value, handing the arena of this array to copy operations allocating from it.
+     */
+    value_type copyValue(const value_type& value) const {
+        copy_op copy;
+        if constexpr (std::is_invocable_v<copy_op, value_type, NodeArena&>) {
+            return copy(value, *arena);
+        } else {
+            return copy(value);
+        }
+    }
+
+    /**
+     * Merges two values, handing the arena of this array to merge operations allocating from it.
+     */
+    value_type mergeValues(const value_type& a, const value_type& b) const {
+        merge_op merg;
+        if constexpr (std::is_invocable_v<merge_op, value_type, value_type, NodeArena&>) {
+            return merg(a, b, *arena);
+        } else {
+            return merg(a, b);
+        }
     }
 
     /**
      * Destroys a node and all its sub-nodes recursively.
      */
-    static void freeNodes(Node* node, int level) {
+    void freeNodes(Node* node, int level) {
         if (!node) return;
         if (level != 0) {
             for (int i = 0; i < NUM_CELLS; i++) {
                 freeNodes(node->cell[i].ptr, level - 1);
             }
         }
-        delete node;
+        deleteNode(node);
     }
 
     /**
-     * Conducts a cleanup of the internal tree structure.
+     * Conducts a cleanup of the internal tree structure. An owned arena releases all
+     * its slabs at once, including those of nested structures sharing it.
      */
     void clean() {
-        freeNodes(unsynced.root, unsynced.levels);
+        if (ownedArena) {
+            ownedArena->clear();
+        } else {
+            freeNodes(unsynced.root, unsynced.levels);
+        }
         unsynced.root = nullptr;
         unsynced.levels = 0;
     }
@@ -1342,20 +1445,19 @@ private:
     /**
      * Clones the given node and all its sub-nodes.
      */
-    static Node* clone(const Node* node, int level) {
+    Node* clone(const Node* node, int level) {
         // support null-pointers
         if (node == nullptr) {
             return nullptr;
         }
 
         // create a clone
-        auto* res = new Node();
+        auto* res = newNode();
 
         // handle leaf level
         if (level == 0) {
-            copy_op copy;
             for (int i = 0; i < NUM_CELLS; i++) {
-                res->cell[i].value = copy(node->cell[i].value);
+                res->cell[i].value = copyValue(node->cell[i].value);
             }
             return res;
         }
@@ -1454,7 +1556,7 @@ private:
             oldRoot->parent = info.root;
         } else {
             // throw away temporary new node
-            delete newRoot;
+            deleteNode(newRoot);
         }
     }
 
@@ -1660,9 +1762,15 @@ public:
     // a simple default constructor
     SparseBitMap() = default;
 
+    // creates an empty bit-map allocating its nodes from the given shared arena
+    explicit SparseBitMap(NodeArena& arena) : store(arena) {}
+
     // a default copy constructor
     SparseBitMap(const SparseBitMap&) = default;
 
+    // creates a copy of the given bit-map within the given shared arena
+    SparseBitMap(const SparseBitMap& other, NodeArena& arena) : store(other.store, arena) {}
+
     // a default r-value copy constructor
     SparseBitMap(SparseBitMap&&) = default;
 
@@ -2027,6 +2135,14 @@ protected:
 
     store_type store;
 
+    TrieBase() = default;
+
+    // creates an empty trie sharing the given arena
+    explicit TrieBase(NodeArena& arena) : store(arena) {}
+
+    // creates a copy of the given trie sharing the given arena
+    TrieBase(const TrieBase& other, NodeArena& arena) : store(other.store, arena) {}
+
 public:
     using const_entry_span_type = typename types::const_entry_span_type;
     using entry_span_type = typename types::entry_span_type;
@@ -2449,11 +2565,23 @@ struct TrieTypes {
     // the type of the nested tries (1 dimension less)
     using nested_trie_type = Trie<Dim - 1>;
 
+    // creates a nested trie within the given arena, as a copy of the given trie if there is one
+    static nested_trie_type* newNested(NodeArena& arena, const nested_trie_type* other = nullptr) {
+        void* mem = arena.allocate(sizeof(nested_trie_type), alignof(nested_trie_type));
+        return other ? new (mem) nested_trie_type(*other, arena) : new (mem) nested_trie_type(arena);
+    }
+
+    // destroys a nested trie created within the given arena
+    static void deleteNested(NodeArena& arena, nested_trie_type* nested) {
+        nested->~nested_trie_type();
+        arena.deallocate(nested, sizeof(nested_trie_type), alignof(nested_trie_type));
+    }
+
     // the merge operation capable of merging two nested tries
     struct nested_trie_merger {
-        nested_trie_type* operator()(nested_trie_type* a, const nested_trie_type* b) const {
+        nested_trie_type* operator()(nested_trie_type* a, const nested_trie_type* b, NodeArena& arena) const {
             if (!b) return a;
-            if (!a) return new nested_trie_type(*b);
+            if (!a) return newNested(arena, b);
             a->insertAll(*b);
             return a;
         }
@@ -2461,9 +2589,9 @@ struct TrieTypes {
 
     // the operation capable of cloning a nested trie
     struct nested_trie_cloner {
-        nested_trie_type* operator()(nested_trie_type* a) const {
+        nested_trie_type* operator()(nested_trie_type* a, NodeArena& arena) const {
             if (!a) return a;
-            return new nested_trie_type(*a);
+            return newNested(arena, a);
         }
     };
 
@@ -2668,6 +2796,23 @@ public:
     using base::lower_bound;
     using base::upper_bound;
 
+    /**
+     * Creates an empty trie owning the arena of its nodes and nested tries.
+     */
+    Trie() = default;
+
+    /**
+     * Creates an empty trie nested in another one, sharing its arena.
+     */
+    explicit Trie(NodeArena& arena) : base(arena) {}
+
+    Trie(const Trie& other) = default;
+
+    /**
+     * Creates a copy of the given trie nested in another one, sharing its arena.
+     */
+    Trie(const Trie& other, NodeArena& arena) : base(other, arena) {}
+
     ~Trie() {
         clear();
     }
@@ -2700,10 +2845,12 @@ public:
      * Removes all entries within this trie.
      */
     void clear() {
-        // delete lower levels manually
-        // (can't use `Own` b/c we need `atomic` instances and those require trivial assignment)
-        for (auto& cur : store)
-            delete cur.second;
+        // lower levels live in the arena of the store, and are released with it if owned;
+        // otherwise they are deleted manually (can't use `Own` b/c we need `atomic` instances)
+        if (!store.ownsArena()) {
+            for (auto& cur : store)
+                types::deleteNested(store.getArena(), cur.second);
+        }
 
         // clear store
         store.clear();
@@ -2738,11 +2885,13 @@ public:
         // conduct a lock-free lazy-creation of nested trees
         if (!nextPtr) {
             // create a sub-tree && register it atomically
-            auto newNested = mk<nested_trie_type>();
-            if (next.compare_exchange_weak(nextPtr, newNested.get())) {
-                nextPtr = newNested.release();  // worked, ownership is acquired by `store`
+            auto* newNested = types::newNested(store.getArena());
+            if (next.compare_exchange_strong(nextPtr, newNested)) {
+                nextPtr = newNested;  // worked, ownership is acquired by `store`
+            } else {
+                // some other thread was faster => use its version
+                types::deleteNested(store.getArena(), newNested);
             }
-            // otherwise some other thread was faster => use its version
         }
 
         // make sure a next has been established
@@ -2940,6 +3089,21 @@ public:
     using base::lower_bound;
     using base::upper_bound;
 
+    /**
+     * Creates an empty trie owning the arena of its nodes.
+     */
+    Trie() = default;
+
+    /**
+     * Creates an empty trie nested in another one, sharing its arena.
+     */
+    explicit Trie(NodeArena& arena) : base(arena) {}
+
+    /**
+     * Creates a copy of the given trie nested in another one, sharing its arena.
+     */
+    Trie(const Trie& other, NodeArena& arena) : base(other, arena) {}
+
     /**
      * Determines the number of entries in this trie.
      */
@@ -0,0 +1,483 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ConcurrentHashSet.h
+ *
+ * Unordered sets of tuples, for relations only scanned or searched by all of their columns.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/Iteration.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace souffle {
+
+namespace detail {
+
+/**
+ * Hashes keys that are sequences of integral values, such as tuples, by their bits.
+ */
+template <typename Key>
+struct tuple_hash {
+    std::size_t operator()(const Key& key) const {
+        std::uint64_t h = 0;
+        for (const auto& cur : key) {
+            using Unsigned = std::make_unsigned_t<std::decay_t<decltype(cur)>>;
+            h = (h ^ static_cast<std::uint64_t>(static_cast<Unsigned>(cur))) * 0x9e3779b97f4a7c15ULL;
+            h ^= h >> 32;
+        }
+        // finalise such that all bits of the hash depend on all bits of the key
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+};
+
+}  // end namespace detail
+
+/**
+ * A set of keys stored in an open-addressing hash table with linear probing, supporting the
+ * concurrent insertion and lookup of keys. Unlike the ordered data structures, the set only
+ * answers whether a key is present and scans its keys in no particular order.
+ *
+ * Each slot of the table holds a key and an atomic state, which is either empty, busy while a
+ * key is written into the slot, or a tag of the hash of the key once the key is published.
+ * Insertions claim an empty slot by a compare-and-swap of its state, such that threads
+ * inserting distinct keys do not wait for each other. Probes compare the tags first, and only
+ * read the keys of slots whose tag matches.
+ *
+ * As in ConcurrentInsertOnlyHashMap, insertions go through the access lane of the calling
+ * thread, and growing the table locks all lanes to let a single thread rehash the keys. The
+ * table doubles when half full, which amortises the global lock. Lookups and scans take no
+ * lock: a grown table is published atomically, and the tables it replaces are retired until
+ * the set is cleared rather than freed, such that concurrent readers and their iterators stay
+ * valid. As tables double, the retired ones take less memory than the current one.
+ *
+ * @tparam Key the type of the stored keys
+ * @tparam Hash the hash function of keys
+ * @tparam Equal the equality of keys, consistent with the hash function
+ */
+template <typename Key, typename Hash = detail::tuple_hash<Key>, typename Equal = std::equal_to<Key>>
+class concurrent_hash_set {
+    using state_type = std::uint32_t;
+
+    // the states of slots without and with a key being written, published keys store their tag
+    static constexpr state_type empty_slot = 0;
+    static constexpr state_type busy_slot = 1;
+
+    struct Table {
+        explicit Table(std::size_t capacity)
+                : capacity(capacity), states(new std::atomic<state_type>[capacity]()),
+                  keys(new Key[capacity]) {}
+
+        // the number of slots, a power of two
+        const std::size_t capacity;
+
+        std::unique_ptr<std::atomic<state_type>[]> states;
+
+        std::unique_ptr<Key[]> keys;
+    };
+
+public:
+    using key_type = Key;
+    using element_type = Key;
+    using size_type = std::size_t;
+
+    // sets are filled by concurrent insertions, not in bulk
+    static constexpr bool has_bulk_load = false;
+
+    /**
+     * The operation hints of this set, which its operations do not depend on. Provided for
+     * compatibility with the ordered data structures.
+     */
+    struct operation_hints {
+        void clear() {}
+    };
+
+    /**
+     * An iterator over the published keys of a range of slots.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        iterator() = default;
+
+        // the first key in [pos, limit) of the given table
+        iterator(const Table* table, size_type pos, size_type limit) : table(table), pos(pos), limit(limit) {
+            skip();
+        }
+
+        // iterators past their range compare equal to end(), whichever table they refer to
+        bool operator==(const iterator& other) const {
+            return pos == other.pos;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return pos != other.pos;
+        }
+
+        const Key& operator*() const {
+            return table->keys[pos];
+        }
+
+        const Key* operator->() const {
+            return &table->keys[pos];
+        }
+
+        iterator& operator++() {
+            ++pos;
+            skip();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto res = *this;
+            ++(*this);
+            return res;
+        }
+
+    private:
+        const Table* table = nullptr;
+        size_type pos = 0;
+        size_type limit = 0;
+
+        void skip() {
+            while (pos < limit && table->states[pos].load(std::memory_order_acquire) <= busy_slot) {
+                ++pos;
+            }
+            if (pos >= limit) {
+                pos = exhausted;
+            }
+        }
+    };
+
+    using const_iterator = iterator;
+    using chunk = range<iterator>;
+
+    concurrent_hash_set() : lanes(static_cast<std::size_t>(MAX_THREADS)) {
+        reset();
+    }
+
+    concurrent_hash_set(const concurrent_hash_set&) = delete;
+    concurrent_hash_set& operator=(const concurrent_hash_set&) = delete;
+
+    // -- modification --
+
+    /**
+     * Inserts the given key, returning whether it was not yet present. Thread safe.
+     */
+    bool insert(const Key& k) {
+        operation_hints hints;
+        return insert(k, hints);
+    }
+
+    bool insert(const Key& k, operation_hints&) {
+        const size_type h = hasher(k);
+        const state_type tag = tagOf(h);
+        const auto guard = lanes.guard();
+
+        // leave an empty slot to each probe, even if all lanes insert at once
+        while (needsGrowth(current().capacity)) {
+            grow();
+        }
+
+        const Table& t = current();
+        const size_type mask = t.capacity - 1;
+        for (size_type i = h & mask;; i = (i + 1) & mask) {
+            state_type s = t.states[i].load(std::memory_order_acquire);
+            if (s == empty_slot) {
+                if (t.states[i].compare_exchange_strong(s, busy_slot, std::memory_order_acquire)) {
+                    t.keys[i] = k;
+                    t.states[i].store(tag, std::memory_order_release);
+                    numKeys.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                // the slot has been claimed by another thread meanwhile
+            }
+            if (s == busy_slot) {
+                s = await(t.states[i]);
+            }
+            if (s == tag && equal(t.keys[i], k)) {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * Inserts the keys of the given range. Thread safe.
+     */
+    template <typename Iter>
+    void insert(const Iter& a, const Iter& b) {
+        operation_hints hints;
+        for (auto it = a; it != b; ++it) {
+            insert(*it, hints);
+        }
+    }
+
+    /**
+     * Removes all keys, shrinking the table to its initial capacity and releasing the retired
+     * tables. Not thread safe.
+     */
+    void clear() {
+        reset();
+        numKeys.store(0, std::memory_order_relaxed);
+    }
+
+    void swap(concurrent_hash_set& other) {
+        tables.swap(other.tables);
+        Table* t = table.load(std::memory_order_relaxed);
+        table.store(other.table.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.table.store(t, std::memory_order_relaxed);
+        const size_type size = numKeys.load(std::memory_order_relaxed);
+        numKeys.store(other.numKeys.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.numKeys.store(size, std::memory_order_relaxed);
+    }
+
+    // -- queries --
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_type size() const {
+        return numKeys.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Obtains an iterator to the first key. Keys are visited in no particular order. Iterators
+     * stay valid while the table grows, but miss the keys inserted since they were obtained.
+     */
+    iterator begin() const {
+        const Table& t = current();
+        return iterator(&t, 0, t.capacity);
+    }
+
+    iterator end() const {
+        const Table& t = current();
+        return iterator(&t, t.capacity, t.capacity);
+    }
+
+    bool contains(const Key& k) const {
+        operation_hints hints;
+        return contains(k, hints);
+    }
+
+    bool contains(const Key& k, operation_hints& hints) const {
+        return find(k, hints) != end();
+    }
+
+    iterator find(const Key& k) const {
+        operation_hints hints;
+        return find(k, hints);
+    }
+
+    /**
+     * Obtains the position of the given key, or end() if absent. A key whose insertion by
+     * another thread has not completed yet may be missed. Thread safe and lock-free.
+     */
+    iterator find(const Key& k, operation_hints&) const {
+        const Table& t = current();
+        const size_type pos = locate(t, k);
+        return iterator(&t, pos, pos == t.capacity ? pos : pos + 1);
+    }
+
+    /**
+     * Obtains the range of keys equal to the given key, which holds at most one key.
+     */
+    chunk equal_range(const Key& k) const {
+        operation_hints hints;
+        return equal_range(k, hints);
+    }
+
+    chunk equal_range(const Key& k, operation_hints& hints) const {
+        auto pos = find(k, hints);
+        auto next = pos;
+        if (pos != end()) {
+            ++next;
+        }
+        return {pos, next};
+    }
+
+    /**
+     * Partitions the slots of this set into about the given number of ranges of equal size,
+     * e.g. to be scanned in parallel. Ranges without keys are omitted.
+     */
+    std::vector<chunk> partition(size_type num) const {
+        return getChunks(num);
+    }
+
+    std::vector<chunk> getChunks(size_type num) const {
+        std::vector<chunk> res;
+        if (empty()) {
+            return res;
+        }
+        const Table& t = current();
+        const size_type capacity = t.capacity;
+        num = std::max<size_type>(1, std::min(num, capacity));
+        const size_type step = (capacity + num - 1) / num;
+        for (size_type first = 0; first < capacity; first += step) {
+            const size_type last = std::min(first + step, capacity);
+            iterator a(&t, first, last);
+            iterator b(&t, last, last);
+            if (a != b) {
+                res.push_back(chunk(a, b));
+            }
+        }
+        return res;
+    }
+
+    void printStats(std::ostream& out = std::cout) const {
+        const size_type capacity = current().capacity;
+        out << " ---------------------------------\n";
+        out << "  Elements: " << size() << "\n";
+        out << "  Slots:    " << capacity << "\n";
+        out << "  Load:     " << static_cast<double>(size()) / static_cast<double>(capacity) << "\n";
+        out << " ---------------------------------\n";
+        out << "  Size of Key:      " << sizeof(Key) << "\n";
+        out << "  memory usage:     " << capacity * (sizeof(Key) + sizeof(state_type)) << "\n";
+        out << " ---------------------------------\n";
+    }
+
+private:
+    // the position of iterators past their range
+    static constexpr size_type exhausted = static_cast<size_type>(-1);
+
+    // the access lanes of inserting threads, all locked while the table grows
+    ConcurrentLanes lanes;
+
+    // the current table, followed by those retired by growing it
+    std::vector<std::unique_ptr<Table>> tables;
+
+    // the current table, published for lock-free readers
+    std::atomic<Table*> table{nullptr};
+
+    std::atomic<size_type> numKeys{0};
+
+    Hash hasher;
+
+    Equal equal;
+
+    // the current table, whose keys are visible once it has been loaded
+    const Table& current() const {
+        return *table.load(std::memory_order_acquire);
+    }
+
+    // replaces all tables by a single one of the initial capacity
+    void reset() {
+        tables.clear();
+        tables.push_back(newTable(0));
+        table.store(tables.front().get(), std::memory_order_release);
+    }
+
+    // the tag of published keys of the given hash, distinct from the empty and busy states
+    static state_type tagOf(size_type h) {
+        return static_cast<state_type>(static_cast<std::uint64_t>(h) >> 32) | 2;
+    }
+
+    // a table of at least the given number of slots, and more than the lanes inserting at once
+    std::unique_ptr<Table> newTable(size_type minCapacity) const {
+        size_type capacity = 16;
+        while (capacity < minCapacity || capacity <= 2 * lanes.lanes()) {
+            capacity *= 2;
+        }
+        return std::make_unique<Table>(capacity);
+    }
+
+    // whether a table of the given capacity is too small for the keys and the ongoing insertions
+    bool needsGrowth(size_type capacity) const {
+        const size_type size = this->size();
+        return 2 * size >= capacity || size + lanes.lanes() >= capacity;
+    }
+
+    // waits for another thread to publish the key of a busy slot, and obtains its tag
+    static state_type await(const std::atomic<state_type>& state) {
+        state_type s;
+        while ((s = state.load(std::memory_order_acquire)) == busy_slot) {
+#ifdef IS_PARALLEL
+            cpu_relax();
+#endif
+        }
+        return s;
+    }
+
+    // the slot of the given key in the given table, or the capacity if absent
+    size_type locate(const Table& t, const Key& k) const {
+        const size_type h = hasher(k);
+        const state_type tag = tagOf(h);
+        const size_type mask = t.capacity - 1;
+        for (size_type i = h & mask;; i = (i + 1) & mask) {
+            const state_type s = t.states[i].load(std::memory_order_acquire);
+            if (s == empty_slot) {
+                return t.capacity;
+            }
+            if (s == tag && equal(t.keys[i], k)) {
+                return i;
+            }
+        }
+    }
+
+    // doubles the table until large enough; called while owning a lane
+    void grow() {
+        lanes.beforeLockAllBut();
+        if (!needsGrowth(current().capacity)) {
+            lanes.beforeUnlockAllBut();
+            return;
+        }
+        lanes.lockAllBut();
+
+        // no other thread inserts into the table, the keys are copied without synchronisation
+        const Table& old = current();
+        auto res = newTable(2 * old.capacity);
+        while (needsGrowth(res->capacity)) {
+            res = newTable(2 * res->capacity);
+        }
+        const size_type mask = res->capacity - 1;
+        for (size_type pos = 0; pos < old.capacity; ++pos) {
+            const state_type s = old.states[pos].load(std::memory_order_relaxed);
+            if (s == empty_slot) {
+                continue;
+            }
+            size_type i = hasher(old.keys[pos]) & mask;
+            while (res->states[i].load(std::memory_order_relaxed) != empty_slot) {
+                i = (i + 1) & mask;
+            }
+            res->keys[i] = old.keys[pos];
+            res->states[i].store(s, std::memory_order_relaxed);
+        }
+        // readers of the old table proceed on it, it is released when the set is cleared
+        table.store(res.get(), std::memory_order_release);
+        tables.insert(tables.begin(), std::move(res));
+
+        lanes.beforeUnlockAllBut();
+        lanes.unlockAllBut();
+    }
+};
+
+}  // end namespace souffle
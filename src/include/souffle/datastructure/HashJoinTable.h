@@ -0,0 +1,223 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HashJoinTable.h
+ *
+ * A hash table over a snapshot of a relation, used by hash joins.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A table of tuples hashed by the values of some of their columns.
+ *
+ * The table is built once from the tuples of a relation and then probed
+ * for the tuples whose key columns equal a given key. It is built in two
+ * phases: the tuples of each chunk of the input are scattered into
+ * partitions by the high bits of the hash of their key, and each partition
+ * is then linked into bucket chains by the low bits. Both phases run in
+ * parallel without synchronisation. Probing is thread-safe.
+ */
+class HashJoinTable {
+    /** Marks the end of a bucket chain */
+    static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+    /** Number of bits of the hash selecting the partition */
+    static constexpr unsigned partitionBits = 6;
+
+    struct Partition {
+        /** Tuples of the partition, stored consecutively */
+        std::vector<RamDomain> tuples;
+
+        /** First tuple of each bucket chain */
+        std::vector<std::size_t> heads;
+
+        /** Next tuple in the bucket chain of each tuple */
+        std::vector<std::size_t> next;
+    };
+
+public:
+    /**
+     * Cursor over the tuples matching a key.
+     *
+     * The key is referenced, not copied, and must outlive the cursor.
+     */
+    class Cursor {
+    public:
+        Cursor(const HashJoinTable& table, const Partition& partition, const RamDomain* key, std::size_t pos)
+                : table(table), partition(partition), key(key), pos(pos) {
+            skip();
+        }
+
+        explicit operator bool() const {
+            return pos != none;
+        }
+
+        const RamDomain* operator*() const {
+            return &partition.tuples[pos * table.arity];
+        }
+
+        Cursor& operator++() {
+            pos = partition.next[pos];
+            skip();
+            return *this;
+        }
+
+    private:
+        /** Skip the tuples of the bucket chain whose key differs */
+        void skip() {
+            while (pos != none && !table.matches(**this, key)) {
+                pos = partition.next[pos];
+            }
+        }
+
+        const HashJoinTable& table;
+        const Partition& partition;
+        const RamDomain* key;
+        std::size_t pos;
+    };
+
+    HashJoinTable(std::size_t arity, std::vector<std::size_t> keyColumns)
+            : arity(arity), keyColumns(std::move(keyColumns)), partitions(std::size_t(1) << partitionBits) {
+        assert(!this->keyColumns.empty() && "hash join requires a key");
+    }
+
+    /**
+     * Build the table from chunks of tuples
+     *
+     * @param chunks random-access sequence of ranges of tuples
+     */
+    template <typename Chunks>
+    void build(const Chunks& chunks) {
+        const int numChunks = static_cast<int>(chunks.size());
+        const int numPartitions = static_cast<int>(partitions.size());
+
+        // scatter the tuples of each chunk into the partitions
+        std::vector<std::vector<std::vector<RamDomain>>> scattered(numChunks);
+        PARALLEL_START
+            pfor(int chunk = 0; chunk < numChunks; ++chunk) {
+                auto& out = scattered[chunk];
+                out.resize(numPartitions);
+                for (const auto& tuple : chunks[chunk]) {
+                    const auto hash = hashKey([&](std::size_t i) { return tuple[keyColumns[i]]; });
+                    auto& part = out[hash >> (64 - partitionBits)];
+                    for (std::size_t i = 0; i < arity; ++i) {
+                        part.push_back(tuple[i]);
+                    }
+                }
+            }
+        PARALLEL_END
+
+        // link the tuples of each partition into bucket chains
+        PARALLEL_START
+            pfor(int p = 0; p < numPartitions; ++p) {
+                auto& partition = partitions[p];
+                std::size_t total = 0;
+                for (const auto& out : scattered) {
+                    total += out[p].size();
+                }
+                partition.tuples.clear();
+                partition.tuples.reserve(total);
+                for (auto& out : scattered) {
+                    partition.tuples.insert(partition.tuples.end(), out[p].begin(), out[p].end());
+                    std::vector<RamDomain>().swap(out[p]);
+                }
+
+                const std::size_t count = total / arity;
+                std::size_t numBuckets = 1;
+                while (numBuckets < count) {
+                    numBuckets <<= 1;
+                }
+                partition.heads.assign(numBuckets, none);
+                partition.next.resize(count);
+                for (std::size_t pos = 0; pos < count; ++pos) {
+                    const RamDomain* tuple = &partition.tuples[pos * arity];
+                    const auto bucket =
+                            hashKey([&](std::size_t i) { return tuple[keyColumns[i]]; }) & (numBuckets - 1);
+                    partition.next[pos] = partition.heads[bucket];
+                    partition.heads[bucket] = pos;
+                }
+            }
+        PARALLEL_END
+    }
+
+    /**
+     * Probe the table
+     *
+     * @param key values of the key columns, in the order of the key columns
+     * @return cursor over the tuples matching the key
+     */
+    Cursor probe(const RamDomain* key) const {
+        const auto hash = hashKey([&](std::size_t i) { return key[i]; });
+        const auto& partition = partitions[hash >> (64 - partitionBits)];
+        if (partition.heads.empty()) {
+            return Cursor(*this, partition, key, none);
+        }
+        return Cursor(*this, partition, key, partition.heads[hash & (partition.heads.size() - 1)]);
+    }
+
+    /** Number of tuples in the table */
+    std::size_t size() const {
+        std::size_t res = 0;
+        for (const auto& partition : partitions) {
+            res += partition.next.size();
+        }
+        return res;
+    }
+
+private:
+    /** Hash the values of the key columns, the i-th of which is given by value(i) */
+    template <typename F>
+    std::uint64_t hashKey(F&& value) const {
+        std::uint64_t hash = 0;
+        for (std::size_t i = 0; i < keyColumns.size(); ++i) {
+            hash = (hash ^ static_cast<std::uint64_t>(ramBitCast<RamUnsigned>(value(i)))) *
+                   UINT64_C(0x9e3779b97f4a7c15);
+        }
+        // spread the bits, both the high bits and the low bits are used
+        hash ^= hash >> 33;
+        hash *= UINT64_C(0xff51afd7ed558ccd);
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    /** Whether the key columns of a tuple equal a key */
+    bool matches(const RamDomain* tuple, const RamDomain* key) const {
+        for (std::size_t i = 0; i < keyColumns.size(); ++i) {
+            if (tuple[keyColumns[i]] != key[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Arity of the tuples */
+    const std::size_t arity;
+
+    /** Columns hashed and compared by probes */
+    const std::vector<std::size_t> keyColumns;
+
+    /** Partitions of the table */
+    std::vector<Partition> partitions;
+};
+
+}  // namespace souffle
@@ -83,7 +83,7 @@ public:
             }
 
             // create new node
-            this->leftmost = new typename parenttype::leaf_node();
+            this->leftmost = parenttype::template createNode<typename parenttype::leaf_node>(*this->arena);
             this->leftmost->numElements = 1;
             // call the functor as we've successfully inserted
             typename Functor::result_type res = f(k);
@@ -314,7 +314,7 @@ public:
                 // split this node
                 auto old_root = this->root;
                 idx -= cur->rebalance_or_split(const_cast<typename parenttype::node**>(&this->root),
-                        this->root_lock, static_cast<int>(idx), parents);
+                        this->root_lock, *this->arena, static_cast<int>(idx), parents);
 
                 // release parent lock
                 for (auto it = parents.rbegin(); it != parents.rend(); ++it) {
@@ -367,7 +367,7 @@ public:
         // special handling for inserting first element
         if (this->empty()) {
             // create new node
-            this->leftmost = new typename parenttype::leaf_node();
+            this->leftmost = parenttype::template createNode<typename parenttype::leaf_node>(*this->arena);
             this->leftmost->numElements = 1;
             // call the functor as we've successfully inserted
             typename Functor::result_type res = f(k);
@@ -445,7 +445,7 @@ public:
             if (cur->numElements >= parenttype::node::maxKeys) {
                 // split this node
                 idx -= cur->rebalance_or_split(const_cast<typename parenttype::node**>(&this->root),
-                        this->root_lock, static_cast<int>(idx));
+                        this->root_lock, *this->arena, static_cast<int>(idx));
 
                 // insert element in right fragment
                 if (((typename parenttype::size_type)idx) > cur->numElements) {
@@ -498,6 +498,7 @@ public:
         // swap the content
         std::swap(this->root, other.root);
         std::swap(this->leftmost, other.leftmost);
+        std::swap(this->arena, other.arena);
     }
 
     // Implementation of the assignment operation for trees.
@@ -507,6 +508,9 @@ public:
             return *this;
         }
 
+        // drop the current content
+        this->clear();
+
         // create a deep-copy of the content of the other tree
         // shortcut for empty sets
         if (other.empty()) {
@@ -514,7 +518,7 @@ public:
         }
 
         // clone content (deep copy)
-        this->root = other.root->clone();
+        this->root = other.root->clone(*this->arena);
 
         // update leftmost reference
         auto tmp = this->root;
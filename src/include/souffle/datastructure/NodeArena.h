@@ -0,0 +1,296 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file NodeArena.h
+ *
+ * An arena allocator for the nodes of index data structures.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+namespace souffle {
+
+/**
+ * Statistics on the memory held by all node arenas, reported by the profiler.
+ */
+class NodeArenaStatistics {
+public:
+    static NodeArenaStatistics& instance() {
+        static NodeArenaStatistics stats;
+        return stats;
+    }
+
+    /** Accounts for a new slab of the given number of bytes. */
+    void reserved(std::size_t bytes, bool huge) {
+        const std::size_t cur = reservedBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::size_t peak = peakBytes.load(std::memory_order_relaxed);
+        while (peak < cur && !peakBytes.compare_exchange_weak(peak, cur, std::memory_order_relaxed)) {
+        }
+        slabs.fetch_add(1, std::memory_order_relaxed);
+        if (huge) {
+            hugeSlabs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /** Accounts for the release of a slab of the given number of bytes. */
+    void released(std::size_t bytes) {
+        reservedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    /** The number of bytes currently held by arenas. */
+    std::size_t getReservedBytes() const {
+        return reservedBytes.load(std::memory_order_relaxed);
+    }
+
+    /** The maximum number of bytes held by arenas at once. */
+    std::size_t getPeakBytes() const {
+        return peakBytes.load(std::memory_order_relaxed);
+    }
+
+    /** The number of slabs allocated so far. */
+    std::size_t getSlabs() const {
+        return slabs.load(std::memory_order_relaxed);
+    }
+
+    /** The number of slabs allocated so far backed by huge pages. */
+    std::size_t getHugeSlabs() const {
+        return hugeSlabs.load(std::memory_order_relaxed);
+    }
+
+private:
+    NodeArenaStatistics() = default;
+
+    std::atomic<std::size_t> reservedBytes{0};
+    std::atomic<std::size_t> peakBytes{0};
+    std::atomic<std::size_t> slabs{0};
+    std::atomic<std::size_t> hugeSlabs{0};
+};
+
+/**
+ * An arena providing the memory of the nodes of index data structures.
+ *
+ * Each thread lane allocates nodes from its own slab, such that allocations do not contend,
+ * and, as slabs are first touched by the allocating thread, nodes are placed on the NUMA
+ * node of the thread inserting them. Slabs grow geometrically per lane, up to the size of a
+ * huge page; full-sized slabs are backed by transparent huge pages if the environment
+ * variable SOUFFLE_HUGE_PAGES is set.
+ *
+ * Released nodes are recycled by the lane of the releasing thread. All slabs are released
+ * at once when the arena is cleared, without visiting the nodes allocated from it.
+ */
+class NodeArena {
+public:
+    // the size of full slabs, matching the size of huge pages
+    static constexpr std::size_t maxSlabSize = std::size_t(2) << 20;
+
+    // the size of the first slab of each lane, keeping arenas of small indexes small
+    static constexpr std::size_t minSlabSize = std::size_t(16) << 10;
+
+    NodeArena() : lanes(static_cast<std::size_t>(MAX_THREADS)), states(lanes.lanes()) {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    ~NodeArena() {
+        clear();
+    }
+
+    /**
+     * Obtains memory for a node of the given size and alignment, which is at most
+     * the alignment of cache lines.
+     */
+    void* allocate(std::size_t size, std::size_t align) {
+        assert(align <= hardware_destructive_interference_size && "Unsupported alignment!");
+        size = roundUp(size, align);
+        auto guard = lanes.guard();
+        LaneState& state = states[lanes.threadLane()];
+
+        // recycle released nodes of the same size
+        for (auto& list : state.released) {
+            if (list.size == size && list.head != nullptr) {
+                void* res = list.head;
+                list.head = *static_cast<void**>(res);
+                return res;
+            }
+        }
+
+        // bump-allocate from the current slab
+        auto cur = roundUp(reinterpret_cast<std::uintptr_t>(state.cur), align);
+        if (state.cur == nullptr || cur + size > reinterpret_cast<std::uintptr_t>(state.end)) {
+            newSlab(state, size);
+            cur = reinterpret_cast<std::uintptr_t>(state.cur);
+        }
+        state.cur = reinterpret_cast<char*>(cur + size);
+        return reinterpret_cast<void*>(cur);
+    }
+
+    /**
+     * Returns the memory of a node of the given size, obtained from this arena, for
+     * being recycled by later allocations.
+     */
+    void deallocate(void* ptr, std::size_t size, std::size_t align) {
+        if (ptr == nullptr) {
+            return;
+        }
+        assert(size >= sizeof(void*) && "Nodes too small to be recycled!");
+        size = roundUp(size, align);
+        auto guard = lanes.guard();
+        LaneState& state = states[lanes.threadLane()];
+        for (auto& list : state.released) {
+            if (list.size == size) {
+                *static_cast<void**>(ptr) = list.head;
+                list.head = ptr;
+                return;
+            }
+        }
+        *static_cast<void**>(ptr) = nullptr;
+        state.released.push_back({size, ptr});
+    }
+
+    /**
+     * Releases all slabs of this arena at once. No node allocated from it may be used
+     * any more. Not thread safe.
+     */
+    void clear() {
+        for (auto& state : states) {
+            for (const auto& slab : state.slabs) {
+                freeSlab(slab);
+            }
+            state = LaneState();
+        }
+    }
+
+    /**
+     * Obtains the number of bytes held by this arena.
+     */
+    std::size_t getMemoryUsage() const {
+        std::size_t res = 0;
+        for (const auto& state : states) {
+            for (const auto& slab : state.slabs) {
+                res += slab.size;
+            }
+        }
+        return res;
+    }
+
+private:
+    struct Slab {
+        void* ptr;
+        std::size_t size;
+        bool mapped;
+    };
+
+    // a list of released nodes of a size, linked through their first word
+    struct ReleasedList {
+        std::size_t size;
+        void* head;
+    };
+
+    struct LaneState {
+        char* cur = nullptr;
+        char* end = nullptr;
+        std::size_t nextSlabSize = minSlabSize;
+        std::vector<Slab> slabs;
+        std::vector<ReleasedList> released;
+    };
+
+    template <typename T>
+    static T roundUp(T value, std::size_t align) {
+        return (value + align - 1) / align * align;
+    }
+
+    static bool useHugePages() {
+        static const bool enabled = std::getenv("SOUFFLE_HUGE_PAGES") != nullptr;
+        return enabled;
+    }
+
+    /** Starts a new slab for the given lane, accommodating at least the given number of bytes. */
+    void newSlab(LaneState& state, std::size_t minSize) {
+        const std::size_t size = std::max(state.nextSlabSize, roundUp(minSize, minSlabSize));
+        state.nextSlabSize = std::min(2 * state.nextSlabSize, maxSlabSize);
+        Slab slab = allocSlab(size);
+        state.slabs.push_back(slab);
+        state.cur = static_cast<char*>(slab.ptr);
+        state.end = state.cur + slab.size;
+    }
+
+    static Slab allocSlab(std::size_t size) {
+        bool huge = false;
+#if defined(__unix__) || defined(__APPLE__)
+        // slabs are mapped lazily, such that their pages are placed on first touch
+        const bool aligned = size == maxSlabSize;
+        const std::size_t mapped = aligned ? size + maxSlabSize : size;
+        void* ptr = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        // full slabs are aligned to their size, such that they may be backed by a single huge page
+        if (aligned) {
+            auto* begin = static_cast<char*>(ptr);
+            auto* start =
+                    reinterpret_cast<char*>(roundUp(reinterpret_cast<std::uintptr_t>(begin), maxSlabSize));
+            if (start != begin) {
+                munmap(begin, static_cast<std::size_t>(start - begin));
+            }
+            if (start + size != begin + mapped) {
+                munmap(start + size, static_cast<std::size_t>(begin + mapped - (start + size)));
+            }
+            ptr = start;
+#ifdef MADV_HUGEPAGE
+            if (useHugePages()) {
+                huge = madvise(ptr, size, MADV_HUGEPAGE) == 0;
+            }
+#endif
+        }
+        NodeArenaStatistics::instance().reserved(size, huge);
+        return {ptr, size, true};
+#else
+        void* ptr = ::operator new(size, std::align_val_t(hardware_destructive_interference_size));
+        NodeArenaStatistics::instance().reserved(size, huge);
+        return {ptr, size, false};
+#endif
+    }
+
+    static void freeSlab(const Slab& slab) {
+        NodeArenaStatistics::instance().released(slab.size);
+#if defined(__unix__) || defined(__APPLE__)
+        if (slab.mapped) {
+            munmap(slab.ptr, slab.size);
+            return;
+        }
+#endif
+        ::operator delete(slab.ptr, std::align_val_t(hardware_destructive_interference_size));
+    }
+
+    // the lanes synchronising the threads allocating from this arena
+    ConcurrentLanes lanes;
+
+    // the slabs and released nodes of each lane
+    std::vector<LaneState> states;
+};
+
+}  // end of namespace souffle
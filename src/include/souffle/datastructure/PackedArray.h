@@ -0,0 +1,606 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file PackedArray.h
+ *
+ * Ordered sets stored in sorted arrays of rows whose columns are narrowed to the values they hold.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/datastructure/BTreeUtil.h"
+#include "souffle/utility/Iteration.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+namespace detail {
+
+/**
+ * The layout of a column of packed rows. Each value of the column is stored as an unsigned code
+ * of 0, 1, 2, 4 or 8 bytes: either its offset from the least value of the column, or its position
+ * in the ascending dictionary of the distinct values of the column. Both codes preserve the order
+ * of the values, and constant columns take no space.
+ *
+ * @tparam Value the type of the values of the column
+ */
+template <typename Value>
+struct packed_column {
+    using unsigned_type = std::make_unsigned_t<Value>;
+
+    // the position of the code within a row, and its number of bytes
+    std::size_t offset = 0;
+    std::size_t width = 0;
+
+    // the least value of the column, the origin of codes without dictionary
+    Value base{};
+
+    // the distinct values of the column in ascending order, if coded by dictionary
+    std::vector<Value> dictionary;
+
+    Value decode(const unsigned char* row) const {
+        const std::uint64_t code = load(row + offset);
+        if (!dictionary.empty()) {
+            return dictionary[code];
+        }
+        return static_cast<Value>(static_cast<unsigned_type>(base) + static_cast<unsigned_type>(code));
+    }
+
+    void encode(unsigned char* row, Value value) const {
+        std::uint64_t code;
+        if (!dictionary.empty()) {
+            code = static_cast<std::uint64_t>(
+                    std::lower_bound(dictionary.begin(), dictionary.end(), value) - dictionary.begin());
+        } else {
+            code = static_cast<unsigned_type>(static_cast<unsigned_type>(value) -
+                                              static_cast<unsigned_type>(base));
+        }
+        store(row + offset, code);
+    }
+
+    // the number of bytes of a code up to the given one
+    static std::size_t widthOf(std::uint64_t maxCode) {
+        if (maxCode == 0) {
+            return 0;
+        } else if (maxCode <= 0xffu) {
+            return 1;
+        } else if (maxCode <= 0xffffu) {
+            return 2;
+        } else if (maxCode <= 0xffffffffu) {
+            return 4;
+        }
+        return 8;
+    }
+
+private:
+    std::uint64_t load(const unsigned char* pos) const {
+        switch (width) {
+            case 0: return 0;
+            case 1: return *pos;
+            case 2: return read<std::uint16_t>(pos);
+            case 4: return read<std::uint32_t>(pos);
+            default: return read<std::uint64_t>(pos);
+        }
+    }
+
+    void store(unsigned char* pos, std::uint64_t code) const {
+        switch (width) {
+            case 0: break;
+            case 1: *pos = static_cast<unsigned char>(code); break;
+            case 2: write(pos, static_cast<std::uint16_t>(code)); break;
+            case 4: write(pos, static_cast<std::uint32_t>(code)); break;
+            default: write(pos, code);
+        }
+    }
+
+    template <typename Code>
+    static Code read(const unsigned char* pos) {
+        Code res;
+        std::memcpy(&res, pos, sizeof(Code));
+        return res;
+    }
+
+    template <typename Code>
+    static void write(unsigned char* pos, Code code) {
+        std::memcpy(pos, &code, sizeof(Code));
+    }
+};
+
+/**
+ * Collects the range and the distinct values of a column, to choose its layout.
+ */
+template <typename Value>
+class packed_column_statistics {
+public:
+    using unsigned_type = std::make_unsigned_t<Value>;
+
+    // columns of more distinct values are not coded by dictionary
+    static constexpr std::size_t maxDictionarySize = 1 << 16;
+
+    void add(Value value) {
+        if (count == 0 || value < min) {
+            min = value;
+        }
+        if (count == 0 || max < value) {
+            max = value;
+        }
+        ++count;
+        if (!overflow) {
+            distinct.insert(value);
+            if (distinct.size() > maxDictionarySize) {
+                overflow = true;
+                distinct.clear();
+            }
+        }
+    }
+
+    /**
+     * Obtains the layout of the column at the given offset of a row, coded by dictionary if
+     * its codes are narrower than the offsets from the least value.
+     */
+    packed_column<Value> layout(std::size_t offset) const {
+        packed_column<Value> res;
+        res.offset = offset;
+        res.base = min;
+        res.width = packed_column<Value>::widthOf(
+                static_cast<unsigned_type>(static_cast<unsigned_type>(max) - static_cast<unsigned_type>(min)));
+        if (!overflow && distinct.size() > 1) {
+            const std::size_t width = packed_column<Value>::widthOf(distinct.size() - 1);
+            if (width < res.width) {
+                res.width = width;
+                res.dictionary.assign(distinct.begin(), distinct.end());
+                std::sort(res.dictionary.begin(), res.dictionary.end());
+            }
+        }
+        return res;
+    }
+
+private:
+    std::size_t count = 0;
+    Value min{};
+    Value max{};
+    std::unordered_set<Value> distinct;
+    bool overflow = false;
+};
+
+/**
+ * An ordered collection of keys stored as rows of a contiguous sorted array, each column of
+ * which is narrowed to the range or the distinct values it holds (see packed_column). Like a
+ * sorted_array, the collection is built from sorted sequences of keys by bulk_load and then only
+ * searched and scanned; each bulk load chooses the layout of the columns anew and repacks all
+ * rows.
+ *
+ * Keys are decoded on access: iterators yield keys by value, and searches compare the decoded
+ * rows by the comparator, such that the order of the keys is the one of an uncompressed data
+ * structure.
+ *
+ * @tparam Key the type of the stored keys, an array of integral values
+ * @tparam Comparator a comparator providing less and equal on keys
+ * @tparam isSet whether keys equal by the comparator are stored once
+ */
+template <typename Key, typename Comparator, bool isSet>
+class packed_array {
+public:
+    using key_type = Key;
+    using element_type = Key;
+    using size_type = std::size_t;
+    using value_type = std::decay_t<decltype(std::declval<const Key&>()[0])>;
+
+    // the number of columns of keys
+    static constexpr size_type arity = std::tuple_size<Key>::value;
+
+    // arrays are built from sorted sequences of keys
+    static constexpr bool has_bulk_load = true;
+
+    // arrays are not modified concurrently, see insert
+    static constexpr bool is_immutable = true;
+
+    /**
+     * The operation hints of this array, which searches do not depend on. Provided for
+     * compatibility with the other ordered data structures.
+     */
+    struct operation_hints {
+        void clear() {}
+    };
+
+    /**
+     * An iterator over the rows of the array, decoding the key of the current row.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = Key;
+
+        iterator() = default;
+
+        iterator(const packed_array* array, size_type pos) : array(array), pos(pos) {}
+
+        Key operator*() const {
+            return array->get(pos);
+        }
+
+        Key operator[](difference_type n) const {
+            return array->get(pos + n);
+        }
+
+        iterator& operator++() {
+            ++pos;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto res = *this;
+            ++pos;
+            return res;
+        }
+
+        iterator& operator--() {
+            --pos;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto res = *this;
+            --pos;
+            return res;
+        }
+
+        iterator& operator+=(difference_type n) {
+            pos += n;
+            return *this;
+        }
+
+        iterator& operator-=(difference_type n) {
+            pos -= n;
+            return *this;
+        }
+
+        iterator operator+(difference_type n) const {
+            return iterator(array, pos + n);
+        }
+
+        iterator operator-(difference_type n) const {
+            return iterator(array, pos - n);
+        }
+
+        difference_type operator-(const iterator& other) const {
+            return static_cast<difference_type>(pos) - static_cast<difference_type>(other.pos);
+        }
+
+        bool operator==(const iterator& other) const {
+            return pos == other.pos;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return pos != other.pos;
+        }
+
+        bool operator<(const iterator& other) const {
+            return pos < other.pos;
+        }
+
+    private:
+        const packed_array* array = nullptr;
+        size_type pos = 0;
+    };
+
+    using const_iterator = iterator;
+    using chunk = range<iterator>;
+
+    packed_array() {
+        columns.resize(arity);
+    }
+
+    template <typename Iter>
+    packed_array(const Iter& a, const Iter& b) : packed_array() {
+        insert(a, b);
+    }
+
+    // -- modification --
+
+    /**
+     * Inserts the given key, repacking all rows. This takes linear time and is not thread safe;
+     * arrays are meant to be built by bulk_load.
+     */
+    bool insert(const Key& k) {
+        operation_hints hints;
+        return insert(k, hints);
+    }
+
+    bool insert(const Key& k, operation_hints& hints) {
+        if (isSet && contains(k, hints)) {
+            return false;
+        }
+        bulk_load(&k, &k + 1);
+        return true;
+    }
+
+    /**
+     * Inserts the keys of the given range, which need not be sorted. Not thread safe.
+     */
+    template <typename Iter>
+    void insert(const Iter& a, const Iter& b) {
+        const auto less = [&](const Key& x, const Key& y) { return comp.less(x, y); };
+        std::vector<Key> sorted(a, b);
+        std::sort(sorted.begin(), sorted.end(), less);
+        bulk_load(sorted.begin(), sorted.end());
+    }
+
+    /**
+     * Inserts the keys of the given range, sorted by the order of this array, merging them with
+     * the keys already present. The layout of the columns is chosen for the merged keys, and all
+     * rows are repacked. Not thread safe.
+     */
+    template <typename Iter>
+    void bulk_load(const Iter& a, const Iter& b) {
+        if (a == b) {
+            return;
+        }
+
+        // choose the layout for the values of both the present and the new keys
+        std::vector<packed_column_statistics<value_type>> statistics(arity);
+        const auto collect = [&](const Key& k) {
+            for (size_type i = 0; i < arity; ++i) {
+                statistics[i].add(k[i]);
+            }
+        };
+        for (size_type pos = 0; pos < numRows; ++pos) {
+            collect(get(pos));
+        }
+        for (auto it = a; it != b; ++it) {
+            collect(*it);
+        }
+        std::vector<packed_column<value_type>> layout;
+        size_type width = 0;
+        for (size_type i = 0; i < arity; ++i) {
+            layout.push_back(statistics[i].layout(width));
+            width += layout.back().width;
+        }
+
+        // merge the present and the new keys into rows of the new layout
+        std::vector<unsigned char> packed;
+        packed.reserve(width * (numRows + static_cast<size_type>(std::distance(a, b))));
+        size_type count = 0;
+        bool hasLast = false;
+        Key last{};
+        const auto append = [&](const Key& k) {
+            if (isSet && hasLast && comp.equal(last, k)) {
+                return;
+            }
+            packed.resize(packed.size() + width);
+            unsigned char* row = packed.data() + count * width;
+            for (size_type i = 0; i < arity; ++i) {
+                layout[i].encode(row, k[i]);
+            }
+            ++count;
+            hasLast = true;
+            last = k;
+        };
+        size_type pos = 0;
+        auto it = a;
+        while (pos < numRows || it != b) {
+            if (it == b) {
+                append(get(pos++));
+            } else if (pos == numRows) {
+                append(*it++);
+            } else {
+                const Key present = get(pos);
+                const Key next = *it;
+                if (comp.less(next, present)) {
+                    append(next);
+                    ++it;
+                } else {
+                    append(present);
+                    ++pos;
+                }
+            }
+        }
+        packed.shrink_to_fit();
+
+        rows.swap(packed);
+        columns.swap(layout);
+        stride = width;
+        numRows = count;
+    }
+
+    void clear() {
+        rows.clear();
+        rows.shrink_to_fit();
+        columns.assign(arity, packed_column<value_type>());
+        stride = 0;
+        numRows = 0;
+    }
+
+    void swap(packed_array& other) {
+        rows.swap(other.rows);
+        columns.swap(other.columns);
+        std::swap(stride, other.stride);
+        std::swap(numRows, other.numRows);
+    }
+
+    // -- queries --
+
+    bool empty() const {
+        return numRows == 0;
+    }
+
+    size_type size() const {
+        return numRows;
+    }
+
+    iterator begin() const {
+        return iterator(this, 0);
+    }
+
+    iterator end() const {
+        return iterator(this, numRows);
+    }
+
+    /**
+     * Decodes the key of the given row.
+     */
+    Key get(size_type pos) const {
+        Key res;
+        const unsigned char* row = rows.data() + pos * stride;
+        for (size_type i = 0; i < arity; ++i) {
+            res[i] = columns[i].decode(row);
+        }
+        return res;
+    }
+
+    /**
+     * Obtains the number of bytes of each row, as chosen by the last bulk load.
+     */
+    size_type getRowSize() const {
+        return stride;
+    }
+
+    bool contains(const Key& k) const {
+        operation_hints hints;
+        return contains(k, hints);
+    }
+
+    bool contains(const Key& k, operation_hints& hints) const {
+        return find(k, hints) != end();
+    }
+
+    iterator find(const Key& k) const {
+        operation_hints hints;
+        return find(k, hints);
+    }
+
+    iterator find(const Key& k, operation_hints& hints) const {
+        auto pos = lower_bound(k, hints);
+        return (pos != end() && comp.equal(*pos, k)) ? pos : end();
+    }
+
+    /** Obtains the position of the first key not less than the given key. */
+    iterator lower_bound(const Key& k) const {
+        operation_hints hints;
+        return lower_bound(k, hints);
+    }
+
+    iterator lower_bound(const Key& k, operation_hints&) const {
+        return search([&](const Key& cur) { return comp.less(cur, k); });
+    }
+
+    /** Obtains the position of the first key greater than the given key. */
+    iterator upper_bound(const Key& k) const {
+        operation_hints hints;
+        return upper_bound(k, hints);
+    }
+
+    iterator upper_bound(const Key& k, operation_hints&) const {
+        return search([&](const Key& cur) { return !comp.less(k, cur); });
+    }
+
+    /**
+     * Partitions the keys of this array into about the given number of ranges of equal size,
+     * e.g. to be scanned in parallel.
+     */
+    std::vector<chunk> partition(size_type num) const {
+        return getChunks(num);
+    }
+
+    std::vector<chunk> getChunks(size_type num) const {
+        std::vector<chunk> res;
+        if (empty()) {
+            return res;
+        }
+        num = std::max<size_type>(1, std::min(num, size()));
+        const size_type step = size() / num;
+        const size_type rest = size() % num;
+        size_type pos = 0;
+        for (size_type i = 0; i < num; ++i) {
+            const size_type next = pos + step + (i < rest ? 1 : 0);
+            res.push_back(chunk(iterator(this, pos), iterator(this, next)));
+            pos = next;
+        }
+        return res;
+    }
+
+    void printStats(std::ostream& out = std::cout) const {
+        out << " ---------------------------------\n";
+        out << "  Elements: " << size() << "\n";
+        out << "  Columns:  ";
+        for (size_type i = 0; i < arity; ++i) {
+            out << (i > 0 ? ", " : "") << columns[i].width << (columns[i].dictionary.empty() ? "" : "d");
+        }
+        out << "\n";
+        out << " ---------------------------------\n";
+        out << "  Size of Key:      " << sizeof(Key) << "\n";
+        out << "  Size of Row:      " << stride << "\n";
+        size_type dictionaries = 0;
+        for (const auto& column : columns) {
+            dictionaries += column.dictionary.capacity() * sizeof(value_type);
+        }
+        out << "  memory usage:     " << rows.capacity() + dictionaries << "\n";
+        out << " ---------------------------------\n";
+    }
+
+private:
+    Comparator comp;
+
+    // the rows of this array in ascending order of their keys, each of stride bytes
+    std::vector<unsigned char> rows;
+
+    // the layout of the columns of the rows
+    std::vector<packed_column<value_type>> columns;
+
+    size_type stride = 0;
+
+    size_type numRows = 0;
+
+    // the first row whose key does not satisfy right, which holds for a prefix of the rows
+    template <typename Right>
+    iterator search(const Right& right) const {
+        size_type lo = 0;
+        size_type hi = numRows;
+        while (lo < hi) {
+            const size_type mid = lo + (hi - lo) / 2;
+            if (right(get(mid))) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return iterator(this, lo);
+    }
+};
+
+}  // end namespace detail
+
+/**
+ * An ordered set stored in a packed array, see detail::packed_array.
+ */
+template <typename Key, typename Comparator = detail::comparator<Key>>
+using packed_array_set = detail::packed_array<Key, Comparator, true>;
+
+/**
+ * An ordered multiset stored in a packed array, see detail::packed_array.
+ */
+template <typename Key, typename Comparator = detail::comparator<Key>>
+using packed_array_multiset = detail::packed_array<Key, Comparator, false>;
+
+}  // end namespace souffle
@@ -0,0 +1,335 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SortedArray.h
+ *
+ * Ordered sets stored in sorted arrays, for relations built in bulk and probed afterwards.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/datastructure/BTreeUtil.h"
+#include "souffle/utility/Iteration.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+namespace souffle {
+
+namespace detail {
+
+/**
+ * An ordered collection of keys stored contiguously in a sorted array. Unlike a b-tree the
+ * collection is not meant to be modified element by element: it is built from sorted sequences
+ * of keys by bulk_load and then only searched and scanned, which visits the keys in the order
+ * of memory.
+ *
+ * Searches first locate the block of blockSize keys containing the bound, and then search
+ * within the block. If Eytzinger is set, the first keys of the blocks are additionally stored
+ * in the Eytzinger (breadth-first) layout of a complete binary search tree, such that the
+ * top levels of the tree visited by every search share a few cache lines, and the descent is
+ * free of hard to predict branches. Otherwise blocks are located by a binary search over the
+ * array itself.
+ *
+ * @tparam Key the type of the stored keys
+ * @tparam Comparator a comparator providing less and equal on keys
+ * @tparam isSet whether keys equal by the comparator are stored once
+ * @tparam Eytzinger whether blocks are located by a search tree in Eytzinger layout
+ */
+template <typename Key, typename Comparator, bool isSet, bool Eytzinger>
+class sorted_array {
+public:
+    using key_type = Key;
+    using element_type = Key;
+    using size_type = std::size_t;
+    using iterator = typename std::vector<Key>::const_iterator;
+    using const_iterator = iterator;
+    using chunk = range<iterator>;
+
+    // the number of keys per block of the search tree
+    static constexpr size_type blockSize = 16;
+
+    // arrays are built from sorted sequences of keys
+    static constexpr bool has_bulk_load = true;
+
+    // arrays are not modified concurrently, see insert
+    static constexpr bool is_immutable = true;
+
+    /**
+     * The operation hints of this array, which searches do not depend on. Provided for
+     * compatibility with the other ordered data structures.
+     */
+    struct operation_hints {
+        void clear() {}
+    };
+
+    sorted_array() = default;
+
+    template <typename Iter>
+    sorted_array(const Iter& a, const Iter& b) {
+        insert(a, b);
+    }
+
+    // -- modification --
+
+    /**
+     * Inserts the given key, shifting all larger keys and rebuilding the search tree. This
+     * takes linear time and is not thread safe; arrays are meant to be built by bulk_load.
+     */
+    bool insert(const Key& k) {
+        operation_hints hints;
+        return insert(k, hints);
+    }
+
+    bool insert(const Key& k, operation_hints& hints) {
+        auto pos = isSet ? lower_bound(k, hints) : upper_bound(k, hints);
+        if (isSet && pos != end() && comp.equal(*pos, k)) {
+            return false;
+        }
+        keys.insert(pos, k);
+        buildTree();
+        return true;
+    }
+
+    /**
+     * Inserts the keys of the given range, which need not be sorted. Not thread safe.
+     */
+    template <typename Iter>
+    void insert(const Iter& a, const Iter& b) {
+        const auto less = [&](const Key& x, const Key& y) { return comp.less(x, y); };
+        std::vector<Key> sorted(a, b);
+        std::sort(sorted.begin(), sorted.end(), less);
+        bulk_load(sorted.begin(), sorted.end());
+    }
+
+    /**
+     * Inserts the keys of the given range, sorted by the order of this array, merging them with
+     * the keys already present. Not thread safe.
+     */
+    template <typename Iter>
+    void bulk_load(const Iter& a, const Iter& b) {
+        const auto less = [&](const Key& x, const Key& y) { return comp.less(x, y); };
+        if (keys.empty()) {
+            keys.assign(a, b);
+        } else {
+            std::vector<Key> merged;
+            merged.reserve(keys.size() + static_cast<size_type>(std::distance(a, b)));
+            std::merge(keys.begin(), keys.end(), a, b, std::back_inserter(merged), less);
+            keys.swap(merged);
+        }
+        if (isSet) {
+            keys.erase(std::unique(keys.begin(), keys.end(),
+                               [&](const Key& x, const Key& y) { return comp.equal(x, y); }),
+                    keys.end());
+        }
+        buildTree();
+    }
+
+    void clear() {
+        keys.clear();
+        tree.clear();
+        ranks.clear();
+    }
+
+    void swap(sorted_array& other) {
+        keys.swap(other.keys);
+        tree.swap(other.tree);
+        ranks.swap(other.ranks);
+    }
+
+    // -- queries --
+
+    bool empty() const {
+        return keys.empty();
+    }
+
+    size_type size() const {
+        return keys.size();
+    }
+
+    iterator begin() const {
+        return keys.begin();
+    }
+
+    iterator end() const {
+        return keys.end();
+    }
+
+    bool contains(const Key& k) const {
+        operation_hints hints;
+        return contains(k, hints);
+    }
+
+    bool contains(const Key& k, operation_hints& hints) const {
+        return find(k, hints) != end();
+    }
+
+    iterator find(const Key& k) const {
+        operation_hints hints;
+        return find(k, hints);
+    }
+
+    iterator find(const Key& k, operation_hints& hints) const {
+        auto pos = lower_bound(k, hints);
+        return (pos != end() && comp.equal(*pos, k)) ? pos : end();
+    }
+
+    /** Obtains the position of the first key not less than the given key. */
+    iterator lower_bound(const Key& k) const {
+        operation_hints hints;
+        return lower_bound(k, hints);
+    }
+
+    iterator lower_bound(const Key& k, operation_hints&) const {
+        const auto less = [&](const Key& x, const Key& y) { return comp.less(x, y); };
+        return search([&](const Key& sep) { return comp.less(sep, k); },
+                [&](iterator a, iterator b) { return std::lower_bound(a, b, k, less); });
+    }
+
+    /** Obtains the position of the first key greater than the given key. */
+    iterator upper_bound(const Key& k) const {
+        operation_hints hints;
+        return upper_bound(k, hints);
+    }
+
+    iterator upper_bound(const Key& k, operation_hints&) const {
+        const auto less = [&](const Key& x, const Key& y) { return comp.less(x, y); };
+        return search([&](const Key& sep) { return !comp.less(k, sep); },
+                [&](iterator a, iterator b) { return std::upper_bound(a, b, k, less); });
+    }
+
+    /**
+     * Partitions the keys of this array into about the given number of ranges of equal size,
+     * e.g. to be scanned in parallel.
+     */
+    std::vector<chunk> partition(size_type num) const {
+        return getChunks(num);
+    }
+
+    std::vector<chunk> getChunks(size_type num) const {
+        std::vector<chunk> res;
+        if (empty()) {
+            return res;
+        }
+        num = std::max<size_type>(1, std::min(num, size()));
+        const size_type step = size() / num;
+        const size_type rest = size() % num;
+        auto pos = begin();
+        for (size_type i = 0; i < num; ++i) {
+            auto next = pos + static_cast<std::ptrdiff_t>(step + (i < rest ? 1 : 0));
+            res.push_back(chunk(pos, next));
+            pos = next;
+        }
+        return res;
+    }
+
+    void printStats(std::ostream& out = std::cout) const {
+        out << " ---------------------------------\n";
+        out << "  Elements: " << size() << "\n";
+        out << "  Blocks:   " << numBlocks() << "\n";
+        out << "  Layout:   " << (Eytzinger ? "eytzinger" : "sorted") << "\n";
+        out << " ---------------------------------\n";
+        out << "  Size of Key:      " << sizeof(Key) << "\n";
+        out << "  keys / block:     " << blockSize << "\n";
+        out << "  memory usage:     "
+            << keys.capacity() * sizeof(Key) + tree.capacity() * sizeof(Key) +
+                       ranks.capacity() * sizeof(size_type)
+            << "\n";
+        out << " ---------------------------------\n";
+    }
+
+private:
+    Comparator comp;
+
+    // the keys of this array, in ascending order
+    std::vector<Key> keys;
+
+    // the first keys of the blocks in Eytzinger layout, the root at position 1
+    std::vector<Key> tree;
+
+    // the block of each key of the tree
+    std::vector<size_type> ranks;
+
+    size_type numBlocks() const {
+        return (keys.size() + blockSize - 1) / blockSize;
+    }
+
+    // fills the tree of the first keys of the blocks; small arrays are searched directly
+    void buildTree() {
+        tree.clear();
+        ranks.clear();
+        if (!Eytzinger || keys.size() <= 2 * blockSize) {
+            return;
+        }
+        tree.resize(numBlocks() + 1);
+        ranks.resize(numBlocks() + 1);
+        buildTree(1, 0);
+    }
+
+    // fills the subtree of the given node in order, starting from the given block
+    size_type buildTree(size_type node, size_type block) {
+        if (node < tree.size()) {
+            block = buildTree(2 * node, block);
+            tree[node] = keys[block * blockSize];
+            ranks[node] = block;
+            block = buildTree(2 * node + 1, block + 1);
+        }
+        return block;
+    }
+
+    /**
+     * Locates a bound: right holds for the keys preceding the bound, and finish searches for
+     * the bound within a range of keys. The block of the bound is the one preceding the first
+     * block whose first key does not satisfy right.
+     */
+    template <typename Right, typename Finish>
+    iterator search(const Right& right, const Finish& finish) const {
+        if (tree.empty()) {
+            return finish(begin(), end());
+        }
+
+        // descend to a leaf, remembering left turns in the trailing bits of the position
+        const size_type n = tree.size();
+        size_type i = 1;
+        while (i < n) {
+            i = 2 * i + static_cast<size_type>(right(tree[i]));
+        }
+        // the last left turn leads back to the first separator not satisfying right
+        i >>= __builtin_ctzll(~static_cast<unsigned long long>(i)) + 1;
+        const size_type block = (i == 0) ? n - 1 : ranks[i];
+        if (block == 0) {
+            return begin();
+        }
+
+        // the first key of the block is known to satisfy right
+        auto first = begin() + static_cast<std::ptrdiff_t>((block - 1) * blockSize + 1);
+        auto last = begin() + static_cast<std::ptrdiff_t>(std::min(block * blockSize, keys.size()));
+        return finish(first, last);
+    }
+};
+
+}  // end namespace detail
+
+/**
+ * An ordered set stored in a sorted array, see detail::sorted_array.
+ */
+template <typename Key, typename Comparator = detail::comparator<Key>, bool Eytzinger = true>
+using sorted_array_set = detail::sorted_array<Key, Comparator, true, Eytzinger>;
+
+/**
+ * An ordered multiset stored in a sorted array, see detail::sorted_array.
+ */
+template <typename Key, typename Comparator = detail::comparator<Key>, bool Eytzinger = true>
+using sorted_array_multiset = detail::sorted_array<Key, Comparator, false, Eytzinger>;
+
+}  // end namespace souffle
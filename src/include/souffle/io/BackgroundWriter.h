@@ -0,0 +1,218 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BackgroundWriter.h
+ *
+ * Writes output relations on a pool of writer threads
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/IOSystem.h"
+#include "souffle/io/WriteStream.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Writes output relations to files on a pool of writer threads, such that evaluation carries on
+ * while the files are written.
+ *
+ * A relation handed over for writing is a frozen view: it must not be modified until its writes
+ * finish. Tasks modifying it, such as clearing it once it expired, are deferred with afterWrites.
+ * The tasks of a relation run one after another, in the order they are handed over, while the
+ * tasks of different relations run concurrently. Writes to the console are not deferred, such
+ * that the console output remains in order.
+ *
+ * The pool grows up to the given number of threads as writes queue up. Errors of writes are
+ * raised by wait, which has to be called before the program ends.
+ *
+ * Without OpenMP, the symbol and record tables are not synchronised, so they must not be read
+ * while evaluation inserts into them. All writes then run on the calling thread.
+ */
+class BackgroundWriter {
+public:
+    explicit BackgroundWriter(std::size_t maxThreads = std::thread::hardware_concurrency())
+            : maxThreads(std::max<std::size_t>(1, maxThreads)) {}
+
+    BackgroundWriter(const BackgroundWriter&) = delete;
+    BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+    ~BackgroundWriter() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&]() { return pending.empty(); });
+            stopping = true;
+        }
+        work.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    /**
+     * Sets the number of threads the pool grows up to; threads already started stay.
+     */
+    void setNumThreads(std::size_t numThreads) {
+        std::lock_guard<std::mutex> lock(mutex);
+        maxThreads = std::max<std::size_t>(1, numThreads);
+    }
+
+    /**
+     * Writes the given relation as directed. The writer is created on the calling thread, such
+     * that errors opening the output are raised here; the tuples are written in the background.
+     */
+    template <typename T>
+    void writeAll(const std::map<std::string, std::string>& rwOperation, const SymbolTable& symbolTable,
+            const RecordTable& recordTable, const T& relation) {
+        std::shared_ptr<WriteStream> writer =
+                IOSystem::getInstance().getWriter(rwOperation, symbolTable, recordTable);
+        if (!isFileOutput(rwOperation.at("IO"))) {
+            writer->writeAll(relation);
+            return;
+        }
+#ifdef IS_PARALLEL
+        submit(&relation, [writer, &relation]() { writer->writeAll(relation); });
+#else
+        try {
+            writer->writeAll(relation);
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+#endif
+    }
+
+    /**
+     * Runs the given task once the pending writes of the given relation finish; on the calling
+     * thread if there are none, and on a writer thread otherwise.
+     */
+    void afterWrites(const void* relation, std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = pending.find(relation);
+            if (it != pending.end()) {
+                it->second.push_back(std::move(task));
+                return;
+            }
+        }
+        task();
+    }
+
+    /**
+     * Waits for all pending writes, and raises the first error of a write since the last wait.
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]() { return pending.empty(); });
+        if (error) {
+            std::exception_ptr first = std::exchange(error, nullptr);
+            std::rethrow_exception(first);
+        }
+    }
+
+private:
+    /** Whether the given output type writes to a file of its own. */
+    static bool isFileOutput(const std::string& ioType) {
+        return ioType == "file" || ioType == "jsonfile" || ioType == "binary";
+    }
+
+    void submit(const void* relation, std::function<void()> task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& tasks = pending[relation];
+        tasks.push_back(std::move(task));
+        // a relation with earlier tasks is queued, or being worked on, already
+        if (tasks.size() > 1) {
+            return;
+        }
+        ready.push_back(relation);
+        if (numIdle == 0 && threads.size() < maxThreads) {
+            threads.emplace_back([this]() { runWorker(); });
+        } else {
+            work.notify_one();
+        }
+    }
+
+    void runWorker() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            ++numIdle;
+            work.wait(lock, [&]() { return stopping || !ready.empty(); });
+            --numIdle;
+            if (ready.empty()) {
+                return;
+            }
+            const void* relation = ready.front();
+            ready.pop_front();
+            // the task stays in the queue of its relation while it runs
+            std::function<void()> task = std::move(pending[relation].front());
+
+            lock.unlock();
+            std::exception_ptr failure;
+            try {
+                task();
+            } catch (...) {
+                failure = std::current_exception();
+            }
+            lock.lock();
+
+            if (failure && !error) {
+                error = failure;
+            }
+            auto it = pending.find(relation);
+            it->second.pop_front();
+            if (!it->second.empty()) {
+                ready.push_back(relation);
+            } else {
+                pending.erase(it);
+                if (pending.empty()) {
+                    done.notify_all();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::size_t maxThreads;
+    // signals the workers that a relation is ready, or that the pool stops
+    std::condition_variable work;
+    // signals that no tasks are pending
+    std::condition_variable done;
+
+    // the pending tasks of each relation, the first of which may be running
+    std::unordered_map<const void*, std::deque<std::function<void()>>> pending;
+    // the relations whose first task is ready to run
+    std::deque<const void*> ready;
+    std::size_t numIdle = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+};
+
+}  // namespace souffle
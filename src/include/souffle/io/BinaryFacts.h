@@ -0,0 +1,89 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BinaryFacts.h
+ *
+ * The layout of binary fact files, read and written with IO=binary
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/utility/json11.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace souffle {
+
+/**
+ * The header of a binary fact file.
+ *
+ * A binary fact file stores the tuples of a relation as fixed-width columns of RamDomain values,
+ * which are read without parsing. Symbols and records are stored by ids local to the file, and
+ * the symbols and records they denote are stored in segments of their own, such that readers
+ * intern them into their own symbol and record tables:
+ *
+ *   header | column kinds | columns | records | symbols
+ *
+ * - column kinds: one BinaryValueKind per column, padded to a multiple of eight bytes;
+ * - columns: for each column, the values of all tuples, starting at an aligned offset;
+ * - records: for each record, its arity as uint32_t, the kinds of its fields, and its fields as
+ *   RamDomain values; the record with index i has the local id i + 1, such that 0 denotes nil,
+ *   and records only refer to records stored before them;
+ * - symbols: for each symbol, its length as uint64_t and its characters; the symbol with index i
+ *   has the local id i.
+ *
+ * Values are stored in the byte order of the writer, which readers check.
+ */
+struct BinaryFactsHeader {
+    static constexpr char magicString[8] = {'S', 'O', 'U', 'F', 'F', 'L', 'E', 'B'};
+    static constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+    char magic[8];
+    std::uint32_t byteOrder;
+    std::uint32_t domainSize;
+    std::uint64_t arity;
+    std::uint64_t numTuples;
+    std::uint64_t columnsOffset;
+    std::uint64_t numRecords;
+    std::uint64_t recordsOffset;
+    std::uint64_t numSymbols;
+    std::uint64_t symbolsOffset;
+};
+
+/** The kind of a stored value, telling readers how to translate it. */
+enum class BinaryValueKind : std::uint8_t {
+    // numbers and enumerations, stored as they are
+    Plain = 0,
+    // symbols, stored by local ids
+    Symbol = 1,
+    // records and ADTs, stored by local ids
+    Record = 2
+};
+
+/** Returns the kind of the values of the given type attribute. */
+inline BinaryValueKind getBinaryValueKind(const json11::Json& types, const std::string& type) {
+    switch (type[0]) {
+        case 's': return BinaryValueKind::Symbol;
+        case 'r': return BinaryValueKind::Record;
+        case '+': return types["ADTs"][type]["enum"].bool_value() ? BinaryValueKind::Plain
+                                                                  : BinaryValueKind::Record;
+        default: return BinaryValueKind::Plain;
+    }
+}
+
+/** Returns the size of the column kinds of the given arity, padded to a multiple of eight bytes. */
+inline std::size_t getBinaryColumnKindsSize(std::size_t arity) {
+    return (arity + 7) / 8 * 8;
+}
+
+}  // namespace souffle
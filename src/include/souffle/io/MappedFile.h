@@ -0,0 +1,94 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MappedFile.h
+ *
+ * A read-only memory mapping of a file
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace souffle {
+
+/**
+ * A read-only memory mapping of a regular file.
+ *
+ * The mapping is advised to be read sequentially, such that pages are read ahead and dropped
+ * behind. Files that are not regular, are empty or cannot be mapped are left unmapped, as are
+ * all files on Windows; their readers fall back to streams.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename) {
+#ifndef _WIN32
+        if (filename.empty()) {
+            return;
+        }
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat status = {};
+        if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+            const auto length = static_cast<std::size_t>(status.st_size);
+            void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                madvise(address, length, MADV_SEQUENTIAL);
+                data = static_cast<const char*>(address);
+                size = length;
+            }
+        }
+        close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+        }
+#endif
+    }
+
+    bool isMapped() const {
+        return data != nullptr;
+    }
+
+    /** Whether the file is compressed with gzip, such that it has to be read through a stream. */
+    bool isCompressed() const {
+        return size >= 2 && static_cast<unsigned char>(data[0]) == 0x1f &&
+               static_cast<unsigned char>(data[1]) == 0x8b;
+    }
+
+    std::string_view contents() const {
+        return {data, size};
+    }
+
+private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+};
+
+}  // namespace souffle
@@ -22,6 +22,7 @@
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/json11.h"
+#include <algorithm>
 #include <cctype>
 #include <cstddef>
 #include <map>
@@ -29,6 +30,9 @@
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace souffle {
@@ -42,13 +46,109 @@ protected:
 public:
     template <typename T>
     void readAll(T& relation) {
-        while (const auto next = readNextTuple()) {
-            const RamDomain* ramDomain = next.get();
-            relation.insert(ramDomain);
+        if constexpr (has_insert_batch<T>::value) {
+            readBatches(relation);
+        } else {
+            const std::size_t width = typeAttributes.size();
+            std::vector<RamDomain> batch(minBatchSize * width);
+            while (const std::size_t count = readNextTuples(batch.data(), minBatchSize)) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    relation.insert(batch.data() + i * width);
+                }
+            }
         }
     }
 
 protected:
+    // the number of tuples handed over to a relation at once, to start with
+    static constexpr std::size_t minBatchSize = 1 << 12;
+
+    /**
+     * Determines whether a relation accepts tuples in batches, to be inserted in bulk.
+     */
+    template <typename T, typename = void>
+    struct has_insert_batch : std::false_type {};
+
+    template <typename T>
+    struct has_insert_batch<T, std::void_t<decltype(std::declval<T&>().insertBatch(
+                                       std::declval<const RamDomain*>(), std::size_t()))>>
+            : std::true_type {};
+
+    /**
+     * Reads all tuples, handing them over to the given relation in batches. Each batch holds as
+     * many tuples as were read before it, such that relations rebuilding their indexes from each
+     * batch do so at an amortised constant cost per tuple. The batches are not capped, as a
+     * btree inserts batches that are small compared to its size tuple by tuple. The buffer of a
+     * batch is reused; it is at most as large as the merge of a rebuild. Indexes are built with
+     * full nodes, as loaded relations are mostly searched.
+     */
+    template <typename T>
+    void readBatches(T& relation) {
+        const std::size_t width = typeAttributes.size();
+        std::size_t batchSize = minBatchSize;
+        std::size_t numRead = 0;
+        std::vector<RamDomain> batch(batchSize * width);
+        while (const std::size_t count = fillBatch(batch.data(), batchSize)) {
+            relation.insertBatch(batch.data(), count);
+            numRead += count;
+            batchSize = std::max(batchSize, numRead);
+            batch.resize(batchSize * width);
+        }
+    }
+
+    /**
+     * Reads tuples into the given buffer until it holds the given number of tuples or the input
+     * is exhausted, and returns the number of tuples read.
+     */
+    std::size_t fillBatch(RamDomain* tuples, std::size_t count) {
+        const std::size_t width = typeAttributes.size();
+        std::size_t numRead = 0;
+        while (numRead < count) {
+            const std::size_t numNext = readNextTuples(tuples + numRead * width, count - numRead);
+            if (numNext == 0) {
+                break;
+            }
+            numRead += numNext;
+        }
+        return numRead;
+    }
+
+    /**
+     * Reads up to the given number of tuples into the given buffer, which holds as many tuples
+     * stored consecutively, and returns the number of tuples read; zero once the input is
+     * exhausted. By default, the tuples are read one at a time, each into a zeroed slot of the
+     * buffer; readers able to parse their input concurrently override this method.
+     */
+    virtual std::size_t readNextTuples(RamDomain* tuples, std::size_t count) {
+        const std::size_t width = typeAttributes.size();
+        std::size_t numRead = 0;
+        for (; numRead < count; ++numRead) {
+            RamDomain* tuple = tuples + numRead * width;
+            std::fill(tuple, tuple + width, 0);
+            if (!readNextTupleInto(tuple)) {
+                break;
+            }
+        }
+        return numRead;
+    }
+
+    /**
+     * Copies the given window into the scratch buffer of this stream, such that the conversion
+     * functions taking strings parse it without allocating, and returns the buffer.
+     */
+    const std::string& toScratch(std::string_view window) {
+        scratch.assign(window.data(), window.size());
+        return scratch;
+    }
+
+    /**
+     * Returns the token of a number starting at the given position, up to the next separator.
+     */
+    const std::string& readNumber(std::string_view source, std::size_t pos) {
+        const std::size_t end = std::min(source.find_first_of(",)]", pos), source.size());
+        return toScratch(source.substr(pos, end - pos));
+    }
+
     /**
      * Read a record from a string.
      *
@@ -58,7 +158,7 @@ protected:
      * @param consumed - if not nullptr: number of characters read.
      *
      */
-    RamDomain readRecord(const std::string& source, const std::string& recordTypeName, std::size_t pos = 0,
+    RamDomain readRecord(std::string_view source, const std::string& recordTypeName, std::size_t pos = 0,
             std::size_t* charactersRead = nullptr) {
         const std::size_t initial_position = pos;
 
@@ -98,15 +198,15 @@ protected:
                     break;
                 }
                 case 'i': {
-                    recordValues[i] = RamSignedFromString(source.substr(pos), &consumed);
+                    recordValues[i] = RamSignedFromString(readNumber(source, pos), &consumed);
                     break;
                 }
                 case 'u': {
-                    recordValues[i] = ramBitCast(RamUnsignedFromString(source.substr(pos), &consumed));
+                    recordValues[i] = ramBitCast(RamUnsignedFromString(readNumber(source, pos), &consumed));
                     break;
                 }
                 case 'f': {
-                    recordValues[i] = ramBitCast(RamFloatFromString(source.substr(pos), &consumed));
+                    recordValues[i] = ramBitCast(RamFloatFromString(readNumber(source, pos), &consumed));
                     break;
                 }
                 case 'r': {
@@ -130,7 +230,7 @@ protected:
         return recordTable.pack(recordValues.data(), recordValues.size());
     }
 
-    RamDomain readADT(const std::string& source, const std::string& adtName, std::size_t pos = 0,
+    RamDomain readADT(std::string_view source, const std::string& adtName, std::size_t pos = 0,
             std::size_t* charactersRead = nullptr) {
         const std::size_t initial_position = pos;
 
@@ -149,7 +249,7 @@ protected:
 
         // Consume initial character
         consumeChar(source, '$', pos);
-        std::string constructor = readQualifiedName(source, pos);
+        std::string_view constructor = readQualifiedName(source, pos);
 
         json11::Json branchInfo = [&]() -> json11::Json {
             for (auto branch : branches.array_items()) {
@@ -160,7 +260,7 @@ protected:
                 }
             }
 
-            throw std::invalid_argument("Missing branch information: " + constructor);
+            throw std::invalid_argument("Missing branch information: " + std::string(constructor));
         }();
 
         assert(branchInfo["types"].is_array());
@@ -202,15 +302,15 @@ protected:
                     break;
                 }
                 case 'i': {
-                    branchArgs[i] = RamSignedFromString(source.substr(pos), &consumed);
+                    branchArgs[i] = RamSignedFromString(readNumber(source, pos), &consumed);
                     break;
                 }
                 case 'u': {
-                    branchArgs[i] = ramBitCast(RamUnsignedFromString(source.substr(pos), &consumed));
+                    branchArgs[i] = ramBitCast(RamUnsignedFromString(readNumber(source, pos), &consumed));
                     break;
                 }
                 case 'f': {
-                    branchArgs[i] = ramBitCast(RamFloatFromString(source.substr(pos), &consumed));
+                    branchArgs[i] = ramBitCast(RamFloatFromString(readNumber(source, pos), &consumed));
                     break;
                 }
                 case 'r': {
@@ -248,9 +348,8 @@ protected:
     /**
      * Read the next alphanumeric + ('_', '?') sequence (corresponding to IDENT).
      * Consume preceding whitespace.
-     * TODO (darth_tytus): use std::string_view?
      */
-    std::string readQualifiedName(const std::string& source, std::size_t& pos) {
+    std::string_view readQualifiedName(std::string_view source, std::size_t& pos) {
         consumeWhiteSpace(source, pos);
         if (pos >= source.length()) {
             throw std::invalid_argument("Unexpected end of input");
@@ -267,7 +366,7 @@ protected:
         return source.substr(bgn, pos - bgn);
     }
 
-    std::string readUntil(const std::string& source, const std::string& stopChars, const std::size_t pos,
+    const std::string& readUntil(std::string_view source, std::string_view stopChars, const std::size_t pos,
             std::size_t* charactersRead) {
         std::size_t endOfSymbol = source.find_first_of(stopChars, pos);
 
@@ -277,10 +376,11 @@ protected:
 
         *charactersRead = endOfSymbol - pos;
 
-        return source.substr(pos, *charactersRead);
+        return toScratch(source.substr(pos, *charactersRead));
     }
 
-    std::string readQuotedSymbol(const std::string& source, std::size_t pos, std::size_t* charactersRead) {
+    const std::string& readQuotedSymbol(
+            std::string_view source, std::size_t pos, std::size_t* charactersRead) {
         const std::size_t start = pos;
         const std::size_t end = source.length();
 
@@ -322,22 +422,21 @@ protected:
 
         // fast handling of symbol without escape sequence
         if (!hasEscaped) {
-            return source.substr(startOfSymbol, lengthOfSymbol);
+            return toScratch(source.substr(startOfSymbol, lengthOfSymbol));
         } else {
             // slow handling of symbol with escape sequence
-            std::string symbol;
-            symbol.reserve(lengthOfSymbol);
+            scratch.clear();
             bool escaped = false;
             for (std::size_t pos = startOfSymbol; pos < endOfSymbol; ++pos) {
                 char ch = source[pos];
                 if (escaped || ch != '\\') {
-                    symbol.push_back(ch);
+                    scratch.push_back(ch);
                     escaped = false;
                 } else {
                     escaped = true;
                 }
             }
-            return symbol;
+            return scratch;
         }
     }
 
@@ -345,8 +444,9 @@ protected:
      * Read the next symbol.
      * It is either a double-quoted symbol with backslash-escaped chars, or the
      * longuest sequence that do not contains any of the given stopChars.
+     * The symbol is returned in the scratch buffer of this stream.
      * */
-    std::string readSymbol(const std::string& source, const std::string& stopChars, const std::size_t pos,
+    const std::string& readSymbol(std::string_view source, std::string_view stopChars, const std::size_t pos,
             std::size_t* charactersRead) {
         if (source[pos] == '"') {
             return readQuotedSymbol(source, pos, charactersRead);
@@ -358,7 +458,7 @@ protected:
     /**
      * Read past given character, consuming any preceding whitespace.
      */
-    void consumeChar(const std::string& str, char c, std::size_t& pos) {
+    void consumeChar(std::string_view str, char c, std::size_t& pos) {
         consumeWhiteSpace(str, pos);
         if (pos >= str.length()) {
             throw std::invalid_argument("Unexpected end of input");
@@ -374,13 +474,69 @@ protected:
     /**
      * Advance position in the string until first non-whitespace character.
      */
-    void consumeWhiteSpace(const std::string& str, std::size_t& pos) {
+    void consumeWhiteSpace(std::string_view str, std::size_t& pos) {
         while (pos < str.length() && std::isspace(static_cast<unsigned char>(str[pos]))) {
             ++pos;
         }
     }
 
-    virtual Own<RamDomain[]> readNextTuple() = 0;
+    /**
+     * Reads the next tuple into the given zeroed buffer, of room for one tuple.
+     *
+     * Returns false if no tuple was readable. Readers implement either this method or the
+     * allocating readNextTuple of the former interface, which it copies the tuple from by
+     * default.
+     */
+    virtual bool readNextTupleInto(RamDomain* tuple) {
+        const Own<RamDomain[]> next = forwardNextTuple([&]() { return readNextTuple(); });
+        if (next == nullptr) {
+            return false;
+        }
+        std::copy_n(next.get(), typeAttributes.size(), tuple);
+        return true;
+    }
+
+    /**
+     * Reads the next tuple into a newly allocated buffer, or returns null if no tuple was
+     * readable.
+     *
+     * Deprecated, as it allocates a buffer for each tuple: kept for readers written against
+     * the former interface. By default, the tuple is read by readNextTupleInto.
+     */
+    virtual Own<RamDomain[]> readNextTuple() {
+        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
+        if (!forwardNextTuple([&]() { return readNextTupleInto(tuple.get()); })) {
+            return nullptr;
+        }
+        return tuple;
+    }
+
+    // the buffer of fields being converted, reused across fields
+    std::string scratch;
+
+private:
+    /**
+     * Runs the given call of one of the methods reading the next tuple from the default of the
+     * other, failing if the call gets back to a default, as the reader implements neither.
+     */
+    template <typename F>
+    std::invoke_result_t<F> forwardNextTuple(F call) {
+        if (forwardingNextTuple) {
+            fatal("reader implements neither readNextTupleInto nor readNextTuple");
+        }
+        forwardingNextTuple = true;
+        try {
+            auto result = call();
+            forwardingNextTuple = false;
+            return result;
+        } catch (...) {
+            forwardingNextTuple = false;
+            throw;
+        }
+    }
+
+    // whether a default of the methods reading the next tuple is calling the other
+    bool forwardingNextTuple = false;
 };
 
 class ReadStreamFactory {
@@ -0,0 +1,290 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReadStreamBinary.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFacts.h"
+#include "souffle/io/MappedFile.h"
+#include "souffle/io/ReadStream.h"
+#include "souffle/utility/FileUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Reads a relation from a binary fact file, as laid out in BinaryFacts.h.
+ *
+ * The file is mapped into memory where possible. Its symbols and records are interned into the
+ * symbol and record tables up front; tuples are then copied out of the columns without parsing,
+ * translating the local ids of symbols and records.
+ */
+class ReadFileBinary : public ReadStream {
+public:
+    ReadFileBinary(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable)
+            : ReadStream(rwOperation, symbolTable, recordTable),
+              baseName(souffle::baseName(getFileName(rwOperation))), mappedFile(getFileName(rwOperation)) {
+        if (mappedFile.isMapped()) {
+            contents = mappedFile.contents();
+        } else {
+            std::ifstream file(getFileName(rwOperation), std::ios::in | std::ios::binary);
+            if (!file.is_open()) {
+                // suppress error message in case file cannot be open when flag -w is set
+                if (getOr(rwOperation, "no-warn", "false") != "true") {
+                    throw std::invalid_argument("Cannot open fact file " + baseName + "\n");
+                }
+                return;
+            }
+            buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            contents = buffer;
+        }
+        readHeader();
+        readSymbols();
+        readRecords();
+    }
+
+    ~ReadFileBinary() override = default;
+
+protected:
+    bool readNextTupleInto(RamDomain* tuple) override {
+        return readNextTuples(tuple, 1) == 1;
+    }
+
+    std::size_t readNextTuples(RamDomain* tuples, std::size_t count) override {
+        const std::size_t width = typeAttributes.size();
+        const std::size_t numRead = std::min<std::size_t>(count, header.numTuples - nextTuple);
+        if (numRead == 0) {
+            return 0;
+        }
+        for (std::size_t i = 0; i < arity; ++i) {
+            const char* column = contents.data() + header.columnsOffset +
+                                 (i * header.numTuples + nextTuple) * sizeof(RamDomain);
+            const BinaryValueKind kind = columnKinds[i];
+            for (std::size_t j = 0; j < numRead; ++j) {
+                RamDomain value;
+                std::memcpy(&value, column + j * sizeof(RamDomain), sizeof(RamDomain));
+                tuples[j * width + i] = toGlobal(value, kind);
+            }
+        }
+        // auxiliary columns are not stored
+        for (std::size_t j = 0; j < numRead; ++j) {
+            std::fill(tuples + j * width + arity, tuples + (j + 1) * width, 0);
+        }
+        nextTuple += numRead;
+        return numRead;
+    }
+
+    /** Translates the given value of the given kind from its value in the file. */
+    RamDomain toGlobal(RamDomain value, BinaryValueKind kind) const {
+        switch (kind) {
+            case BinaryValueKind::Symbol: return symbols[value];
+            case BinaryValueKind::Record: return value == 0 ? 0 : records[value - 1];
+            default: return value;
+        }
+    }
+
+    void readHeader() {
+        if (contents.size() < sizeof(BinaryFactsHeader)) {
+            corrupt("missing header");
+        }
+        std::memcpy(&header, contents.data(), sizeof(BinaryFactsHeader));
+        if (std::memcmp(header.magic, BinaryFactsHeader::magicString, sizeof(header.magic)) != 0) {
+            corrupt("not a binary fact file");
+        }
+        if (header.byteOrder != BinaryFactsHeader::byteOrderMark) {
+            corrupt("written with a different byte order");
+        }
+        if (header.domainSize != RAM_DOMAIN_SIZE) {
+            corrupt("written with a domain size of " + std::to_string(header.domainSize));
+        }
+        if (header.arity != arity) {
+            corrupt("arity " + std::to_string(header.arity) + " instead of " + std::to_string(arity));
+        }
+        if (arity == 0 ? header.numTuples > 1
+                       : header.numTuples > contents.size() / (arity * sizeof(RamDomain))) {
+            corrupt("too many tuples");
+        }
+        const std::size_t kindsSize = getBinaryColumnKindsSize(arity);
+        if (header.columnsOffset != sizeof(BinaryFactsHeader) + kindsSize ||
+                header.recordsOffset != header.columnsOffset + arity * header.numTuples * sizeof(RamDomain) ||
+                header.recordsOffset > header.symbolsOffset || header.symbolsOffset > contents.size()) {
+            corrupt("segments out of bounds");
+        }
+        for (std::size_t i = 0; i < arity; ++i) {
+            columnKinds.push_back(getBinaryValueKind(types, typeAttributes[i]));
+            if (static_cast<BinaryValueKind>(contents[sizeof(BinaryFactsHeader) + i]) != columnKinds[i]) {
+                corrupt("type mismatch in column " + std::to_string(i + 1));
+            }
+        }
+    }
+
+    /** Interns the symbols of the file, concurrently. */
+    void readSymbols() {
+        std::vector<std::string_view> strings;
+        std::size_t pos = header.symbolsOffset;
+        for (std::size_t i = 0; i < header.numSymbols; ++i) {
+            std::uint64_t length;
+            if (contents.size() - pos < sizeof(length)) {
+                corrupt("symbols out of bounds");
+            }
+            std::memcpy(&length, contents.data() + pos, sizeof(length));
+            pos += sizeof(length);
+            if (contents.size() - pos < length) {
+                corrupt("symbols out of bounds");
+            }
+            strings.push_back(contents.substr(pos, length));
+            pos += length;
+        }
+
+        symbols.resize(strings.size());
+        PARALLEL_START
+            pfor(int i = 0; i < static_cast<int>(strings.size()); ++i) {
+                symbols[i] = symbolTable.encode(std::string(strings[i]));
+            }
+        PARALLEL_END
+
+        // local symbol ids in the columns index the symbols
+        checkIds(BinaryValueKind::Symbol);
+    }
+
+    /** Packs the records of the file, in order, such that the records they refer to come first. */
+    void readRecords() {
+        std::size_t pos = header.recordsOffset;
+        std::vector<RamDomain> fields;
+        for (std::size_t i = 0; i < header.numRecords; ++i) {
+            std::uint32_t recordArity;
+            if (header.symbolsOffset - pos < sizeof(recordArity)) {
+                corrupt("records out of bounds");
+            }
+            std::memcpy(&recordArity, contents.data() + pos, sizeof(recordArity));
+            pos += sizeof(recordArity);
+            if ((header.symbolsOffset - pos) / (1 + sizeof(RamDomain)) < recordArity) {
+                corrupt("records out of bounds");
+            }
+            const char* kinds = contents.data() + pos;
+            const char* values = kinds + recordArity;
+            fields.resize(recordArity);
+            for (std::size_t j = 0; j < recordArity; ++j) {
+                RamDomain value;
+                std::memcpy(&value, values + j * sizeof(RamDomain), sizeof(RamDomain));
+                const auto kind = static_cast<BinaryValueKind>(kinds[j]);
+                if (!isValidId(value, kind)) {
+                    corrupt("invalid reference in record " + std::to_string(i + 1));
+                }
+                fields[j] = toGlobal(value, kind);
+            }
+            records.push_back(recordTable.pack(fields.data(), recordArity));
+            pos += recordArity * (1 + sizeof(RamDomain));
+        }
+        if (pos != header.symbolsOffset) {
+            corrupt("records out of bounds");
+        }
+        checkIds(BinaryValueKind::Record);
+    }
+
+    /** Checks that the local ids of the given kind in the columns refer to interned values. */
+    void checkIds(BinaryValueKind kind) const {
+        for (std::size_t i = 0; i < arity; ++i) {
+            if (columnKinds[i] != kind) {
+                continue;
+            }
+            const char* column =
+                    contents.data() + header.columnsOffset + i * header.numTuples * sizeof(RamDomain);
+            for (std::size_t j = 0; j < header.numTuples; ++j) {
+                RamDomain value;
+                std::memcpy(&value, column + j * sizeof(RamDomain), sizeof(RamDomain));
+                if (!isValidId(value, kind)) {
+                    corrupt("invalid reference in column " + std::to_string(i + 1));
+                }
+            }
+        }
+    }
+
+    /** Whether the given value of the given kind refers to a symbol or record interned so far. */
+    bool isValidId(RamDomain value, BinaryValueKind kind) const {
+        const auto id = static_cast<std::size_t>(static_cast<RamUnsigned>(value));
+        switch (kind) {
+            case BinaryValueKind::Plain: return true;
+            case BinaryValueKind::Symbol: return id < symbols.size();
+            case BinaryValueKind::Record: return id <= records.size();
+            default: return false;
+        }
+    }
+
+    [[noreturn]] void corrupt(const std::string& reason) const {
+        throw std::invalid_argument("Cannot read binary fact file " + baseName + ": " + reason + "\n");
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].bin
+     *
+     * @param rwOperation map of IO configuration options
+     * @return input filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".bin");
+        if (!isAbsolute(name)) {
+            name = getOr(rwOperation, "fact-dir", ".") + pathSeparator + name;
+        }
+        return name;
+    }
+
+    std::string baseName;
+    MappedFile mappedFile;
+    // the file contents, unless mapped
+    std::string buffer;
+    std::string_view contents;
+
+    BinaryFactsHeader header{};
+    std::vector<BinaryValueKind> columnKinds;
+    std::size_t nextTuple = 0;
+
+    // the interned symbols and records, by local id
+    std::vector<RamDomain> symbols;
+    std::vector<RamDomain> records;
+};
+
+class ReadFileBinaryFactory : public ReadStreamFactory {
+public:
+    Own<ReadStream> getReader(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable) override {
+        return mk<ReadFileBinary>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+
+    ~ReadFileBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
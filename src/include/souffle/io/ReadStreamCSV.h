@@ -17,9 +17,11 @@
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
+#include "souffle/io/MappedFile.h"
 #include "souffle/io/ReadStream.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StringUtil.h"
 
 #ifdef USE_LIBZ
@@ -32,12 +34,14 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace souffle {
@@ -49,7 +53,8 @@ public:
             : ReadStream(rwOperation, symbolTable, recordTable),
               rfc4180(getOr(rwOperation, "rfc4180", "false") == std::string("true")),
               delimiter(getOr(rwOperation, "delimiter", (rfc4180 ? "," : "\t"))), file(file), lineNumber(0),
-              inputMap(getInputColumnMap(rwOperation, static_cast<unsigned int>(arity))) {
+              inputMap(getInputColumnMap(rwOperation, static_cast<unsigned int>(arity))),
+              directives(rwOperation) {
         if (rfc4180 && delimiter.find('"') != std::string::npos) {
             std::stringstream errorMessage;
             errorMessage << "CSV delimiter cannot contain '\"' character when rfc4180 is enabled.";
@@ -63,41 +68,62 @@ public:
     }
 
 protected:
-    bool readNextLine(std::string& line, bool& isCRLF) {
-        if (!getline(file, line)) {
-            return false;
+    /**
+     * Read the records of the given input in memory, rather than those of the stream.
+     */
+    void setInput(std::string_view contents) {
+        input = contents;
+        inputPos = 0;
+        inMemory = true;
+    }
+
+    /**
+     * Read the next line, as a view of the input in memory or of the line buffer.
+     */
+    bool readNextLine(std::string_view& line, bool& isCRLF) {
+        if (inMemory) {
+            if (inputPos >= input.size()) {
+                return false;
+            }
+            const std::size_t end = std::min(input.find('\n', inputPos), input.size());
+            line = input.substr(inputPos, end - inputPos);
+            inputPos = end + 1;
+        } else {
+            if (!getline(file, lineBuffer)) {
+                return false;
+            }
+            line = lineBuffer;
         }
         // Handle Windows line endings on non-Windows systems
         isCRLF = !line.empty() && line.back() == '\r';
         if (isCRLF) {
-            line.pop_back();
+            line.remove_suffix(1);
         }
         ++lineNumber;
         return true;
     }
 
     /**
-     * Read and return the next tuple.
+     * Read the next tuple into the given buffer.
      *
-     * Returns nullptr if no tuple was readable.
-     * @return
+     * The line and the fields are parsed in place, in buffers reused across tuples.
+     * Returns false if no tuple was readable.
      */
-    Own<RamDomain[]> readNextTuple() override {
-        if (file.eof()) {
-            return nullptr;
+    bool readNextTupleInto(RamDomain* tuple) override {
+        if (!inMemory && file.eof()) {
+            return false;
         }
-        std::string line;
-        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
+        std::string_view line;
         bool wasCRLF = false;
         if (!readNextLine(line, wasCRLF)) {
-            return nullptr;
+            return false;
         }
 
         std::size_t start = 0;
         std::size_t columnsFilled = 0;
         for (uint32_t column = 0; columnsFilled < arity; column++) {
             std::size_t charactersRead = 0;
-            std::string element = nextElement(line, start, wasCRLF);
+            std::string_view element = nextElement(line, start, wasCRLF);
             if (inputMap.count(column) == 0) {
                 continue;
             }
@@ -107,7 +133,7 @@ protected:
                 auto&& ty = typeAttributes.at(inputMap[column]);
                 switch (ty[0]) {
                     case 's': {
-                        tuple[inputMap[column]] = symbolTable.encode(element);
+                        tuple[inputMap[column]] = symbolTable.encode(toScratch(element));
                         charactersRead = element.size();
                         break;
                     }
@@ -120,15 +146,17 @@ protected:
                         break;
                     }
                     case 'i': {
-                        tuple[inputMap[column]] = RamSignedFromString(element, &charactersRead);
+                        tuple[inputMap[column]] = RamSignedFromString(toScratch(element), &charactersRead);
                         break;
                     }
                     case 'u': {
-                        tuple[inputMap[column]] = ramBitCast(readRamUnsigned(element, charactersRead));
+                        tuple[inputMap[column]] =
+                                ramBitCast(readRamUnsigned(toScratch(element), charactersRead));
                         break;
                     }
                     case 'f': {
-                        tuple[inputMap[column]] = ramBitCast(RamFloatFromString(element, &charactersRead));
+                        tuple[inputMap[column]] =
+                                ramBitCast(RamFloatFromString(toScratch(element), &charactersRead));
                         break;
                     }
                     default: fatal("invalid type attribute: `%c`", ty[0]);
@@ -140,13 +168,189 @@ protected:
                 }
             } catch (...) {
                 std::stringstream errorMessage;
-                errorMessage << "Error converting <" + element + "> in column " << column + 1 << " in line "
+                errorMessage << "Error converting <" << element << "> in column " << column + 1 << " in line "
                              << lineNumber << "; ";
                 throw std::invalid_argument(errorMessage.str());
             }
         }
 
-        return tuple;
+        return true;
+    }
+
+    /**
+     * Read up to the given number of tuples into the given buffer.
+     *
+     * The input is read in blocks of raw bytes, which are split into chunks of whole records.
+     * The chunks are parsed concurrently, each by a reader of its own over the chunk in memory,
+     * such that delimiters, columns and quotes are treated as by readNextTupleInto. The tuples
+     * of a block are handed out over as many calls as needed.
+     */
+    std::size_t readNextTuples(RamDomain* tuples, std::size_t count) override {
+        if (numHandedOut == numParsed && !parseNextBlock(count)) {
+            return 0;
+        }
+        const std::size_t width = typeAttributes.size();
+        const std::size_t numRead = std::min(count, numParsed - numHandedOut);
+        std::copy_n(parsed.data() + numHandedOut * width, numRead * width, tuples);
+        numHandedOut += numRead;
+        return numRead;
+    }
+
+    /**
+     * Parse the next block of about the given number of tuples into the buffer of parsed tuples.
+     *
+     * Returns false if the input is exhausted.
+     */
+    bool parseNextBlock(std::size_t count) {
+        const std::size_t bytesPerTuple = (numTuplesParsed == 0) ? 64 : numBytesParsed / numTuplesParsed + 1;
+        const std::size_t minBlockSize = static_cast<std::size_t>(MAX_THREADS) * chunkSize;
+        const std::size_t blockSize = std::min(std::max(count * bytesPerTuple, minBlockSize), maxBlockSize);
+
+        // read until the block holds a complete record, or the input is exhausted; input in memory
+        // is split in place
+        std::string_view window;
+        std::vector<std::size_t> bounds;
+        for (std::size_t size = blockSize;; size *= 2) {
+            bool exhausted = false;
+            if (inMemory) {
+                window = input.substr(std::min(inputPos, input.size()), size);
+                exhausted = inputPos + size >= input.size();
+            } else {
+                const std::size_t filled = block.size();
+                if (filled < size) {
+                    block.resize(size);
+                    file.read(&block[filled], static_cast<std::streamsize>(size - filled));
+                    block.resize(filled + static_cast<std::size_t>(file.gcount()));
+                }
+                window = block;
+                exhausted = !file;
+            }
+            bounds = splitIntoChunks(window, exhausted);
+            if (bounds.size() > 1 || exhausted) {
+                break;
+            }
+        }
+
+        const std::size_t numChunks = bounds.size() - 1;
+        std::vector<std::size_t> firstLines(numChunks);
+        for (std::size_t i = 0; i < numChunks; ++i) {
+            firstLines[i] = lineNumber;
+            lineNumber += static_cast<std::size_t>(
+                    std::count(window.begin() + bounds[i], window.begin() + bounds[i + 1], '\n'));
+        }
+
+        // parse each chunk with a reader of its own into a buffer of its own, collecting errors
+        const std::size_t width = typeAttributes.size();
+        if (chunkTuples.size() < numChunks) {
+            chunkTuples.resize(numChunks);
+        }
+        std::vector<std::size_t> chunkCounts(numChunks, 0);
+        std::vector<std::exception_ptr> errors(numChunks);
+        auto parseChunk = [&](std::size_t i) {
+            try {
+                ReadStreamCSV reader(file, directives, symbolTable, recordTable);
+                reader.setInput(window.substr(bounds[i], bounds[i + 1] - bounds[i]));
+                reader.lineNumber = firstLines[i];
+                auto& out = chunkTuples[i];
+                out.clear();
+                while (true) {
+                    out.resize((chunkCounts[i] + 1) * width);
+                    if (!reader.readNextTupleInto(out.data() + chunkCounts[i] * width)) {
+                        break;
+                    }
+                    ++chunkCounts[i];
+                }
+                out.resize(chunkCounts[i] * width);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+        if (numChunks == 1) {
+            parseChunk(0);
+        } else {
+            PARALLEL_START
+                pfor(int i = 0; i < static_cast<int>(numChunks); ++i) {
+                    parseChunk(static_cast<std::size_t>(i));
+                }
+            PARALLEL_END
+        }
+        for (const auto& error : errors) {
+            if (error != nullptr) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        parsed.clear();
+        numParsed = 0;
+        numHandedOut = 0;
+        for (std::size_t i = 0; i < numChunks; ++i) {
+            parsed.insert(parsed.end(), chunkTuples[i].begin(), chunkTuples[i].end());
+            numParsed += chunkCounts[i];
+        }
+        numBytesParsed += bounds.back();
+        numTuplesParsed += numParsed;
+        if (inMemory) {
+            inputPos += bounds.back();
+        } else {
+            block.erase(0, bounds.back());
+        }
+        return numParsed > 0;
+    }
+
+    /**
+     * Split the block into chunks of whole records, of about chunkSize bytes each.
+     *
+     * Returns the bounds of the chunks, the last of which is the end of the last complete
+     * record of the block; or the end of the block, if the input is exhausted.
+     */
+    std::vector<std::size_t> splitIntoChunks(std::string_view block, bool exhausted) const {
+        std::vector<std::size_t> bounds{0};
+        std::size_t end = 0;
+        if (rfc4180 && block.find('"') != std::string::npos) {
+            // quoted fields may span lines, such that records end at the newlines outside of them
+            bool quoted = false;
+            bool fieldStart = true;
+            for (std::size_t pos = 0; pos < block.size(); ++pos) {
+                const char c = block[pos];
+                if (quoted) {
+                    if (c == '"') {
+                        if (pos + 1 < block.size() && block[pos + 1] == '"') {
+                            ++pos;
+                        } else {
+                            quoted = false;
+                        }
+                    }
+                } else if (fieldStart && c == '"') {
+                    quoted = true;
+                    fieldStart = false;
+                } else if (c == '\n') {
+                    end = pos + 1;
+                    fieldStart = true;
+                    if (end - bounds.back() >= chunkSize) {
+                        bounds.push_back(end);
+                    }
+                } else if (!delimiter.empty() && block.substr(pos, delimiter.size()) == delimiter) {
+                    pos += delimiter.size() - 1;
+                    fieldStart = true;
+                } else {
+                    fieldStart = false;
+                }
+            }
+        } else {
+            // records are lines
+            const std::size_t last = block.rfind('\n');
+            end = (last == std::string::npos) ? 0 : last + 1;
+            while (end - bounds.back() > chunkSize) {
+                bounds.push_back(block.find('\n', bounds.back() + chunkSize) + 1);
+            }
+        }
+        if (exhausted) {
+            end = block.size();
+        }
+        if (end > bounds.back()) {
+            bounds.push_back(end);
+        }
+        return bounds;
     }
 
     /**
@@ -170,12 +374,16 @@ protected:
         return value;
     }
 
-    std::string nextElement(std::string& line, std::size_t& start, bool& wasCRLF) {
-        std::string element;
-
+    /**
+     * Return the next element of the line, as a view of the line or, for quoted fields, of a buffer
+     * reused across fields.
+     */
+    std::string_view nextElement(std::string_view& line, std::size_t& start, bool& wasCRLF) {
         if (rfc4180) {
-            if (line[start] == '"') {
+            if (start < line.length() && line[start] == '"') {
                 // quoted field
+                std::string& element = quotedElement;
+                element.clear();
                 std::size_t end = line.length();
                 std::size_t pos = start + 1;
                 bool foundEndQuote = false;
@@ -236,7 +444,7 @@ protected:
             } else {
                 // non-quoted field, span until next delimiter or end of line
                 const std::size_t end = std::min(line.find(delimiter, start), line.length());
-                element = line.substr(start, end - start);
+                std::string_view element = line.substr(start, end - start);
                 start = end + delimiter.size();
 
                 return element;
@@ -250,7 +458,7 @@ protected:
             std::size_t next_delimiter = line.find(delimiter, start);
 
             // Find first delimiter after the record.
-            while (end < std::min(next_delimiter, line.length()) || record_parens != 0) {
+            while (end < line.length() && (end < next_delimiter || record_parens != 0)) {
                 // Track the number of parenthesis.
                 if (line[end] == '[') {
                     ++record_parens;
@@ -289,7 +497,7 @@ protected:
             throw std::invalid_argument(errorMessage.str());
         }
 
-        element = line.substr(start, end - start);
+        std::string_view element = line.substr(start, end - start);
         start = end + delimiter.size();
 
         return element;
@@ -324,37 +532,85 @@ protected:
     std::istream& file;
     std::size_t lineNumber;
     std::map<int, int> inputMap;
+
+    // the line read from the stream and the quoted field being unescaped, reused across tuples
+    std::string lineBuffer;
+    std::string quotedElement;
+
+    // the input in memory, if any, read instead of the stream
+    std::string_view input;
+    std::size_t inputPos = 0;
+    bool inMemory = false;
+
+    // the number of bytes of input parsed as a whole by one thread
+    static constexpr std::size_t chunkSize = 1 << 20;
+    // the maximal number of bytes of input read at once
+    static constexpr std::size_t maxBlockSize = 1 << 26;
+
+    // the directives, to set up the readers of chunks
+    const std::map<std::string, std::string> directives;
+    // the input read but not parsed yet
+    std::string block;
+    // the tuples parsed from each chunk of the last block, and from the whole block
+    std::vector<std::vector<RamDomain>> chunkTuples;
+    std::vector<RamDomain> parsed;
+    std::size_t numParsed = 0;
+    std::size_t numHandedOut = 0;
+    // the numbers of bytes and tuples parsed so far, to estimate the size of blocks
+    std::size_t numBytesParsed = 0;
+    std::size_t numTuplesParsed = 0;
 };
 
+/**
+ * Reads a fact file. Regular files that are not compressed are mapped into memory and parsed in
+ * place, unless mmap=false is given; other files are read through a stream.
+ */
 class ReadFileCSV : public ReadStreamCSV {
 public:
     ReadFileCSV(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
             RecordTable& recordTable)
             : ReadStreamCSV(fileHandle, rwOperation, symbolTable, recordTable),
               baseName(souffle::baseName(getFileName(rwOperation))),
-              fileHandle(getFileName(rwOperation), std::ios::in | std::ios::binary) {
+              fileHandle(getFileName(rwOperation), std::ios::in | std::ios::binary),
+              mappedFile(getOr(rwOperation, "mmap", "true") == "true" ? getFileName(rwOperation) : "") {
         if (!fileHandle.is_open()) {
             // suppress error message in case file cannot be open when flag -w is set
             if (getOr(rwOperation, "no-warn", "false") != "true") {
                 throw std::invalid_argument("Cannot open fact file " + baseName + "\n");
             }
         }
-        // Strip headers if we're using them
+        if (mappedFile.isMapped() && !mappedFile.isCompressed()) {
+            setInput(mappedFile.contents());
+        }
+        // Strip headers if we're using them, not counting them as a line
         if (getOr(rwOperation, "headers", "false") == "true") {
-            std::string line;
-            getline(file, line);
+            std::string_view header;
+            bool isCRLF = false;
+            if (readNextLine(header, isCRLF)) {
+                --lineNumber;
+            }
         }
     }
 
     /**
-     * Read and return the next tuple.
+     * Read the next tuple into the given buffer.
      *
-     * Returns nullptr if no tuple was readable.
-     * @return
+     * Returns false if no tuple was readable.
      */
-    Own<RamDomain[]> readNextTuple() override {
+    bool readNextTupleInto(RamDomain* tuple) override {
+        try {
+            return ReadStreamCSV::readNextTupleInto(tuple);
+        } catch (std::exception& e) {
+            std::stringstream errorMessage;
+            errorMessage << e.what();
+            errorMessage << "cannot parse fact file " << baseName << "!\n";
+            throw std::invalid_argument(errorMessage.str());
+        }
+    }
+
+    std::size_t readNextTuples(RamDomain* tuples, std::size_t count) override {
         try {
-            return ReadStreamCSV::readNextTuple();
+            return ReadStreamCSV::readNextTuples(tuples, count);
         } catch (std::exception& e) {
             std::stringstream errorMessage;
             errorMessage << e.what();
@@ -387,6 +643,7 @@ protected:
 #else
     std::ifstream fileHandle;
 #endif
+    MappedFile mappedFile;
 };
 
 class ReadCinCSVFactory : public ReadStreamFactory {
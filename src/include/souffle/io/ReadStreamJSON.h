@@ -67,7 +67,7 @@ protected:
     bool useObjects;
     std::map<const std::string, const std::size_t> paramIndex;
 
-    Own<RamDomain[]> readNextTuple() override {
+    bool readNextTupleInto(RamDomain* tuple) override {
         // for some reasons we cannot initalized our json objects in constructor
         // otherwise it will segfault, so we initialize in the first call
         if (!isInitialized) {
@@ -83,7 +83,7 @@ protected:
 
             if (jsonSource.array_items().empty()) {
                 // No tuples defined
-                return nullptr;
+                return false;
             }
 
             // we only check the first one, since there are extra checks
@@ -103,18 +103,17 @@ protected:
         }
 
         if (useObjects) {
-            return readNextTupleObject();
+            return readNextTupleObject(tuple);
         } else {
-            return readNextTupleList();
+            return readNextTupleList(tuple);
         }
     }
 
-    Own<RamDomain[]> readNextTupleList() {
+    bool readNextTupleList(RamDomain* tuple) {
         if (pos >= jsonSource.array_items().size()) {
-            return nullptr;
+            return false;
         }
 
-        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
         const Json& jsonObj = jsonSource[pos];
         assert(jsonObj.is_array() && "the input is not json array");
         pos++;
@@ -155,7 +154,7 @@ protected:
             }
         }
 
-        return tuple;
+        return true;
     }
 
     RamDomain readNextElementList(const Json& source, const std::string& recordTypeName) {
@@ -204,16 +203,15 @@ protected:
         return recordTable.pack(recordValues.data(), recordValues.size());
     }
 
-    Own<RamDomain[]> readNextTupleObject() {
+    bool readNextTupleObject(RamDomain* tuple) {
         if (pos >= jsonSource.array_items().size()) {
-            return nullptr;
+            return false;
         }
 
-        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
         const Json& jsonObj = jsonSource[pos];
         assert(jsonObj.is_object() && "the input is not json object");
         pos++;
-        for (auto p : jsonObj.object_items()) {
+        for (const auto& p : jsonObj.object_items()) {
             try {
                 // get the corresponding position by parameter name
                 if (paramIndex.find(p.first) == paramIndex.end()) {
@@ -251,7 +249,7 @@ protected:
             }
         }
 
-        return tuple;
+        return true;
     }
 
     RamDomain readNextElementObject(const Json& source, const std::string& recordTypeName) {
@@ -279,7 +277,7 @@ protected:
         const std::size_t recordArity = recordInfo["arity"].long_value();
         std::vector<RamDomain> recordValues(recordArity);
         recordValues.reserve(recordIndex.size());
-        for (auto readParam : source.object_items()) {
+        for (const auto& readParam : source.object_items()) {
             // get the corresponding position by parameter name
             if (recordIndex.find(readParam.first) == recordIndex.end()) {
                 throwError("invalid parameter: ", readParam.first);
@@ -27,6 +27,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sqlite3.h>
 
@@ -50,39 +51,34 @@ public:
 
 protected:
     /**
-     * Read and return the next tuple.
+     * Read the next tuple into the given buffer.
      *
-     * Returns nullptr if no tuple was readable.
-     * @return
+     * The columns are converted in the scratch buffer, reused across columns.
+     * Returns false if no tuple was readable.
      */
-    Own<RamDomain[]> readNextTuple() override {
+    bool readNextTupleInto(RamDomain* tuple) override {
         if (sqlite3_step(selectStatement) != SQLITE_ROW) {
-            return nullptr;
+            return false;
         }
 
-        Own<RamDomain[]> tuple = mk<RamDomain[]>(arity + auxiliaryArity);
-
         uint32_t column;
         for (column = 0; column < arity; column++) {
-            std::string element;
-            if (0 == sqlite3_column_bytes(selectStatement, column)) {
-                element = "n/a";
-            } else {
+            std::string_view element;
+            if (0 != sqlite3_column_bytes(selectStatement, column)) {
                 element = reinterpret_cast<const char*>(sqlite3_column_text(selectStatement, column));
-
-                if (element.empty()) {
-                    element = "n/a";
-                }
+            }
+            if (element.empty()) {
+                element = "n/a";
             }
 
             try {
                 auto&& ty = typeAttributes.at(column);
                 switch (ty[0]) {
-                    case 's': tuple[column] = symbolTable.encode(element); break;
-                    case 'f': tuple[column] = ramBitCast(RamFloatFromString(element)); break;
+                    case 's': tuple[column] = symbolTable.encode(toScratch(element)); break;
+                    case 'f': tuple[column] = ramBitCast(RamFloatFromString(toScratch(element))); break;
                     case 'i':
                     case 'u':
-                    case 'r': tuple[column] = RamSignedFromString(element); break;
+                    case 'r': tuple[column] = RamSignedFromString(toScratch(element)); break;
                     default: fatal("invalid type attribute: `%c`", ty[0]);
                 }
             } catch (...) {
@@ -92,7 +88,7 @@ protected:
             }
         }
 
-        return tuple;
+        return true;
     }
 
     void executeSQL(const std::string& sql) {
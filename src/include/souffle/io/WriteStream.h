@@ -48,11 +48,12 @@ public:
             if (relation.begin() != relation.end()) {
                 writeNullary();
             }
-            return;
-        }
-        for (const auto& current : relation) {
-            writeNext(current);
+        } else {
+            for (const auto& current : relation) {
+                writeNext(current);
+            }
         }
+        writeEnd();
     }
 
     template <typename T>
@@ -65,6 +66,8 @@ protected:
 
     virtual void writeNullary() = 0;
     virtual void writeNextTuple(const RamDomain* tuple) = 0;
+    /** Completes the output after all tuples are written, for formats laid out as a whole. */
+    virtual void writeEnd() {}
     virtual void writeSize(std::size_t) {
         fatal("attempting to print size of a write operation");
     }
@@ -0,0 +1,239 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file WriteStreamBinary.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFacts.h"
+#include "souffle/io/WriteStream.h"
+#include "souffle/utility/MiscUtil.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Writes a relation to a binary fact file, as laid out in BinaryFacts.h.
+ *
+ * The columns are collected while the tuples are written, translating symbols and records to
+ * ids local to the file, and the file is written once all tuples are collected.
+ */
+class WriteFileBinary : public WriteStream {
+public:
+    WriteFileBinary(const std::map<std::string, std::string>& rwOperation, const SymbolTable& symbolTable,
+            const RecordTable& recordTable)
+            : WriteStream(rwOperation, symbolTable, recordTable), fileName(getFileName(rwOperation)),
+              columns(arity) {
+        for (std::size_t i = 0; i < arity; ++i) {
+            columnKinds.push_back(getBinaryValueKind(types, typeAttributes[i]));
+        }
+    }
+
+    ~WriteFileBinary() override = default;
+
+protected:
+    void writeNullary() override {
+        ++numTuples;
+    }
+
+    void writeNextTuple(const RamDomain* tuple) override {
+        for (std::size_t i = 0; i < arity; ++i) {
+            columns[i].push_back(toLocal(tuple[i], typeAttributes[i]));
+        }
+        ++numTuples;
+    }
+
+    void writeEnd() override {
+        BinaryFactsHeader header{};
+        std::memcpy(header.magic, BinaryFactsHeader::magicString, sizeof(header.magic));
+        header.byteOrder = BinaryFactsHeader::byteOrderMark;
+        header.domainSize = RAM_DOMAIN_SIZE;
+        header.arity = arity;
+        header.numTuples = numTuples;
+        header.columnsOffset = sizeof(BinaryFactsHeader) + getBinaryColumnKindsSize(arity);
+        header.numRecords = numRecords;
+        header.recordsOffset = header.columnsOffset + arity * numTuples * sizeof(RamDomain);
+        header.numSymbols = symbols.size();
+        header.symbolsOffset = header.recordsOffset + records.size();
+
+        std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::vector<BinaryValueKind> paddedKinds(columnKinds);
+        paddedKinds.resize(getBinaryColumnKindsSize(arity), BinaryValueKind::Plain);
+        file.write(reinterpret_cast<const char*>(paddedKinds.data()), paddedKinds.size());
+        for (const auto& column : columns) {
+            file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(RamDomain));
+        }
+        file.write(records.data(), records.size());
+        for (const std::string* symbol : symbols) {
+            const std::uint64_t length = symbol->size();
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.write(symbol->data(), symbol->size());
+        }
+        if (!file) {
+            throw std::invalid_argument("Cannot write binary fact file " + fileName + "\n");
+        }
+    }
+
+    /** Translates the given value of the given type to its value in the file. */
+    RamDomain toLocal(RamDomain value, const std::string& type) {
+        switch (type[0]) {
+            case 's': return toLocalSymbol(value);
+            case 'r': return toLocalRecord(value, type);
+            case '+': return toLocalADT(value, type);
+            default: return value;
+        }
+    }
+
+    RamDomain toLocalSymbol(RamDomain value) {
+        auto [it, inserted] = localSymbols.try_emplace(value, static_cast<RamDomain>(symbols.size()));
+        if (inserted) {
+            symbols.push_back(&symbolTable.decode(value));
+        }
+        return it->second;
+    }
+
+    RamDomain toLocalRecord(RamDomain value, const std::string& name) {
+        // Check for nil
+        if (value == 0) {
+            return 0;
+        }
+        auto& known = localRecords[name];
+        if (auto it = known.find(value); it != known.end()) {
+            return it->second;
+        }
+
+        auto&& recordInfo = types["records"][name];
+        auto&& recordTypes = recordInfo["types"];
+        const std::size_t recordArity = recordInfo["arity"].long_value();
+        const RamDomain* tuplePtr = recordTable.unpack(value, recordArity);
+
+        std::vector<RamDomain> fields(tuplePtr, tuplePtr + recordArity);
+        std::vector<BinaryValueKind> kinds;
+        for (std::size_t i = 0; i < recordArity; ++i) {
+            const std::string& recordType = recordTypes[i].string_value();
+            fields[i] = toLocal(fields[i], recordType);
+            kinds.push_back(getBinaryValueKind(types, recordType));
+        }
+        return known[value] = appendRecord(fields, kinds);
+    }
+
+    RamDomain toLocalADT(RamDomain value, const std::string& name) {
+        auto&& adtInfo = types["ADTs"][name];
+        if (adtInfo["enum"].bool_value()) {
+            return value;
+        }
+        auto& known = localRecords[name];
+        if (auto it = known.find(value); it != known.end()) {
+            return it->second;
+        }
+
+        // the ADT is stored as [branchID, arg] when its branch takes a single argument, and as
+        // [branchID, [branch_args]] otherwise, as it is encoded in the record table
+        const RamDomain* tuplePtr = recordTable.unpack(value, 2);
+        const RamDomain branchId = tuplePtr[0];
+        RamDomain payload = tuplePtr[1];
+        auto&& branchTypes = adtInfo["branches"][branchId]["types"].array_items();
+
+        BinaryValueKind payloadKind = BinaryValueKind::Record;
+        if (branchTypes.size() == 1) {
+            const std::string& argType = branchTypes[0].string_value();
+            payload = toLocal(payload, argType);
+            payloadKind = getBinaryValueKind(types, argType);
+        } else {
+            const RamDomain* branchArgs = recordTable.unpack(payload, branchTypes.size());
+            std::vector<RamDomain> args(branchArgs, branchArgs + branchTypes.size());
+            std::vector<BinaryValueKind> kinds;
+            for (std::size_t i = 0; i < branchTypes.size(); ++i) {
+                const std::string& argType = branchTypes[i].string_value();
+                args[i] = toLocal(args[i], argType);
+                kinds.push_back(getBinaryValueKind(types, argType));
+            }
+            payload = appendRecord(args, kinds);
+        }
+        return known[value] = appendRecord({branchId, payload}, {BinaryValueKind::Plain, payloadKind});
+    }
+
+    /** Appends a record with the given local fields to the records segment, returning its local id. */
+    RamDomain appendRecord(const std::vector<RamDomain>& fields, const std::vector<BinaryValueKind>& kinds) {
+        const auto recordArity = static_cast<std::uint32_t>(fields.size());
+        const std::size_t start = records.size();
+        records.resize(start + sizeof(recordArity) + recordArity + recordArity * sizeof(RamDomain));
+        char* pos = records.data() + start;
+        std::memcpy(pos, &recordArity, sizeof(recordArity));
+        if (recordArity > 0) {
+            pos += sizeof(recordArity);
+            std::memcpy(pos, kinds.data(), recordArity);
+            pos += recordArity;
+            std::memcpy(pos, fields.data(), recordArity * sizeof(RamDomain));
+        }
+        return static_cast<RamDomain>(++numRecords);
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].bin
+     *
+     * @param rwOperation map of IO configuration options
+     * @return output filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".bin");
+        if (name.front() != '/') {
+            name = getOr(rwOperation, "output-dir", ".") + "/" + name;
+        }
+        return name;
+    }
+
+    std::string fileName;
+    std::vector<BinaryValueKind> columnKinds;
+    std::vector<std::vector<RamDomain>> columns;
+    std::size_t numTuples = 0;
+
+    // the symbols in the file, by local id, and the local ids of symbols
+    std::vector<const std::string*> symbols;
+    std::unordered_map<RamDomain, RamDomain> localSymbols;
+
+    // the records segment, and the local ids of records by type
+    std::vector<char> records;
+    std::size_t numRecords = 0;
+    std::unordered_map<std::string, std::unordered_map<RamDomain, RamDomain>> localRecords;
+};
+
+class WriteFileBinaryFactory : public WriteStreamFactory {
+public:
+    Own<WriteStream> getWriter(const std::map<std::string, std::string>& rwOperation,
+            const SymbolTable& symbolTable, const RecordTable& recordTable) override {
+        return mk<WriteFileBinary>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+
+    ~WriteFileBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
@@ -21,17 +21,18 @@
 
 namespace souffle::interpreter {
 
-#define CREATE_BRIE_REL(Structure, Arity, ...)                                                               \
-    case (Arity): {                                                                                          \
-        return mk<Relation<Arity, interpreter::Brie>>(id.getAuxiliaryArity(), id.getName(), indexSelection); \
+#define CREATE_BRIE_REL(Structure, Arity, ...)                         \
+    case (Arity): {                                                    \
+        return mk<Relation<Arity, interpreter::Brie>>(                 \
+                id.getAuxiliaryArity(), id.getName(), indexSelection); \
     }
 
 Own<RelationWrapper> createBrieRelation(
-        const ram::Relation& id, const ram::analysis::IndexCluster& /* orderSet */) {
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection) {
     switch (id.getArity()) {
         FOR_EACH_BRIE(CREATE_BRIE_REL);
 
-        default: fatal("Brie is not supported in the interpreter mode.");
+        default: fatal("Requested arity not yet supported. Feel free to add it.");
     }
 }
 
@@ -19,6 +19,8 @@
 #include "interpreter/Index.h"
 #include "interpreter/Relation.h"
 #include "souffle/RamTypes.h"
+#include "souffle/datastructure/HashJoinTable.h"
+#include "souffle/utility/Iteration.h"
 #include <cassert>
 #include <cstddef>
 #include <memory>
@@ -37,8 +39,10 @@ public:
     Context(std::size_t size = 0) : data(size) {}
 
     /** This constructor is used when program enter a new scope.
-     * Only Subroutine value needs to be copied */
-    Context(Context& ctxt) : returnValues(ctxt.returnValues), args(ctxt.args) {}
+     * Only Subroutine value, loop iteration and hash tables need to be copied */
+    Context(Context& ctxt)
+            : returnValues(ctxt.returnValues), args(ctxt.args), iteration(ctxt.iteration),
+              hashTables(ctxt.hashTables) {}
     virtual ~Context() = default;
 
     const RamDomain*& operator[](std::size_t index) {
@@ -94,6 +98,21 @@ public:
         return (*args)[i];
     }
 
+    /** @brief Return current iteration number for loop operation */
+    std::size_t getIterationNumber() const {
+        return iteration;
+    }
+
+    /** @brief Increase iteration number by one */
+    void incIterationNumber() {
+        ++iteration;
+    }
+
+    /** @brief Reset iteration number */
+    void resetIterationNumber() {
+        iteration = 0;
+    }
+
     /** @brief Create a view in the environment */
     void createView(const RelationWrapper& rel, std::size_t indexPos, std::size_t viewPos) {
         ViewPtr view;
@@ -109,6 +128,28 @@ public:
         return views[id].get();
     }
 
+    /** @brief Build a hash table of a relation in the environment */
+    void createHashTable(
+            const RelationWrapper& rel, std::vector<std::size_t> keyColumns, std::size_t tablePos) {
+        if (hashTables.size() < tablePos + 1) {
+            hashTables.resize(tablePos + 1);
+        }
+        auto table = std::make_shared<HashJoinTable>(rel.getArity(), std::move(keyColumns));
+        table->build(std::vector<range<RelationWrapper::Iterator>>{make_range(rel.begin(), rel.end())});
+        hashTables[tablePos] = std::move(table);
+    }
+
+    /** @brief Return a hash table */
+    const HashJoinTable* getHashTable(std::size_t id) const {
+        assert(id < hashTables.size() && hashTables[id] != nullptr);
+        return hashTables[id].get();
+    }
+
+    /** @brief Release all hash tables */
+    void clearHashTables() {
+        hashTables.clear();
+    }
+
 private:
     /** @brief Run-time value */
     std::vector<const RamDomain*> data;
@@ -116,10 +157,14 @@ private:
     std::vector<RamDomain>* returnValues = nullptr;
     /** @brief Subroutine arguments */
     const std::vector<RamDomain>* args = nullptr;
+    /** @brief Loop iteration counter */
+    std::size_t iteration = 0;
     /** @bref Allocated data */
     VecOwn<RamDomain[]> allocatedDataContainer;
     /** @brief Views */
     VecOwn<ViewWrapper> views;
+    /** @brief Hash tables, shared with the contexts of parallel operations */
+    std::vector<std::shared_ptr<const HashJoinTable>> hashTables;
 };
 
 }  // namespace souffle::interpreter
@@ -19,9 +19,11 @@
 #include "Global.h"
 #include "interpreter/Context.h"
 #include "interpreter/Index.h"
+#include "interpreter/JoinSizeEstimate.h"
 #include "interpreter/Node.h"
 #include "interpreter/Relation.h"
 #include "interpreter/ViewContext.h"
+#include "ram/AdaptiveQuery.h"
 #include "ram/Aggregate.h"
 #include "ram/Aggregator.h"
 #include "ram/AutoIncrement.h"
@@ -38,6 +40,7 @@
 #include "ram/Exit.h"
 #include "ram/False.h"
 #include "ram/Filter.h"
+#include "ram/HashJoin.h"
 #include "ram/IO.h"
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
@@ -46,10 +49,12 @@
 #include "ram/Insert.h"
 #include "ram/IntrinsicAggregator.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
@@ -81,6 +86,7 @@
 #include "ram/UnpackRecord.h"
 #include "ram/UserDefinedAggregator.h"
 #include "ram/UserDefinedOperator.h"
+#include "ram/analysis/SortedDelta.h"
 #include "ram/utility/Visitor.h"
 #include "souffle/BinaryConstraintOps.h"
 #include "souffle/RamTypes.h"
@@ -88,6 +94,7 @@
 #include "souffle/SignalHandler.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/TypeAttribute.h"
+#include "souffle/datastructure/NodeArena.h"
 #include "souffle/datastructure/RecordTableImpl.h"
 #include "souffle/datastructure/SymbolTableImpl.h"
 #include "souffle/io/IOSystem.h"
@@ -103,6 +110,8 @@
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -110,12 +119,19 @@
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <regex>
+#include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -148,6 +164,8 @@ constexpr RamDomain RAM_BIT_SHIFT_MASK = RAM_DOMAIN_SIZE - 1;
 
 #ifdef _OPENMP
 std::size_t number_of_threads(const std::size_t user_specified) {
+    // parallel statements open a second level of parallelism around the parallel loops
+    omp_set_max_active_levels(std::max(omp_get_max_active_levels(), 2));
     if (user_specified > 0) {
         omp_set_num_threads(static_cast<int>(user_specified));
         return user_specified;
@@ -222,6 +240,52 @@ RamDomain callStatefulAggregate(AnyFunctor&& userFunctor, souffle::SymbolTable*
  */
 static constexpr std::size_t StatelessFunctorMaxArity = 2;
 
+// Number of queued tuples a worker of an eager evaluation propagates at once.
+static constexpr std::size_t EagerBatchSize = 64;
+
+/**
+ * Number of tuples to sample for join size statistics, such that the standard error
+ * of the sampled fractions stays within the requested bound; zero for a full scan.
+ */
+std::size_t getJoinSizeSampleSize(Global& global) {
+    if (!global.config().has("statistics-error")) {
+        return 0;
+    }
+    const double error = std::stod(global.config().get("statistics-error"));
+    return static_cast<std::size_t>(std::ceil(1.0 / (4.0 * error * error)));
+}
+
+/**
+ * Relations whose distinct prefixes are looked up by sampled join size estimates, including
+ * the relations swapped with them, such that their statistics are only maintained where used.
+ */
+std::set<std::string> getPrefixStatisticsRelations(const ram::Program& program, std::size_t sampleSize) {
+    std::set<std::string> res;
+    if (sampleSize == 0) {
+        return res;
+    }
+    visit(program, [&](const ram::EstimateJoinSize& estimate) {
+        if (estimate.getConstantsMap().empty() && !estimate.getKeyColumns().empty()) {
+            res.insert(estimate.getRelation());
+        }
+    });
+    std::vector<std::pair<std::string, std::string>> swaps;
+    visit(program, [&](const ram::Swap& swap) {
+        swaps.emplace_back(swap.getFirstRelation(), swap.getSecondRelation());
+    });
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (const auto& [first, second] : swaps) {
+            if ((res.count(first) > 0) != (res.count(second) > 0)) {
+                res.insert(first);
+                res.insert(second);
+                changed = true;
+            }
+        }
+    }
+    return res;
+}
+
 /** Construct a native argument value for a stateless functor. */
 template <typename T>
 T nativeArgument(souffle::SymbolTable& symbolTable, const RamDomain value) {
@@ -303,9 +367,11 @@ RamDomain callStateless(ExecuteFn&& execute, Context& ctxt, Shadow& shadow, souf
 Engine::Engine(ram::TranslationUnit& tUnit, const std::size_t numberOfThreadsOrZero)
         : tUnit(tUnit), global(tUnit.global()), profileEnabled(global.config().has("profile")),
           frequencyCounterEnabled(global.config().has("profile-frequency")),
+          joinSizeSampleSize(getJoinSizeSampleSize(global)),
+          prefixStatisticsRelations(getPrefixStatisticsRelations(tUnit.getProgram(), joinSizeSampleSize)),
           numOfThreads(number_of_threads(numberOfThreadsOrZero)),
           isa(tUnit.getAnalysis<ram::analysis::IndexAnalysis>()), recordTable(numOfThreads),
-          symbolTable(numOfThreads), regexCache(numOfThreads) {}
+          symbolTable(numOfThreads), regexCache(numOfThreads), backgroundWriter(numOfThreads) {}
 
 Engine::RelationHandle& Engine::getRelationHandle(const std::size_t idx) {
     return *relations[idx];
@@ -314,6 +380,8 @@ Engine::RelationHandle& Engine::getRelationHandle(const std::size_t idx) {
 void Engine::swapRelation(const std::size_t ramRel1, const std::size_t ramRel2) {
     RelationHandle& rel1 = getRelationHandle(ramRel1);
     RelationHandle& rel2 = getRelationHandle(ramRel2);
+    rel1->seal();
+    rel2->seal();
     std::swap(rel1, rel2);
 }
 
@@ -362,14 +430,52 @@ void Engine::createRelation(const ram::Relation& id, const std::size_t idx) {
         res = createEqrelRelation(id, isa.getIndexSelection(id.getName()));
     } else if (id.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
         res = createBTreeDeleteRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (isLatticeRepresentation(id.getRepresentation())) {
+        res = createLatticeRelation(id, isa.getIndexSelection(id.getName()));
     } else if (id.getRepresentation() == RelationRepresentation::PROVENANCE) {
         res = createProvenanceRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (id.getArity() > MaxFixedArity) {
+        res = createGenericRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (tUnit.getAnalysis<ram::analysis::SortedDeltaAnalysis>().isSortedDelta(id.getName())) {
+        res = createSortedArrayRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (isa.isHashRelation(id.getName())) {
+        res = createHashSetRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (id.getRepresentation() == RelationRepresentation::COMPRESSED && id.getArity() > 0) {
+        res = createPackedArrayRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (id.getRepresentation() == RelationRepresentation::BRIE) {
+        res = createBrieRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (global.config().has("compress-leaves") && id.getArity() >= MinCompressedLeafArity) {
+        res = createCompressedBTreeRelation(id, isa.getIndexSelection(id.getName()));
     } else {
         res = createBTreeRelation(id, isa.getIndexSelection(id.getName()));
     }
+    if (prefixStatisticsRelations.count(id.getName()) > 0) {
+        res->enablePrefixStatistics();
+    }
     relations[idx] = mk<RelationHandle>(std::move(res));
 }
 
+double Engine::getCachedRelationSize(const RelationHandle* rel) {
+    {
+        std::lock_guard<std::mutex> guard(cachedRelationSizesLock);
+        auto it = cachedRelationSizes.find(rel);
+        if (it != cachedRelationSizes.end()) {
+            return it->second;
+        }
+    }
+    // count outside of the lock, as counting visits all nodes of an index; relations other than
+    // deltas do not change within an iteration, such that concurrent counts agree
+    const auto size = static_cast<double>((*rel)->size());
+    std::lock_guard<std::mutex> guard(cachedRelationSizesLock);
+    cachedRelationSizes.emplace(rel, size);
+    return size;
+}
+
+void Engine::clearCachedRelationSizes() {
+    std::lock_guard<std::mutex> guard(cachedRelationSizesLock);
+    cachedRelationSizes.clear();
+}
+
 const std::vector<void*>& Engine::loadDLL() {
     if (!dll.empty()) {
         return dll;
@@ -419,16 +525,6 @@ const std::vector<void*>& Engine::loadDLL() {
     return dll;
 }
 
-std::size_t Engine::getIterationNumber() const {
-    return iteration;
-}
-void Engine::incIterationNumber() {
-    ++iteration;
-}
-void Engine::resetIterationNumber() {
-    iteration = 0;
-}
-
 void Engine::executeMain() {
     SignalHandler::instance()->set();
     if (global.config().has("verbose")) {
@@ -445,6 +541,7 @@ void Engine::executeMain() {
     if (!profileEnabled) {
         Context ctxt;
         execute(main.get(), ctxt);
+        waitForOutputs();
     } else {
         ProfileEventSingleton::instance().setOutputFile(global.config().get("profile"));
         // Prepare the frequency table for threaded use
@@ -480,7 +577,17 @@ void Engine::executeMain() {
 
         Context ctxt;
         execute(main.get(), ctxt);
+        waitForOutputs();
         ProfileEventSingleton::instance().stopTimer();
+
+        // Store the memory held by the nodes of indexes
+        const auto& arenaStats = NodeArenaStatistics::instance();
+        ProfileEventSingleton::instance().makeConfigRecord(
+                "nodeArenaPeakBytes", std::to_string(arenaStats.getPeakBytes()));
+        ProfileEventSingleton::instance().makeConfigRecord(
+                "nodeArenaSlabs", std::to_string(arenaStats.getSlabs()));
+        ProfileEventSingleton::instance().makeConfigRecord(
+                "nodeArenaHugeSlabs", std::to_string(arenaStats.getHugeSlabs()));
         for (auto const& cur : frequencies) {
             for (std::size_t i = 0; i < cur.second.size(); ++i) {
                 ProfileEventSingleton::instance().makeQuantityEvent(
@@ -495,6 +602,15 @@ void Engine::executeMain() {
     SignalHandler::instance()->reset();
 }
 
+void Engine::waitForOutputs() {
+    try {
+        backgroundWriter.wait();
+    } catch (std::exception& e) {
+        std::cerr << e.what();
+        exit(EXIT_FAILURE);
+    }
+}
+
 void Engine::generateIR() {
     const ram::Program& program = tUnit.getProgram();
     NodeGenerator generator(*this);
@@ -972,19 +1088,21 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return !execute(shadow.getChild(), ctxt);
         ESAC(Negation)
 
-#define EMPTINESS_CHECK(Structure, Arity, ...)                          \
-    CASE(EmptinessCheck, Structure, Arity)                              \
-        const auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
-        return rel.empty();                                             \
+#define EMPTINESS_CHECK(Structure, Arity, ...)                    \
+    CASE(EmptinessCheck, Structure, Arity)                        \
+        auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
+        rel.seal();                                               \
+        return rel.empty();                                       \
     ESAC(EmptinessCheck)
 
         FOR_EACH(EMPTINESS_CHECK)
 #undef EMPTINESS_CHECK
 
-#define RELATION_SIZE(Structure, Arity, ...)                            \
-    CASE(RelationSize, Structure, Arity)                                \
-        const auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
-        return rel.size();                                              \
+#define RELATION_SIZE(Structure, Arity, ...)                      \
+    CASE(RelationSize, Structure, Arity)                          \
+        auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
+        rel.seal();                                               \
+        return rel.size();                                        \
     ESAC(RelationSize)
 
         FOR_EACH(RELATION_SIZE)
@@ -1110,13 +1228,13 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             bool result = execute(shadow.getChild(), ctxt);
 
             auto& currentFrequencies = frequencies[cur.getProfileText()];
-            while (currentFrequencies.size() <= getIterationNumber()) {
+            while (currentFrequencies.size() <= ctxt.getIterationNumber()) {
 #ifdef _OPENMP
 #pragma omp critical(frequencies)
 #endif
                 currentFrequencies.emplace_back(0);
             }
-            frequencies[cur.getProfileText()][getIterationNumber()]++;
+            frequencies[cur.getProfileText()][ctxt.getIterationNumber()]++;
 
             return result;
         ESAC(TupleOperation)
@@ -1209,6 +1327,77 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return execute(shadow.getNestedOperation(), ctxt);
         ESAC(UnpackRecord)
 
+        CASE(LeapfrogJoin)
+            const auto& inputs = shadow.getInputs();
+            const std::size_t count = inputs.size();
+
+            // the bounds of the inputs are fixed but for the sought column
+            std::vector<std::vector<RamDomain>> lows(count);
+            std::vector<std::vector<RamDomain>> highs(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto& superInfo = inputs[i].superInst;
+                auto& low = lows[i];
+                auto& high = highs[i];
+                low.resize(superInfo.first.size());
+                high.resize(superInfo.second.size());
+                TUPLE_COPY_FROM(low, superInfo.first);
+                TUPLE_COPY_FROM(high, superInfo.second);
+                for (const auto& tupleElement : superInfo.tupleFirst) {
+                    low[tupleElement[0]] = ctxt[tupleElement[1]][tupleElement[2]];
+                    high[tupleElement[0]] = low[tupleElement[0]];
+                }
+                for (const auto& expr : superInfo.exprFirst) {
+                    low[expr.first] = execute(expr.second.get(), ctxt);
+                    high[expr.first] = low[expr.first];
+                }
+            }
+
+            // seek the inputs in turn to the candidate value until all of them agree on it
+            RamDomain value = MIN_RAM_SIGNED;
+            ctxt[cur.getTupleId()] = &value;
+            std::size_t agree = 0;
+            for (std::size_t i = 0;; i = (i + 1) % count) {
+                const auto& input = inputs[i];
+                lows[i][input.column] = value;
+                RamDomain next;
+                if (!ctxt.getView(input.viewId)->seek(lows[i].data(), highs[i].data(), input.column, next)) {
+                    break;
+                }
+                agree = (next == value) ? agree + 1 : 1;
+                value = next;
+                if (agree < count) {
+                    continue;
+                }
+
+                if (!execute(shadow.getNestedOperation(), ctxt)) {
+                    break;
+                }
+                if (value == MAX_RAM_SIGNED) {
+                    break;
+                }
+                ++value;
+                agree = 0;
+            }
+            return true;
+        ESAC(LeapfrogJoin)
+
+        CASE(HashJoin)
+            const auto& children = shadow.getChildren();
+            std::vector<RamDomain> key(children.size());
+            for (std::size_t i = 0; i < children.size(); ++i) {
+                key[i] = execute(children[i].get(), ctxt);
+            }
+
+            const HashJoinTable* table = ctxt.getHashTable(shadow.getTableId());
+            for (auto cursor = table->probe(key.data()); cursor; ++cursor) {
+                ctxt[cur.getTupleId()] = *cursor;
+                if (!execute(shadow.getNestedOperation(), ctxt)) {
+                    break;
+                }
+            }
+            return true;
+        ESAC(HashJoin)
+
 #define PARALLEL_AGGREGATE(Structure, Arity, ...)                       \
     CASE(ParallelAggregate, Structure, Arity)                           \
         const auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
@@ -1261,10 +1450,10 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 
             if (profileEnabled && frequencyCounterEnabled && !cur.getProfileText().empty()) {
                 auto& currentFrequencies = frequencies[cur.getProfileText()];
-                while (currentFrequencies.size() <= getIterationNumber()) {
+                while (currentFrequencies.size() <= ctxt.getIterationNumber()) {
                     currentFrequencies.emplace_back(0);
                 }
-                frequencies[cur.getProfileText()][getIterationNumber()]++;
+                frequencies[cur.getProfileText()][ctxt.getIterationNumber()]++;
             }
             return result;
         ESAC(Filter)
@@ -1318,7 +1507,30 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Sequence)
 
         CASE(Parallel)
-            for (const auto& child : shadow.getChildren()) {
+            const auto& children = shadow.getChildren();
+#ifdef _OPENMP
+            // Independent statements are dispatched to their own threads, unless we are
+            // already nested inside a parallel region or there is nothing to overlap.
+            if (numOfThreads > 1 && children.size() > 1 && !omp_in_parallel()) {
+                const std::size_t numTasks = std::min(numOfThreads, children.size());
+                // split the thread budget between the tasks so that the nested parallel
+                // loops of each task do not oversubscribe the machine.
+                const int innerThreads = static_cast<int>(std::max<std::size_t>(1, numOfThreads / numTasks));
+                const int numChildren = static_cast<int>(children.size());
+                std::atomic<bool> result{true};
+#pragma omp parallel for schedule(dynamic) num_threads(numTasks)
+                for (int i = 0; i < numChildren; ++i) {
+                    omp_set_num_threads(innerThreads);
+                    // each task evaluates with its own context
+                    Context taskCtxt(ctxt);
+                    if (!execute(children[i].get(), taskCtxt)) {
+                        result = false;
+                    }
+                }
+                return result.load();
+            }
+#endif
+            for (const auto& child : children) {
                 if (!execute(child.get(), ctxt)) {
                     return false;
                 }
@@ -1326,12 +1538,50 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return true;
         ESAC(Parallel)
 
+        CASE(AdaptiveQuery)
+            // Execute the alternative with the least estimated cost for the current relation sizes,
+            // counting relations other than deltas once per loop iteration
+            const auto& plans = shadow.getPlans();
+            std::map<const RelationHandle*, double> sizes;
+            std::size_t best = 0;
+            double bestCost = std::numeric_limits<double>::infinity();
+            for (std::size_t i = 0; i < plans.size(); ++i) {
+                double cost = 0;
+                double tuples = 1;
+                for (const auto& step : plans[i]) {
+                    auto it = sizes.find(step.relation);
+                    if (it == sizes.end()) {
+                        const double size = step.delta ? static_cast<double>((*step.relation)->size())
+                                                       : getCachedRelationSize(step.relation);
+                        it = sizes.emplace(step.relation, size).first;
+                    }
+                    tuples *= std::pow(it->second, step.exponent);
+                    cost += tuples;
+                }
+                if (cost < bestCost) {
+                    best = i;
+                    bestCost = cost;
+                }
+            }
+            return execute(shadow.getChild(best), ctxt);
+        ESAC(AdaptiveQuery)
+
         CASE(Loop)
-            resetIterationNumber();
-            while (execute(shadow.getChild(), ctxt)) {
-                incIterationNumber();
+            if (const auto* eager = shadow.getEagerEvaluation()) {
+                // eager loops grow their relations throughout, such that sizes are counted once
+                clearCachedRelationSizes();
+                evalEagerLoop(*eager, ctxt);
+                return true;
             }
-            resetIterationNumber();
+            ctxt.resetIterationNumber();
+            while (true) {
+                clearCachedRelationSizes();
+                if (!execute(shadow.getChild(), ctxt)) {
+                    break;
+                }
+                ctxt.incIterationNumber();
+            }
+            ctxt.resetIterationNumber();
             return true;
         ESAC(Loop)
 
@@ -1340,13 +1590,15 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Exit)
 
         CASE(LogRelationTimer)
-            Logger logger(cur.getMessage(), getIterationNumber(),
-                    std::bind(&RelationWrapper::size, shadow.getRelation()));
+            Logger logger(cur.getMessage(), ctxt.getIterationNumber(), [rel = shadow.getRelation()]() {
+                rel->seal();
+                return rel->size();
+            });
             return execute(shadow.getChild(), ctxt);
         ESAC(LogRelationTimer)
 
         CASE(LogTimer)
-            Logger logger(cur.getMessage(), getIterationNumber());
+            Logger logger(cur.getMessage(), ctxt.getIterationNumber());
             return execute(shadow.getChild(), ctxt);
         ESAC(LogTimer)
 
@@ -1355,11 +1607,11 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return execute(shadow.getChild(), ctxt);
         ESAC(DebugInfo)
 
-#define CLEAR(Structure, Arity, ...)                              \
-    CASE(Clear, Structure, Arity)                                 \
-        auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
-        rel.__purge();                                            \
-        return true;                                              \
+#define CLEAR(Structure, Arity, ...)                                                   \
+    CASE(Clear, Structure, Arity)                                                      \
+        auto& rel = *static_cast<RelType*>(shadow.getRelation());                      \
+        backgroundWriter.afterWrites(shadow.getRelation(), [&rel]() { rel.__purge(); }); \
+        return true;                                                                   \
     ESAC(Clear)
 
         FOR_EACH(CLEAR)
@@ -1380,9 +1632,10 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Call)
 
         CASE(LogSize)
-            const auto& rel = *shadow.getRelation();
+            auto& rel = *shadow.getRelation();
+            rel.seal();
             ProfileEventSingleton::instance().makeQuantityEvent(
-                    cur.getMessage(), rel.size(), static_cast<int>(getIterationNumber()));
+                    cur.getMessage(), rel.size(), static_cast<int>(ctxt.getIterationNumber()));
             return true;
         ESAC(LogSize)
 
@@ -1403,9 +1656,7 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                 return true;
             } else if (op == "output" || op == "printsize") {
                 try {
-                    IOSystem::getInstance()
-                            .getWriter(directive, getSymbolTable(), getRecordTable())
-                            ->writeAll(rel);
+                    backgroundWriter.writeAll(directive, getSymbolTable(), getRecordTable(), rel);
                 } catch (std::exception& e) {
                     std::cerr << e.what();
                     exit(EXIT_FAILURE);
@@ -1451,10 +1702,26 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                     ctxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
                 }
             }
+
+            // Build hash tables for hash joins, which are shared by parallel instructions.
+            for (auto& info : viewContext->getHashTableInfo()) {
+                ctxt.createHashTable(*getRelationHandle(info.relId), info.keyColumns, info.tablePos);
+            }
+
             execute(shadow.getChild(), ctxt);
+            ctxt.clearHashTables();
             return true;
         ESAC(Query)
 
+#define MERGE(Structure, Arity, ...)                                                       \
+    CASE(Merge, Structure, Arity)                                                          \
+        auto& rel = *static_cast<RelType*>(getRelationHandle(shadow.getTargetId()).get()); \
+        return evalMerge(rel, shadow);                                                     \
+    ESAC(Merge)
+
+        FOR_EACH(MERGE)
+#undef MERGE
+
         CASE(MergeExtend)
             auto& src = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getSourceId()).get());
             auto& trg = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getTargetId()).get());
@@ -1476,7 +1743,6 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 
 template <typename Rel>
 RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt) {
-    constexpr std::size_t Arity = Rel::Arity;
     std::size_t viewPos = shadow.getViewId();
 
     if (profileEnabled && !shadow.isTemp()) {
@@ -1486,7 +1752,7 @@ RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt
     const auto& superInfo = shadow.getSuperInst();
     // for total we use the exists test
     if (shadow.isTotalSearch()) {
-        souffle::Tuple<RamDomain, Arity> tuple;
+        auto tuple = Rel::createTuple(superInfo.first.size());
         TUPLE_COPY_FROM(tuple, superInfo.first);
         /* TupleElement */
         for (const auto& tupleElement : superInfo.tupleFirst) {
@@ -1500,8 +1766,8 @@ RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt
     }
 
     // for partial we search for lower and upper boundaries
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = Rel::createTuple(superInfo.first.size());
+    auto high = Rel::createTuple(superInfo.first.size());
     TUPLE_COPY_FROM(low, superInfo.first);
     TUPLE_COPY_FROM(high, superInfo.second);
 
@@ -1610,8 +1876,6 @@ RamDomain Engine::evalParallelScan(
 template <typename Rel>
 RamDomain Engine::evalEstimateJoinSize(
         const Rel& rel, const ram::EstimateJoinSize& cur, const EstimateJoinSize& shadow, Context& ctxt) {
-    (void)ctxt;
-    constexpr std::size_t Arity = Rel::Arity;
     bool onlyConstants = true;
 
     for (auto col : cur.getKeyColumns()) {
@@ -1621,10 +1885,6 @@ RamDomain Engine::evalEstimateJoinSize(
         }
     }
 
-    // save a copy of the columns and index
-    std::vector<std::size_t> keyColumns(cur.getKeyColumns().size());
-    std::iota(keyColumns.begin(), keyColumns.end(), 0);
-
     std::size_t indexPos = shadow.getViewId();
     auto order = rel.getIndexOrder(indexPos);
 
@@ -1656,38 +1916,12 @@ RamDomain Engine::evalEstimateJoinSize(
         keyConstants[inverseOrder[k]] = value;
     }
 
-    // ensure range is non-empty
-    auto* index = rel.getIndex(indexPos);
-    // initial values
-    double total = 0;
-    double duplicates = 0;
-
-    if (!index->scan().empty()) {
-        // assign first tuple as prev as a dummy
-        bool first = true;
-        Tuple<RamDomain, Arity> prev = *index->scan().begin();
-
-        for (const auto& tuple : index->scan()) {
-            // only if every constant matches do we consider the tuple
-            bool matchesConstants = std::all_of(keyConstants.begin(), keyConstants.end(),
-                    [tuple](const auto& p) { return tuple[p.first] == p.second; });
-            if (!matchesConstants) {
-                continue;
-            }
-            if (first) {
-                first = false;
-            } else {
-                // only if on every column do we have a match do we consider it a duplicate
-                bool matchesPrev = std::all_of(keyColumns.begin(), keyColumns.end(),
-                        [&prev, &tuple](std::size_t column) { return tuple[column] == prev[column]; });
-                if (matchesPrev) {
-                    ++duplicates;
-                }
-            }
-            prev = tuple;
-            ++total;
-        }
-    }
+    auto low = Rel::createTuple(order.size());
+    auto high = Rel::createTuple(order.size());
+    std::fill(low.begin(), low.end(), MIN_RAM_SIGNED);
+    std::fill(high.begin(), high.end(), MAX_RAM_SIGNED);
+    const auto [total, duplicates] = countJoinSize(*rel.getIndex(indexPos), low, high,
+            cur.getKeyColumns().size(), keyConstants, joinSizeSampleSize);
     double joinSize = (onlyConstants ? total : total / std::max(1.0, (total - duplicates)));
 
     std::stringstream columnsStream;
@@ -1712,7 +1946,8 @@ RamDomain Engine::evalEstimateJoinSize(
     if (cur.isRecursiveRelation()) {
         std::string txt =
                 "@recursive-estimate-join-size;" + cur.getRelation() + ";" + columns + ";" + constants;
-        ProfileEventSingleton::instance().makeRecursiveCountEvent(txt, joinSize, getIterationNumber());
+        ProfileEventSingleton::instance().makeRecursiveCountEvent(
+                txt, joinSize, ctxt.getIterationNumber());
     } else {
         std::string txt =
                 "@non-recursive-estimate-join-size;" + cur.getRelation() + ";" + columns + ";" + constants;
@@ -1723,11 +1958,10 @@ RamDomain Engine::evalEstimateJoinSize(
 
 template <typename Rel>
 RamDomain Engine::evalIndexScan(const ram::IndexScan& cur, const IndexScan& shadow, Context& ctxt) {
-    constexpr std::size_t Arity = Rel::Arity;
     // create pattern tuple for range query
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = Rel::createTuple(superInfo.first.size());
+    auto high = Rel::createTuple(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t viewId = shadow.getViewId();
@@ -1748,10 +1982,9 @@ RamDomain Engine::evalParallelIndexScan(
     auto viewContext = shadow.getViewContext();
 
     // create pattern tuple for range query
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = Rel::createTuple(superInfo.first.size());
+    auto high = Rel::createTuple(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t indexPos = shadow.getViewId();
@@ -1830,10 +2063,9 @@ RamDomain Engine::evalParallelIfExists(
 template <typename Rel>
 RamDomain Engine::evalIndexIfExists(
         const ram::IndexIfExists& cur, const IndexIfExists& shadow, Context& ctxt) {
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = Rel::createTuple(superInfo.first.size());
+    auto high = Rel::createTuple(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t viewId = shadow.getViewId();
@@ -1857,10 +2089,9 @@ RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelI
     auto viewInfo = viewContext->getViewInfoForNested();
 
     // create pattern tuple for range query
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = Rel::createTuple(superInfo.first.size());
+    auto high = Rel::createTuple(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t indexPos = shadow.getViewId();
@@ -2065,11 +2296,10 @@ RamDomain Engine::evalParallelIndexAggregate(
         newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
     }
     // init temporary tuple for this level
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
     // get lower and upper boundaries for iteration
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = Rel::createTuple(superInfo.first.size());
+    auto high = Rel::createTuple(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t viewId = shadow.getViewId();
@@ -2082,10 +2312,9 @@ template <typename Rel>
 RamDomain Engine::evalIndexAggregate(
         const ram::IndexAggregate& cur, const IndexAggregate& shadow, Context& ctxt) {
     // init temporary tuple for this level
-    const std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = Rel::createTuple(superInfo.first.size());
+    auto high = Rel::createTuple(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t viewId = shadow.getViewId();
@@ -2096,9 +2325,8 @@ RamDomain Engine::evalIndexAggregate(
 
 template <typename Rel>
 RamDomain Engine::evalInsert(Rel& rel, const Insert& shadow, Context& ctxt) {
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> tuple;
+    auto tuple = Rel::createTuple(superInfo.first.size());
     TUPLE_COPY_FROM(tuple, superInfo.first);
 
     /* TupleElement */
@@ -2110,8 +2338,12 @@ RamDomain Engine::evalInsert(Rel& rel, const Insert& shadow, Context& ctxt) {
         tuple[expr.first] = execute(expr.second.get(), ctxt);
     }
 
-    // insert in target relation
-    rel.insert(tuple);
+    // insert in target relation, or buffer it until the relation is sealed
+    if (shadow.isBuffered()) {
+        rel.append(tuple);
+    } else {
+        rel.insert(tuple);
+    }
     return true;
 }
 
@@ -2136,15 +2368,214 @@ RamDomain Engine::evalErase(Rel& rel, const Erase& shadow, Context& ctxt) {
     return true;
 }
 
+template <typename Rel>
+RamDomain Engine::evalMerge(Rel& rel, const Merge& shadow) {
+    auto& source = *getRelationHandle(shadow.getSourceId());
+    source.seal();
+    rel.seal();
+    const std::size_t partitionCount = numOfThreads * 20;
+    if (const auto* src = as<Rel>(source)) {
+        rel.insertAll(*src, partitionCount);
+        return true;
+    }
+
+    // the auxiliary relations of subsumptive relations do not support deletion, delta relations
+    // may be stored in sorted arrays, and the relations of a fixpoint may be stored in hash sets
+    constexpr std::size_t Arity = Rel::Arity;
+    if constexpr (std::is_same_v<Rel, Relation<Arity, Btree>> ||
+                  std::is_same_v<Rel, Relation<Arity, CompressedBtree>> ||
+                  std::is_same_v<Rel, Relation<Arity, BtreeDelete>> ||
+                  std::is_same_v<Rel, Relation<Arity, SortedArray>> ||
+                  std::is_same_v<Rel, Relation<Arity, HashSet>>) {
+        if (const auto* src = as<Relation<Arity, Btree>>(source)) {
+            rel.insertAll(*src, partitionCount);
+        } else if (const auto* src = as<Relation<Arity, CompressedBtree>>(source)) {
+            rel.insertAll(*src, partitionCount);
+        } else if (const auto* src = as<Relation<Arity, BtreeDelete>>(source)) {
+            rel.insertAll(*src, partitionCount);
+        } else if (const auto* src = as<Relation<Arity, SortedArray>>(source)) {
+            rel.insertAll(*src, partitionCount);
+        } else {
+            rel.insertAll(asAssert<Relation<Arity, HashSet>>(source), partitionCount);
+        }
+    } else {
+        fatal("cannot merge relations of different data structures");
+    }
+    return true;
+}
+
+void Engine::evalEagerLoop(const EagerEvaluation& eager, Context& ctxt) {
+    const std::size_t numRelations = eager.full.size();
+    std::vector<std::size_t> arities;
+    for (const auto* rel : eager.full) {
+        arities.push_back((*rel)->getArity());
+    }
+
+    std::size_t numWorkers = 1;
+#ifdef _OPENMP
+    if (eager.workers.size() > 1 && !omp_in_parallel()) {
+        numWorkers = eager.workers.size();
+    }
+#endif
+
+    // Each worker propagates the tuples of its own queue, and steals from the others when it
+    // runs out. Tuples are stored back to back, each followed by the position of its relation.
+    struct Queue {
+        std::mutex lock;
+        std::vector<RamDomain> tuples;
+        std::size_t size = 0;
+    };
+    std::vector<Queue> queues(numWorkers);
+    // the number of tuples in all queues
+    std::atomic<std::size_t> queued{0};
+
+    // moves a batch of tuples from the back of the given queue, at most half of them if stolen
+    auto take = [&](Queue& queue, bool steal, std::vector<RamDomain>& batch) {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        const std::size_t count = steal ? std::min(EagerBatchSize, (queue.size + 1) / 2) : EagerBatchSize;
+        std::size_t taken = 0;
+        for (; taken < count && queue.size > 0; ++taken, --queue.size) {
+            const auto k = static_cast<std::size_t>(queue.tuples.back());
+            const auto start = queue.tuples.end() - 1 - arities[k];
+            batch.insert(batch.end(), start, queue.tuples.end());
+            queue.tuples.erase(start, queue.tuples.end());
+        }
+        queued -= taken;
+        return taken;
+    };
+
+    for (std::size_t k = 0, next = 0; k < numRelations; ++k) {
+        for (const RamDomain* tuple : **eager.seed[k]) {
+            auto& queue = queues[next++ % numWorkers];
+            queue.tuples.insert(queue.tuples.end(), tuple, tuple + arities[k]);
+            queue.tuples.push_back(static_cast<RamDomain>(k));
+            ++queue.size;
+            ++queued;
+        }
+    }
+
+    // Rules only read the relations of the stratum while no worker publishes new tuples
+    std::shared_mutex relationLock;
+    // Workers without tuples to propagate wait until some are queued, or all workers are idle
+    std::mutex idleLock;
+    std::condition_variable wakeUp;
+    std::atomic<std::size_t> idle{0};
+    bool done = false;
+
+    auto work = [&](const EagerEvaluation::Worker& worker, std::size_t id) {
+        std::vector<RamDomain> batch;
+        std::vector<RamDomain> fresh;
+        std::vector<bool> touched(numRelations);
+        for (;;) {
+            // take a batch from the own queue, or steal half of the queue of another worker
+            batch.clear();
+            if (take(queues[id], false, batch) == 0) {
+                for (std::size_t i = 1; i < numWorkers && batch.empty(); ++i) {
+                    take(queues[(id + i) % numWorkers], true, batch);
+                }
+            }
+            if (batch.empty()) {
+                std::unique_lock<std::mutex> idleGuard(idleLock);
+                if (queued > 0) {
+                    continue;
+                }
+                // terminate once no other worker can produce new tuples
+                if (++idle == numWorkers) {
+                    done = true;
+                    wakeUp.notify_all();
+                    return;
+                }
+                wakeUp.wait(idleGuard, [&]() { return done || queued > 0; });
+                if (done) {
+                    return;
+                }
+                --idle;
+                continue;
+            }
+
+            // evaluate the rules reading a delta relation once on all tuples of the batch
+            for (auto it = batch.end(); it != batch.begin();) {
+                const auto k = static_cast<std::size_t>(*(it - 1));
+                it -= 1 + arities[k];
+                (**worker.delta[k]).insert(&*it);
+                touched[k] = true;
+            }
+            {
+                std::shared_lock<std::shared_mutex> readGuard(relationLock);
+                for (std::size_t k = 0; k < numRelations; ++k) {
+                    if (touched[k]) {
+                        for (const auto& rule : worker.rules[k]) {
+                            Context ruleCtxt(ctxt);
+                            execute(rule.get(), ruleCtxt);
+                        }
+                    }
+                }
+            }
+            for (std::size_t k = 0; k < numRelations; ++k) {
+                if (touched[k]) {
+                    (**worker.delta[k]).purge();
+                    touched[k] = false;
+                }
+            }
+
+            // publish the tuples derived from the batch at once, and queue the ones not known yet
+            fresh.clear();
+            std::size_t numFresh = 0;
+            {
+                std::unique_lock<std::shared_mutex> writeGuard(relationLock);
+                for (std::size_t j = 0; j < numRelations; ++j) {
+                    auto& derived = **worker.derived[j];
+                    auto& full = **eager.full[j];
+                    for (const RamDomain* derivedTuple : derived) {
+                        if (!full.contains(derivedTuple)) {
+                            full.insert(derivedTuple);
+                            fresh.insert(fresh.end(), derivedTuple, derivedTuple + arities[j]);
+                            fresh.push_back(static_cast<RamDomain>(j));
+                            ++numFresh;
+                        }
+                    }
+                    derived.purge();
+                }
+            }
+            if (numFresh > 0) {
+                {
+                    auto& queue = queues[id];
+                    std::lock_guard<std::mutex> guard(queue.lock);
+                    queue.tuples.insert(queue.tuples.end(), fresh.begin(), fresh.end());
+                    queue.size += numFresh;
+                    queued += numFresh;
+                }
+                if (idle > 0) {
+                    std::lock_guard<std::mutex> idleGuard(idleLock);
+                    wakeUp.notify_all();
+                }
+            }
+        }
+    };
+
+#ifdef _OPENMP
+    if (numWorkers > 1) {
+#pragma omp parallel num_threads(numWorkers)
+        {
+            // the workers occupy all threads, so parallel operations of the rules run sequentially
+            omp_set_num_threads(1);
+            const std::size_t id = omp_get_thread_num();
+            work(eager.workers[id], id);
+        }
+        return;
+    }
+#endif
+    work(eager.workers.front(), 0);
+}
+
 template <typename Rel>
 RamDomain Engine::evalGuardedInsert(Rel& rel, const GuardedInsert& shadow, Context& ctxt) {
     if (!execute(shadow.getCondition(), ctxt)) {
         return true;
     }
 
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> tuple;
+    auto tuple = Rel::createTuple(superInfo.first.size());
     TUPLE_COPY_FROM(tuple, superInfo.first);
 
     /* TupleElement */
@@ -30,13 +30,16 @@
 #include "souffle/datastructure/ConcurrentCache.h"
 #include "souffle/datastructure/RecordTableImpl.h"
 #include "souffle/datastructure/SymbolTableImpl.h"
+#include "souffle/io/BackgroundWriter.h"
 #include "souffle/utility/ContainerUtil.h"
 #include <atomic>
 #include <cstddef>
 #include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <regex>
+#include <set>
 #include <string>
 #include <vector>
 #ifdef _OPENMP
@@ -78,6 +81,8 @@ public:
 private:
     /** @brief Generate intermediate representation from RAM */
     void generateIR();
+    /** @brief Wait for the outputs written in the background, exiting on errors */
+    void waitForOutputs();
     /** @brief Remove a relation from the environment */
     void dropRelation(const std::size_t relId);
     /** @brief Swap the content of two relations */
@@ -92,18 +97,16 @@ private:
     void* getMethodHandle(const std::string& method);
     /** @brief Load DLL */
     const std::vector<void*>& loadDLL();
-    /** @brief Return current iteration number for loop operation */
-    std::size_t getIterationNumber() const;
-    /** @brief Increase iteration number by one */
-    void incIterationNumber();
-    /** @brief Reset iteration number */
-    void resetIterationNumber();
     /** @brief Increment the counter */
     RamDomain incCounter();
     /** @brief Return the relation map. */
     VecOwn<RelationHandle>& getRelationMap();
     /** @brief Create and add relation into the runtime environment.  */
     void createRelation(const ram::Relation& id, const std::size_t idx);
+    /** @brief Return the size of a relation other than a delta, counted once per loop iteration */
+    double getCachedRelationSize(const RelationHandle* rel);
+    /** @brief Drop the cached relation sizes, as the relations may have changed */
+    void clearCachedRelationSizes();
 
     // -- Defines template for specialized interpreter operation -- */
     template <typename Rel>
@@ -171,6 +174,12 @@ private:
     template <typename Rel>
     RamDomain evalErase(Rel& rel, const Erase& shadow, Context& ctxt);
 
+    template <typename Rel>
+    RamDomain evalMerge(Rel& rel, const Merge& shadow);
+
+    /** @brief Evaluate a recursive loop by propagating new tuples one at a time */
+    void evalEagerLoop(const EagerEvaluation& eager, Context& ctxt);
+
     /** Program */
     ram::TranslationUnit& tUnit;
     /** Global */
@@ -178,16 +187,22 @@ private:
     /** If profile is enable in this program */
     const bool profileEnabled;
     const bool frequencyCounterEnabled;
+    /** Number of tuples sampled to estimate a join size, zero for a full scan */
+    const std::size_t joinSizeSampleSize;
+    /** Relations maintaining the number of distinct prefixes of their indexes */
+    const std::set<std::string> prefixStatisticsRelations;
     /** subroutines */
     std::map<std::string /*name*/, Own<Node>> subroutine;
     /** main program */
     Own<Node> main;
     /** Number of threads enabled for this program */
     std::size_t numOfThreads;
+    /** Sizes of relations counted by adaptive queries, cleared whenever a loop iteration starts */
+    std::map<const RelationHandle*, double> cachedRelationSizes;
+    /** Lock of the cached relation sizes, shared by the strata evaluated concurrently */
+    std::mutex cachedRelationSizesLock;
     /** Profile counter */
     std::atomic<RamDomain> counter{0};
-    /** Loop iteration counter */
-    std::size_t iteration = 0;
     /** Profile for rule frequencies */
     std::map<std::string, std::deque<std::atomic<std::size_t>>> frequencies;
     /** Profile for relation reads */
@@ -204,6 +219,8 @@ private:
     SymbolTableImpl symbolTable;
     /** A cache for regexes */
     ConcurrentCache<std::string, std::regex> regexCache;
+    /** Writer of output relations, declared last to finish its writes before relations are destroyed */
+    BackgroundWriter backgroundWriter;
 };
 
 }  // namespace souffle::interpreter
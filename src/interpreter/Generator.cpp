@@ -16,6 +16,7 @@
 #include "interpreter/Generator.h"
 #include "interpreter/Engine.h"
 #include "ram/UserDefinedAggregator.h"
+#include "souffle/utility/StringUtil.h"
 
 namespace souffle::interpreter {
 
@@ -23,7 +24,11 @@ using NodePtr = Own<Node>;
 using NodePtrVec = std::vector<NodePtr>;
 using RelationHandle = Own<RelationWrapper>;
 
-NodeGenerator::NodeGenerator(Engine& engine) : engine(engine), global(engine.getGlobal()) {
+NodeGenerator::NodeGenerator(Engine& engine)
+        : appendOnly(engine.tUnit.getAnalysis<ram::analysis::AppendOnlyAnalysis>()),
+          sortedDelta(engine.tUnit.getAnalysis<ram::analysis::SortedDeltaAnalysis>()),
+          indexAnalysis(engine.tUnit.getAnalysis<ram::analysis::IndexAnalysis>()), engine(engine),
+          global(engine.getGlobal()) {
     visit(engine.tUnit.getProgram(), [&](const ram::Relation& relation) {
         assert(relationMap.find(relation.getName()) == relationMap.end() && "double-naming of relations");
         relationMap[relation.getName()] = &relation;
@@ -42,6 +47,9 @@ NodePtr NodeGenerator::generateTree(const ram::Node& root) {
         } else if (const auto* indexSearch = as<ram::IndexOperation>(node)) {
             encodeIndexPos(*indexSearch);
             encodeView(indexSearch);
+        } else if (const auto* input = as<ram::LeapfrogInput>(node)) {
+            encodeIndexPos(*input);
+            encodeView(input);
         } else if (const auto* exists = as<ram::ExistenceCheck>(node)) {
             encodeIndexPos(*exists);
             encodeView(exists);
@@ -206,14 +214,14 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Negation>, const ram::Negation&
 NodePtr NodeGenerator::visit_(type_identity<ram::EmptinessCheck>, const ram::EmptinessCheck& emptiness) {
     std::size_t relId = encodeRelation(emptiness.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "EmptinessCheck", lookup(emptiness.getRelation()));
+    NodeType type = constructNodeType("EmptinessCheck", lookup(emptiness.getRelation()));
     return mk<EmptinessCheck>(type, &emptiness, rel);
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::RelationSize>, const ram::RelationSize& size) {
     std::size_t relId = encodeRelation(size.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "RelationSize", lookup(size.getRelation()));
+    NodeType type = constructNodeType("RelationSize", lookup(size.getRelation()));
     return mk<RelationSize>(type, &size, rel);
 }
 
@@ -227,7 +235,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::ExistenceCheck>, const ram::Exi
         }
     }
     const auto& ramRelation = lookup(exists.getRelation());
-    NodeType type = constructNodeType(global, "ExistenceCheck", ramRelation);
+    NodeType type = constructNodeType("ExistenceCheck", ramRelation);
     return mk<ExistenceCheck>(type, &exists, isTotal, encodeView(&exists), std::move(superOp),
             ramRelation.isTemp(), ramRelation.getName());
 }
@@ -235,7 +243,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::ExistenceCheck>, const ram::Exi
 NodePtr NodeGenerator::visit_(
         type_identity<ram::ProvenanceExistenceCheck>, const ram::ProvenanceExistenceCheck& provExists) {
     SuperInstruction superOp = getExistenceSuperInstInfo(provExists);
-    NodeType type = constructNodeType(global, "ProvenanceExistenceCheck", lookup(provExists.getRelation()));
+    NodeType type = constructNodeType("ProvenanceExistenceCheck", lookup(provExists.getRelation()));
     return mk<ProvenanceExistenceCheck>(type, &provExists, dispatch(*(--provExists.getChildNodes().end())),
             encodeView(&provExists), std::move(superOp));
 }
@@ -281,7 +289,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Scan>, const ram::Scan& scan) {
     orderingContext.addTupleWithDefaultOrder(scan.getTupleId(), scan);
     std::size_t relId = encodeRelation(scan.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "Scan", lookup(scan.getRelation()));
+    NodeType type = constructNodeType("Scan", lookup(scan.getRelation()));
     return mk<Scan>(type, &scan, rel, visit_(type_identity<ram::TupleOperation>(), scan));
 }
 
@@ -289,7 +297,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::ParallelScan>, const ram::Paral
     orderingContext.addTupleWithDefaultOrder(pScan.getTupleId(), pScan);
     std::size_t relId = encodeRelation(pScan.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "ParallelScan", lookup(pScan.getRelation()));
+    NodeType type = constructNodeType("ParallelScan", lookup(pScan.getRelation()));
     auto res = mk<ParallelScan>(type, &pScan, rel, visit_(type_identity<ram::TupleOperation>(), pScan));
     res->setViewContext(parentQueryViewContext);
     return res;
@@ -298,7 +306,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::ParallelScan>, const ram::Paral
 NodePtr NodeGenerator::visit_(type_identity<ram::IndexScan>, const ram::IndexScan& iScan) {
     orderingContext.addTupleWithIndexOrder(iScan.getTupleId(), iScan);
     SuperInstruction indexOperation = getIndexSuperInstInfo(iScan);
-    NodeType type = constructNodeType(global, "IndexScan", lookup(iScan.getRelation()));
+    NodeType type = constructNodeType("IndexScan", lookup(iScan.getRelation()));
     return mk<IndexScan>(type, &iScan, nullptr, visit_(type_identity<ram::TupleOperation>(), iScan),
             encodeView(&iScan), std::move(indexOperation));
 }
@@ -308,7 +316,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::ParallelIndexScan>, const ram::
     SuperInstruction indexOperation = getIndexSuperInstInfo(piscan);
     std::size_t relId = encodeRelation(piscan.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "ParallelIndexScan", lookup(piscan.getRelation()));
+    NodeType type = constructNodeType("ParallelIndexScan", lookup(piscan.getRelation()));
     auto res = mk<ParallelIndexScan>(type, &piscan, rel, visit_(type_identity<ram::TupleOperation>(), piscan),
             encodeIndexPos(piscan), std::move(indexOperation));
     res->setViewContext(parentQueryViewContext);
@@ -319,7 +327,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::IfExists>, const ram::IfExists&
     orderingContext.addTupleWithDefaultOrder(ifexists.getTupleId(), ifexists);
     std::size_t relId = encodeRelation(ifexists.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "IfExists", lookup(ifexists.getRelation()));
+    NodeType type = constructNodeType("IfExists", lookup(ifexists.getRelation()));
     return mk<IfExists>(type, &ifexists, rel, dispatch(ifexists.getCondition()),
             visit_(type_identity<ram::TupleOperation>(), ifexists));
 }
@@ -328,7 +336,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::ParallelIfExists>, const ram::P
     orderingContext.addTupleWithDefaultOrder(pIfExists.getTupleId(), pIfExists);
     std::size_t relId = encodeRelation(pIfExists.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "ParallelIfExists", lookup(pIfExists.getRelation()));
+    NodeType type = constructNodeType("ParallelIfExists", lookup(pIfExists.getRelation()));
     auto res = mk<ParallelIfExists>(type, &pIfExists, rel, dispatch(pIfExists.getCondition()),
             visit_(type_identity<ram::TupleOperation>(), pIfExists));
     res->setViewContext(parentQueryViewContext);
@@ -338,7 +346,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::ParallelIfExists>, const ram::P
 NodePtr NodeGenerator::visit_(type_identity<ram::IndexIfExists>, const ram::IndexIfExists& iIfExists) {
     orderingContext.addTupleWithIndexOrder(iIfExists.getTupleId(), iIfExists);
     SuperInstruction indexOperation = getIndexSuperInstInfo(iIfExists);
-    NodeType type = constructNodeType(global, "IndexIfExists", lookup(iIfExists.getRelation()));
+    NodeType type = constructNodeType("IndexIfExists", lookup(iIfExists.getRelation()));
     return mk<IndexIfExists>(type, &iIfExists, nullptr, dispatch(iIfExists.getCondition()),
             visit_(type_identity<ram::TupleOperation>(), iIfExists), encodeView(&iIfExists),
             std::move(indexOperation));
@@ -350,7 +358,7 @@ NodePtr NodeGenerator::visit_(
     SuperInstruction indexOperation = getIndexSuperInstInfo(piIfExists);
     std::size_t relId = encodeRelation(piIfExists.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "ParallelIndexIfExists", lookup(piIfExists.getRelation()));
+    NodeType type = constructNodeType("ParallelIndexIfExists", lookup(piIfExists.getRelation()));
     auto res = mk<ParallelIndexIfExists>(type, &piIfExists, rel, dispatch(piIfExists.getCondition()),
             dispatch(piIfExists.getOperation()), encodeIndexPos(piIfExists), std::move(indexOperation));
     res->setViewContext(parentQueryViewContext);
@@ -364,6 +372,33 @@ NodePtr NodeGenerator::visit_(
             visit_(type_identity<ram::TupleOperation>(), unpack));
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::LeapfrogJoin>, const ram::LeapfrogJoin& leapfrog) {
+    std::vector<LeapfrogJoin::Input> inputs;
+    for (const auto* input : leapfrog.getInputs()) {
+        std::size_t indexId = encodeIndexPos(*input);
+        auto order = (*getRelationHandle(encodeRelation(input->getRelation())))->getIndexOrder(indexId);
+        std::size_t column = 0;
+        while (order[column] != input->getColumn()) {
+            ++column;
+        }
+        inputs.emplace_back(encodeView(input), column,
+                getPatternSuperInstInfo(input->getRelation(), indexId, input->getValues()));
+    }
+    orderingContext.addNewTuple(leapfrog.getTupleId(), 1);
+    return mk<LeapfrogJoin>(I_LeapfrogJoin, &leapfrog, std::move(inputs),
+            visit_(type_identity<ram::TupleOperation>(), leapfrog));
+}
+
+NodePtr NodeGenerator::visit_(type_identity<ram::HashJoin>, const ram::HashJoin& hashJoin) {
+    orderingContext.addNewTuple(hashJoin.getTupleId(), lookup(hashJoin.getRelation()).getArity());
+    NodePtrVec keyValues;
+    for (const auto* value : hashJoin.getKeyValues()) {
+        keyValues.push_back(dispatch(*value));
+    }
+    return mk<HashJoin>(I_HashJoin, &hashJoin, hashJoin.getTupleId(), std::move(keyValues),
+            visit_(type_identity<ram::TupleOperation>(), hashJoin));
+}
+
 NodePtr NodeGenerator::mkInit(const ram::AbstractAggregate& aggregate) {
     const ram::Aggregator& aggregator = aggregate.getAggregator();
     if (const auto* uda = as<ram::UserDefinedAggregator>(aggregator)) {
@@ -399,7 +434,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Aggregate>, const ram::Aggregat
     NodePtr nested = visit_(type_identity<ram::TupleOperation>(), aggregate);
     std::size_t relId = encodeRelation(aggregate.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "Aggregate", lookup(aggregate.getRelation()));
+    NodeType type = constructNodeType("Aggregate", lookup(aggregate.getRelation()));
 
     /* Resolve functor to actual function pointer now */
     void* functionPtr = resolveFunctionPointers(aggregate);
@@ -418,7 +453,7 @@ NodePtr NodeGenerator::visit_(
     NodePtr nested = visit_(type_identity<ram::TupleOperation>(), pAggregate);
     std::size_t relId = encodeRelation(pAggregate.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "ParallelAggregate", lookup(pAggregate.getRelation()));
+    NodeType type = constructNodeType("ParallelAggregate", lookup(pAggregate.getRelation()));
     /* Resolve functor to actual function pointer now */
     void* functionPtr = resolveFunctionPointers(pAggregate);
     auto res = mk<ParallelAggregate>(type, &pAggregate, rel, std::move(expr), std::move(cond),
@@ -438,7 +473,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::IndexAggregate>, const ram::Ind
     NodePtr nested = visit_(type_identity<ram::TupleOperation>(), iAggregate);
     std::size_t relId = encodeRelation(iAggregate.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "IndexAggregate", lookup(iAggregate.getRelation()));
+    NodeType type = constructNodeType("IndexAggregate", lookup(iAggregate.getRelation()));
     /* Resolve functor to actual function pointer now */
     void* functionPtr = resolveFunctionPointers(iAggregate);
     return mk<IndexAggregate>(type, &iAggregate, rel, std::move(expr), std::move(cond), std::move(nested),
@@ -456,7 +491,7 @@ NodePtr NodeGenerator::visit_(
     NodePtr nested = visit_(type_identity<ram::TupleOperation>(), piAggregate);
     std::size_t relId = encodeRelation(piAggregate.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "ParallelIndexAggregate", lookup(piAggregate.getRelation()));
+    NodeType type = constructNodeType("ParallelIndexAggregate", lookup(piAggregate.getRelation()));
     /* Resolve functor to actual function pointer now */
     void* functionPtr = resolveFunctionPointers(piAggregate);
     auto res = mk<ParallelIndexAggregate>(type, &piAggregate, rel, std::move(expr), std::move(cond),
@@ -478,7 +513,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::GuardedInsert>, const ram::Guar
     SuperInstruction superOp = getInsertSuperInstInfo(guardedInsert);
     std::size_t relId = encodeRelation(guardedInsert.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "GuardedInsert", lookup(guardedInsert.getRelation()));
+    NodeType type = constructNodeType("GuardedInsert", lookup(guardedInsert.getRelation()));
     auto condition = guardedInsert.getCondition();
     return mk<GuardedInsert>(type, &guardedInsert, rel, std::move(superOp), dispatch(*condition));
 }
@@ -487,15 +522,19 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Insert>, const ram::Insert& ins
     SuperInstruction superOp = getInsertSuperInstInfo(insert);
     std::size_t relId = encodeRelation(insert.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "Insert", lookup(insert.getRelation()));
-    return mk<Insert>(type, &insert, rel, std::move(superOp));
+    NodeType type = constructNodeType("Insert", lookup(insert.getRelation()));
+    // the private relations of eager workers are read while being computed, and hash sets are
+    // cheaper to insert into concurrently than to build from buffered tuples
+    const bool buffered = relOverrides.empty() && appendOnly.isAppendOnly(insert.getRelation()) &&
+                          !indexAnalysis.isHashRelation(insert.getRelation());
+    return mk<Insert>(type, &insert, rel, std::move(superOp), buffered);
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Erase>, const ram::Erase& erase) {
     SuperInstruction superOp = getEraseSuperInstInfo(erase);
     std::size_t relId = encodeRelation(erase.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "Erase", lookup(erase.getRelation()));
+    NodeType type = constructNodeType("Erase", lookup(erase.getRelation()));
     return mk<Erase>(type, &erase, rel, std::move(superOp));
 }
 
@@ -516,7 +555,6 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Sequence>, const ram::Sequence&
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Parallel>, const ram::Parallel& parallel) {
-    // Parallel statements are executed in sequence for now.
     NodePtrVec children;
     for (const auto& value : parallel.getStatements()) {
         children.push_back(dispatch(*value));
@@ -524,8 +562,26 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Parallel>, const ram::Parallel&
     return mk<Parallel>(I_Parallel, &parallel, std::move(children));
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::AdaptiveQuery>, const ram::AdaptiveQuery& adaptive) {
+    NodePtrVec children;
+    for (const auto& value : adaptive.getStatements()) {
+        children.push_back(dispatch(*value));
+    }
+    std::vector<AdaptiveQuery::Plan> plans;
+    for (const auto& plan : adaptive.getPlans()) {
+        AdaptiveQuery::Plan steps;
+        for (const auto& [relation, exponent] : plan) {
+            steps.push_back({getRelationHandle(encodeRelation(relation)), exponent,
+                    isPrefix("@delta_", relation)});
+        }
+        plans.push_back(std::move(steps));
+    }
+    return mk<AdaptiveQuery>(I_AdaptiveQuery, &adaptive, std::move(children), std::move(plans));
+}
+
 NodePtr NodeGenerator::visit_(type_identity<ram::Loop>, const ram::Loop& loop) {
-    return mk<Loop>(I_Loop, &loop, dispatch(loop.getBody()));
+    auto body = dispatch(loop.getBody());
+    return mk<Loop>(I_Loop, &loop, std::move(body), generateEagerEvaluation(loop));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Exit>, const ram::Exit& exit) {
@@ -558,7 +614,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::DebugInfo>, const ram::DebugInf
 NodePtr NodeGenerator::visit_(type_identity<ram::Clear>, const ram::Clear& clear) {
     std::size_t relId = encodeRelation(clear.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "Clear", lookup(clear.getRelation()));
+    NodeType type = constructNodeType("Clear", lookup(clear.getRelation()));
     return mk<Clear>(type, &clear, rel);
 }
 
@@ -566,7 +622,7 @@ NodePtr NodeGenerator::visit_(
         type_identity<ram::EstimateJoinSize>, const ram::EstimateJoinSize& estimateJoinSize) {
     std::size_t relId = encodeRelation(estimateJoinSize.getRelation());
     auto rel = getRelationHandle(relId);
-    NodeType type = constructNodeType(global, "EstimateJoinSize", lookup(estimateJoinSize.getRelation()));
+    NodeType type = constructNodeType("EstimateJoinSize", lookup(estimateJoinSize.getRelation()));
     return mk<EstimateJoinSize>(type, &estimateJoinSize, rel, encodeIndexPos(estimateJoinSize));
 }
 
@@ -621,6 +677,11 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Query>, const ram::Query& query
         };
     });
 
+    visit(*next, [&](const ram::HashJoin& hashJoin) {
+        viewContext->addHashTableInfo(
+                encodeRelation(hashJoin.getRelation()), hashJoin.getKeyColumns(), hashJoin.getTupleId());
+    });
+
     viewContext->isParallel =
             visitExists(*next, [&](const Node& n) { return as<ram::AbstractParallel, AllowCrossCast>(n); });
 
@@ -629,6 +690,13 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Query>, const ram::Query& query
     return res;
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::Merge>, const ram::Merge& merge) {
+    std::size_t src = encodeRelation(merge.getSourceRelation());
+    std::size_t target = encodeRelation(merge.getTargetRelation());
+    NodeType type = constructNodeType("Merge", lookup(merge.getTargetRelation()));
+    return mk<Merge>(type, &merge, src, target);
+}
+
 NodePtr NodeGenerator::visit_(type_identity<ram::MergeExtend>, const ram::MergeExtend& extend) {
     std::size_t src = encodeRelation(extend.getFirstRelation());
     std::size_t target = encodeRelation(extend.getSecondRelation());
@@ -691,12 +759,21 @@ const ram::Relation& NodeGenerator::lookup(const std::string& relName) {
     return *it->second;
 }
 
+NodeType NodeGenerator::constructNodeType(std::string tokBase, const ram::Relation& rel) {
+    return interpreter::constructNodeType(global, std::move(tokBase), rel,
+            sortedDelta.isSortedDelta(rel.getName()), indexAnalysis.isHashRelation(rel.getName()));
+}
+
 std::size_t NodeGenerator::getArity(const std::string& relName) {
     const auto& rel = lookup(relName);
     return rel.getArity();
 }
 
 std::size_t NodeGenerator::encodeRelation(const std::string& relName) {
+    auto override = relOverrides.find(relName);
+    if (override != relOverrides.end()) {
+        return override->second;
+    }
     auto pos = relTable.find(relName);
     if (pos != relTable.end()) {
         return pos->second;
@@ -711,11 +788,109 @@ RelationHandle* NodeGenerator::getRelationHandle(const std::size_t idx) {
     return engine.relations[idx].get();
 }
 
+Own<EagerEvaluation> NodeGenerator::generateEagerEvaluation(const ram::Loop& loop) {
+    if (!global.config().has("eager-eval")) {
+        return nullptr;
+    }
+
+    // Subsumption, equivalence relations and provenance rely on the batches of the semi-naive loop
+    if (visitExists(loop, [&](const ram::Node& node) {
+            return isA<ram::Erase>(node) || isA<ram::GuardedInsert>(node) || isA<ram::MergeExtend>(node);
+        })) {
+        return nullptr;
+    }
+
+    // Collect the relations of the stratum and the rules reading their delta relations
+    std::vector<std::string> names;
+    std::vector<std::pair<std::size_t, const ram::Query*>> rules;
+    auto position = [&](const std::string& name) {
+        auto it = std::find(names.begin(), names.end(), name);
+        if (it != names.end()) {
+            return static_cast<std::size_t>(std::distance(names.begin(), it));
+        }
+        names.push_back(name);
+        return names.size() - 1;
+    };
+    bool supported = true;
+    visit(loop, [&](const ram::Query& query) {
+        // as in the synthesiser, queries inserting into delta relations are not propagated
+        if (visitExists(query, [&](const ram::Node& node) {
+                const auto* insert = as<ram::Insert>(node);
+                return insert != nullptr && isPrefix("@delta_", insert->getRelation());
+            })) {
+            return;
+        }
+        std::vector<std::size_t> deltas;
+        visit(query, [&](const ram::RelationOperation& op) {
+            if (isPrefix("@delta_", op.getRelation())) {
+                deltas.push_back(position(op.getRelation().substr(7)));
+            }
+        });
+        if (deltas.empty()) {
+            return;
+        }
+        visit(query, [&](const ram::Insert& insert) {
+            if (isPrefix("@new_", insert.getRelation())) {
+                position(insert.getRelation().substr(5));
+            } else {
+                supported = false;
+            }
+        });
+        for (std::size_t k : deltas) {
+            rules.emplace_back(k, &query);
+        }
+    });
+    for (const auto& name : names) {
+        for (const auto& relName : {name, "@delta_" + name, "@new_" + name}) {
+            if (!contains(relationMap, relName)) {
+                supported = false;
+            }
+        }
+        if (supported) {
+            auto representation = lookup(name).getRepresentation();
+            supported = representation != RelationRepresentation::EQREL &&
+                        representation != RelationRepresentation::BTREE_DELETE &&
+                        representation != RelationRepresentation::PROVENANCE &&
+                        !isLatticeRepresentation(representation);
+        }
+    }
+    if (!supported || rules.empty()) {
+        return nullptr;
+    }
+
+    auto eager = mk<EagerEvaluation>();
+    for (const auto& name : names) {
+        eager->full.push_back(getRelationHandle(encodeRelation(name)));
+        eager->seed.push_back(getRelationHandle(encodeRelation("@delta_" + name)));
+    }
+    for (std::size_t i = 0; i < engine.numOfThreads; ++i) {
+        EagerEvaluation::Worker worker;
+        for (const auto& name : names) {
+            for (const auto& relName : {"@delta_" + name, "@new_" + name}) {
+                std::size_t id = getNewRelId();
+                engine.createRelation(lookup(relName), id);
+                relOverrides[relName] = id;
+            }
+            worker.delta.push_back(getRelationHandle(relOverrides["@delta_" + name]));
+            worker.derived.push_back(getRelationHandle(relOverrides["@new_" + name]));
+        }
+        worker.rules.resize(names.size());
+        for (const auto& [k, query] : rules) {
+            worker.rules[k].push_back(dispatch(*query));
+        }
+        relOverrides.clear();
+        eager->workers.push_back(std::move(worker));
+    }
+    return eager;
+}
+
 bool NodeGenerator::requireView(const ram::Node* node) {
     if (isA<ram::AbstractExistenceCheck>(node)) {
         return true;
     } else if (isA<ram::IndexOperation>(node)) {
         return true;
+    } else if (isA<ram::LeapfrogInput>(node)) {
+        return true;
     }
     return false;
 }
@@ -725,6 +900,8 @@ const std::string& NodeGenerator::getViewRelation(const ram::Node* node) {
         return exist->getRelation();
     } else if (const auto* index = as<ram::IndexOperation>(node)) {
         return index->getRelation();
+    } else if (const auto* input = as<ram::LeapfrogInput>(node)) {
+        return input->getRelation();
     }
 
     fatal("The ram::Node does not require a view.");
@@ -800,7 +977,6 @@ SuperInstruction NodeGenerator::getIndexSuperInstInfo(const ram::IndexOperation&
 }
 
 SuperInstruction NodeGenerator::getExistenceSuperInstInfo(const ram::AbstractExistenceCheck& abstractExist) {
-    auto interpreterRel = encodeRelation(abstractExist.getRelation());
     std::size_t indexId = 0;
     if (isA<ram::ExistenceCheck>(&abstractExist)) {
         indexId = encodeIndexPos(*as<ram::ExistenceCheck>(abstractExist));
@@ -809,10 +985,14 @@ SuperInstruction NodeGenerator::getExistenceSuperInstInfo(const ram::AbstractExi
     } else {
         fatal("Unrecognized ram::AbstractExistenceCheck.");
     }
-    auto order = (*getRelationHandle(interpreterRel))->getIndexOrder(indexId);
-    std::size_t arity = getArity(abstractExist.getRelation());
+    return getPatternSuperInstInfo(abstractExist.getRelation(), indexId, abstractExist.getValues());
+}
+
+SuperInstruction NodeGenerator::getPatternSuperInstInfo(
+        const std::string& relation, std::size_t indexId, const std::vector<ram::Expression*>& children) {
+    auto order = (*getRelationHandle(encodeRelation(relation)))->getIndexOrder(indexId);
+    std::size_t arity = getArity(relation);
     SuperInstruction superOp(arity);
-    const auto& children = abstractExist.getValues();
     for (std::size_t i = 0; i < arity; ++i) {
         auto& child = children[order[i]];
 
@@ -24,6 +24,7 @@
 #include "interpreter/ViewContext.h"
 #include "ram/AbstractExistenceCheck.h"
 #include "ram/AbstractParallel.h"
+#include "ram/AdaptiveQuery.h"
 #include "ram/Aggregate.h"
 #include "ram/AutoIncrement.h"
 #include "ram/Break.h"
@@ -40,6 +41,7 @@
 #include "ram/Expression.h"
 #include "ram/False.h"
 #include "ram/Filter.h"
+#include "ram/HashJoin.h"
 #include "ram/IO.h"
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
@@ -48,10 +50,13 @@
 #include "ram/IndexScan.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogInput.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
@@ -85,6 +90,8 @@
 #include "ram/UndefValue.h"
 #include "ram/UnpackRecord.h"
 #include "ram/UserDefinedOperator.h"
+#include "ram/analysis/AppendOnly.h"
+#include "ram/analysis/SortedDelta.h"
 #include "ram/analysis/Index.h"
 #include "ram/utility/Utils.h"
 #include "ram/utility/Visitor.h"
@@ -186,6 +193,8 @@ public:
             type_identity<ram::ParallelIndexIfExists>, const ram::ParallelIndexIfExists& piIfExists) override;
 
     NodePtr visit_(type_identity<ram::UnpackRecord>, const ram::UnpackRecord& unpack) override;
+    NodePtr visit_(type_identity<ram::LeapfrogJoin>, const ram::LeapfrogJoin& leapfrog) override;
+    NodePtr visit_(type_identity<ram::HashJoin>, const ram::HashJoin& hashJoin) override;
 
     NodePtr visit_(type_identity<ram::Aggregate>, const ram::Aggregate& aggregate) override;
 
@@ -212,6 +221,8 @@ public:
 
     NodePtr visit_(type_identity<ram::Parallel>, const ram::Parallel& parallel) override;
 
+    NodePtr visit_(type_identity<ram::AdaptiveQuery>, const ram::AdaptiveQuery& adaptive) override;
+
     NodePtr visit_(type_identity<ram::Loop>, const ram::Loop& loop) override;
 
     NodePtr visit_(type_identity<ram::Exit>, const ram::Exit& exit) override;
@@ -235,6 +246,7 @@ public:
 
     NodePtr visit_(type_identity<ram::Query>, const ram::Query& query) override;
 
+    NodePtr visit_(type_identity<ram::Merge>, const ram::Merge& merge) override;
     NodePtr visit_(type_identity<ram::MergeExtend>, const ram::MergeExtend& extend) override;
 
     NodePtr visit_(type_identity<ram::Swap>, const ram::Swap& swap) override;
@@ -304,6 +316,9 @@ private:
     /** @brief get arity of relation */
     const ram::Relation& lookup(const std::string& relName);
 
+    /** @brief Construct the node type of an operation on the given relation */
+    NodeType constructNodeType(std::string tokBase, const ram::Relation& rel);
+
     /** @brief get arity of relation */
     std::size_t getArity(const std::string& relName);
 
@@ -313,6 +328,12 @@ private:
     /* @brief Get a relation instance from engine */
     RelationHandle* getRelationHandle(const std::size_t idx);
 
+    /**
+     * @brief Return the non-batching evaluation plan of a loop, or nullptr if the loop has to be
+     * evaluated semi-naively.
+     */
+    Own<EagerEvaluation> generateEagerEvaluation(const ram::Loop& loop);
+
     /**
      * Return true if the given operation requires a view.
      */
@@ -334,6 +355,12 @@ private:
      */
     SuperInstruction getExistenceSuperInstInfo(const ram::AbstractExistenceCheck& abstractExist);
 
+    /**
+     * @brief Encode and return the super-instruction information about a tuple pattern searched in an index
+     */
+    SuperInstruction getPatternSuperInstInfo(
+            const std::string& relation, std::size_t indexId, const std::vector<ram::Expression*>& children);
+
     /**
      * @brief Encode and return the super-instruction information about a insert operation
      *
@@ -360,8 +387,16 @@ private:
     std::unordered_map<const ram::Node*, std::size_t> viewTable;
     /** Environment encoding, store a mapping from ram::Relation to its id */
     std::unordered_map<std::string, std::size_t> relTable;
+    /** Relation ids taking precedence over relTable, e.g. for the private relations of eager workers */
+    std::unordered_map<std::string, std::size_t> relOverrides;
     /** name / relation mapping */
     std::unordered_map<std::string, const ram::Relation*> relationMap;
+    /** Relations whose insertions are buffered */
+    const ram::analysis::AppendOnlyAnalysis& appendOnly;
+    /** Relations stored in sorted arrays */
+    const ram::analysis::SortedDeltaAnalysis& sortedDelta;
+    /** Relations stored in hash sets */
+    const ram::analysis::IndexAnalysis& indexAnalysis;
     /** ordering context */
     OrderingContext orderingContext = OrderingContext(*this);
     /** Reference to the engine instance */
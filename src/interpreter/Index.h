@@ -22,6 +22,7 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StreamUtil.h"
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
@@ -30,6 +31,9 @@
 #include <iosfwd>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -137,8 +141,99 @@ inline std::ostream& operator<<(std::ostream& out, const Order& order) {
  */
 struct ViewWrapper {
     virtual ~ViewWrapper() = default;
+
+    /**
+     * Obtains the element at the given position of the first tuple in the range [low, high], where the
+     * bounds are encoded in the order of the index. Returns false if the range is empty.
+     */
+    virtual bool seek(const RamDomain* /* low */, const RamDomain* /* high */, std::size_t /* pos */,
+            RamDomain& /* value */) {
+        fatal("index does not support seeking");
+    }
 };
 
+/**
+ * Obtains the elements of an ordered data structure in the range [low, high].
+ */
+template <typename Data, typename Tuple, typename Hints>
+souffle::range<typename Data::iterator> searchRange(
+        const Data& data, const Tuple& low, const Tuple& high, Hints& hints) {
+    return {data.lower_bound(low, hints), data.upper_bound(high, hints)};
+}
+
+/**
+ * Obtains the elements of a trie whose first columns match the given entry.
+ */
+template <unsigned Dim, unsigned Levels = 0>
+souffle::range<typename Trie<Dim>::iterator> prefixRange(const Trie<Dim>& data,
+        const typename Trie<Dim>::entry_type& entry, std::size_t levels,
+        typename Trie<Dim>::op_context& ctxt) {
+    if constexpr (Levels == Dim) {
+        return data.template getBoundaries<Dim>(entry, ctxt);
+    } else {
+        if (levels == Levels) {
+            return data.template getBoundaries<Levels>(entry, ctxt);
+        }
+        return prefixRange<Dim, Levels + 1>(data, entry, levels, ctxt);
+    }
+}
+
+/**
+ * Tries order their elements by the unsigned representation of the columns, so a signed range
+ * is not contiguous. Brie relations are never indexed on inequalities however (see MakeIndex),
+ * hence the bound columns form a prefix of the order with low == high.
+ */
+template <unsigned Dim, typename Tuple, typename Hints>
+souffle::range<typename Trie<Dim>::iterator> searchRange(
+        const Trie<Dim>& data, const Tuple& low, const Tuple& high, Hints& hints) {
+    std::size_t levels = 0;
+    while (levels < Dim && low[levels] == high[levels]) {
+        ++levels;
+    }
+    return prefixRange(data, low, levels, hints);
+}
+
+/**
+ * Hash sets are only searched by all of their columns, with low == high, or scanned as a whole
+ * (see IndexAnalysis::isHashRelation).
+ */
+template <typename Key, typename Hash, typename Equal, typename Tuple, typename Hints>
+souffle::range<typename concurrent_hash_set<Key, Hash, Equal>::iterator> searchRange(
+        const concurrent_hash_set<Key, Hash, Equal>& data, const Tuple& low, const Tuple& high,
+        Hints& hints) {
+    if (low == high) {
+        return data.equal_range(low, hints);
+    }
+    return {data.begin(), data.end()};
+}
+
+/**
+ * Determines whether a data structure maintains the number of distinct prefixes of its tuples.
+ */
+template <typename Data, typename = void>
+struct has_prefix_statistics : std::false_type {};
+
+template <typename Data>
+struct has_prefix_statistics<Data, std::enable_if_t<Data::has_prefix_statistics>> : std::true_type {};
+
+/**
+ * Determines whether a data structure can be built in bulk from sorted elements.
+ */
+template <typename Data, typename = void>
+struct has_bulk_load : std::false_type {};
+
+template <typename Data>
+struct has_bulk_load<Data, std::enable_if_t<Data::has_bulk_load>> : std::true_type {};
+
+/**
+ * Determines whether a data structure is only modified in bulk, not concurrently.
+ */
+template <typename Data, typename = void>
+struct is_immutable : std::false_type {};
+
+template <typename Data>
+struct is_immutable<Data, std::enable_if_t<Data::is_immutable>> : std::true_type {};
+
 /**
  * An index is an abstraction of a data structure
  */
@@ -152,6 +247,12 @@ public:
     using Hints = typename Data::operation_hints;
     using Comparator = comparator<Arity>;
 
+    // whether elements are inserted in bulk only, see bulkInsert
+    static constexpr bool immutable = is_immutable<Data>::value;
+
+    // whether the data structure is built bottom-up by bulkInsert
+    static constexpr bool bulkLoad = has_bulk_load<Data>::value;
+
     Index(Order order) : order(std::move(order)) {}
 
 protected:
@@ -188,7 +289,20 @@ public:
             if (cmp(low, high) > 0) {
                 return {data.end(), data.end()};
             }
-            return {data.lower_bound(low, hints), data.upper_bound(high, hints)};
+            return searchRange(data, low, high, hints);
+        }
+
+        bool seek(const RamDomain* low, const RamDomain* high, std::size_t pos, RamDomain& value) override {
+            Tuple l;
+            Tuple h;
+            std::copy_n(low, Arity, l.begin());
+            std::copy_n(high, Arity, h.begin());
+            auto found = range(l, h);
+            if (found.empty()) {
+                return false;
+            }
+            value = (*found.begin())[pos];
+            return true;
         }
     };
 
@@ -229,6 +343,29 @@ public:
         return data.size();
     }
 
+    /**
+     * Obtains the (approximate) number of distinct values of the first columns of this
+     * index, if the data structure maintains it.
+     */
+    std::optional<std::size_t> distinctPrefixes([[maybe_unused]] std::size_t length) const {
+        if constexpr (has_prefix_statistics<Data>::value) {
+            if (data.hasPrefixStatistics()) {
+                return data.getDistinctPrefixes(length);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Starts maintaining the number of distinct values of the first columns of this index,
+     * if the data structure supports it; not thread safe.
+     */
+    void enablePrefixStatistics() {
+        if constexpr (has_prefix_statistics<Data>::value) {
+            data.enablePrefixStatistics();
+        }
+    }
+
     /**
      * Inserts a tuple into this index.
      */
@@ -245,6 +382,68 @@ public:
         }
     }
 
+    /**
+     * Inserts the elements of a range of the given index, which may differ in order and
+     * data structure. The elements are inserted sorted by the order of this index, such
+     * that each insertion starts from the position of the previous one. Distinct ranges
+     * may be inserted concurrently.
+     */
+    template <typename Source>
+    void insert(const Source& src, const souffle::range<typename Source::iterator>& chunk) {
+        Hints hints;
+        const Order srcOrder = src.getOrder();
+        if (srcOrder == order) {
+            for (const auto& tuple : chunk) {
+                data.insert(tuple, hints);
+            }
+            return;
+        }
+        std::vector<Tuple> tuples;
+        for (const auto& tuple : chunk) {
+            tuples.push_back(order.encode(srcOrder.decode(tuple)));
+        }
+        std::sort(tuples.begin(), tuples.end());
+        for (const auto& tuple : tuples) {
+            data.insert(tuple, hints);
+        }
+    }
+
+    /**
+     * Inserts the given tuples in bulk. The tuples are sorted by the order of this index unless
+     * already ordered by it, such that data structures supporting it are built bottom-up.
+     * Not thread safe.
+     */
+    void bulkInsert(const std::vector<Tuple>& tuples) {
+        std::vector<Tuple> sorted;
+        sorted.reserve(tuples.size());
+        for (const auto& tuple : tuples) {
+            sorted.push_back(order.encode(tuple));
+        }
+        if (!std::is_sorted(sorted.begin(), sorted.end())) {
+            std::sort(sorted.begin(), sorted.end());
+        }
+        insertSorted(sorted.begin(), sorted.end());
+    }
+
+    /**
+     * Inserts all elements of the given index, which may differ in order and data structure,
+     * in bulk. Not thread safe.
+     */
+    template <typename Source>
+    void bulkInsert(const Source& src) {
+        const Order srcOrder = src.getOrder();
+        if (srcOrder == order) {
+            insertSorted(src.begin(), src.end());
+            return;
+        }
+        std::vector<Tuple> tuples;
+        for (const auto& tuple : src) {
+            tuples.push_back(order.encode(srcOrder.decode(tuple)));
+        }
+        std::sort(tuples.begin(), tuples.end());
+        insertSorted(tuples.begin(), tuples.end());
+    }
+
     /**
      * Tests whether the given tuple is present in this index or not.
      */
@@ -273,7 +472,8 @@ public:
         if (cmp(low, high) > 0) {
             return {data.end(), data.end()};
         }
-        return {data.lower_bound(low), data.upper_bound(high)};
+        Hints hints;
+        return searchRange(data, low, high, hints);
     }
 
     /**
@@ -310,6 +510,23 @@ public:
     void clear() {
         data.clear();
     }
+
+private:
+    /**
+     * Inserts the given range of encoded tuples, sorted by the order of this index. Data
+     * structures not supporting bulk loads start each insertion from the previous one.
+     */
+    template <typename Iter>
+    void insertSorted(const Iter& a, const Iter& b) {
+        if constexpr (has_bulk_load<Data>::value) {
+            data.bulk_load(a, b);
+        } else {
+            Hints hints;
+            for (auto it = a; it != b; ++it) {
+                data.insert(*it, hints);
+            }
+        }
+    }
 };
 
 /**
@@ -322,6 +539,9 @@ public:
     static constexpr std::size_t Arity = 0;
     using Tuple = typename souffle::Tuple<RamDomain, 0>;
 
+    static constexpr bool immutable = false;
+    static constexpr bool bulkLoad = true;
+
 protected:
     // indicates whether the one single element is present or not.
     std::atomic<bool> data{false};
@@ -409,6 +629,12 @@ public:
         return data ? 1 : 0;
     }
 
+    std::optional<std::size_t> distinctPrefixes(std::size_t /* length */) const {
+        return std::nullopt;
+    }
+
+    void enablePrefixStatistics() {}
+
     bool insert(const Tuple& /* t */) {
         return data = true;
     }
@@ -417,6 +643,26 @@ public:
         data = src.data;
     }
 
+    template <typename Source>
+    void insert(const Source& /* src */, const souffle::range<typename Source::iterator>& chunk) {
+        if (!chunk.empty()) {
+            data = true;
+        }
+    }
+
+    void bulkInsert(const std::vector<Tuple>& tuples) {
+        if (!tuples.empty()) {
+            data = true;
+        }
+    }
+
+    template <typename Source>
+    void bulkInsert(const Source& src) {
+        if (!src.empty()) {
+            data = true;
+        }
+    }
+
     bool contains(const Tuple& /* t */) const {
         return data;
     }
@@ -449,6 +695,229 @@ public:
     }
 };
 
+/**
+ * A specialization for relations whose arity exceeds the instantiated ones.
+ *
+ * Tuples are copied in the order of the index into a flat, append-only storage and the
+ * btree orders references to them using a comparator over the runtime arity.
+ */
+template <>
+class Index<Dynamic, Generic> {
+public:
+    static constexpr std::size_t Arity = Dynamic;
+    using Data = Generic<Dynamic>;
+    using Tuple = std::vector<RamDomain>;
+    using iterator = Data::iterator;
+    using Hints = Data::operation_hints;
+
+    Index(Order order) : order(std::move(order)), cmp{this->order.size()}, data(cmp, cmp) {}
+
+protected:
+    // the number of tuples per block of the storage
+    static constexpr std::size_t BlockSize = 1024;
+
+    Order order;
+    dynamic_comparator cmp;
+    Data data;
+
+    // the storage of the referenced tuples, blocks are never relocated
+    std::mutex storageLock;
+    std::vector<std::unique_ptr<RamDomain[]>> blocks;
+    std::size_t blockFill = BlockSize;
+
+    // the storage of rejected tuples, reused before the blocks grow
+    std::vector<RamDomain*> released;
+
+    /** Reserves the storage for a single tuple. */
+    RamDomain* allocate() {
+        std::lock_guard<std::mutex> guard(storageLock);
+        if (!released.empty()) {
+            RamDomain* res = released.back();
+            released.pop_back();
+            return res;
+        }
+        if (blockFill == BlockSize) {
+            blocks.emplace_back(new RamDomain[BlockSize * cmp.arity]);
+            blockFill = 0;
+        }
+        return &blocks.back()[cmp.arity * blockFill++];
+    }
+
+    /** Returns the storage of a rejected tuple, to be reused by the next allocation. */
+    void release(RamDomain* entry) {
+        std::lock_guard<std::mutex> guard(storageLock);
+        released.push_back(entry);
+    }
+
+public:
+    class View : public ViewWrapper {
+        mutable Hints hints;
+        const Data& data;
+        dynamic_comparator cmp;
+
+    public:
+        View(const Data& data, dynamic_comparator cmp) : data(data), cmp(cmp) {}
+
+        bool contains(const Tuple& entry) {
+            return data.contains(entry.data(), hints);
+        }
+
+        bool contains(const Tuple& low, const Tuple& high) {
+            return !range(low, high).empty();
+        }
+
+        souffle::range<iterator> range(const Tuple& low, const Tuple& high) {
+            if (cmp(low.data(), high.data()) > 0) {
+                return {data.end(), data.end()};
+            }
+            return searchRange(data, TupleRef(low.data()), TupleRef(high.data()), hints);
+        }
+
+        bool seek(const RamDomain* low, const RamDomain* high, std::size_t pos, RamDomain& value) override {
+            if (cmp(low, high) > 0) {
+                return false;
+            }
+            auto found = searchRange(data, TupleRef(low), TupleRef(high), hints);
+            if (found.empty()) {
+                return false;
+            }
+            value = (*found.begin())[pos];
+            return true;
+        }
+    };
+
+public:
+    View createView() {
+        return View(this->data, cmp);
+    }
+
+    iterator begin() const {
+        return data.begin();
+    }
+
+    iterator end() const {
+        return data.end();
+    }
+
+    Order getOrder() const {
+        return order;
+    }
+
+    bool empty() const {
+        return data.empty();
+    }
+
+    std::size_t size() const {
+        return data.size();
+    }
+
+    std::optional<std::size_t> distinctPrefixes(std::size_t /* length */) const {
+        return std::nullopt;
+    }
+
+    bool insert(const Tuple& tuple) {
+        RamDomain* entry = allocate();
+        for (std::size_t i = 0; i < cmp.arity; ++i) {
+            entry[i] = tuple[order[i]];
+        }
+        if (data.insert(entry)) {
+            return true;
+        }
+        release(entry);
+        return false;
+    }
+
+    /**
+     * Inserts the elements of a range of the given index, sorted by the order of this index.
+     * Distinct ranges may be inserted concurrently.
+     */
+    void insert(const Index& src, const souffle::range<iterator>& chunk) {
+        // the position of each column of this index within the source index
+        std::vector<std::size_t> positions(cmp.arity);
+        for (std::size_t i = 0; i < cmp.arity; ++i) {
+            for (std::size_t j = 0; j < cmp.arity; ++j) {
+                if (src.order[j] == order[i]) {
+                    positions[i] = j;
+                }
+            }
+        }
+        std::vector<const RamDomain*> tuples;
+        for (const auto& tuple : chunk) {
+            tuples.push_back(tuple.data());
+        }
+        if (src.order != order) {
+            std::sort(tuples.begin(), tuples.end(), [&](const RamDomain* a, const RamDomain* b) {
+                for (std::size_t pos : positions) {
+                    if (a[pos] != b[pos]) {
+                        return a[pos] < b[pos];
+                    }
+                }
+                return false;
+            });
+        }
+        Hints hints;
+        for (const RamDomain* tuple : tuples) {
+            RamDomain* entry = allocate();
+            for (std::size_t i = 0; i < cmp.arity; ++i) {
+                entry[i] = tuple[positions[i]];
+            }
+            if (!data.insert(entry, hints)) {
+                release(entry);
+            }
+        }
+    }
+
+    bool contains(const Tuple& tuple) const {
+        return data.contains(tuple.data());
+    }
+
+    bool contains(const Tuple& low, const Tuple& high) const {
+        return !range(low, high).empty();
+    }
+
+    souffle::range<iterator> scan() const {
+        return {data.begin(), data.end()};
+    }
+
+    souffle::range<iterator> range(const Tuple& low, const Tuple& high) const {
+        if (cmp(low.data(), high.data()) > 0) {
+            return {data.end(), data.end()};
+        }
+        Hints hints;
+        return searchRange(data, TupleRef(low.data()), TupleRef(high.data()), hints);
+    }
+
+    std::vector<souffle::range<iterator>> partitionScan(std::size_t partitionCount) const {
+        auto chunks = data.partition(partitionCount);
+        std::vector<souffle::range<iterator>> res;
+        res.reserve(chunks.size());
+        for (const auto& cur : chunks) {
+            res.push_back({cur.begin(), cur.end()});
+        }
+        return res;
+    }
+
+    std::vector<souffle::range<iterator>> partitionRange(
+            const Tuple& low, const Tuple& high, std::size_t partitionCount) const {
+        auto ranges = this->range(low, high);
+        auto chunks = ranges.partition(partitionCount);
+        std::vector<souffle::range<iterator>> res;
+        res.reserve(chunks.size());
+        for (const auto& cur : chunks) {
+            res.push_back({cur.begin(), cur.end()});
+        }
+        return res;
+    }
+
+    void clear() {
+        data.clear();
+        std::lock_guard<std::mutex> guard(storageLock);
+        blocks.clear();
+        blockFill = BlockSize;
+        released.clear();
+    }
+};
+
 /**
  * For EqrelIndex we do inheritence since EqrelIndex only diff with one extra function.
  */
@@ -0,0 +1,141 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file JoinSizeEstimate.h
+ *
+ * Counts the tuples of an index taking part in a join, for the join size
+ * statistics of the auto scheduler.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+
+namespace souffle::interpreter {
+
+/**
+ * The number of tuples matching the constants of a join, and how many of them repeat the
+ * key columns of their predecessor.
+ */
+struct JoinSizeCounts {
+    double total = 0;
+    double duplicates = 0;
+};
+
+/**
+ * Counts the tuples of the given index matching the given constants, and the duplicates among
+ * them on the first keyLength columns, which include the columns of the constants. Columns refer
+ * to positions in the order of the index, and low and high are tuples of the arity of the index
+ * holding the smallest and largest values.
+ *
+ * Tuples matching constants bound to a prefix of the index are looked up as a range and counted
+ * exactly. Otherwise, if sampleSize is non-zero and the index is large enough, the counts are
+ * extrapolated from a single tuple, and its successor, at the start of sampleSize chunks spread
+ * evenly over the index, such that the samples are not clustered.
+ */
+template <typename Index>
+JoinSizeCounts countJoinSize(const Index& index, typename Index::Tuple low, typename Index::Tuple high,
+        std::size_t keyLength, const std::map<std::size_t, RamDomain>& constants, std::size_t sampleSize) {
+    JoinSizeCounts res;
+
+    // the index maintains the number of distinct values of its first columns
+    if (sampleSize > 0 && constants.empty() && keyLength > 0) {
+        if (auto distinct = index.distinctPrefixes(keyLength)) {
+            res.total = index.size();
+            res.duplicates = res.total - std::min<double>(res.total, *distinct);
+            return res;
+        }
+    }
+
+    auto matchesConstants = [&](const auto& tuple) {
+        return std::all_of(constants.begin(), constants.end(),
+                [&tuple](const auto& p) { return tuple[p.first] == p.second; });
+    };
+    auto matchesKey = [&](const auto& a, const auto& b) {
+        for (std::size_t i = 0; i < keyLength; ++i) {
+            if (a[i] != b[i]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // count the tuples of a range matching the constants, and those repeating their predecessor
+    auto countRange = [&](auto range) {
+        if (range.empty()) {
+            return;
+        }
+        bool first = true;
+        auto prev = *range.begin();
+        for (const auto& tuple : range) {
+            if (!matchesConstants(tuple)) {
+                continue;
+            }
+            if (first) {
+                first = false;
+            } else if (matchesKey(prev, tuple)) {
+                ++res.duplicates;
+            }
+            prev = tuple;
+            ++res.total;
+        }
+    };
+
+    // the tuples matching the constants bound to a prefix of the index form a single range
+    std::size_t prefix = 0;
+    for (auto it = constants.begin(); it != constants.end() && it->first == prefix; ++it, ++prefix) {
+        low[prefix] = it->second;
+        high[prefix] = it->second;
+    }
+    if (prefix > 0) {
+        countRange(index.range(low, high));
+        return res;
+    }
+
+    const std::size_t size = (sampleSize == 0) ? 0 : index.size();
+    if (size <= 2 * sampleSize) {
+        countRange(index.scan());
+        return res;
+    }
+
+    double sampled = 0;
+    double matches = 0;
+    double repeats = 0;
+    double pairs = 0;
+    for (const auto& chunk : index.partitionScan(sampleSize)) {
+        auto it = chunk.begin();
+        if (it == chunk.end()) {
+            continue;
+        }
+        ++sampled;
+        const auto tuple = *it;
+        if (!matchesConstants(tuple)) {
+            continue;
+        }
+        ++matches;
+        // the successor repeats the key exactly if the tuple is not the last one of its key
+        if (++it != chunk.end()) {
+            ++pairs;
+            if (matchesKey(tuple, *it)) {
+                ++repeats;
+            }
+        }
+    }
+    res.total = std::round(size * matches / std::max(1.0, sampled));
+    res.duplicates = (pairs == 0) ? 0 : std::round(res.total * repeats / pairs);
+    return res;
+}
+
+}  // namespace souffle::interpreter
@@ -0,0 +1,41 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file LatticeIndex.cpp
+ *
+ * Interpreter lattice index with generic interface.
+ *
+ ***********************************************************************/
+
+#include "RelationTag.h"
+#include "interpreter/Relation.h"
+#include "ram/Relation.h"
+#include "ram/analysis/Index.h"
+#include "souffle/utility/MiscUtil.h"
+#include <type_traits>
+
+namespace souffle::interpreter {
+
+#define CREATE_LATTICE_REL(Structure, Arity, ...)                                                        \
+    if (id.getArity() == (Arity) &&                                                                      \
+            isMax == std::is_same_v<interpreter::Structure<Arity>, interpreter::LatticeMax<Arity>>) {    \
+        return mk<Relation<Arity, interpreter::Structure>>(                                              \
+                id.getAuxiliaryArity(), id.getName(), indexSelection);                                   \
+    }
+
+Own<RelationWrapper> createLatticeRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection) {
+    const bool isMax = id.getRepresentation() == RelationRepresentation::LATTICE_MAX;
+    FOR_EACH_LATTICE(CREATE_LATTICE_REL);
+
+    fatal("Requested arity not yet supported. Feel free to add it.");
+}
+
+}  // namespace souffle::interpreter
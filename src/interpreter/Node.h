@@ -87,6 +87,8 @@ struct RelationWrapper;
     FOR_EACH(Expand, IndexIfExists)\
     FOR_EACH(Expand, ParallelIndexIfExists)\
     Forward(UnpackRecord)\
+    Forward(LeapfrogJoin)\
+    Forward(HashJoin)\
     FOR_EACH(Expand, Aggregate)\
     FOR_EACH(Expand, ParallelAggregate)\
     FOR_EACH(Expand, IndexAggregate)\
@@ -99,6 +101,7 @@ struct RelationWrapper;
     Forward(SubroutineReturn)\
     Forward(Sequence)\
     Forward(Parallel)\
+    Forward(AdaptiveQuery)\
     Forward(Loop)\
     Forward(Exit)\
     Forward(LogRelationTimer)\
@@ -109,6 +112,7 @@ struct RelationWrapper;
     Forward(LogSize)\
     Forward(IO)\
     Forward(Query)\
+    FOR_EACH(Expand, Merge)\
     Forward(MergeExtend)\
     Forward(Swap)\
     Forward(Call)
@@ -136,11 +140,14 @@ enum NodeType {
     {__TO_STRING(I_##tok##_##Structure##_##arity), I_##tok##_##Structure##_##arity},
 
 /**
- * Construct interpreterNodeType by looking at the representation and the arity of the given rel.
+ * Construct interpreterNodeType by looking at the representation and the arity of the given rel,
+ * and whether it is stored in sorted arrays (see SortedDeltaAnalysis) or in a hash set (see
+ * IndexAnalysis::isHashRelation).
  *
  * Add reflective from string to NodeType.
  */
-inline NodeType constructNodeType(Global& glb, std::string tokBase, const ram::Relation& rel) {
+inline NodeType constructNodeType(Global& glb, std::string tokBase, const ram::Relation& rel,
+        bool sortedDelta = false, bool hashSet = false) {
     const bool isProvenance = glb.config().has("provenance");
 
     static const std::unordered_map<std::string, NodeType> map = {
@@ -152,8 +159,24 @@ inline NodeType constructNodeType(Global& glb, std::string tokBase, const ram::R
         return map.at("I_" + tokBase + "_Eqrel_" + arity);
     } else if(rel.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
         return map.at("I_" + tokBase + "_BtreeDelete_" + arity);
+    } else if (rel.getRepresentation() == RelationRepresentation::LATTICE_MIN) {
+        return map.at("I_" + tokBase + "_LatticeMin_" + arity);
+    } else if (rel.getRepresentation() == RelationRepresentation::LATTICE_MAX) {
+        return map.at("I_" + tokBase + "_LatticeMax_" + arity);
+    } else if (rel.getArity() > MaxFixedArity && !isProvenance) {
+        return map.at("I_" + tokBase + "_Generic_Dynamic");
+    } else if (sortedDelta) {
+        return map.at("I_" + tokBase + "_SortedArray_" + arity);
+    } else if (hashSet) {
+        return map.at("I_" + tokBase + "_HashSet_" + arity);
+    } else if (rel.getRepresentation() == RelationRepresentation::COMPRESSED && rel.getArity() > 0) {
+        return map.at("I_" + tokBase + "_PackedArray_" + arity);
+    } else if (rel.getRepresentation() == RelationRepresentation::BRIE) {
+        return map.at("I_" + tokBase + "_Brie_" + arity);
     } else if (isProvenance) {
         return map.at("I_" + tokBase + "_Provenance_" + arity);
+    } else if (glb.config().has("compress-leaves") && rel.getArity() >= MinCompressedLeafArity) {
+        return map.at("I_" + tokBase + "_CompressedBtree_" + arity);
     } else  {
         return map.at("I_" + tokBase + "_Btree_" + arity);
     }
@@ -348,7 +371,7 @@ protected:
 /**
  * @class BinRelOperation
  * @brief  operation that involves with two relations should inherit from this class.
- *        E.g. Swap, MergeExtend
+ *        E.g. Swap, Merge, MergeExtend
  */
 class BinRelOperation {
 public:
@@ -741,6 +764,54 @@ protected:
     Own<Node> expr;
 };
 
+/**
+ * @class LeapfrogJoin
+ */
+class LeapfrogJoin : public Node, public NestedOperation {
+public:
+    /** A column of an index sought in order among the tuples matching a pattern */
+    struct Input {
+        Input(std::size_t viewId, std::size_t column, SuperInstruction superInst)
+                : viewId(viewId), column(column), superInst(std::move(superInst)) {}
+
+        /** View on the index */
+        std::size_t viewId;
+        /** Position of the column in the order of the index */
+        std::size_t column;
+        /** Pattern of the tuples, encoded in the order of the index */
+        SuperInstruction superInst;
+    };
+
+    LeapfrogJoin(enum NodeType ty, const ram::Node* sdw, std::vector<Input> inputs, Own<Node> nested)
+            : Node(ty, sdw), NestedOperation(std::move(nested)), inputs(std::move(inputs)) {}
+
+    inline const std::vector<Input>& getInputs() const {
+        return inputs;
+    }
+
+protected:
+    std::vector<Input> inputs;
+};
+
+/**
+ * @class HashJoin
+ */
+class HashJoin : public CompoundNode, public NestedOperation {
+public:
+    HashJoin(enum NodeType ty, const ram::Node* sdw, std::size_t tableId, VecOwn<Node> keyValues,
+            Own<Node> nested)
+            : CompoundNode(ty, sdw, std::move(keyValues)), NestedOperation(std::move(nested)),
+              tableId(tableId) {}
+
+    inline std::size_t getTableId() const {
+        return tableId;
+    }
+
+protected:
+    /** Position of the hash table in the context */
+    std::size_t tableId;
+};
+
 /**
  * @class Aggregate
  */
@@ -819,8 +890,18 @@ public:
  */
 class Insert : public Node, public SuperOperation, public RelationalOperation {
 public:
-    Insert(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle, SuperInstruction superInst)
-            : Node(ty, sdw), SuperOperation(std::move(superInst)), RelationalOperation(relHandle) {}
+    Insert(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle, SuperInstruction superInst,
+            bool buffered = false)
+            : Node(ty, sdw), SuperOperation(std::move(superInst)), RelationalOperation(relHandle),
+              buffered(buffered) {}
+
+    /** @brief whether the tuple is appended to the buffer of the relation, to be sealed later */
+    bool isBuffered() const {
+        return buffered;
+    }
+
+private:
+    const bool buffered;
 };
 
 /**
@@ -863,11 +944,78 @@ class Parallel : public CompoundNode {
     using CompoundNode::CompoundNode;
 };
 
+/**
+ * @class AdaptiveQuery
+ * @brief Alternative join orders of a rule, chosen by the relation sizes at each execution
+ */
+class AdaptiveQuery : public CompoundNode {
+public:
+    using RelationHandle = Own<RelationWrapper>;
+
+    /** A scanned relation with the exponent of its size estimating the fan-out */
+    struct Step {
+        RelationHandle* relation;
+        double exponent;
+        /** Whether the relation is a delta relation, whose size is read at each execution */
+        bool delta;
+    };
+    using Plan = std::vector<Step>;
+
+    AdaptiveQuery(enum NodeType ty, const ram::Node* sdw, VecOwn<Node> children, std::vector<Plan> plans)
+            : CompoundNode(ty, sdw, std::move(children)), plans(std::move(plans)) {}
+
+    /** @brief get plans of the alternatives */
+    const std::vector<Plan>& getPlans() const {
+        return plans;
+    }
+
+private:
+    std::vector<Plan> plans;
+};
+
+/**
+ * @class EagerEvaluation
+ * @brief Non-batching evaluation plan of a recursive loop
+ *
+ * Instead of iterating the loop body, new tuples are propagated as soon as they are derived. Each
+ * worker owns private copies of the delta and new relations of the stratum, and evaluates the rules
+ * reading a delta relation on a delta holding a small batch of the tuples to be propagated.
+ */
+struct EagerEvaluation {
+    using RelationHandle = Own<RelationWrapper>;
+
+    struct Worker {
+        /** Private delta relation of each relation of the stratum */
+        std::vector<RelationHandle*> delta;
+        /** Private new relation of each relation of the stratum */
+        std::vector<RelationHandle*> derived;
+        /** Rules reading the delta relation of each relation of the stratum */
+        std::vector<std::vector<Own<Node>>> rules;
+    };
+
+    /** Relations of the stratum */
+    std::vector<RelationHandle*> full;
+    /** Initial delta relations of the stratum */
+    std::vector<RelationHandle*> seed;
+    /** One entry per thread */
+    std::vector<Worker> workers;
+};
+
 /**
  * @class Loop
  */
 class Loop : public UnaryNode {
-    using UnaryNode::UnaryNode;
+public:
+    Loop(enum NodeType ty, const ram::Node* sdw, Own<Node> child, Own<EagerEvaluation> eager = nullptr)
+            : UnaryNode(ty, sdw, std::move(child)), eager(std::move(eager)) {}
+
+    /** @brief Return the eager evaluation plan, or nullptr if the loop is evaluated semi-naively */
+    const EagerEvaluation* getEagerEvaluation() const {
+        return eager.get();
+    }
+
+private:
+    Own<EagerEvaluation> eager;
 };
 
 /**
@@ -959,6 +1107,15 @@ class Query : public UnaryNode, public AbstractParallel {
     using UnaryNode::UnaryNode;
 };
 
+/**
+ * @class Merge
+ */
+class Merge : public Node, public BinRelOperation {
+public:
+    Merge(enum NodeType ty, const ram::Node* sdw, std::size_t src, std::size_t target)
+            : Node(ty, sdw), BinRelOperation(src, target) {}
+};
+
 /**
  * @class MergeExtend
  */
@@ -20,10 +20,13 @@
 #include "ram/analysis/Index.h"
 #include "souffle/RamTypes.h"
 #include "souffle/SouffleInterface.h"
+#include "souffle/datastructure/AppendBuffer.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <set>
@@ -107,12 +110,32 @@ public:
 
     virtual void insert(const RamDomain*) = 0;
 
+    /**
+     * Inserts the given number of tuples, stored consecutively, in bulk.
+     */
+    virtual void insertBatch(const RamDomain* data, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            insert(data + i * arity);
+        }
+    }
+
     virtual bool contains(const RamDomain*) const = 0;
 
     virtual std::size_t size() const = 0;
 
     virtual void purge() = 0;
 
+    /**
+     * Inserts the tuples appended to this relation since it was last sealed. Not thread safe.
+     */
+    virtual void seal() {}
+
+    /**
+     * Starts maintaining the number of distinct prefixes of the tuples in the indexes
+     * supporting it. Not thread safe.
+     */
+    virtual void enablePrefixStatistics() {}
+
     const std::string& getName() const {
         return relName;
     }
@@ -162,6 +185,13 @@ public:
     using View = typename Index::View;
     using iterator = typename Index::iterator;
 
+    /**
+     * Construct a tuple to be filled by the caller; the arity is implied by the type.
+     */
+    static Tuple createTuple(std::size_t /* arity */) {
+        return {};
+    }
+
     /**
      * Construct a typed tuple from a raw data.
      */
@@ -213,10 +243,43 @@ public:
         __purge();
     }
 
+    void seal() override {
+        if (buffer.empty()) {
+            return;
+        }
+        const auto tuples = buffer.drain(std::less<Tuple>());
+        const int numIndexes = static_cast<int>(indexes.size());
+        PARALLEL_START
+            pfor(int i = 0; i < numIndexes; ++i) {
+                indexes[i]->bulkInsert(tuples);
+            }
+        PARALLEL_END
+    }
+
+    void enablePrefixStatistics() override {
+        for (auto& index : indexes) {
+            index->enablePrefixStatistics();
+        }
+    }
+
     void insert(const RamDomain* data) override {
         insert(constructTuple(data));
     }
 
+    void insertBatch(const RamDomain* data, std::size_t count) override {
+        std::vector<Tuple> tuples;
+        tuples.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            tuples.push_back(constructTuple(data + i * Arity));
+        }
+        const int numIndexes = static_cast<int>(indexes.size());
+        PARALLEL_START
+            pfor(int i = 0; i < numIndexes; ++i) {
+                indexes[i]->bulkInsert(tuples);
+            }
+        PARALLEL_END
+    }
+
     bool contains(const RamDomain* data) const override {
         return contains(constructTuple(data));
     }
@@ -296,6 +359,14 @@ public:
         return true;
     }
 
+    /**
+     * Appends the given tuple to the buffer of this relation, such that it is inserted by the
+     * next seal. Appending does not synchronise with other threads appending tuples.
+     */
+    void append(const Tuple& tuple) {
+        buffer.append(tuple);
+    }
+
     /**
      * Add all entries of the given relation to this relation.
      */
@@ -305,6 +376,61 @@ public:
         }
     }
 
+    /**
+     * Add all entries of the given relation, which may be of another data structure, to this
+     * relation in bulk.
+     *
+     * Each index is filled separately, from the index of the other relation of the same order
+     * if there is one, such that the chunks of its partitioned scan are sorted key ranges. The
+     * indexes and the chunks are filled in parallel. Empty relations of data structures built
+     * in bulk, and relations of immutable data structures, are instead built in bulk, each index
+     * as a whole.
+     */
+    template <template <std::size_t> typename Source>
+    void insertAll(const Relation<Arity, Source>& other, std::size_t partitionCount) {
+        using SourceIndex = typename Relation<Arity, Source>::Index;
+        std::vector<const SourceIndex*> sources;
+        for (auto& index : indexes) {
+            const SourceIndex* source = other.main;
+            for (const auto& candidate : other.indexes) {
+                if (candidate->getOrder() == index->getOrder()) {
+                    source = candidate.get();
+                    break;
+                }
+            }
+            sources.push_back(source);
+        }
+
+        if ((empty() && Index::bulkLoad) || Index::immutable) {
+            const int numIndexes = static_cast<int>(indexes.size());
+            PARALLEL_START
+                pfor(int i = 0; i < numIndexes; ++i) {
+                    indexes[i]->bulkInsert(*sources[i]);
+                }
+            PARALLEL_END
+            return;
+        }
+
+        struct Task {
+            Index* target;
+            const SourceIndex* source;
+            souffle::range<typename SourceIndex::iterator> chunk;
+        };
+        std::vector<Task> tasks;
+        for (std::size_t i = 0; i < indexes.size(); ++i) {
+            for (const auto& chunk : sources[i]->partitionScan(partitionCount)) {
+                tasks.push_back({indexes[i].get(), sources[i], chunk});
+            }
+        }
+
+        const int numTasks = static_cast<int>(tasks.size());
+        PARALLEL_START
+            pfor(int i = 0; i < numTasks; ++i) {
+                tasks[i].target->insert(*tasks[i].source, tasks[i].chunk);
+            }
+        PARALLEL_END
+    }
+
     /**
      * Tests whether this relation contains the given tuple.
      */
@@ -379,6 +505,7 @@ public:
         for (auto& idx : indexes) {
             idx->clear();
         }
+        buffer.clear();
     }
 
     /**
@@ -393,6 +520,9 @@ public:
     }
 
 protected:
+    template <std::size_t, template <std::size_t> typename>
+    friend class Relation;
+
     // Number of height parameters of relation
     std::size_t auxiliaryArity;
 
@@ -401,6 +531,224 @@ protected:
 
     // a pointer to the main index within the managed index
     Index* main;
+
+    // the tuples appended since this relation was last sealed
+    AppendBuffer<Tuple> buffer;
+};
+
+/**
+ * A relation whose arity is only known at runtime, see Index<Dynamic, Generic>.
+ */
+template <>
+class Relation<Dynamic, Generic> : public RelationWrapper {
+public:
+    static constexpr std::size_t Arity = Dynamic;
+    using Index = interpreter::Index<Dynamic, Generic>;
+    using Tuple = Index::Tuple;
+    using View = Index::View;
+    using iterator = Index::iterator;
+
+    /**
+     * Construct a tuple of the given arity.
+     */
+    static Tuple createTuple(std::size_t arity) {
+        return Tuple(arity);
+    }
+
+    /**
+     * Cast an abstract view into a view of Index::View type.
+     */
+    static View* castView(ViewWrapper* view) {
+        return static_cast<View*>(view);
+    }
+
+    /**
+     * Creates a relation, build all necessary indexes.
+     */
+    Relation(std::size_t arity, std::size_t auxiliaryArity, const std::string& name,
+            const ram::analysis::IndexCluster& indexSelection)
+            : RelationWrapper(arity, auxiliaryArity, name) {
+        for (const auto& order : indexSelection.getAllOrders()) {
+            ram::analysis::LexOrder fullOrder = order;
+            // Expand the order to a total order
+            ram::analysis::AttributeSet set{order.begin(), order.end()};
+            for (std::size_t i = 0; i < arity; ++i) {
+                if (set.find(i) == set.end()) {
+                    fullOrder.push_back(i);
+                }
+            }
+
+            indexes.push_back(mk<Index>(fullOrder));
+        }
+
+        // Use the first index as default main index
+        main = indexes[0].get();
+    }
+
+    Relation(Relation& other) = delete;
+
+    // -- Implement all virtual interface from Wrapper. --
+public:
+    void purge() override {
+        __purge();
+    }
+
+    void insert(const RamDomain* data) override {
+        insert(Tuple(data, data + getArity()));
+    }
+
+    bool contains(const RamDomain* data) const override {
+        return contains(Tuple(data, data + getArity()));
+    }
+
+    IndexViewPtr createView(const std::size_t& indexPos) const override {
+        return mk<View>(indexes[indexPos]->createView());
+    }
+
+    std::size_t size() const override {
+        return __size();
+    }
+
+    Order getIndexOrder(std::size_t idx) const override {
+        return indexes[idx]->getOrder();
+    }
+
+    class iterator_base : public RelationWrapper::iterator_base {
+        iterator iter;
+        Order order;
+        Tuple data;
+
+    public:
+        iterator_base(iterator iter, Order order)
+                : iter(std::move(iter)), order(std::move(order)), data(this->order.size()) {}
+
+        iterator_base& operator++() override {
+            ++iter;
+            return *this;
+        }
+
+        const RamDomain* operator*() override {
+            const auto& tuple = *iter;
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                data[order[i]] = tuple[i];
+            }
+            return data.data();
+        }
+
+        iterator_base* clone() const override {
+            return new iterator_base(iter, order);
+        }
+
+        bool equal(const RelationWrapper::iterator_base& other) const override {
+            if (auto* o = as<iterator_base>(other)) {
+                return iter == o->iter;
+            }
+            return false;
+        }
+    };
+
+    Iterator begin() const override {
+        return Iterator(new iterator_base(main->begin(), main->getOrder()));
+    }
+
+    Iterator end() const override {
+        return Iterator(new iterator_base(main->end(), main->getOrder()));
+    }
+
+    // -- Interfaces for interpreter execution, mirroring the ones of the fixed arity relations. --
+public:
+    bool insert(const Tuple& tuple) {
+        if (!(main->insert(tuple))) {
+            return false;
+        }
+        for (std::size_t i = 1; i < indexes.size(); ++i) {
+            indexes[i]->insert(tuple);
+        }
+        return true;
+    }
+
+    // tuples of dynamic arity are not buffered but inserted right away
+    void append(const Tuple& tuple) {
+        insert(tuple);
+    }
+
+    void insertAll(const Relation& other, std::size_t partitionCount) {
+        struct Task {
+            Index* target;
+            const Index* source;
+            souffle::range<iterator> chunk;
+        };
+        std::vector<Task> tasks;
+        for (auto& index : indexes) {
+            const Index* source = other.main;
+            for (const auto& candidate : other.indexes) {
+                if (candidate->getOrder() == index->getOrder()) {
+                    source = candidate.get();
+                    break;
+                }
+            }
+            for (const auto& chunk : source->partitionScan(partitionCount)) {
+                tasks.push_back({index.get(), source, chunk});
+            }
+        }
+
+        const int numTasks = static_cast<int>(tasks.size());
+        PARALLEL_START
+            pfor(int i = 0; i < numTasks; ++i) {
+                tasks[i].target->insert(*tasks[i].source, tasks[i].chunk);
+            }
+        PARALLEL_END
+    }
+
+    bool contains(const Tuple& tuple) const {
+        return main->contains(tuple);
+    }
+
+    bool contains(const std::size_t& indexPos, const Tuple& low, const Tuple& high) const {
+        return indexes[indexPos]->contains(low, high);
+    }
+
+    souffle::range<iterator> scan() const {
+        return main->scan();
+    }
+
+    std::vector<souffle::range<iterator>> partitionScan(std::size_t partitionCount) const {
+        return main->partitionScan(partitionCount);
+    }
+
+    souffle::range<iterator> range(const std::size_t& indexPos, const Tuple& low, const Tuple& high) const {
+        return indexes[indexPos]->range(low, high);
+    }
+
+    std::vector<souffle::range<iterator>> partitionRange(const std::size_t& indexPos, const Tuple& low,
+            const Tuple& high, std::size_t partitionCount) const {
+        return indexes[indexPos]->partitionRange(low, high, partitionCount);
+    }
+
+    std::size_t __size() const {
+        return main->size();
+    }
+
+    bool empty() const {
+        return main->empty();
+    }
+
+    void __purge() {
+        for (auto& idx : indexes) {
+            idx->clear();
+        }
+    }
+
+    Index* getIndex(std::size_t idx) const {
+        return indexes.at(idx).get();
+    }
+
+protected:
+    // a map of managed indexes
+    VecOwn<Index> indexes;
+
+    // a pointer to the main index within the managed index
+    Index* main;
 };
 
 template <std::size_t _Arity>
@@ -447,10 +795,30 @@ using RelationFactory = Own<RelationWrapper> (*)(
 Own<RelationWrapper> createBTreeRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
 
+// A factory for BTree based relation with compressed leaves, see --compress-leaves.
+Own<RelationWrapper> createCompressedBTreeRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
 // A factory for BTreeDelete based relation.
 Own<RelationWrapper> createBTreeDeleteRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
 
+// A factory for relations based on sorted arrays, see SortedDeltaAnalysis.
+Own<RelationWrapper> createSortedArrayRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
+// A factory for compressed relations, based on packed arrays.
+Own<RelationWrapper> createPackedArrayRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
+// A factory for relations based on hash sets, see IndexAnalysis::isHashRelation.
+Own<RelationWrapper> createHashSetRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
+// A factory for lattice relations, based on BTrees.
+Own<RelationWrapper> createLatticeRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
 // A factory for BTree provenance index.
 Own<RelationWrapper> createProvenanceRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
@@ -459,6 +827,10 @@ Own<RelationWrapper> createProvenanceRelation(
 Own<RelationWrapper> createBrieRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
 
+// A factory for relations whose arity exceeds MaxFixedArity.
+Own<RelationWrapper> createGenericRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
 // A factory for Eqrel index.
 Own<RelationWrapper> createEqrelRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
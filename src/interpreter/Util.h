@@ -20,11 +20,29 @@
 #include "souffle/datastructure/BTree.h"
 #include "souffle/datastructure/BTreeDelete.h"
 #include "souffle/datastructure/Brie.h"
+#include "souffle/datastructure/ConcurrentHashSet.h"
 #include "souffle/datastructure/EquivalenceRelation.h"
+#include "souffle/datastructure/PackedArray.h"
+#include "souffle/datastructure/SortedArray.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include <cstddef>
+#include <limits>
 
 namespace souffle::interpreter {
+
+// The largest arity the btree, sorted array, hash set, packed array and brie structures are
+// instantiated for (see FOR_EACH_BTREE, FOR_EACH_SORTED_ARRAY, FOR_EACH_HASH_SET,
+// FOR_EACH_PACKED_ARRAY and FOR_EACH_BRIE); wider relations are represented by the Generic structure.
+constexpr std::size_t MaxFixedArity = 20;
+
+// The smallest arity the btree structure with compressed leaves is instantiated for (see
+// FOR_EACH_COMPRESSED_BTREE), used for wider relations if enabled by --compress-leaves.
+constexpr std::size_t MinCompressedLeafArity = 6;
+
+// The arity parameter of the Generic structure, whose arity is only known at runtime.
+constexpr std::size_t Dynamic = std::numeric_limits<std::size_t>::max();
+
 // clang-format off
 
 #define FOR_EACH_PROVENANCE(func, ...) \
@@ -82,6 +100,23 @@ namespace souffle::interpreter {
     func(Btree, 19, __VA_ARGS__) \
     func(Btree, 20, __VA_ARGS__)
 
+#define FOR_EACH_COMPRESSED_BTREE(func, ...)\
+    func(CompressedBtree, 6, __VA_ARGS__) \
+    func(CompressedBtree, 7, __VA_ARGS__) \
+    func(CompressedBtree, 8, __VA_ARGS__) \
+    func(CompressedBtree, 9, __VA_ARGS__) \
+    func(CompressedBtree, 10, __VA_ARGS__) \
+    func(CompressedBtree, 11, __VA_ARGS__) \
+    func(CompressedBtree, 12, __VA_ARGS__) \
+    func(CompressedBtree, 13, __VA_ARGS__) \
+    func(CompressedBtree, 14, __VA_ARGS__) \
+    func(CompressedBtree, 15, __VA_ARGS__) \
+    func(CompressedBtree, 16, __VA_ARGS__) \
+    func(CompressedBtree, 17, __VA_ARGS__) \
+    func(CompressedBtree, 18, __VA_ARGS__) \
+    func(CompressedBtree, 19, __VA_ARGS__) \
+    func(CompressedBtree, 20, __VA_ARGS__)
+
 #define FOR_EACH_BTREE_DELETE(func, ...)\
     func(BtreeDelete, 1, __VA_ARGS__) \
     func(BtreeDelete, 2, __VA_ARGS__) \
@@ -104,39 +139,155 @@ namespace souffle::interpreter {
     func(BtreeDelete, 19, __VA_ARGS__) \
     func(BtreeDelete, 20, __VA_ARGS__)
 
-// Brie is disabled for now.
-#define FOR_EACH_BRIE(func, ...)
-    /* func(Brie, 0, __VA_ARGS__) \ */
-    /* func(Brie, 1, __VA_ARGS__) \ */
-    /* func(Brie, 2, __VA_ARGS__) \ */
-    /* func(Brie, 3, __VA_ARGS__) \ */
-    /* func(Brie, 4, __VA_ARGS__) \ */
-    /* func(Brie, 5, __VA_ARGS__) \ */
-    /* func(Brie, 6, __VA_ARGS__) \ */
-    /* func(Brie, 7, __VA_ARGS__) \ */
-    /* func(Brie, 8, __VA_ARGS__) \ */
-    /* func(Brie, 9, __VA_ARGS__) \ */
-    /* func(Brie, 10, __VA_ARGS__) \ */
-    /* func(Brie, 11, __VA_ARGS__) \ */
-    /* func(Brie, 12, __VA_ARGS__) \ */
-    /* func(Brie, 13, __VA_ARGS__) \ */
-    /* func(Brie, 14, __VA_ARGS__) \ */
-    /* func(Brie, 15, __VA_ARGS__) \ */
-    /* func(Brie, 16, __VA_ARGS__) \ */
-    /* func(Brie, 17, __VA_ARGS__) \ */
-    /* func(Brie, 18, __VA_ARGS__) \ */
-    /* func(Brie, 19, __VA_ARGS__) \ */
-    /* func(Brie, 20, __VA_ARGS__)   */
+#define FOR_EACH_SORTED_ARRAY(func, ...)\
+    func(SortedArray, 1, __VA_ARGS__) \
+    func(SortedArray, 2, __VA_ARGS__) \
+    func(SortedArray, 3, __VA_ARGS__) \
+    func(SortedArray, 4, __VA_ARGS__) \
+    func(SortedArray, 5, __VA_ARGS__) \
+    func(SortedArray, 6, __VA_ARGS__) \
+    func(SortedArray, 7, __VA_ARGS__) \
+    func(SortedArray, 8, __VA_ARGS__) \
+    func(SortedArray, 9, __VA_ARGS__) \
+    func(SortedArray, 10, __VA_ARGS__) \
+    func(SortedArray, 11, __VA_ARGS__) \
+    func(SortedArray, 12, __VA_ARGS__) \
+    func(SortedArray, 13, __VA_ARGS__) \
+    func(SortedArray, 14, __VA_ARGS__) \
+    func(SortedArray, 15, __VA_ARGS__) \
+    func(SortedArray, 16, __VA_ARGS__) \
+    func(SortedArray, 17, __VA_ARGS__) \
+    func(SortedArray, 18, __VA_ARGS__) \
+    func(SortedArray, 19, __VA_ARGS__) \
+    func(SortedArray, 20, __VA_ARGS__)
+
+#define FOR_EACH_HASH_SET(func, ...)\
+    func(HashSet, 1, __VA_ARGS__) \
+    func(HashSet, 2, __VA_ARGS__) \
+    func(HashSet, 3, __VA_ARGS__) \
+    func(HashSet, 4, __VA_ARGS__) \
+    func(HashSet, 5, __VA_ARGS__) \
+    func(HashSet, 6, __VA_ARGS__) \
+    func(HashSet, 7, __VA_ARGS__) \
+    func(HashSet, 8, __VA_ARGS__) \
+    func(HashSet, 9, __VA_ARGS__) \
+    func(HashSet, 10, __VA_ARGS__) \
+    func(HashSet, 11, __VA_ARGS__) \
+    func(HashSet, 12, __VA_ARGS__) \
+    func(HashSet, 13, __VA_ARGS__) \
+    func(HashSet, 14, __VA_ARGS__) \
+    func(HashSet, 15, __VA_ARGS__) \
+    func(HashSet, 16, __VA_ARGS__) \
+    func(HashSet, 17, __VA_ARGS__) \
+    func(HashSet, 18, __VA_ARGS__) \
+    func(HashSet, 19, __VA_ARGS__) \
+    func(HashSet, 20, __VA_ARGS__)
+
+#define FOR_EACH_PACKED_ARRAY(func, ...)\
+    func(PackedArray, 1, __VA_ARGS__) \
+    func(PackedArray, 2, __VA_ARGS__) \
+    func(PackedArray, 3, __VA_ARGS__) \
+    func(PackedArray, 4, __VA_ARGS__) \
+    func(PackedArray, 5, __VA_ARGS__) \
+    func(PackedArray, 6, __VA_ARGS__) \
+    func(PackedArray, 7, __VA_ARGS__) \
+    func(PackedArray, 8, __VA_ARGS__) \
+    func(PackedArray, 9, __VA_ARGS__) \
+    func(PackedArray, 10, __VA_ARGS__) \
+    func(PackedArray, 11, __VA_ARGS__) \
+    func(PackedArray, 12, __VA_ARGS__) \
+    func(PackedArray, 13, __VA_ARGS__) \
+    func(PackedArray, 14, __VA_ARGS__) \
+    func(PackedArray, 15, __VA_ARGS__) \
+    func(PackedArray, 16, __VA_ARGS__) \
+    func(PackedArray, 17, __VA_ARGS__) \
+    func(PackedArray, 18, __VA_ARGS__) \
+    func(PackedArray, 19, __VA_ARGS__) \
+    func(PackedArray, 20, __VA_ARGS__)
+
+#define FOR_EACH_LATTICE(func, ...)\
+    func(LatticeMin, 1, __VA_ARGS__) \
+    func(LatticeMin, 2, __VA_ARGS__) \
+    func(LatticeMin, 3, __VA_ARGS__) \
+    func(LatticeMin, 4, __VA_ARGS__) \
+    func(LatticeMin, 5, __VA_ARGS__) \
+    func(LatticeMin, 6, __VA_ARGS__) \
+    func(LatticeMin, 7, __VA_ARGS__) \
+    func(LatticeMin, 8, __VA_ARGS__) \
+    func(LatticeMin, 9, __VA_ARGS__) \
+    func(LatticeMin, 10, __VA_ARGS__) \
+    func(LatticeMin, 11, __VA_ARGS__) \
+    func(LatticeMin, 12, __VA_ARGS__) \
+    func(LatticeMin, 13, __VA_ARGS__) \
+    func(LatticeMin, 14, __VA_ARGS__) \
+    func(LatticeMin, 15, __VA_ARGS__) \
+    func(LatticeMin, 16, __VA_ARGS__) \
+    func(LatticeMin, 17, __VA_ARGS__) \
+    func(LatticeMin, 18, __VA_ARGS__) \
+    func(LatticeMin, 19, __VA_ARGS__) \
+    func(LatticeMin, 20, __VA_ARGS__) \
+    func(LatticeMax, 1, __VA_ARGS__) \
+    func(LatticeMax, 2, __VA_ARGS__) \
+    func(LatticeMax, 3, __VA_ARGS__) \
+    func(LatticeMax, 4, __VA_ARGS__) \
+    func(LatticeMax, 5, __VA_ARGS__) \
+    func(LatticeMax, 6, __VA_ARGS__) \
+    func(LatticeMax, 7, __VA_ARGS__) \
+    func(LatticeMax, 8, __VA_ARGS__) \
+    func(LatticeMax, 9, __VA_ARGS__) \
+    func(LatticeMax, 10, __VA_ARGS__) \
+    func(LatticeMax, 11, __VA_ARGS__) \
+    func(LatticeMax, 12, __VA_ARGS__) \
+    func(LatticeMax, 13, __VA_ARGS__) \
+    func(LatticeMax, 14, __VA_ARGS__) \
+    func(LatticeMax, 15, __VA_ARGS__) \
+    func(LatticeMax, 16, __VA_ARGS__) \
+    func(LatticeMax, 17, __VA_ARGS__) \
+    func(LatticeMax, 18, __VA_ARGS__) \
+    func(LatticeMax, 19, __VA_ARGS__) \
+    func(LatticeMax, 20, __VA_ARGS__)
+
+#define FOR_EACH_BRIE(func, ...)\
+    func(Brie, 0, __VA_ARGS__) \
+    func(Brie, 1, __VA_ARGS__) \
+    func(Brie, 2, __VA_ARGS__) \
+    func(Brie, 3, __VA_ARGS__) \
+    func(Brie, 4, __VA_ARGS__) \
+    func(Brie, 5, __VA_ARGS__) \
+    func(Brie, 6, __VA_ARGS__) \
+    func(Brie, 7, __VA_ARGS__) \
+    func(Brie, 8, __VA_ARGS__) \
+    func(Brie, 9, __VA_ARGS__) \
+    func(Brie, 10, __VA_ARGS__) \
+    func(Brie, 11, __VA_ARGS__) \
+    func(Brie, 12, __VA_ARGS__) \
+    func(Brie, 13, __VA_ARGS__) \
+    func(Brie, 14, __VA_ARGS__) \
+    func(Brie, 15, __VA_ARGS__) \
+    func(Brie, 16, __VA_ARGS__) \
+    func(Brie, 17, __VA_ARGS__) \
+    func(Brie, 18, __VA_ARGS__) \
+    func(Brie, 19, __VA_ARGS__) \
+    func(Brie, 20, __VA_ARGS__)
 
 #define FOR_EACH_EQREL(func, ...)\
     func(Eqrel, 2, __VA_ARGS__)
 
+#define FOR_EACH_GENERIC(func, ...)\
+    func(Generic, Dynamic, __VA_ARGS__)
+
 #define FOR_EACH(func, ...)                 \
     FOR_EACH_BTREE(func, __VA_ARGS__)       \
+    FOR_EACH_COMPRESSED_BTREE(func, __VA_ARGS__)       \
     FOR_EACH_BTREE_DELETE(func, __VA_ARGS__)       \
+    FOR_EACH_SORTED_ARRAY(func, __VA_ARGS__)       \
+    FOR_EACH_HASH_SET(func, __VA_ARGS__)       \
+    FOR_EACH_PACKED_ARRAY(func, __VA_ARGS__)       \
+    FOR_EACH_LATTICE(func, __VA_ARGS__)     \
     FOR_EACH_BRIE(func, __VA_ARGS__)        \
     FOR_EACH_PROVENANCE(func, __VA_ARGS__)  \
-    FOR_EACH_EQREL(func, __VA_ARGS__)
+    FOR_EACH_EQREL(func, __VA_ARGS__)       \
+    FOR_EACH_GENERIC(func, __VA_ARGS__)
 
 // clang-format on
 
@@ -147,11 +298,23 @@ namespace index_utils {
 
 // -------- generic tuple comparator ----------
 
+// whether the given columns are 0, 1, 2, ... in this order
+template <unsigned... Columns>
+constexpr bool is_natural_order() {
+    unsigned pos = 0;
+    return ((Columns == pos++) && ...);
+}
+
 template <unsigned... Columns>
 struct comparator;
 
 template <unsigned First, unsigned... Rest>
 struct comparator<First, Rest...> {
+    // columns in natural order compare the leading components of tuples lexicographically
+    // by their signed values, enabling SIMD searches in b-trees (see detail::simd_search)
+    static constexpr std::size_t lexicographic_signed_arity =
+            is_natural_order<First, Rest...>() ? 1 + sizeof...(Rest) : 0;
+
     template <typename T>
     int operator()(const T& a, const T& b) const {
         return (a[First] < b[First]) ? -1 : ((a[First] > b[First]) ? 1 : comparator<Rest...>()(a, b));
@@ -244,18 +407,89 @@ using comparator = typename index_utils::get_full_index<Arity>::type::comparator
 template <std::size_t Arity>
 using prov_comparator = typename index_utils::get_full_prov_index<Arity>::type::comparator;
 
-// Alias for btree_set
+// Alias for btree_set, maintaining the number of distinct prefixes of its tuples
 template <std::size_t Arity>
-using Btree = btree_set<t_tuple<Arity>, comparator<Arity>>;
+using Btree = btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>, 256,
+        typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity>,
+        detail::updater<t_tuple<Arity>>, detail::prefix_statistics<t_tuple<Arity>>>;
 
-// Alias for btree_set
+// Alias for btree_set sharing common prefixes among the tuples of its leaves (see --compress-leaves)
 template <std::size_t Arity>
-using BtreeDelete = btree_delete_set<t_tuple<Arity>, comparator<Arity>>;
+using CompressedBtree = btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>, 256,
+        typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity>,
+        detail::updater<t_tuple<Arity>>, detail::prefix_statistics<t_tuple<Arity>>,
+        detail::prefix_compression<t_tuple<Arity>>>;
+
+// Alias for btree_delete_set, maintaining the number of distinct prefixes of its tuples
+template <std::size_t Arity>
+using BtreeDelete = btree_delete_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>, 256,
+        typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity>,
+        detail::updater<t_tuple<Arity>>, detail::prefix_statistics<t_tuple<Arity>>>;
+
+// Alias for sorted_array_set, storing the delta relations of fixpoints (see SortedDeltaAnalysis)
+template <std::size_t Arity>
+using SortedArray = sorted_array_set<t_tuple<Arity>, comparator<Arity>>;
+
+// Alias for concurrent_hash_set, storing relations only searched by all of their columns (see
+// IndexAnalysis::isHashRelation)
+template <std::size_t Arity>
+using HashSet = concurrent_hash_set<t_tuple<Arity>>;
+
+// Alias for packed_array_set, storing compressed relations with narrowed columns
+template <std::size_t Arity>
+using PackedArray = packed_array_set<t_tuple<Arity>, comparator<Arity>>;
 
 // Alias for Trie
 template <std::size_t Arity>
 using Brie = Trie<Arity>;
 
+/**
+ * A reference to a tuple whose arity is only known at runtime.
+ * The referenced data is owned by the index storing the tuple.
+ */
+class TupleRef {
+    const RamDomain* ptr = nullptr;
+
+public:
+    TupleRef() = default;
+    TupleRef(const RamDomain* ptr) : ptr(ptr) {}
+
+    const RamDomain* data() const {
+        return ptr;
+    }
+
+    RamDomain operator[](std::size_t idx) const {
+        return ptr[idx];
+    }
+};
+
+/**
+ * A lexicographical comparator on tuples of a runtime arity.
+ */
+struct dynamic_comparator {
+    std::size_t arity = 0;
+
+    int operator()(const TupleRef& a, const TupleRef& b) const {
+        for (std::size_t i = 0; i < arity; ++i) {
+            if (a[i] != b[i]) {
+                return (a[i] < b[i]) ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+    bool less(const TupleRef& a, const TupleRef& b) const {
+        return (*this)(a, b) < 0;
+    }
+    bool equal(const TupleRef& a, const TupleRef& b) const {
+        return (*this)(a, b) == 0;
+    }
+};
+
+// Alias for relations of a runtime arity
+// Note: only instantiated with Arity = Dynamic, see Index<Dynamic, Generic>.
+template <std::size_t Arity>
+using Generic = btree_set<TupleRef, dynamic_comparator>;
+
 // Updater for Provenance
 template <std::size_t Arity>
 struct ProvenanceUpdater {
@@ -271,6 +505,30 @@ using Provenance = btree_set<t_tuple<Arity>, prov_comparator<Arity>, std::alloca
         typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - 2>,
         ProvenanceUpdater<Arity>>;
 
+// Updater for lattices, joining the last column of tuples weakly equal by their other columns
+// by min, or by max if Max is set
+template <std::size_t Arity, bool Max>
+struct LatticeUpdater {
+    bool updates(const t_tuple<Arity>& old_t, const t_tuple<Arity>& new_t) const {
+        return Max ? old_t[Arity - 1] < new_t[Arity - 1] : new_t[Arity - 1] < old_t[Arity - 1];
+    }
+    void update(t_tuple<Arity>& old_t, const t_tuple<Arity>& new_t) {
+        old_t[Arity - 1] = new_t[Arity - 1];
+    }
+};
+
+// Alias for lattices joined by min, requires the last column to be the last of every index order
+template <std::size_t Arity>
+using LatticeMin = btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>, 256,
+        typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - 1>,
+        LatticeUpdater<Arity, false>>;
+
+// Alias for lattices joined by max, requires the last column to be the last of every index order
+template <std::size_t Arity>
+using LatticeMax = btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>, 256,
+        typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - 1>,
+        LatticeUpdater<Arity, true>>;
+
 // Alias for Eqrel
 // Note: require Arity = 2.
 template <std::size_t Arity>
@@ -19,7 +19,9 @@
 
 #include "interpreter/Node.h"
 #include <array>
+#include <cstddef>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace souffle::interpreter {
@@ -31,6 +33,13 @@ namespace souffle::interpreter {
  */
 class ViewContext {
 public:
+    /** Information for building the hash table of a hash join */
+    struct HashTableInfo {
+        std::size_t relId;
+        std::vector<std::size_t> keyColumns;
+        std::size_t tablePos;
+    };
+
     /** @brief Add outer-most filter operation which requires a view.  */
     void addViewOperationForFilter(Own<Node> node) {
         outerFilterViewOps.push_back(std::move(node));
@@ -81,6 +90,16 @@ public:
         viewInfoForNested.push_back({relId, indexPos, viewPos});
     }
 
+    /** @brief Add hash table creation information into the list for nested operations. */
+    void addHashTableInfo(std::size_t relId, std::vector<std::size_t> keyColumns, std::size_t tablePos) {
+        hashTableInfo.push_back({relId, std::move(keyColumns), tablePos});
+    }
+
+    /** @brief Return hash table information for nested operations */
+    const std::vector<HashTableInfo>& getHashTableInfo() const {
+        return hashTableInfo;
+    }
+
     /** If this context has information for parallel operation.  */
     bool isParallel = false;
 
@@ -95,6 +114,8 @@ private:
     std::vector<std::array<std::size_t, 3>> viewInfoForFilter;
     /** Vector of View information in nested operations */
     std::vector<std::array<std::size_t, 3>> viewInfoForNested;
+    /** Vector of hash table information in nested operations */
+    std::vector<HashTableInfo> hashTableInfo;
 };
 
 }  // namespace souffle::interpreter
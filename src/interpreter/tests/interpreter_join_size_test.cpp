@@ -0,0 +1,143 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file interpreter_join_size_test.cpp
+ *
+ * Tests the join size estimates of the interpreter against exact counts
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "interpreter/Index.h"
+#include "interpreter/JoinSizeEstimate.h"
+#include "souffle/RamTypes.h"
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+using TestIndex = Index<3, Btree>;
+using Constants = std::map<std::size_t, RamDomain>;
+
+// a skewed relation: (a, b, c) for b < a % 10 + 1 and c < 5
+TestIndex::Tuple tuple(RamDomain a, RamDomain b, RamDomain c) {
+    return {a, b, c};
+}
+
+void fill(TestIndex& index) {
+    std::vector<TestIndex::Tuple> tuples;
+    for (RamDomain a = 0; a < 20000; ++a) {
+        for (RamDomain b = 0; b <= a % 10; ++b) {
+            for (RamDomain c = 0; c < 5; ++c) {
+                tuples.push_back(tuple(a, b, c));
+            }
+        }
+    }
+    for (const auto& cur : tuples) {
+        index.insert(cur);
+    }
+}
+
+JoinSizeCounts count(const TestIndex& index, std::size_t keyLength, const Constants& constants,
+        std::size_t sampleSize) {
+    return countJoinSize(index, tuple(MIN_RAM_SIGNED, MIN_RAM_SIGNED, MIN_RAM_SIGNED),
+            tuple(MAX_RAM_SIGNED, MAX_RAM_SIGNED, MAX_RAM_SIGNED), keyLength, constants, sampleSize);
+}
+
+/** Counts matching tuples, and those repeating their predecessor, by a scan of the index. */
+JoinSizeCounts reference(const TestIndex& index, std::size_t keyLength, const Constants& constants) {
+    JoinSizeCounts res;
+    const TestIndex::Tuple* prev = nullptr;
+    std::vector<TestIndex::Tuple> matching;
+    for (const auto& cur : index.scan()) {
+        bool matches = true;
+        for (const auto& [column, value] : constants) {
+            matches = matches && cur[column] == value;
+        }
+        if (matches) {
+            matching.push_back(cur);
+        }
+    }
+    for (const auto& cur : matching) {
+        if (prev != nullptr) {
+            bool repeats = true;
+            for (std::size_t i = 0; i < keyLength; ++i) {
+                repeats = repeats && cur[i] == (*prev)[i];
+            }
+            res.duplicates += repeats ? 1 : 0;
+        }
+        res.total += 1;
+        prev = &cur;
+    }
+    return res;
+}
+
+bool near(double expected, double actual) {
+    return std::abs(expected - actual) <= 0.1 * expected;
+}
+
+TEST(JoinSize, FullScanIsExact) {
+    TestIndex index(Order({0, 1, 2}));
+    fill(index);
+    for (const Constants& constants : {Constants{}, Constants{{0, 7}}, Constants{{1, 3}}}) {
+        const auto exact = reference(index, 2, constants);
+        const auto counts = count(index, 2, constants, 0);
+        EXPECT_EQ(exact.total, counts.total);
+        EXPECT_EQ(exact.duplicates, counts.duplicates);
+    }
+}
+
+TEST(JoinSize, SampledWithoutConstants) {
+    TestIndex index(Order({0, 1, 2}));
+    fill(index);
+    const auto exact = reference(index, 2, {});
+    EXPECT_EQ(550000, exact.total);
+
+    // sampled from chunks of the index
+    auto counts = count(index, 2, {}, 2500);
+    EXPECT_EQ(exact.total, counts.total);
+    EXPECT_TRUE(near(exact.duplicates, counts.duplicates));
+
+    // looked up in the prefix statistics
+    index.enablePrefixStatistics();
+    counts = count(index, 2, {}, 2500);
+    EXPECT_EQ(exact.total, counts.total);
+    EXPECT_TRUE(near(exact.duplicates, counts.duplicates));
+}
+
+TEST(JoinSize, SampledWithConstants) {
+    TestIndex index(Order({0, 1, 2}));
+    fill(index);
+
+    // the tuples matching a constant prefix form a run, which is looked up and counted exactly
+    for (RamDomain a : {0, 7, 12345}) {
+        const Constants constants = {{0, a}};
+        const auto exact = reference(index, 2, constants);
+        EXPECT_EQ(5 * (a % 10 + 1), exact.total);
+        const auto counts = count(index, 2, constants, 2500);
+        EXPECT_EQ(exact.total, counts.total);
+        EXPECT_EQ(exact.duplicates, counts.duplicates);
+    }
+
+    // constants of other columns are estimated from the samples
+    const Constants constants = {{1, 3}};
+    const auto exact = reference(index, 2, constants);
+    const auto counts = count(index, 2, constants, 2500);
+    EXPECT_TRUE(near(exact.total, counts.total));
+    EXPECT_TRUE(near(exact.duplicates, counts.duplicates));
+
+    // absent constants match nothing
+    EXPECT_EQ(0, count(index, 2, {{0, 20000}}, 2500).total);
+}
+
+}  // namespace souffle::interpreter::test
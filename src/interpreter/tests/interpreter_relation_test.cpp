@@ -21,9 +21,13 @@
 #include "ram/analysis/Index.h"
 #include "souffle/SouffleInterface.h"
 #include "souffle/datastructure/SymbolTableImpl.h"
+#include <atomic>
 #include <iosfwd>
+#include <iterator>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace souffle::interpreter::test {
 
@@ -287,4 +291,464 @@ TEST(Reordering, Iteration) {
     }
 }
 
+TEST(Brie, Range) {
+    // create a brie relation with a primary and a secondary index
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(3);
+    SearchSignature lastBound = SearchSignature(3);
+    lastBound[2] = AttributeConstraint::Equal;
+    SearchSet searches = {existenceCheck, lastBound};
+    LexOrder fullOrder = {0, 1, 2};
+    LexOrder secondaryOrder = {2, 0, 1};
+    OrderCollection orders = {fullOrder, secondaryOrder};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({lastBound, secondaryOrder});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<3, interpreter::Brie> rel(0, "test", indexSelection);
+    for (RamDomain i = 0; i < 100; ++i) {
+        EXPECT_TRUE(rel.insert(souffle::Tuple<RamDomain, 3>{i, i % 10, i % 3}));
+    }
+    EXPECT_FALSE(rel.insert(souffle::Tuple<RamDomain, 3>{0, 0, 0}));
+    EXPECT_EQ(100, rel.size());
+
+    // range query on the secondary index, tuples are encoded in its order
+    souffle::Tuple<RamDomain, 3> low{1, MIN_RAM_SIGNED, MIN_RAM_SIGNED};
+    souffle::Tuple<RamDomain, 3> high{1, MAX_RAM_SIGNED, MAX_RAM_SIGNED};
+    std::size_t count = 0;
+    for (const auto& cur : rel.range(1, low, high)) {
+        EXPECT_EQ(1, cur[0]);
+        EXPECT_EQ(cur[1] % 3, 1);
+        ++count;
+    }
+    EXPECT_EQ(33, count);
+
+    // partitions of a scan cover the whole relation
+    count = 0;
+    for (const auto& chunk : rel.partitionScan(8)) {
+        for (const auto& cur : chunk) {
+            (void)cur;
+            ++count;
+        }
+    }
+    EXPECT_EQ(100, count);
+
+    rel.purge();
+    EXPECT_EQ(0, rel.size());
+}
+
+TEST(BtreeDelete, InsertAll) {
+    // the target has an index in the order of the source and one in another order
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(3);
+    SearchSignature lastBound = SearchSignature(3);
+    lastBound[2] = AttributeConstraint::Equal;
+    LexOrder fullOrder = {0, 1, 2};
+    LexOrder secondaryOrder = {2, 0, 1};
+    mapping.insert({existenceCheck, fullOrder});
+    IndexCluster sourceSelection(mapping, {existenceCheck}, {fullOrder});
+    mapping.insert({lastBound, secondaryOrder});
+    IndexCluster targetSelection(mapping, {existenceCheck, lastBound}, {fullOrder, secondaryOrder});
+
+    Relation<3, interpreter::Btree> source(0, "source", sourceSelection);
+    BtreeDeleteRelation<3> target(0, "target", targetSelection);
+    for (RamDomain i = 0; i < 5000; ++i) {
+        source.insert(souffle::Tuple<RamDomain, 3>{i, i % 10, i % 3});
+    }
+    for (RamDomain i = 4000; i < 6000; ++i) {
+        target.insert(souffle::Tuple<RamDomain, 3>{i, i % 10, i % 3});
+    }
+
+    target.insertAll(source, 16);
+    EXPECT_EQ(6000, target.size());
+    EXPECT_EQ(5000, source.size());
+
+    // both indexes hold the union
+    for (RamDomain i = 0; i < 6000; ++i) {
+        EXPECT_TRUE(target.contains(souffle::Tuple<RamDomain, 3>{i, i % 10, i % 3}));
+    }
+    souffle::Tuple<RamDomain, 3> low{2, MIN_RAM_SIGNED, MIN_RAM_SIGNED};
+    souffle::Tuple<RamDomain, 3> high{2, MAX_RAM_SIGNED, MAX_RAM_SIGNED};
+    std::size_t count = 0;
+    for (const auto& cur : target.range(1, low, high)) {
+        EXPECT_EQ(2, cur[0]);
+        EXPECT_EQ(cur[1] % 3, 2);
+        ++count;
+    }
+    EXPECT_EQ(2000, count);
+}
+
+TEST(Btree, InsertBatch) {
+    // a relation with an index in natural order and one in another order
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(3);
+    SearchSignature lastBound = SearchSignature(3);
+    lastBound[2] = AttributeConstraint::Equal;
+    LexOrder fullOrder = {0, 1, 2};
+    LexOrder secondaryOrder = {2, 0, 1};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({lastBound, secondaryOrder});
+    IndexCluster indexSelection(mapping, {existenceCheck, lastBound}, {fullOrder, secondaryOrder});
+
+    Relation<3, interpreter::Btree> rel(0, "test", indexSelection);
+    RelationWrapper* wrapper = &rel;
+
+    // batches are unsorted and overlap each other
+    auto batch = [](RamDomain from, RamDomain to) {
+        std::vector<RamDomain> data;
+        for (RamDomain i = to - 1; i >= from; --i) {
+            data.insert(data.end(), {i, i % 10, i % 3});
+        }
+        return data;
+    };
+    auto first = batch(0, 5000);
+    wrapper->insertBatch(first.data(), 5000);
+    EXPECT_EQ(5000, rel.size());
+    auto second = batch(4000, 6000);
+    wrapper->insertBatch(second.data(), 2000);
+    EXPECT_EQ(6000, rel.size());
+    auto third = batch(5990, 6010);
+    wrapper->insertBatch(third.data(), 20);
+    EXPECT_EQ(6010, rel.size());
+
+    // both indexes hold all tuples
+    std::size_t count = 0;
+    souffle::Tuple<RamDomain, 3> low{2, MIN_RAM_SIGNED, MIN_RAM_SIGNED};
+    souffle::Tuple<RamDomain, 3> high{2, MAX_RAM_SIGNED, MAX_RAM_SIGNED};
+    for (const auto& cur : rel.range(1, low, high)) {
+        EXPECT_EQ(2, cur[0]);
+        ++count;
+    }
+    EXPECT_EQ(2003, count);
+
+    // empty relations are built from all tuples of the other relation
+    Relation<3, interpreter::Btree> copy(0, "copy", indexSelection);
+    copy.insertAll(rel, 16);
+    EXPECT_EQ(6010, copy.size());
+    for (RamDomain i = 0; i < 6010; ++i) {
+        EXPECT_TRUE(copy.contains(souffle::Tuple<RamDomain, 3>{i, i % 10, i % 3}));
+    }
+    auto copied = copy.range(1, low, high);
+    EXPECT_EQ(2003, std::distance(copied.begin(), copied.end()));
+}
+
+TEST(Btree, AppendSeal) {
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(2);
+    SearchSignature lastBound = SearchSignature(2);
+    lastBound[1] = AttributeConstraint::Equal;
+    LexOrder fullOrder = {0, 1};
+    LexOrder secondaryOrder = {1, 0};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({lastBound, secondaryOrder});
+    IndexCluster indexSelection(mapping, {existenceCheck, lastBound}, {fullOrder, secondaryOrder});
+
+    Relation<2, interpreter::Btree> rel(0, "test", indexSelection);
+    rel.insert(souffle::Tuple<RamDomain, 2>{0, 0});
+
+    // appended tuples, including duplicates of each other and of present ones, only show once sealed
+    for (RamDomain i = 999; i >= 0; --i) {
+        rel.append(souffle::Tuple<RamDomain, 2>{i, i % 7});
+        rel.append(souffle::Tuple<RamDomain, 2>{i, i % 7});
+    }
+    EXPECT_EQ(1, rel.size());
+    rel.seal();
+    EXPECT_EQ(1000, rel.size());
+
+    souffle::Tuple<RamDomain, 2> low{3, MIN_RAM_SIGNED};
+    souffle::Tuple<RamDomain, 2> high{3, MAX_RAM_SIGNED};
+    auto range = rel.range(1, low, high);
+    EXPECT_EQ(143, std::distance(range.begin(), range.end()));
+
+    // purging discards tuples not sealed yet
+    rel.append(souffle::Tuple<RamDomain, 2>{1000, 1});
+    rel.purge();
+    rel.seal();
+    EXPECT_EQ(0, rel.size());
+}
+
+TEST(SortedArray, InsertAll) {
+    // delta relations are merged from btrees, and merged into them
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(2);
+    SearchSignature lastBound = SearchSignature(2);
+    lastBound[1] = AttributeConstraint::Equal;
+    LexOrder fullOrder = {0, 1};
+    LexOrder secondaryOrder = {1, 0};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({lastBound, secondaryOrder});
+    IndexCluster indexSelection(mapping, {existenceCheck, lastBound}, {fullOrder, secondaryOrder});
+
+    Relation<2, interpreter::Btree> full(0, "full", indexSelection);
+    Relation<2, interpreter::SortedArray> delta(0, "delta", indexSelection);
+    for (RamDomain i = 0; i < 3000; ++i) {
+        full.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+    }
+    delta.insertAll(full, 16);
+    EXPECT_EQ(3000, delta.size());
+
+    // appended tuples are merged with the sorted ones
+    for (RamDomain i = 2000; i < 5000; ++i) {
+        delta.append(souffle::Tuple<RamDomain, 2>{i, i % 7});
+    }
+    delta.seal();
+    EXPECT_EQ(5000, delta.size());
+    for (RamDomain i = 0; i < 5000; ++i) {
+        EXPECT_TRUE(delta.contains(souffle::Tuple<RamDomain, 2>{i, i % 7}));
+    }
+    souffle::Tuple<RamDomain, 2> low{3, MIN_RAM_SIGNED};
+    souffle::Tuple<RamDomain, 2> high{3, MAX_RAM_SIGNED};
+    auto range = delta.range(1, low, high);
+    EXPECT_EQ(714, std::distance(range.begin(), range.end()));
+
+    full.insertAll(delta, 16);
+    EXPECT_EQ(5000, full.size());
+}
+
+TEST(HashSet, InsertAll) {
+    // relations stored in hash sets are merged with the other data structures of a fixpoint
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(2);
+    LexOrder fullOrder = {0, 1};
+    mapping.insert({existenceCheck, fullOrder});
+    IndexCluster indexSelection(mapping, {existenceCheck}, {fullOrder});
+
+    Relation<2, interpreter::Btree> full(0, "full", indexSelection);
+    Relation<2, interpreter::SortedArray> delta(0, "delta", indexSelection);
+    Relation<2, interpreter::HashSet> rel(0, "rel", indexSelection);
+    for (RamDomain i = 0; i < 3000; ++i) {
+        full.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+    }
+    for (RamDomain i = 2000; i < 5000; ++i) {
+        delta.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+    }
+    rel.insertAll(full, 16);
+    EXPECT_EQ(3000, rel.size());
+    rel.insertAll(delta, 16);
+    EXPECT_EQ(5000, rel.size());
+    for (RamDomain i = 0; i < 5000; ++i) {
+        EXPECT_TRUE(rel.contains(souffle::Tuple<RamDomain, 2>{i, i % 7}));
+    }
+    EXPECT_FALSE(rel.contains(souffle::Tuple<RamDomain, 2>{1, 2}));
+
+    // searches bind all columns, or none
+    souffle::Tuple<RamDomain, 2> tuple{10, 3};
+    auto found = rel.range(0, tuple, tuple);
+    EXPECT_EQ(1, std::distance(found.begin(), found.end()));
+    souffle::Tuple<RamDomain, 2> low{MIN_RAM_SIGNED, MIN_RAM_SIGNED};
+    souffle::Tuple<RamDomain, 2> high{MAX_RAM_SIGNED, MAX_RAM_SIGNED};
+    auto all = rel.range(0, low, high);
+    EXPECT_EQ(5000, std::distance(all.begin(), all.end()));
+
+    full.insertAll(rel, 16);
+    EXPECT_EQ(5000, full.size());
+}
+
+TEST(PackedArray, InsertBatch) {
+    // compressed relations are loaded in batches, and searched by all of their indexes
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(3);
+    SearchSignature lastBound = SearchSignature(3);
+    lastBound[2] = AttributeConstraint::Equal;
+    LexOrder fullOrder = {0, 1, 2};
+    LexOrder secondaryOrder = {2, 0, 1};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({lastBound, secondaryOrder});
+    IndexCluster indexSelection(mapping, {existenceCheck, lastBound}, {fullOrder, secondaryOrder});
+
+    Relation<3, interpreter::PackedArray> rel(0, "test", indexSelection);
+    RelationWrapper* wrapper = &rel;
+
+    // the columns widen as the batches extend their ranges
+    auto batch = [](RamDomain from, RamDomain to) {
+        std::vector<RamDomain> data;
+        for (RamDomain i = to - 1; i >= from; --i) {
+            data.insert(data.end(), {i, i % 10, -(i % 3)});
+        }
+        return data;
+    };
+    auto first = batch(0, 200);
+    wrapper->insertBatch(first.data(), 200);
+    EXPECT_EQ(200, rel.size());
+    auto second = batch(100, 100000);
+    wrapper->insertBatch(second.data(), 99900);
+    EXPECT_EQ(100000, rel.size());
+
+    for (RamDomain i = 0; i < 100000; i += 7) {
+        EXPECT_TRUE(rel.contains(souffle::Tuple<RamDomain, 3>{i, i % 10, -(i % 3)}));
+    }
+    EXPECT_FALSE(rel.contains(souffle::Tuple<RamDomain, 3>{1, 2, 0}));
+    std::size_t count = 0;
+    souffle::Tuple<RamDomain, 3> low{-2, MIN_RAM_SIGNED, MIN_RAM_SIGNED};
+    souffle::Tuple<RamDomain, 3> high{-2, MAX_RAM_SIGNED, MAX_RAM_SIGNED};
+    for (const auto& cur : rel.range(1, low, high)) {
+        EXPECT_EQ(-2, cur[0]);
+        ++count;
+    }
+    EXPECT_EQ(33333, count);
+
+    // tuples are decoded in the order of the attributes
+    count = 0;
+    for (const RamDomain* cur : *wrapper) {
+        EXPECT_EQ(static_cast<RamDomain>(count), cur[0]);
+        EXPECT_EQ(-(cur[0] % 3), cur[2]);
+        ++count;
+    }
+    EXPECT_EQ(100000, count);
+}
+
+TEST(Generic, Range) {
+    // create a relation above the instantiated arities with a primary and a secondary index
+    constexpr std::size_t arity = 25;
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(arity);
+    SearchSignature lastBound = SearchSignature(arity);
+    lastBound[arity - 1] = AttributeConstraint::Equal;
+    SearchSet searches = {existenceCheck, lastBound};
+    LexOrder fullOrder;
+    LexOrder secondaryOrder = {arity - 1};
+    for (std::size_t i = 0; i < arity; ++i) {
+        fullOrder.push_back(i);
+    }
+    OrderCollection orders = {fullOrder, secondaryOrder};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({lastBound, secondaryOrder});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<Dynamic, interpreter::Generic> rel(arity, 0, "test", indexSelection);
+    RelationWrapper* wrapper = &rel;
+    EXPECT_EQ(arity, wrapper->getArity());
+
+    // each tuple is i followed by its residues modulo 2 .. arity
+    auto make = [&](RamDomain i) {
+        std::vector<RamDomain> tuple(arity);
+        tuple[0] = i;
+        for (std::size_t j = 1; j < arity; ++j) {
+            tuple[j] = i % static_cast<RamDomain>(j + 1);
+        }
+        return tuple;
+    };
+    for (RamDomain i = 0; i < 3000; ++i) {
+        EXPECT_TRUE(rel.insert(make(i)));
+    }
+    EXPECT_FALSE(rel.insert(make(0)));
+    EXPECT_EQ(3000, rel.size());
+    EXPECT_TRUE(wrapper->contains(make(42).data()));
+    EXPECT_FALSE(wrapper->contains(make(3000).data()));
+
+    // range query on the secondary index, tuples are encoded in its order
+    std::vector<RamDomain> low(arity, MIN_RAM_SIGNED);
+    std::vector<RamDomain> high(arity, MAX_RAM_SIGNED);
+    low[0] = high[0] = 7;
+    std::size_t count = 0;
+    for (const auto& cur : rel.range(1, low, high)) {
+        EXPECT_EQ(7, cur[0]);
+        EXPECT_EQ(cur[1] % static_cast<RamDomain>(arity), 7);
+        ++count;
+    }
+    EXPECT_EQ(120, count);
+
+    // the wrapper iterates decoded tuples in the order of the primary index
+    RamDomain expected = 0;
+    for (auto it = wrapper->begin(); it != wrapper->end(); ++it) {
+        EXPECT_EQ(expected, (*it)[0]);
+        EXPECT_EQ(expected % static_cast<RamDomain>(arity), (*it)[arity - 1]);
+        ++expected;
+    }
+    EXPECT_EQ(3000, expected);
+
+    rel.purge();
+    EXPECT_EQ(0, rel.size());
+}
+
+TEST(Generic, InsertAll) {
+    constexpr std::size_t arity = 25;
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(arity);
+    LexOrder fullOrder;
+    LexOrder reverseOrder;
+    for (std::size_t i = 0; i < arity; ++i) {
+        fullOrder.push_back(i);
+        reverseOrder.push_back(arity - 1 - i);
+    }
+    mapping.insert({existenceCheck, fullOrder});
+    IndexCluster sourceSelection(mapping, {existenceCheck}, {fullOrder});
+    IndexCluster targetSelection(mapping, {existenceCheck}, {fullOrder, reverseOrder});
+
+    Relation<Dynamic, interpreter::Generic> source(arity, 0, "source", sourceSelection);
+    Relation<Dynamic, interpreter::Generic> target(arity, 0, "target", targetSelection);
+    auto make = [&](RamDomain i) {
+        std::vector<RamDomain> tuple(arity);
+        for (std::size_t j = 0; j < arity; ++j) {
+            tuple[j] = i % static_cast<RamDomain>(j + 2);
+        }
+        tuple[0] = i;
+        return tuple;
+    };
+    for (RamDomain i = 0; i < 3000; ++i) {
+        source.insert(make(i));
+    }
+    for (RamDomain i = 2000; i < 4000; ++i) {
+        target.insert(make(i));
+    }
+
+    target.insertAll(source, 16);
+    EXPECT_EQ(4000, target.size());
+    for (RamDomain i = 0; i < 4000; ++i) {
+        EXPECT_TRUE(target.contains(make(i)));
+    }
+
+    // the index of another order than the source holds the union as well
+    std::vector<RamDomain> low(arity, MIN_RAM_SIGNED);
+    std::vector<RamDomain> high(arity, MAX_RAM_SIGNED);
+    std::size_t count = 0;
+    for (const auto& cur : target.range(1, low, high)) {
+        // tuples are encoded in reverse, the last column is i % (arity + 1)
+        EXPECT_EQ(cur[arity - 1] % static_cast<RamDomain>(arity + 1), cur[0]);
+        ++count;
+    }
+    EXPECT_EQ(4000, count);
+}
+
+
+TEST(Generic, ConcurrentDuplicates) {
+    // exposes the number of storage blocks of the index
+    struct Probe : public Index<Dynamic, Generic> {
+        using Index::Index;
+        std::size_t numBlocks() const {
+            return blocks.size();
+        }
+    };
+    constexpr std::size_t arity = 25;
+    std::vector<std::size_t> columns;
+    for (std::size_t i = 0; i < arity; ++i) {
+        columns.push_back(arity - 1 - i);
+    }
+    Probe index{Order(columns)};
+
+    // threads insert the same tuples concurrently, such that most insertions are rejected
+    constexpr RamDomain count = 1000;
+    std::atomic<int> started = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (++started; started < 8;) {
+                std::this_thread::yield();
+            }
+            for (int round = 0; round < 50; ++round) {
+                for (RamDomain i = 0; i < count; ++i) {
+                    index.insert(std::vector<RamDomain>(arity, i));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(count, index.size());
+
+    // the storage of rejected tuples is reused, rather than one slot leaked for each of them
+    EXPECT_EQ(1, index.numBlocks());
+}
+
 }  // namespace souffle::interpreter::test
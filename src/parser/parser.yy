@@ -135,6 +135,8 @@
 %token BTREE_QUALIFIER           "BTREE datastructure qualifier"
 %token BTREE_DELETE_QUALIFIER    "BTREE_DELETE datastructure qualifier"
 %token EQREL_QUALIFIER           "equivalence relation qualifier"
+%token LATTICE_QUALIFIER         "lattice relation qualifier"
+%token COMPRESSED_QUALIFIER      "COMPRESSED datastructure qualifier"
 %token OVERRIDABLE_QUALIFIER     "relation qualifier overidable"
 %token INLINE_QUALIFIER          "relation qualifier inline"
 %token NO_INLINE_QUALIFIER       "relation qualifier no_inline"
@@ -577,6 +579,18 @@ relation_tags
     {
       $$ = driver.addReprTag(RelationTag::EQREL, @2, $1);
     }
+  | relation_tags LATTICE_QUALIFIER LPAREN MIN RPAREN
+    {
+      $$ = driver.addReprTag(RelationTag::LATTICE_MIN, @2, $1);
+    }
+  | relation_tags LATTICE_QUALIFIER LPAREN MAX RPAREN
+    {
+      $$ = driver.addReprTag(RelationTag::LATTICE_MAX, @2, $1);
+    }
+  | relation_tags COMPRESSED_QUALIFIER
+    {
+      $$ = driver.addReprTag(RelationTag::COMPRESSED, @2, $1);
+    }
   /* Deprecated Qualifiers */
   | relation_tags OUTPUT_QUALIFIER
     {
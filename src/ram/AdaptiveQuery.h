@@ -0,0 +1,103 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file AdaptiveQuery.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/ListStatement.h"
+#include "ram/Node.h"
+#include "ram/Statement.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <cassert>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+/**
+ * @class AdaptiveQuery
+ * @brief Equivalent statements evaluating a rule with different join orders
+ *
+ * Each time the statement is executed, exactly one of the alternatives is
+ * executed. The alternative is chosen by the cost of its plan, which lists
+ * the scanned relations in join order together with an exponent e; a scan
+ * of relation R is estimated to produce |R|^e tuples per outer tuple. The
+ * cost of a plan is the sum of the estimated number of tuples over all
+ * levels of the join, i.e. sum_k prod_{j<=k} |R_j|^e_j. Ties are broken in
+ * favour of the earlier alternative.
+ *
+ * For example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * ADAPTIVE
+ *  PLAN @delta_path^1 edge^0.5
+ *   QUERY
+ *    ...
+ *  PLAN edge^1 @delta_path^0.5
+ *   QUERY
+ *    ...
+ * END ADAPTIVE
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class AdaptiveQuery : public ListStatement {
+public:
+    /** A scanned relation and the exponent of its size estimating its fan-out */
+    using Step = std::pair<std::string, double>;
+    using Plan = std::vector<Step>;
+
+    AdaptiveQuery(VecOwn<Statement> alternatives, std::vector<Plan> plans)
+            : ListStatement(std::move(alternatives)), plans(std::move(plans)) {
+        assert(statements.size() == this->plans.size() && "each alternative requires a plan");
+    }
+
+    /** @brief Get plans of the alternatives */
+    const std::vector<Plan>& getPlans() const {
+        return plans;
+    }
+
+    AdaptiveQuery* cloning() const override {
+        VecOwn<Statement> alternatives;
+        for (auto& cur : statements) {
+            alternatives.push_back(clone(cur));
+        }
+        return new AdaptiveQuery(std::move(alternatives), plans);
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos) << "ADAPTIVE" << std::endl;
+        for (std::size_t i = 0; i < statements.size(); ++i) {
+            os << times(" ", tabpos + 1) << "PLAN "
+               << join(plans[i], " ",
+                          [](std::ostream& out, const Step& step) {
+                              out << step.first << "^" << step.second;
+                          })
+               << std::endl;
+            Statement::print(statements[i].get(), os, tabpos + 2);
+        }
+        os << times(" ", tabpos) << "END ADAPTIVE" << std::endl;
+    }
+
+    bool equal(const Node& node) const override {
+        const auto& other = asAssert<AdaptiveQuery>(node);
+        return ListStatement::equal(node) && plans == other.plans;
+    }
+
+    /** Plans of the alternatives */
+    std::vector<Plan> plans;
+};
+
+}  // namespace souffle::ram
@@ -0,0 +1,119 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HashJoin.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Expression.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/RelationOperation.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+/**
+ * @class HashJoin
+ * @brief Search for tuples of a relation with given values in some columns using a hash table
+ *
+ * The hash table is built from the relation by the query before its
+ * operation is evaluated, and each search probes the table with the
+ * values of the key columns. In contrast to an index scan, the relation
+ * requires no index ordered by the key columns.
+ *
+ * For example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    HASH JOIN t1 IN X ON t1.2 = t0.0
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class HashJoin : public RelationOperation {
+public:
+    HashJoin(std::string rel, std::size_t ident, std::vector<std::size_t> keyColumns,
+            VecOwn<Expression> keyValues, Own<Operation> nested, std::string profileText = "")
+            : RelationOperation(std::move(rel), ident, std::move(nested), std::move(profileText)),
+              keyColumns(std::move(keyColumns)), keyValues(std::move(keyValues)) {
+        assert(allValidPtrs(this->keyValues));
+        assert(!this->keyColumns.empty() && this->keyColumns.size() == this->keyValues.size() &&
+                "each key column requires a value");
+    }
+
+    /** @brief Get the columns of the key */
+    const std::vector<std::size_t>& getKeyColumns() const {
+        return keyColumns;
+    }
+
+    /** @brief Get the values of the key columns */
+    std::vector<Expression*> getKeyValues() const {
+        return toPtrVector(keyValues);
+    }
+
+    void apply(const NodeMapper& map) override {
+        RelationOperation::apply(map);
+        for (auto& value : keyValues) {
+            value = map(std::move(value));
+        }
+    }
+
+    HashJoin* cloning() const override {
+        return new HashJoin(relation, getTupleId(), keyColumns, clone(keyValues), clone(getOperation()),
+                getProfileText());
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos);
+        os << "HASH JOIN t" << getTupleId() << " IN " << relation << " ON ";
+        for (std::size_t i = 0; i < keyColumns.size(); ++i) {
+            if (i > 0) {
+                os << " AND ";
+            }
+            os << "t" << getTupleId() << "." << keyColumns[i] << " = " << *keyValues[i];
+        }
+        os << std::endl;
+        RelationOperation::print(os, tabpos + 1);
+    }
+
+    bool equal(const Node& node) const override {
+        const auto& other = asAssert<HashJoin>(node);
+        return RelationOperation::equal(other) && keyColumns == other.keyColumns &&
+               equal_targets(keyValues, other.keyValues);
+    }
+
+    NodeVec getChildren() const override {
+        auto res = RelationOperation::getChildren();
+        for (auto& value : keyValues) {
+            res.push_back(value.get());
+        }
+        return res;
+    }
+
+    /** Columns of the key */
+    const std::vector<std::size_t> keyColumns;
+
+    /** Values of the key columns */
+    VecOwn<Expression> keyValues;
+};
+
+}  // namespace souffle::ram
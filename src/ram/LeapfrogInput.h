@@ -0,0 +1,119 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file LeapfrogInput.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Expression.h"
+#include "ram/Node.h"
+#include "ram/utility/Utils.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include <cassert>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+/**
+ * @class LeapfrogInput
+ * @brief A column of a relation intersected by a leapfrog join
+ *
+ * The values of the column are enumerated in order among the tuples
+ * matching the pattern, whose defined elements are compared for equality.
+ * The element of the pattern at the column itself is always undefined.
+ *
+ * For example, the second column of B among the tuples whose first
+ * element is t0.0:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * B(t0.0,?)
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class LeapfrogInput : public Node {
+public:
+    LeapfrogInput(std::string rel, std::size_t column, VecOwn<Expression> vals)
+            : relation(std::move(rel)), column(column), values(std::move(vals)) {
+        assert(allValidPtrs(values));
+        assert(column < values.size() && isUndefValue(values[column].get()) && "column must be unbound");
+    }
+
+    /** @brief Get relation */
+    const std::string& getRelation() const {
+        return relation;
+    }
+
+    /** @brief Get intersected column */
+    std::size_t getColumn() const {
+        return column;
+    }
+
+    /** @brief Get pattern of the tuples, undefined elements are unbound */
+    const std::vector<Expression*> getValues() const {
+        return toPtrVector(values);
+    }
+
+    void apply(const NodeMapper& map) override {
+        for (auto& val : values) {
+            val = map(std::move(val));
+        }
+    }
+
+    LeapfrogInput* cloning() const override {
+        VecOwn<Expression> newValues;
+        for (auto& cur : values) {
+            newValues.emplace_back(cur->cloning());
+        }
+        return new LeapfrogInput(relation, column, std::move(newValues));
+    }
+
+protected:
+    void print(std::ostream& os) const override {
+        os << relation << "(";
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) {
+                os << ",";
+            }
+            if (i == column) {
+                os << "?";
+            } else if (isUndefValue(values[i].get())) {
+                os << "_";
+            } else {
+                os << *values[i];
+            }
+        }
+        os << ")";
+    }
+
+    bool equal(const Node& node) const override {
+        const auto& other = asAssert<LeapfrogInput>(node);
+        return relation == other.relation && column == other.column && equal_targets(values, other.values);
+    }
+
+    NodeVec getChildren() const override {
+        return toPtrVector<Node const>(values);
+    }
+
+    /** Relation */
+    const std::string relation;
+
+    /** Intersected column */
+    const std::size_t column;
+
+    /** Pattern of the tuples */
+    VecOwn<Expression> values;
+};
+
+}  // namespace souffle::ram
@@ -0,0 +1,107 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file LeapfrogJoin.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/LeapfrogInput.h"
+#include "ram/NestedOperation.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/TupleOperation.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+/**
+ * @class LeapfrogJoin
+ * @brief Intersection of columns of several relations
+ *
+ * Binds the single element of the tuple to each value occurring in all
+ * inputs. The values are found by a leapfrog merge: each input in turn is
+ * searched for its least value not smaller than the largest value found so
+ * far, until all inputs agree. The inputs are hence never enumerated in
+ * full, which makes the join worst-case optimal for cyclic rule bodies.
+ *
+ * For example, the values of t1.0 occurring in the second column of A
+ * and in the first column of B among the tuples following t0.0:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    LEAPFROG t1 ON A(_,?) AND B(?,t0.0)
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class LeapfrogJoin : public TupleOperation {
+public:
+    LeapfrogJoin(std::size_t ident, VecOwn<LeapfrogInput> inputs, Own<Operation> nested,
+            std::string profileText = "")
+            : TupleOperation(ident, std::move(nested), std::move(profileText)), inputs(std::move(inputs)) {
+        assert(allValidPtrs(this->inputs));
+        assert(!this->inputs.empty() && "leapfrog join requires inputs");
+    }
+
+    /** @brief Get intersected inputs */
+    std::vector<LeapfrogInput*> getInputs() const {
+        return toPtrVector(inputs);
+    }
+
+    void apply(const NodeMapper& map) override {
+        TupleOperation::apply(map);
+        for (auto& input : inputs) {
+            input = map(std::move(input));
+        }
+    }
+
+    LeapfrogJoin* cloning() const override {
+        VecOwn<LeapfrogInput> newInputs;
+        for (auto& cur : inputs) {
+            newInputs.emplace_back(cur->cloning());
+        }
+        return new LeapfrogJoin(getTupleId(), std::move(newInputs), clone(getOperation()), getProfileText());
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos);
+        os << "LEAPFROG t" << getTupleId() << " ON "
+           << join(inputs, " AND ", print_deref<Own<LeapfrogInput>>()) << std::endl;
+        NestedOperation::print(os, tabpos + 1);
+    }
+
+    bool equal(const Node& node) const override {
+        const auto& other = asAssert<LeapfrogJoin>(node);
+        return TupleOperation::equal(other) && equal_targets(inputs, other.inputs);
+    }
+
+    NodeVec getChildren() const override {
+        auto res = TupleOperation::getChildren();
+        for (auto& input : inputs) {
+            res.push_back(input.get());
+        }
+        return res;
+    }
+
+    /** Intersected inputs */
+    VecOwn<LeapfrogInput> inputs;
+};
+
+}  // namespace souffle::ram
@@ -0,0 +1,97 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file AppendOnly.cpp
+ *
+ * Implementation of RAM Append-Only Analysis
+ *
+ ***********************************************************************/
+
+#include "ram/analysis/AppendOnly.h"
+#include "RelationTag.h"
+#include "ram/AbstractExistenceCheck.h"
+#include "ram/BinRelationStatement.h"
+#include "ram/Clear.h"
+#include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
+#include "ram/GuardedInsert.h"
+#include "ram/Insert.h"
+#include "ram/LeapfrogInput.h"
+#include "ram/LogRelationTimer.h"
+#include "ram/LogSize.h"
+#include "ram/Merge.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/RelationOperation.h"
+#include "ram/RelationSize.h"
+#include "ram/RelationStatement.h"
+#include "ram/Swap.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/StringUtil.h"
+#include <ostream>
+
+namespace souffle::ram::analysis {
+
+void AppendOnlyAnalysis::run(const TranslationUnit& tUnit) {
+    const Program& program = tUnit.getProgram();
+    std::set<std::string> excluded;
+
+    // relations written by plain insertions only
+    visit(program, [&](const Insert& insert) {
+        if (isA<GuardedInsert>(insert)) {
+            excluded.insert(insert.getRelation());
+        } else {
+            appendOnly.insert(insert.getRelation());
+        }
+    });
+    visit(program, [&](const Erase& erase) { excluded.insert(erase.getRelation()); });
+
+    // relations read by queries
+    visit(program, [&](const RelationOperation& op) { excluded.insert(op.getRelation()); });
+    visit(program, [&](const AbstractExistenceCheck& check) { excluded.insert(check.getRelation()); });
+    visit(program, [&](const LeapfrogInput& input) { excluded.insert(input.getRelation()); });
+    visit(program, [&](const Query& query) {
+        visit(query, [&](const EmptinessCheck& check) { excluded.insert(check.getRelation()); });
+        visit(query, [&](const RelationSize& size) { excluded.insert(size.getRelation()); });
+    });
+
+    // relations accessed by statements other than clearing, merging, swapping and logging
+    visit(program, [&](const RelationStatement& stmt) {
+        if (!isA<Clear>(stmt) && !isA<LogSize>(stmt) && !isA<LogRelationTimer>(stmt)) {
+            excluded.insert(stmt.getRelation());
+        }
+    });
+    visit(program, [&](const BinRelationStatement& stmt) {
+        if (!isA<Merge>(stmt) && !isA<Swap>(stmt)) {
+            excluded.insert(stmt.getFirstRelation());
+            excluded.insert(stmt.getSecondRelation());
+        }
+    });
+
+    // relations of other data structures than plain btrees
+    visit(program, [&](const Relation& rel) {
+        const auto representation = rel.getRepresentation();
+        if (rel.getArity() == 0 || (representation != RelationRepresentation::DEFAULT &&
+                                           representation != RelationRepresentation::BTREE)) {
+            excluded.insert(rel.getName());
+        }
+    });
+
+    for (const auto& name : excluded) {
+        appendOnly.erase(name);
+    }
+}
+
+void AppendOnlyAnalysis::print(std::ostream& os) const {
+    os << "Append-only relations: " << join(appendOnly, ", ") << "\n";
+}
+
+}  // namespace souffle::ram::analysis
@@ -0,0 +1,60 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file AppendOnly.h
+ *
+ * RAM Analysis finding the relations that are only written while computed
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Node.h"
+#include "ram/TranslationUnit.h"
+#include <set>
+#include <string>
+
+namespace souffle::ram::analysis {
+
+/**
+ * @class AppendOnlyAnalysis
+ * @brief A RAM Analysis for finding relations whose tuples may be buffered while inserted
+ *
+ * A relation is append-only if queries insert into it without ever reading it, as the new
+ * knowledge of recursive relations. Their tuples are appended to per-thread buffers by
+ * queries and sealed into the indexes of the relation in bulk, once the relation is
+ * swapped, merged, or its size is taken by a statement.
+ *
+ * Only relations represented by btrees whose insertions are neither guarded nor erased
+ * qualify; they may not be loaded, stored, or otherwise accessed by a statement other than
+ * clearing, merging and swapping.
+ */
+class AppendOnlyAnalysis : public Analysis {
+public:
+    AppendOnlyAnalysis() : Analysis(name) {}
+
+    static constexpr const char* name = "append-only-analysis";
+
+    void run(const TranslationUnit& tUnit) override;
+
+    void print(std::ostream& os) const override;
+
+    /**
+     * @brief Check whether the tuples inserted into the given relation may be buffered
+     */
+    bool isAppendOnly(const std::string& relation) const {
+        return appendOnly.find(relation) != appendOnly.end();
+    }
+
+protected:
+    std::set<std::string> appendOnly;
+};
+
+}  // namespace souffle::ram::analysis
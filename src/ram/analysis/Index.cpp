@@ -19,6 +19,7 @@
 #include "RelationTag.h"
 #include "ram/EstimateJoinSize.h"
 #include "ram/Expression.h"
+#include "ram/IO.h"
 #include "ram/Node.h"
 #include "ram/Program.h"
 #include "ram/Relation.h"
@@ -393,17 +394,23 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
     // visit all nodes to collect searches of each relation
 
     // visit all nodes to collect searches of each relation
+    auto addSearch = [&](const std::string& relation, const SearchSignature& signature) {
+        relationToSearches[relation].insert(signature);
+        ++searchUses[relation][signature];
+    };
     visit(translationUnit.getProgram(), [&](const Node& node) {
         if (const auto* estimateJoinSize = as<EstimateJoinSize>(node)) {
-            relationToSearches[estimateJoinSize->getRelation()].insert(getSearchSignature(estimateJoinSize));
+            addSearch(estimateJoinSize->getRelation(), getSearchSignature(estimateJoinSize));
         } else if (const auto* indexSearch = as<IndexOperation>(node)) {
-            relationToSearches[indexSearch->getRelation()].insert(getSearchSignature(indexSearch));
+            addSearch(indexSearch->getRelation(), getSearchSignature(indexSearch));
+        } else if (const auto* input = as<LeapfrogInput>(node)) {
+            addSearch(input->getRelation(), getSearchSignature(input));
         } else if (const auto* exists = as<ExistenceCheck>(node)) {
-            relationToSearches[exists->getRelation()].insert(getSearchSignature(exists));
+            addSearch(exists->getRelation(), getSearchSignature(exists));
         } else if (const auto* provExists = as<ProvenanceExistenceCheck>(node)) {
-            relationToSearches[provExists->getRelation()].insert(getSearchSignature(provExists));
+            addSearch(provExists->getRelation(), getSearchSignature(provExists));
         } else if (const auto* ramRel = as<Relation>(node)) {
-            relationToSearches[ramRel->getName()].insert(getSearchSignature(ramRel));
+            addSearch(ramRel->getName(), getSearchSignature(ramRel));
         }
     });
 
@@ -417,6 +424,8 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
         // Currently RAM does not have such situation.
         const std::string& relA = swap.getFirstRelation();
         const std::string& relB = swap.getSecondRelation();
+        swappedRelations.insert(relA);
+        swappedRelations.insert(relB);
 
         const auto searchesA = relationToSearches[relA];
         const auto searchesB = relationToSearches[relB];
@@ -425,6 +434,57 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
         relationToSearches[relB].insert(searchesA.begin(), searchesA.end());
     });
 
+    // relations only scanned or searched by all of their columns do not need ordered indexes
+    const auto& config = translationUnit.global().config();
+    if (!config.has("eager-eval") && !config.has("provenance")) {
+        std::set<std::string> excluded;
+        // written relations keep their tuples in order, and join size estimates count the
+        // distinct prefixes of ordered tuples
+        visit(translationUnit.getProgram(), [&](const IO& io) {
+            if (io.get("operation") == "output") {
+                excluded.insert(io.getRelation());
+            }
+        });
+        visit(translationUnit.getProgram(), [&](const EstimateJoinSize& estimateJoinSize) {
+            excluded.insert(estimateJoinSize.getRelation());
+        });
+        for (const auto& [relation, searches] : relationToSearches) {
+            const Relation& rel = relAnalysis->lookup(relation);
+            if (excluded.count(relation) > 0 || rel.getArity() == 0 ||
+                    rel.getRepresentation() != RelationRepresentation::DEFAULT) {
+                continue;
+            }
+            // float keys are compared as floats by indexes, but would be hashed bitwise
+            const auto& types = rel.getAttributeTypes();
+            if (std::any_of(types.begin(), types.end(), [](const std::string& type) {
+                    return type[0] == 'f';
+                })) {
+                continue;
+            }
+            const auto total = SearchSignature::getFullSearchSignature(rel.getArity());
+            if (std::all_of(searches.begin(), searches.end(), [&](const SearchSignature& search) {
+                    return search.empty() || search == total;
+                })) {
+                hashRelations.insert(relation);
+            }
+        }
+
+        // the partners of swaps share their data structure
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            visit(translationUnit.getProgram(), [&](const Swap& swap) {
+                const std::string& relA = swap.getFirstRelation();
+                const std::string& relB = swap.getSecondRelation();
+                if (isHashRelation(relA) != isHashRelation(relB)) {
+                    hashRelations.erase(relA);
+                    hashRelations.erase(relB);
+                    changed = true;
+                }
+            });
+        }
+    }
+
     // remove all empty searches
     for (auto& relToSearch : relationToSearches) {
         auto& searches = relToSearch.second;
@@ -441,7 +501,32 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
     for (auto& relToSearch : relationToSearches) {
         const std::string& relation = relToSearch.first;
         auto& searches = relToSearch.second;
-        indexCover.insert({relation, solver->solve(searches)});
+        auto cluster = solver->solve(searches);
+        const Relation& rel = relAnalysis->lookup(relation);
+        if (isLatticeRepresentation(rel.getRepresentation())) {
+            // lattice relations join their last column in place, hence it must be last in every index
+            const auto lattice = static_cast<AttributeIndex>(rel.getArity() - 1);
+            auto toLatticeOrder = [&](LexOrder order) {
+                auto it = std::find(order.begin(), order.end(), lattice);
+                if (it != order.end()) {
+                    order.erase(it);
+                    order.push_back(lattice);
+                }
+                return order;
+            };
+            OrderCollection orders;
+            for (const auto& order : cluster.getAllOrders()) {
+                orders.push_back(toLatticeOrder(order));
+            }
+            SignatureOrderMap indexSelection;
+            SearchSet searchSet;
+            for (const auto& search : cluster.getSearches()) {
+                indexSelection.insert({search, toLatticeOrder(cluster.getLexOrder(search))});
+                searchSet.insert(search);
+            }
+            cluster = IndexCluster(indexSelection, searchSet, orders);
+        }
+        indexCover.insert({relation, cluster});
     }
 }
 
@@ -451,6 +536,9 @@ void IndexAnalysis::print(std::ostream& os) const {
         const auto& selection = cur.second;
 
         os << "Relation " << relName << "\n";
+        if (isHashRelation(relName)) {
+            os << "\tStored in a hash set\n";
+        }
 
         /* print searches */
         os << "\tNumber of Searches: " << selection.getSearches().size() << "\n";
@@ -525,6 +613,14 @@ SearchSignature IndexAnalysis::getSearchSignature(const IndexOperation* search)
     return keys;
 }
 
+SearchSignature IndexAnalysis::getSearchSignature(const LeapfrogInput* input) const {
+    const Relation* rel = &relAnalysis->lookup(input->getRelation());
+    SearchSignature keys = searchSignature(rel->getArity(), input->getValues());
+    // the values of the column are sought in order following the bound prefix
+    keys[input->getColumn()] = AttributeConstraint::Inequal;
+    return keys;
+}
+
 SearchSignature IndexAnalysis::getSearchSignature(const ProvenanceExistenceCheck* provExistCheck) const {
     const auto values = provExistCheck->getValues();
     const Relation* rel = &relAnalysis->lookup(provExistCheck->getRelation());
@@ -565,4 +661,41 @@ bool IndexAnalysis::isTotalSignature(const AbstractExistenceCheck* existCheck) c
     return true;
 }
 
+bool IndexAnalysis::isHashJoinCandidate(const IndexOperation* search) const {
+    const std::string& relName = search->getRelation();
+    switch (relAnalysis->lookup(relName).getRepresentation()) {
+        case RelationRepresentation::DEFAULT:
+        case RelationRepresentation::BTREE:
+        case RelationRepresentation::BTREE_DELETE:
+        case RelationRepresentation::BRIE:
+        case RelationRepresentation::COMPRESSED: break;
+        default: return false;
+    }
+    // the indexes of swapped relations are shared with their partners
+    if (swappedRelations.count(relName) > 0) {
+        return false;
+    }
+
+    // float keys are compared as floats by indexes, but would be hashed bitwise
+    const auto signature = getSearchSignature(search);
+    const auto& types = relAnalysis->lookup(relName).getAttributeTypes();
+    if (signature.empty()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < signature.arity(); ++i) {
+        if (signature[i] == AttributeConstraint::Inequal ||
+                (signature[i] == AttributeConstraint::Equal && types[i][0] == 'f')) {
+            return false;
+        }
+    }
+    if (searchUses.at(relName).at(signature) != 1) {
+        return false;
+    }
+
+    // the signature must not be served by an index required anyway
+    auto searches = relationToSearches.at(relName);
+    searches.erase(signature);
+    return solver->solve(searches).getAllOrders().size() < indexCover.at(relName).getAllOrders().size();
+}
+
 }  // namespace souffle::ram::analysis
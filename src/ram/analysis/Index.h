@@ -20,6 +20,7 @@
 #include "ram/EstimateJoinSize.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/IndexOperation.h"
+#include "ram/LeapfrogInput.h"
 #include "ram/ProvenanceExistenceCheck.h"
 #include "ram/Relation.h"
 #include "ram/TranslationUnit.h"
@@ -515,6 +516,13 @@ public:
      */
     SearchSignature getSearchSignature(const IndexOperation* search) const;
 
+    /**
+     * @Brief Get the index signature for an input of a leapfrog join
+     * @param Leapfrog input
+     * @result Index signature of the input, the intersected column is an inequality
+     */
+    SearchSignature getSearchSignature(const LeapfrogInput* input) const;
+
     /**
      * @Brief Get the index signature for an existence check
      * @param Existence check
@@ -545,6 +553,23 @@ public:
      */
     bool isTotalSignature(const AbstractExistenceCheck* existCheck) const;
 
+    /**
+     * @Brief Whether a search is better answered by a hash join than by an index
+     * @param Index-relation-search operation
+     * @result true if the search is the only one of its signature, consists of equalities only,
+     * and the relation requires fewer indexes without it
+     */
+    bool isHashJoinCandidate(const IndexOperation* search) const;
+
+    /**
+     * @Brief Whether a relation is stored in a hash set rather than in ordered indexes
+     * @param relName name of the relation
+     * @result true if the relation is only scanned or searched by all of its columns
+     */
+    bool isHashRelation(const std::string& relName) const {
+        return hashRelations.count(relName) > 0;
+    }
+
 private:
     /** relation analysis for looking up relations by name */
     RelationAnalysis* relAnalysis;
@@ -555,6 +580,15 @@ private:
     Own<IndexSelectionStrategy> solver;
     std::map<std::string, IndexCluster> indexCover;
     std::map<std::string, SearchSet> relationToSearches;
+
+    /** number of operations performing each search of a relation */
+    std::map<std::string, std::map<SearchSignature, std::size_t, SearchComparator>> searchUses;
+
+    /** relations taking part in swaps */
+    std::set<std::string> swappedRelations;
+
+    /** relations stored in hash sets, see isHashRelation */
+    std::set<std::string> hashRelations;
 };
 
 }  // namespace souffle::ram::analysis
@@ -26,12 +26,15 @@
 #include "ram/Expression.h"
 #include "ram/False.h"
 #include "ram/Filter.h"
+#include "ram/HashJoin.h"
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
 #include "ram/IndexIfExists.h"
 #include "ram/IndexScan.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogInput.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/Negation.h"
 #include "ram/Node.h"
 #include "ram/NumericConstant.h"
@@ -117,6 +120,26 @@ std::optional<std::size_t> LevelAnalysis::getLevel(const Node* node) const {
             return level;
         }
 
+        // hash join
+        maybe_level visit_(type_identity<HashJoin>, const HashJoin& hashJoin) override {
+            maybe_level level = std::nullopt;
+            for (auto* value : hashJoin.getKeyValues()) {
+                level = max(level, dispatch(*value));
+            }
+            return level;
+        }
+
+        // leapfrog join
+        maybe_level visit_(type_identity<LeapfrogJoin>, const LeapfrogJoin& leapfrog) override {
+            maybe_level level = std::nullopt;
+            for (auto* input : leapfrog.getInputs()) {
+                for (auto* value : input->getValues()) {
+                    level = max(level, dispatch(*value));
+                }
+            }
+            return level;
+        }
+
         // choice
         maybe_level visit_(type_identity<IfExists>, const IfExists& choice) override {
             return max(-1, dispatch(choice.getCondition()));
@@ -0,0 +1,105 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SortedDelta.cpp
+ *
+ * Implementation of RAM Sorted-Delta Analysis
+ *
+ ***********************************************************************/
+
+#include "ram/analysis/SortedDelta.h"
+#include "Global.h"
+#include "RelationTag.h"
+#include "ram/BinRelationStatement.h"
+#include "ram/Clear.h"
+#include "ram/Insert.h"
+#include "ram/LogRelationTimer.h"
+#include "ram/LogSize.h"
+#include "ram/Merge.h"
+#include "ram/Program.h"
+#include "ram/Relation.h"
+#include "ram/RelationStatement.h"
+#include "ram/Swap.h"
+#include "ram/analysis/AppendOnly.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/StringUtil.h"
+#include <map>
+#include <ostream>
+#include <vector>
+
+namespace souffle::ram::analysis {
+
+void SortedDeltaAnalysis::run(const TranslationUnit& tUnit) {
+    const auto& config = tUnit.global().config();
+    if (config.has("eager-eval") || config.has("provenance")) {
+        return;
+    }
+    const Program& program = tUnit.getProgram();
+    const auto& appendOnly = tUnit.getAnalysis<AppendOnlyAnalysis>();
+    std::set<std::string> excluded;
+
+    // the relations of swaps and their partners
+    std::multimap<std::string, std::string> partners;
+    visit(program, [&](const Swap& swap) {
+        partners.emplace(swap.getFirstRelation(), swap.getSecondRelation());
+        partners.emplace(swap.getSecondRelation(), swap.getFirstRelation());
+        sorted.insert(swap.getFirstRelation());
+        sorted.insert(swap.getSecondRelation());
+    });
+
+    // relations inserted into tuple by tuple
+    visit(program, [&](const Insert& insert) {
+        if (!appendOnly.isAppendOnly(insert.getRelation())) {
+            excluded.insert(insert.getRelation());
+        }
+    });
+
+    // relations accessed by statements other than clearing, merging, swapping and logging
+    visit(program, [&](const RelationStatement& stmt) {
+        if (!isA<Clear>(stmt) && !isA<LogSize>(stmt) && !isA<LogRelationTimer>(stmt)) {
+            excluded.insert(stmt.getRelation());
+        }
+    });
+    visit(program, [&](const BinRelationStatement& stmt) {
+        if (!isA<Merge>(stmt) && !isA<Swap>(stmt)) {
+            excluded.insert(stmt.getFirstRelation());
+            excluded.insert(stmt.getSecondRelation());
+        }
+    });
+
+    // relations of other data structures than plain btrees
+    visit(program, [&](const Relation& rel) {
+        const auto representation = rel.getRepresentation();
+        if (rel.getArity() == 0 || (representation != RelationRepresentation::DEFAULT &&
+                                           representation != RelationRepresentation::BTREE)) {
+            excluded.insert(rel.getName());
+        }
+    });
+
+    // exclude the partners of excluded relations
+    std::vector<std::string> pending(excluded.begin(), excluded.end());
+    while (!pending.empty()) {
+        const std::string cur = pending.back();
+        pending.pop_back();
+        if (sorted.erase(cur) == 0) {
+            continue;
+        }
+        auto range = partners.equal_range(cur);
+        for (auto it = range.first; it != range.second; ++it) {
+            pending.push_back(it->second);
+        }
+    }
+}
+
+void SortedDeltaAnalysis::print(std::ostream& os) const {
+    os << "Sorted delta relations: " << join(sorted, ", ") << "\n";
+}
+
+}  // namespace souffle::ram::analysis
@@ -0,0 +1,61 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SortedDelta.h
+ *
+ * RAM Analysis finding the delta relations that may be stored in sorted arrays
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Node.h"
+#include "ram/TranslationUnit.h"
+#include <set>
+#include <string>
+
+namespace souffle::ram::analysis {
+
+/**
+ * @class SortedDeltaAnalysis
+ * @brief A RAM Analysis for finding relations that are only ever filled in bulk
+ *
+ * The delta relations of a fixpoint are swapped with the new knowledge of each iteration and
+ * only read by the queries of the next one. If the new knowledge is append-only (see
+ * AppendOnlyAnalysis), both relations of the swap are filled exclusively by merges and seals,
+ * and may be stored in immutable sorted arrays instead of btrees.
+ *
+ * Both relations of a swap qualify or neither does, as swapping exchanges their data
+ * structures. Insertions into either relation must be buffered, and they may not be accessed
+ * by a statement other than clearing, merging, swapping and logging. Eager evaluation and
+ * provenance insert into relations tuple by tuple, hence no relation qualifies with either.
+ */
+class SortedDeltaAnalysis : public Analysis {
+public:
+    SortedDeltaAnalysis() : Analysis(name) {}
+
+    static constexpr const char* name = "sorted-delta-analysis";
+
+    void run(const TranslationUnit& tUnit) override;
+
+    void print(std::ostream& os) const override;
+
+    /**
+     * @brief Check whether the given relation may be stored in sorted arrays
+     */
+    bool isSortedDelta(const std::string& relation) const {
+        return sorted.find(relation) != sorted.end();
+    }
+
+protected:
+    std::set<std::string> sorted;
+};
+
+}  // namespace souffle::ram::analysis
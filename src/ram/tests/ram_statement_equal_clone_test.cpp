@@ -18,6 +18,7 @@
 
 #include "FunctorOps.h"
 #include "RelationTag.h"
+#include "ram/AdaptiveQuery.h"
 #include "ram/Break.h"
 #include "ram/Clear.h"
 #include "ram/Condition.h"
@@ -28,13 +29,17 @@
 #include "ram/Exit.h"
 #include "ram/Expression.h"
 #include "ram/Filter.h"
+#include "ram/HashJoin.h"
 #include "ram/IO.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogInput.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
 #include "ram/Negation.h"
 #include "ram/Operation.h"
@@ -92,6 +97,24 @@ TEST(Clear, CloneAndEquals) {
     delete c;
 }
 
+TEST(Merge, CloneAndEquals) {
+    // MERGE A INTO B
+    Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
+    Relation B("B", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
+    Merge a("B", "A");
+    Merge b("B", "A");
+    EXPECT_EQ(a, b);
+    EXPECT_NE(&a, &b);
+
+    Merge* c = a.cloning();
+    EXPECT_EQ(a, *c);
+    EXPECT_NE(&a, c);
+    delete c;
+
+    Merge d("A", "B");
+    EXPECT_NE(a, d);
+}
+
 TEST(MergeExtend, CloneAndEquals) {
     // MERGE B WITH A
     Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
@@ -264,6 +287,145 @@ TEST(Parallel, CloneAndEquals) {
     EXPECT_NE(&a, c);
     delete c;
 }
+
+TEST(AdaptiveQuery, CloneAndEquals) {
+    Relation A("A", 2, 1, {"a", "b"}, {"i", "i"}, RelationRepresentation::DEFAULT);
+    Relation B("B", 1, 1, {"a"}, {"i"}, RelationRepresentation::DEFAULT);
+    Relation C("C", 2, 1, {"a", "b"}, {"i", "i"}, RelationRepresentation::DEFAULT);
+
+    /* ADAPTIVE
+     *  PLAN A^1 B^0
+     *   QUERY
+     *    FOR t0 IN A
+     *     FOR t1 IN B
+     *      IF (t0.0 = t1.0)
+     *       INSERT (t0.0, t0.1) INTO C
+     *  PLAN B^1 A^0.5
+     *   QUERY
+     *    FOR t0 IN B
+     *     FOR t1 IN A
+     *      IF (t1.0 = t0.0)
+     *       INSERT (t1.0, t1.1) INTO C
+     * END ADAPTIVE
+     * */
+
+    auto makeQuery = [](const std::string& outer, const std::string& inner, std::size_t level) {
+        VecOwn<Expression> expressions;
+        expressions.emplace_back(new TupleElement(level, 0));
+        expressions.emplace_back(new TupleElement(level, 1));
+        auto insert = mk<Insert>("C", std::move(expressions));
+        auto cond = mk<Filter>(mk<Constraint>(BinaryConstraintOp::EQ, mk<TupleElement>(level, 0),
+                                       mk<TupleElement>(1 - level, 0)),
+                std::move(insert), "");
+        auto innerScan = mk<Scan>(inner, 1, std::move(cond), "");
+        return mk<Query>(mk<Scan>(outer, 0, std::move(innerScan), ""));
+    };
+    auto makeAdaptive = [&](double exponent) {
+        VecOwn<Statement> alternatives;
+        alternatives.push_back(makeQuery("A", "B", 0));
+        alternatives.push_back(makeQuery("B", "A", 1));
+        std::vector<AdaptiveQuery::Plan> plans{{{"A", 1}, {"B", 0}}, {{"B", 1}, {"A", exponent}}};
+        return mk<AdaptiveQuery>(std::move(alternatives), std::move(plans));
+    };
+
+    auto a = makeAdaptive(0.5);
+    auto b = makeAdaptive(0.5);
+    EXPECT_EQ(*a, *b);
+    EXPECT_NE(a.get(), b.get());
+
+    // plans take part in the comparison
+    auto d = makeAdaptive(1);
+    EXPECT_NE(*a, *d);
+
+    AdaptiveQuery* c = a->cloning();
+    EXPECT_EQ(*a, *c);
+    EXPECT_NE(a.get(), c);
+    EXPECT_EQ(a->getPlans(), c->getPlans());
+    delete c;
+}
+
+TEST(HashJoin, CloneAndEquals) {
+    Relation A("A", 2, 1, {"a", "b"}, {"i", "i"}, RelationRepresentation::DEFAULT);
+    Relation B("B", 3, 1, {"a", "b", "c"}, {"i", "i", "i"}, RelationRepresentation::DEFAULT);
+
+    /* QUERY
+     *  FOR t0 IN A
+     *   HASH JOIN t1 IN B ON t1.0 = t0.1 AND t1.2 = 5
+     *    INSERT (t0.0, t1.1) INTO A
+     * */
+    auto makeQuery = [](std::size_t column) {
+        VecOwn<Expression> insertValues;
+        insertValues.emplace_back(new TupleElement(0, 0));
+        insertValues.emplace_back(new TupleElement(1, 1));
+        auto insert = mk<Insert>("A", std::move(insertValues));
+
+        VecOwn<Expression> keyValues;
+        keyValues.emplace_back(new TupleElement(0, 1));
+        keyValues.emplace_back(new SignedConstant(5));
+        std::vector<std::size_t> keyColumns = {0, column};
+        auto hashJoin = mk<HashJoin>("B", 1, std::move(keyColumns), std::move(keyValues), std::move(insert));
+        return mk<Query>(mk<Scan>("A", 0, std::move(hashJoin), ""));
+    };
+
+    auto a = makeQuery(2);
+    auto b = makeQuery(2);
+    EXPECT_EQ(*a, *b);
+    EXPECT_NE(a.get(), b.get());
+
+    // key columns take part in the comparison
+    auto d = makeQuery(1);
+    EXPECT_NE(*a, *d);
+
+    Query* c = a->cloning();
+    EXPECT_EQ(*a, *c);
+    EXPECT_NE(a.get(), c);
+    delete c;
+}
+
+TEST(LeapfrogJoin, CloneAndEquals) {
+    Relation A("A", 2, 1, {"a", "b"}, {"i", "i"}, RelationRepresentation::DEFAULT);
+    Relation B("B", 2, 1, {"a", "b"}, {"i", "i"}, RelationRepresentation::DEFAULT);
+
+    /* QUERY
+     *  FOR t0 IN A
+     *   LEAPFROG t1 ON A(_,?) AND B(?,t0.0)
+     *    INSERT (t0.0, t1.0) INTO A
+     * */
+    auto makeQuery = [](std::size_t column) {
+        VecOwn<Expression> insertValues;
+        insertValues.emplace_back(new TupleElement(0, 0));
+        insertValues.emplace_back(new TupleElement(1, 0));
+        auto insert = mk<Insert>("A", std::move(insertValues));
+
+        VecOwn<Expression> aValues;
+        aValues.emplace_back(new UndefValue());
+        aValues.emplace_back(new UndefValue());
+        VecOwn<Expression> bValues;
+        bValues.emplace_back(new UndefValue());
+        bValues.emplace_back(new TupleElement(0, 0));
+        VecOwn<LeapfrogInput> inputs;
+        inputs.emplace_back(new LeapfrogInput("A", column, std::move(aValues)));
+        inputs.emplace_back(new LeapfrogInput("B", 0, std::move(bValues)));
+
+        auto leapfrog = mk<LeapfrogJoin>(1, std::move(inputs), std::move(insert));
+        return mk<Query>(mk<Scan>("A", 0, std::move(leapfrog), ""));
+    };
+
+    auto a = makeQuery(1);
+    auto b = makeQuery(1);
+    EXPECT_EQ(*a, *b);
+    EXPECT_NE(a.get(), b.get());
+
+    // intersected columns take part in the comparison
+    auto d = makeQuery(0);
+    EXPECT_NE(*a, *d);
+
+    Query* c = a->cloning();
+    EXPECT_EQ(*a, *c);
+    EXPECT_NE(a.get(), c);
+    delete c;
+}
+
 TEST(Loop, CloneAndEquals) {
     Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
     Relation B("B", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
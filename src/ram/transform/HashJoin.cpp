@@ -0,0 +1,83 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HashJoin.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/HashJoin.h"
+#include "ram/Expression.h"
+#include "ram/HashJoin.h"
+#include "ram/Loop.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/utility/NodeMapper.h"
+#include "ram/utility/Utils.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/MiscUtil.h"
+#include <cstddef>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+Own<Operation> HashJoinTransformer::rewriteIndexScan(const IndexScan* indexScan) {
+    // the outer-most loop searches the relation only once
+    if (indexScan->getTupleId() == 0 || !rla->getLevel(indexScan).has_value()) {
+        return nullptr;
+    }
+    if (!idxAnalysis->isHashJoinCandidate(indexScan)) {
+        return nullptr;
+    }
+
+    // the candidate consists of equalities, which are given by the lower bounds
+    std::vector<std::size_t> keyColumns;
+    VecOwn<Expression> keyValues;
+    const auto lower = indexScan->getRangePattern().first;
+    for (std::size_t i = 0; i < lower.size(); ++i) {
+        if (!isUndefValue(lower[i])) {
+            keyColumns.push_back(i);
+            keyValues.push_back(clone(lower[i]));
+        }
+    }
+    return mk<HashJoin>(indexScan->getRelation(), indexScan->getTupleId(), std::move(keyColumns),
+            std::move(keyValues), clone(indexScan->getOperation()), indexScan->getProfileText());
+}
+
+bool HashJoinTransformer::convertIndexScans(Program& program) {
+    // queries of fixpoint loops are evaluated many times
+    std::set<const Query*> recursive;
+    visit(program, [&](const Loop& loop) {
+        visit(loop, [&](const Query& query) { recursive.insert(&query); });
+    });
+
+    bool changed = false;
+    forEachQuery(program, [&](Query& query) {
+        if (recursive.count(&query) > 0) {
+            return;
+        }
+        query.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
+            if (const IndexScan* indexScan = as<IndexScan>(node)) {
+                if (auto op = rewriteIndexScan(indexScan)) {
+                    changed = true;
+                    node = std::move(op);
+                }
+            }
+            node->apply(go);
+            return node;
+        }));
+    });
+    return changed;
+}
+
+}  // namespace souffle::ram::transform
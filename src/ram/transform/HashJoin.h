@@ -0,0 +1,87 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HashJoin.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/IndexScan.h"
+#include "ram/Operation.h"
+#include "ram/Program.h"
+#include "ram/TranslationUnit.h"
+#include "ram/analysis/Index.h"
+#include "ram/analysis/Level.h"
+#include "ram/transform/Transformer.h"
+#include <memory>
+#include <string>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class HashJoinTransformer
+ * @brief Convert inner index scans of non-recursive queries to hash joins
+ *
+ * An index scan nested in another loop is rewritten to a hash join if the
+ * query is not part of a fixpoint loop and the index analysis finds that
+ * the search is the only reason for an additional index of the relation.
+ * The query then builds a hash table from the relation once, instead of
+ * the relation maintaining an index for its whole lifetime.
+ *
+ * For example,
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN A
+ *    FOR t1 IN B ON INDEX t1.1 = t0.0
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN A
+ *    HASH JOIN t1 IN B ON t1.1 = t0.0
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class HashJoinTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "HashJoinTransformer";
+    }
+
+    /**
+     * @brief Rewrite an index scan
+     * @param An index operation
+     * @result The hash join if the index scan is a candidate; otherwise nullptr
+     */
+    Own<Operation> rewriteIndexScan(const IndexScan* indexScan);
+
+    /**
+     * @brief Apply the hash-join conversion to the whole program
+     * @param RAM program
+     * @result A flag indicating whether the RAM program has been changed.
+     */
+    bool convertIndexScans(Program& program);
+
+protected:
+    analysis::IndexAnalysis* idxAnalysis{nullptr};
+    analysis::LevelAnalysis* rla{nullptr};
+    bool transform(TranslationUnit& translationUnit) override {
+        idxAnalysis = &translationUnit.getAnalysis<analysis::IndexAnalysis>();
+        rla = &translationUnit.getAnalysis<analysis::LevelAnalysis>();
+        return convertIndexScans(translationUnit.getProgram());
+    }
+};
+
+}  // namespace souffle::ram::transform
@@ -95,7 +95,8 @@ ExpressionPair MakeIndexTransformer::getLowerUpperExpression(Condition* c, std::
                                  !glb->config().has("swig");
         bool provenance = rep == RelationRepresentation::PROVENANCE;
         bool btree = (rep == RelationRepresentation::BTREE || rep == RelationRepresentation::DEFAULT ||
-                      rep == RelationRepresentation::BTREE_DELETE);
+                      rep == RelationRepresentation::BTREE_DELETE ||
+                      rep == RelationRepresentation::COMPRESSED);
         auto op = binRelOp->getOperator();
 
         // don't index FEQ in interpreter mode
@@ -288,6 +289,14 @@ Own<Condition> MakeIndexTransformer::constructPattern(const std::vector<std::str
         std::tie(lowerExpression, upperExpression) =
                 getLowerUpperExpression(cond.get(), element, identifier, rep);
 
+        // the last column of a lattice relation is joined in place and never indexed; as the remaining
+        // columns determine a single tuple, filtering on it loses nothing
+        if (isLatticeRepresentation(rep) && element + 1 == arity &&
+                (!isUndefValue(lowerExpression.get()) || !isUndefValue(upperExpression.get()))) {
+            addCondition(std::move(cond));
+            continue;
+        }
+
         // we have new bounds if at least one is defined
         if (!isUndefValue(lowerExpression.get()) || !isUndefValue(upperExpression.get())) {
             // if no previous bounds are set then just assign them, consider both bounds to be set (but not
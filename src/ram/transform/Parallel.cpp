@@ -13,13 +13,21 @@
  ***********************************************************************/
 
 #include "ram/transform/Parallel.h"
+#include "RelationTag.h"
+#include "ram/AbstractExistenceCheck.h"
 #include "ram/Condition.h"
+#include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
 #include "ram/Expression.h"
 #include "ram/IntrinsicAggregator.h"
+#include "ram/LeapfrogInput.h"
 #include "ram/Node.h"
 #include "ram/Operation.h"
 #include "ram/Program.h"
+#include "ram/Query.h"
 #include "ram/Relation.h"
+#include "ram/RelationOperation.h"
+#include "ram/RelationSize.h"
 #include "ram/Statement.h"
 #include "ram/utility/NodeMapper.h"
 #include "ram/utility/Visitor.h"
@@ -28,11 +36,26 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace souffle::ram::transform {
 
+namespace {
+
+/** Whether the given query reads the given relation */
+bool readsRelation(const Query& query, const std::string& name) {
+    return visitExists(query, [&](const RelationOperation& op) { return op.getRelation() == name; }) ||
+           visitExists(query,
+                   [&](const AbstractExistenceCheck& check) { return check.getRelation() == name; }) ||
+           visitExists(query, [&](const EmptinessCheck& check) { return check.getRelation() == name; }) ||
+           visitExists(query, [&](const RelationSize& size) { return size.getRelation() == name; }) ||
+           visitExists(query, [&](const LeapfrogInput& input) { return input.getRelation() == name; });
+}
+
+}  // namespace
+
 bool ParallelTransformer::parallelizeOperations(Program& program) {
     bool changed = false;
 
@@ -41,8 +64,16 @@ bool ParallelTransformer::parallelizeOperations(Program& program) {
     forEachQuery(program, [&](Query& query) {
         // guardedInsert cannot be parallelized
         if (visitExists(query, [&](const GuardedInsert&) { return true; })) return;
-        // erase cannot be parallelized
-        if (visitExists(query, [&](const Erase&) { return true; })) return;
+        // erase can only be parallelized on relations supporting concurrent erasure,
+        // which are not read by the same query
+        if (visitExists(query, [&](const Erase& erase) {
+                const std::string& name = erase.getRelation();
+                return relAnalysis->lookup(name).getRepresentation() !=
+                               RelationRepresentation::BTREE_DELETE ||
+                       readsRelation(query, name);
+            })) {
+            return;
+        }
 
         query.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
             if (const Scan* scan = as<Scan>(node)) {
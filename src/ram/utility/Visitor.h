@@ -20,6 +20,7 @@
 #include "ram/AbstractConditional.h"
 #include "ram/AbstractExistenceCheck.h"
 #include "ram/AbstractOperator.h"
+#include "ram/AdaptiveQuery.h"
 #include "ram/Aggregate.h"
 #include "ram/Aggregator.h"
 #include "ram/AutoIncrement.h"
@@ -41,6 +42,7 @@
 #include "ram/Filter.h"
 #include "ram/FloatConstant.h"
 #include "ram/GuardedInsert.h"
+#include "ram/HashJoin.h"
 #include "ram/IO.h"
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
@@ -49,11 +51,14 @@
 #include "ram/IndexScan.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogInput.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/ListStatement.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
@@ -116,6 +121,7 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
 
         // Relation
         SOUFFLE_VISITOR_FORWARD(Relation);
+        SOUFFLE_VISITOR_FORWARD(LeapfrogInput);
 
         // Expressions
         SOUFFLE_VISITOR_FORWARD(TupleElement);
@@ -155,6 +161,8 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
         SOUFFLE_VISITOR_FORWARD(Scan);
         SOUFFLE_VISITOR_FORWARD(ParallelIndexScan);
         SOUFFLE_VISITOR_FORWARD(IndexScan);
+        SOUFFLE_VISITOR_FORWARD(LeapfrogJoin);
+        SOUFFLE_VISITOR_FORWARD(HashJoin);
         SOUFFLE_VISITOR_FORWARD(ParallelIfExists);
         SOUFFLE_VISITOR_FORWARD(IfExists);
         SOUFFLE_VISITOR_FORWARD(ParallelIndexIfExists);
@@ -172,6 +180,7 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
         SOUFFLE_VISITOR_FORWARD(EstimateJoinSize);
 
         SOUFFLE_VISITOR_FORWARD(Swap);
+        SOUFFLE_VISITOR_FORWARD(Merge);
         SOUFFLE_VISITOR_FORWARD(MergeExtend);
 
         // Control-flow
@@ -179,6 +188,7 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
         SOUFFLE_VISITOR_FORWARD(Sequence);
         SOUFFLE_VISITOR_FORWARD(Loop);
         SOUFFLE_VISITOR_FORWARD(Parallel);
+        SOUFFLE_VISITOR_FORWARD(AdaptiveQuery);
         SOUFFLE_VISITOR_FORWARD(Exit);
         SOUFFLE_VISITOR_FORWARD(LogTimer);
         SOUFFLE_VISITOR_FORWARD(LogRelationTimer);
@@ -200,12 +210,14 @@ protected:
     SOUFFLE_VISITOR_LINK(RelationStatement, Statement);
 
     SOUFFLE_VISITOR_LINK(Swap, BinRelationStatement);
+    SOUFFLE_VISITOR_LINK(Merge, BinRelationStatement);
     SOUFFLE_VISITOR_LINK(MergeExtend, BinRelationStatement);
     SOUFFLE_VISITOR_LINK(BinRelationStatement, Statement);
 
     SOUFFLE_VISITOR_LINK(Sequence, ListStatement);
     SOUFFLE_VISITOR_LINK(Loop, Statement);
     SOUFFLE_VISITOR_LINK(Parallel, ListStatement);
+    SOUFFLE_VISITOR_LINK(AdaptiveQuery, ListStatement);
     SOUFFLE_VISITOR_LINK(ListStatement, Statement);
     SOUFFLE_VISITOR_LINK(Exit, Statement);
     SOUFFLE_VISITOR_LINK(LogTimer, Statement);
@@ -222,10 +234,12 @@ protected:
     SOUFFLE_VISITOR_LINK(SubroutineReturn, Operation);
     SOUFFLE_VISITOR_LINK(UnpackRecord, TupleOperation);
     SOUFFLE_VISITOR_LINK(NestedIntrinsicOperator, TupleOperation)
+    SOUFFLE_VISITOR_LINK(LeapfrogJoin, TupleOperation);
     SOUFFLE_VISITOR_LINK(Scan, RelationOperation);
     SOUFFLE_VISITOR_LINK(ParallelScan, Scan);
     SOUFFLE_VISITOR_LINK(IndexScan, IndexOperation);
     SOUFFLE_VISITOR_LINK(ParallelIndexScan, IndexScan);
+    SOUFFLE_VISITOR_LINK(HashJoin, RelationOperation);
     SOUFFLE_VISITOR_LINK(IfExists, RelationOperation);
     SOUFFLE_VISITOR_LINK(ParallelIfExists, IfExists);
     SOUFFLE_VISITOR_LINK(IndexIfExists, IndexOperation);
@@ -280,6 +294,7 @@ protected:
 
     // -- relation
     SOUFFLE_VISITOR_LINK(Relation, Node);
+    SOUFFLE_VISITOR_LINK(LeapfrogInput, Node);
 };
 }  // namespace souffle::ram
 
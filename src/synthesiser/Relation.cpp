@@ -46,7 +46,8 @@ std::string Relation::getTypeAttributeString(const std::vector<std::string>& att
 }
 
 Own<Relation> Relation::getSynthesiserRelation(const ram::Relation& ramRel,
-        const ram::analysis::IndexCluster& indexSelection, const IndexInfo& indexInfo, bool eagerEval) {
+        const ram::analysis::IndexCluster& indexSelection, const IndexInfo& indexInfo, bool eagerEval,
+        bool sortedDelta, bool hashSet, bool compressLeaves) {
     Relation* rel;
 
     // Handle the qualifier in souffle code
@@ -55,8 +56,25 @@ Own<Relation> Relation::getSynthesiserRelation(const ram::Relation& ramRel,
         rel = new DirectRelation(ramRel, indexSelection, true, false, indexInfo);
     } else if (ramRel.isNullary()) {
         rel = new NullaryRelation(ramRel, indexSelection);
+    } else if (sortedDelta && (ramRel.getRepresentation() == RelationRepresentation::BTREE ||
+                                      ramRel.getArity() <= 6)) {
+        assert(!eagerEval);
+        rel = new DirectRelation(ramRel, indexSelection, false, false, indexInfo, true);
+    } else if (hashSet) {
+        assert(!eagerEval);
+        rel = new DirectRelation(ramRel, indexSelection, false, false, indexInfo, false, true);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::COMPRESSED) {
+        if (eagerEval) {
+            rel = new DirectRelation(ramRel, indexSelection, false, false, indexInfo);
+        } else {
+            rel = new DirectRelation(ramRel, indexSelection, false, false, indexInfo, false, false, true);
+        }
     } else if (ramRel.getRepresentation() == RelationRepresentation::BTREE) {
-        rel = new DirectRelation(ramRel, indexSelection, false, false, indexInfo);
+        rel = new DirectRelation(
+                ramRel, indexSelection, false, false, indexInfo, false, false, false, compressLeaves);
+    } else if (isLatticeRepresentation(ramRel.getRepresentation())) {
+        assert(!eagerEval);
+        rel = new DirectRelation(ramRel, indexSelection, false, false, IndexInfo{});
     } else if (ramRel.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
         assert(!eagerEval);
         rel = new DirectRelation(ramRel, indexSelection, false, true, indexInfo);
@@ -77,7 +95,8 @@ Own<Relation> Relation::getSynthesiserRelation(const ram::Relation& ramRel,
         if (ramRel.getArity() > 6 && !eagerEval) {
             rel = new IndirectRelation(ramRel, indexSelection);
         } else {
-            rel = new DirectRelation(ramRel, indexSelection, false, false, indexInfo);
+            rel = new DirectRelation(
+                    ramRel, indexSelection, false, false, indexInfo, false, false, false, compressLeaves);
         }
     }
 
@@ -145,8 +164,9 @@ void DirectRelation::computeIndices() {
         // If this relation is used with provenance,
         // we must expand all search orders to be full indices,
         // since weak/strong comparators and updaters need this,
-        // and also add provenance annotations to the indices
-        if (isProvenance || hasErase) {
+        // and also add provenance annotations to the indices.
+        // The same holds for lattices, whose joined last column ends all their search orders
+        if (isProvenance || hasErase || isLattice) {
             // expand index to be full
             for (std::size_t i = 0; i < getArity() - relation.getAuxiliaryArity(); i++) {
                 if (curIndexElems.find(i) == curIndexElems.end()) {
@@ -193,6 +213,16 @@ std::string DirectRelation::getTypeNamespace() {
     std::stringstream res;
     if (hasErase) {
         res << "t_btree_delete_";
+    } else if (isSorted) {
+        res << "t_sorted_";
+    } else if (isHash) {
+        res << "t_hash_";
+    } else if (isPacked) {
+        res << "t_packed_";
+    } else if (relation.getRepresentation() == RelationRepresentation::LATTICE_MIN) {
+        res << "t_lattice_min_";
+    } else if (relation.getRepresentation() == RelationRepresentation::LATTICE_MAX) {
+        res << "t_lattice_max_";
     } else {
         res << "t_btree_";
     }
@@ -219,6 +249,14 @@ std::string DirectRelation::getTypeName() {
     return getTypeNamespace() + "::Type";
 }
 
+/**
+ * Tuples of relations in plain btrees may be appended, as no updater joins them. Hash sets are
+ * cheaper to insert into concurrently than to build from buffered tuples.
+ */
+bool DirectRelation::supportsAppendBuffer() const {
+    return !isProvenance && !hasErase && !isLattice && !isHash;
+}
+
 /** Generate type struct of a direct indexed relation */
 void DirectRelation::generateTypeStruct(GenDb& db) {
     std::size_t arity = getArity();
@@ -236,10 +274,20 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     cl.addInclude("\"souffle/SouffleInterface.h\"");
     if (hasErase) {
         cl.addInclude("\"souffle/datastructure/BTreeDelete.h\"");
+    } else if (isSorted) {
+        cl.addInclude("\"souffle/datastructure/SortedArray.h\"");
+    } else if (isHash) {
+        cl.addInclude("\"souffle/datastructure/ConcurrentHashSet.h\"");
+    } else if (isPacked) {
+        cl.addInclude("\"souffle/datastructure/PackedArray.h\"");
     } else {
         cl.addInclude("\"souffle/datastructure/BTree.h\"");
         cl.addInclude("\"souffle/datastructure/EagerEval.h\"");
     }
+    if (supportsAppendBuffer()) {
+        cl.addInclude("\"souffle/datastructure/AppendBuffer.h\"");
+    }
+    cl.addInclude("\"souffle/utility/ParallelUtil.h\"");
 
     // struct definition
     decl << "struct Type {\n";
@@ -261,6 +309,22 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
         decl << "};\n";
     }
 
+    // generate an updater class joining the last column of lattices
+    if (isLattice) {
+        const bool isMax = relation.getRepresentation() == RelationRepresentation::LATTICE_MAX;
+        const std::string oldValue = "ramBitCast<RamSigned>(old_t[" + std::to_string(arity - 1) + "])";
+        const std::string newValue = "ramBitCast<RamSigned>(new_t[" + std::to_string(arity - 1) + "])";
+        decl << "struct updater {\n";
+        decl << "bool updates(const t_tuple& old_t, const t_tuple& new_t) const {\n";
+        decl << "return " << (isMax ? oldValue : newValue) << " < " << (isMax ? newValue : oldValue)
+             << ";\n";
+        decl << "}\n";
+        decl << "void update(t_tuple& old_t, const t_tuple& new_t) {\n";
+        decl << "old_t[" << arity - 1 << "] = new_t[" << arity - 1 << "];\n";
+        decl << "}\n";
+        decl << "};\n";
+    }
+
     // compute which indices need to be stored using an `eager_eval` data structure
     std::set<std::size_t> eagerEvalPositions;
     if (indexInfo.master) {
@@ -270,6 +334,9 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
         eagerEvalPositions.emplace(indexSelection.getLexOrderNum(search));
     }
 
+    // the indexes stored in plain btrees, sorted arrays or packed arrays, which can be built in bulk
+    std::set<std::size_t> bulkLoadIndexes;
+
     // generate the btree type for each relation
     for (std::size_t i = 0; i < inds.size(); i++) {
         auto& ind = inds[i];
@@ -291,6 +358,16 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
 
         auto genstruct = [&](std::string name, std::size_t bound) {
             decl << "struct " << name << "{\n";
+
+            // comparing all columns in natural order by their signed values enables SIMD searches
+            bool lexicographicSigned = (bound == arity);
+            for (std::size_t i = 0; i < bound; i++) {
+                lexicographicSigned &= ind[i] == i && types[i][0] != 'f' && types[i][0] != 'u';
+            }
+            if (lexicographicSigned) {
+                decl << "static constexpr std::size_t lexicographic_signed_arity = " << arity << ";\n";
+            }
+
             decl << " int operator()(const t_tuple& a, const t_tuple& b) const {\n";
             decl << "  return ";
             std::function<void(std::size_t)> gencmp = [&](std::size_t i) {
@@ -307,7 +384,11 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
                 }
                 decl << ")";
             };
-            gencmp(0);
+            if (bound > 0) {
+                gencmp(0);
+            } else {
+                decl << "0";
+            }
             decl << ";\n }\n";
             decl << "bool less(const t_tuple& a, const t_tuple& b) const {\n";
             decl << "  return ";
@@ -323,7 +404,11 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
                     decl << "))";
                 }
             };
-            genless(0);
+            if (bound > 0) {
+                genless(0);
+            } else {
+                decl << "false";
+            }
             decl << ";\n }\n";
             decl << "bool equal(const t_tuple& a, const t_tuple& b) const {\n";
             decl << "return ";
@@ -338,7 +423,11 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
                     geneq(i + 1);
                 }
             };
-            geneq(0);
+            if (bound > 0) {
+                geneq(0);
+            } else {
+                decl << "true";
+            }
             decl << ";\n }\n";
             decl << "};\n";
         };
@@ -363,6 +452,28 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
                  << ",std::allocator<t_tuple>,256,typename "
                     "souffle::detail::default_strategy<t_tuple>::type,"
                  << comparator_aux << ",updater>;\n";
+        } else if (isLattice) {
+            // tuples weakly equal by all but the last column are joined by the updater
+            std::string comparator_aux = "t_comparator_" + std::to_string(i) + "_aux";
+            genstruct(comparator_aux, ind.size() - 1);
+            decl << "using t_ind_" << i << " = btree_set<t_tuple," << comparator
+                 << ",std::allocator<t_tuple>,256,typename "
+                    "souffle::detail::default_strategy<t_tuple>::type,"
+                 << comparator_aux << ",updater>;\n";
+        } else if (isHash) {
+            // hash sets are only searched by all columns, hence a single index is required
+            assert(inds.size() == 1 && ind.size() == arity);
+            decl << "using t_ind_" << i << " = concurrent_hash_set<t_tuple>;\n";
+        } else if (isSorted) {
+            // sorted arrays are built in bulk only
+            bulkLoadIndexes.insert(i);
+            decl << "using t_ind_" << i << " = sorted_array_" << (ind.size() == arity ? "set" : "multiset")
+                 << "<t_tuple," << comparator << ">;\n";
+        } else if (isPacked) {
+            // packed arrays choose the widths of their columns when built in bulk
+            bulkLoadIndexes.insert(i);
+            decl << "using t_ind_" << i << " = packed_array_" << (ind.size() == arity ? "set" : "multiset")
+                 << "<t_tuple," << comparator << ">;\n";
         } else {
             std::string btree_name = "btree";
             if (eagerEvalPositions.count(i)) {
@@ -370,12 +481,24 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
             } else if (hasErase) {
                 btree_name = "btree_delete";
             }
+            if (btree_name == "btree") {
+                bulkLoadIndexes.insert(i);
+            }
+            // the leaves of btrees of wide relations may share common prefixes among their tuples
+            std::string params = "<t_tuple," + comparator;
+            if (compressLeaves && btree_name == "btree" && arity >= 6) {
+                params += ",std::allocator<t_tuple>,256,"
+                          "typename souffle::detail::default_strategy<t_tuple>::type," +
+                          comparator +
+                          ",souffle::detail::updater<t_tuple>,souffle::detail::no_statistics<t_tuple>,"
+                          "souffle::detail::prefix_compression<t_tuple>";
+            }
+            params += ">";
             if (ind.size() == arity) {
-                decl << "using t_ind_" << i << " = " << btree_name << "_set<t_tuple," << comparator << ">;\n";
+                decl << "using t_ind_" << i << " = " << btree_name << "_set" << params << ";\n";
             } else {
                 // without provenance, some indices may be not full, so we use btree_multiset for those
-                decl << "using t_ind_" << i << " = " << btree_name << "_multiset<t_tuple," << comparator
-                     << ">;\n";
+                decl << "using t_ind_" << i << " = " << btree_name << "_multiset" << params << ";\n";
             }
         }
         decl << "t_ind_" << i << " ind_" << i << ";\n";
@@ -459,6 +582,167 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     def << "return insert(data);\n";
     def << "}\n";  // end of insert(RamDomain x1, RamDomain x2, ...)
 
+    // bulk insert method: the chunks of the other relation are inserted into the master index, and
+    // the tuples new to it into the other indexes, each index and chunk in parallel
+    std::vector<std::size_t> secondaryIndexes;
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        if (i != masterIndex && provenanceIndexNumbers.find(i) == provenanceIndexNumbers.end()) {
+            secondaryIndexes.push_back(i);
+        }
+    }
+    decl << "template <typename Source>\n";
+    decl << "void insertAll(const Source& source) {\n";
+    if (isHash) {
+        // hash sets are inserted into concurrently, regardless of the order of the tuples
+        decl << "const auto chunks = source.partition();\n";
+        decl << "const int numChunks = static_cast<int>(chunks.size());\n";
+        decl << "PARALLEL_START\n";
+        decl << "pfor(int i = 0; i < numChunks; ++i) {\n";
+        decl << "t_ind_" << masterIndex << "::operation_hints hints;\n";
+        decl << "for (const auto& t : chunks[i]) ind_" << masterIndex << ".insert(t, hints);\n";
+        decl << "}\n";
+        decl << "PARALLEL_END\n";
+    } else if (isSorted || isPacked) {
+        // sorted and packed arrays are merged with the tuples of the other relation as a whole
+        decl << "std::vector<t_tuple> tuples;\n";
+        decl << "tuples.reserve(source.size());\n";
+        decl << "for (const auto& t : source) tuples.push_back(t);\n";
+        decl << "t_comparator_" << masterIndex << " comparator;\n";
+        decl << "auto less = [&](const t_tuple& a, const t_tuple& b) { return comparator.less(a, b); };\n";
+        decl << "if (!std::is_sorted(tuples.begin(), tuples.end(), less)) {\n";
+        decl << "std::sort(tuples.begin(), tuples.end(), less);\n";
+        decl << "}\n";
+        decl << "insertSorted(tuples);\n";
+    } else {
+        decl << "const auto chunks = source.partition();\n";
+        decl << "const int numChunks = static_cast<int>(chunks.size());\n";
+        if (!secondaryIndexes.empty()) {
+            decl << "std::vector<std::vector<t_tuple>> added(numChunks);\n";
+        }
+        decl << "PARALLEL_START\n";
+        decl << "pfor(int i = 0; i < numChunks; ++i) {\n";
+        decl << "insertChunk<t_comparator_" << masterIndex << ">(ind_" << masterIndex << ", chunks[i]"
+             << (secondaryIndexes.empty() ? "" : ", &added[i]") << ");\n";
+        decl << "}\n";
+        decl << "PARALLEL_END\n";
+        if (!secondaryIndexes.empty()) {
+            decl << "PARALLEL_START\n";
+            decl << "pfor(int i = 0; i < " << secondaryIndexes.size() << " * numChunks; ++i) {\n";
+            decl << "const auto& chunk = added[i % numChunks];\n";
+            decl << "switch (i / numChunks) {\n";
+            for (std::size_t k = 0; k < secondaryIndexes.size(); k++) {
+                std::size_t i = secondaryIndexes[k];
+                decl << "case " << k << ": insertChunk<t_comparator_" << i << ">(ind_" << i << ", chunk);\n";
+                decl << "break;\n";
+            }
+            decl << "}\n";
+            decl << "}\n";
+            decl << "PARALLEL_END\n";
+        }
+    }
+    decl << "}\n";
+
+    // inserts a chunk sorted by the order of an index, such that each insertion starts from the
+    // previous one, and collects the tuples new to the index if requested
+    decl << "template <typename Comparator, typename Index, typename Chunk>\n";
+    decl << "static void insertChunk(Index& index, const Chunk& chunk, std::vector<t_tuple>* added = "
+            "nullptr) {\n";
+    decl << "auto less = [](const t_tuple& a, const t_tuple& b) { return Comparator().less(a, b); };\n";
+    decl << "if (!std::is_sorted(chunk.begin(), chunk.end(), less)) {\n";
+    decl << "std::vector<t_tuple> tuples(chunk.begin(), chunk.end());\n";
+    decl << "std::sort(tuples.begin(), tuples.end(), less);\n";
+    decl << "insertChunk<Comparator>(index, tuples, added);\n";
+    decl << "return;\n";
+    decl << "}\n";
+    decl << "typename Index::operation_hints hints;\n";
+    decl << "for (const auto& t : chunk) {\n";
+    decl << "if (index.insert(t, hints) && added != nullptr) added->push_back(t);\n";
+    decl << "}\n";
+    decl << "}\n";
+
+    // batch insert method: the tuples of the batch new to the master index are inserted into each
+    // index in parallel, building btrees in bulk
+    if (isHash) {
+        // hash sets are inserted into concurrently, in chunks of 1024 tuples as in insertAll
+        decl << "void insertBatch(const RamDomain* data, std::size_t count) {\n";
+        decl << "const int numChunks = static_cast<int>((count + 1023) / 1024);\n";
+        decl << "PARALLEL_START\n";
+        decl << "pfor(int i = 0; i < numChunks; ++i) {\n";
+        decl << "t_ind_" << masterIndex << "::operation_hints hints;\n";
+        decl << "const std::size_t last = std::min(count, static_cast<std::size_t>(i + 1) * 1024);\n";
+        decl << "for (std::size_t j = static_cast<std::size_t>(i) * 1024; j < last; ++j) {\n";
+        decl << "t_tuple t;\n";
+        decl << "std::copy_n(data + j * " << arity << ", " << arity << ", t.begin());\n";
+        decl << "ind_" << masterIndex << ".insert(t, hints);\n";
+        decl << "}\n";
+        decl << "}\n";
+        decl << "PARALLEL_END\n";
+        decl << "}\n";
+    } else if (!isProvenance) {
+        std::vector<std::size_t> batchIndexes = secondaryIndexes;
+        batchIndexes.insert(batchIndexes.begin(), masterIndex);
+        decl << "void insertBatch(const RamDomain* data, std::size_t count) {\n";
+        decl << "std::vector<t_tuple> tuples(count);\n";
+        decl << "for (std::size_t i = 0; i < count; ++i) {\n";
+        decl << "std::copy_n(data + i * " << arity << ", " << arity << ", tuples[i].begin());\n";
+        decl << "}\n";
+        decl << "t_comparator_" << masterIndex << " comparator;\n";
+        decl << "std::sort(tuples.begin(), tuples.end(), [&](const t_tuple& a, const t_tuple& b) { return "
+                "comparator.less(a, b); });\n";
+        decl << "insertSorted(tuples);\n";
+        decl << "}\n";
+
+        // inserts tuples sorted by the order of the master index
+        decl << "void insertSorted(const std::vector<t_tuple>& tuples) {\n";
+        decl << "t_comparator_" << masterIndex << " comparator;\n";
+        decl << "std::vector<t_tuple> added;\n";
+        decl << "t_ind_" << masterIndex << "::operation_hints hints;\n";
+        decl << "for (const auto& t : tuples) {\n";
+        decl << "if ((added.empty() || !comparator.equal(added.back(), t)) && !ind_" << masterIndex
+             << ".contains(t, hints)) added.push_back(t);\n";
+        decl << "}\n";
+        decl << "PARALLEL_START\n";
+        decl << "pfor(int i = 0; i < " << batchIndexes.size() << "; ++i) {\n";
+        decl << "switch (i) {\n";
+        for (std::size_t k = 0; k < batchIndexes.size(); k++) {
+            std::size_t i = batchIndexes[k];
+            decl << "case " << k << ": " << (bulkLoadIndexes.count(i) ? "bulkLoad" : "insertChunk")
+                 << "<t_comparator_" << i << ">(ind_" << i << ", added);\n";
+            decl << "break;\n";
+        }
+        decl << "}\n";
+        decl << "}\n";
+        decl << "PARALLEL_END\n";
+        decl << "}\n";
+
+        // builds a btree in bulk from tuples sorted by the order of the given index
+        decl << "template <typename Comparator, typename Index>\n";
+        decl << "static void bulkLoad(Index& index, const std::vector<t_tuple>& tuples) {\n";
+        decl << "auto less = [](const t_tuple& a, const t_tuple& b) { return Comparator().less(a, b); };\n";
+        decl << "if (!std::is_sorted(tuples.begin(), tuples.end(), less)) {\n";
+        decl << "std::vector<t_tuple> sorted(tuples);\n";
+        decl << "std::sort(sorted.begin(), sorted.end(), less);\n";
+        decl << "index.bulk_load(sorted.begin(), sorted.end());\n";
+        decl << "return;\n";
+        decl << "}\n";
+        decl << "index.bulk_load(tuples.begin(), tuples.end());\n";
+        decl << "}\n";
+    }
+
+    // append methods: tuples are collected by per-thread buffers, and inserted in bulk once sealed
+    if (supportsAppendBuffer()) {
+        decl << "AppendBuffer<t_tuple> buffer;\n";
+        decl << "void append(const t_tuple& t) {\n";
+        decl << "buffer.append(t);\n";
+        decl << "}\n";
+        decl << "void seal() {\n";
+        decl << "if (buffer.empty()) return;\n";
+        decl << "t_comparator_" << masterIndex << " comparator;\n";
+        decl << "insertSorted(buffer.drain([&](const t_tuple& a, const t_tuple& b) { return "
+                "comparator.less(a, b); }));\n";
+        decl << "}\n";
+    }
+
     // contains methods
     decl << "bool contains(const t_tuple& t, context& h) const;\n";
     def << "bool Type::contains(const t_tuple& t, context& h) const {\n";
@@ -531,6 +815,9 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
         if (eagerEval) {
             def << "auto p = ind_"  << indNum << ".slice(lower, upper);\n";
             def << "return make_range(p.first, p.second);\n";
+        } else if (isHash) {
+            // hash sets are only searched by all of their columns, with lower == upper
+            def << "return ind_" << indNum << ".equal_range(lower, h.hints_" << indNum << "_lower);\n";
         } else {
             // count size of search pattern
             std::size_t eqSize = 0;
@@ -606,6 +893,9 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     for (std::size_t i = 0; i < numIndexes; i++) {
         def << "ind_" << i << ".clear();\n";
     }
+    if (supportsAppendBuffer()) {
+        def << "buffer.clear();\n";
+    }
     def << "}\n";
 
     // begin and end iterators
@@ -635,7 +925,9 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     decl << "void printStatistics(std::ostream& o) const;\n";
     def << "void Type::printStatistics(std::ostream& o) const {\n";
     for (std::size_t i = 0; i < numIndexes; i++) {
-        def << "o << \" arity " << arity << " direct b-tree index " << i << " lex-order " << inds[i]
+        def << "o << \" arity " << arity << " direct "
+            << (isSorted ? "sorted-array" : isHash ? "hash-set" : isPacked ? "packed-array" : "b-tree")
+            << " index " << i << " lex-order " << inds[i]
             << "\\n\";\n";
         def << "ind_" << i << ".printStats(o);\n";
     }
@@ -713,6 +1005,7 @@ void IndirectRelation::generateTypeStruct(GenDb& db) {
     cl.addInclude("\"souffle/SouffleInterface.h\"");
     cl.addInclude("\"souffle/datastructure/Table.h\"");
     cl.addInclude("\"souffle/datastructure/BTree.h\"");
+    cl.addInclude("\"souffle/utility/ParallelUtil.h\"");
 
     // struct definition
     decl << "struct Type {\n";
@@ -849,6 +1142,19 @@ void IndirectRelation::generateTypeStruct(GenDb& db) {
     def << "return true;\n";
     def << "}\n";
 
+    // bulk insert method, inserting the chunks of the other relation in parallel
+    decl << "template <typename Source>\n";
+    decl << "void insertAll(const Source& source) {\n";
+    decl << "const auto chunks = source.partition();\n";
+    decl << "const int numChunks = static_cast<int>(chunks.size());\n";
+    decl << "PARALLEL_START\n";
+    decl << "pfor(int i = 0; i < numChunks; ++i) {\n";
+    decl << "context h;\n";
+    decl << "for (const auto& t : chunks[i]) insert(t, h);\n";
+    decl << "}\n";
+    decl << "PARALLEL_END\n";
+    decl << "}\n";
+
     decl << "bool insert(const RamDomain* ramDomain);\n";
     def << "bool Type::insert(const RamDomain* ramDomain) {\n";
     def << "RamDomain data[" << arity << "];\n";
@@ -1093,6 +1399,7 @@ void BrieRelation::generateTypeStruct(GenDb& db) {
     std::ostream& def = cl.def();
     cl.addInclude("\"souffle/SouffleInterface.h\"");
     cl.addInclude("\"souffle/datastructure/Brie.h\"");
+    cl.addInclude("\"souffle/utility/ParallelUtil.h\"");
 
     // struct definition
     decl << "struct Type {\n";
@@ -1182,6 +1489,19 @@ void BrieRelation::generateTypeStruct(GenDb& db) {
     def << "} else return false;\n";
     def << "}\n";
 
+    // bulk insert method, inserting the chunks of the other relation in parallel
+    decl << "template <typename Source>\n";
+    decl << "void insertAll(const Source& source) {\n";
+    decl << "const auto chunks = source.partition();\n";
+    decl << "const int numChunks = static_cast<int>(chunks.size());\n";
+    decl << "PARALLEL_START\n";
+    decl << "pfor(int i = 0; i < numChunks; ++i) {\n";
+    decl << "context h;\n";
+    decl << "for (const auto& t : chunks[i]) insert(t, h);\n";
+    decl << "}\n";
+    decl << "PARALLEL_END\n";
+    decl << "}\n";
+
     decl << "bool insert(const RamDomain* ramDomain);\n";
     def << "bool Type::insert(const RamDomain* ramDomain) {\n";
     def << "RamDomain data[" << arity << "];\n";
@@ -73,9 +73,15 @@ public:
     /** Generate relation type struct */
     virtual void generateTypeStruct(GenDb& db) = 0;
 
+    /** Whether the relation type may buffer appended tuples until sealed */
+    virtual bool supportsAppendBuffer() const {
+        return false;
+    }
+
     /** Factory method to generate a SynthesiserRelation */
     static Own<Relation> getSynthesiserRelation(const ram::Relation& ramRel,
-            const ram::analysis::IndexCluster& indexSelection, const IndexInfo& indexInfo, bool eagerEval);
+            const ram::analysis::IndexCluster& indexSelection, const IndexInfo& indexInfo, bool eagerEval,
+            bool sortedDelta, bool hashSet, bool compressLeaves);
 
 protected:
     /** Ram relation referred to by this */
@@ -120,18 +126,30 @@ public:
 class DirectRelation : public Relation {
 public:
     DirectRelation(const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection,
-            bool isProvenance, bool hasErase, const IndexInfo& indexInfo)
+            bool isProvenance, bool hasErase, const IndexInfo& indexInfo, bool isSorted = false,
+            bool isHash = false, bool isPacked = false, bool compressLeaves = false)
             : Relation(ramRel, indexSelection), isProvenance(isProvenance), hasErase(hasErase),
-              indexInfo(indexInfo) {}
+              isLattice(isLatticeRepresentation(ramRel.getRepresentation())), isSorted(isSorted),
+              isHash(isHash), isPacked(isPacked), compressLeaves(compressLeaves), indexInfo(indexInfo) {}
 
     void computeIndices() override;
     std::string getTypeNamespace();
     std::string getTypeName() override;
     void generateTypeStruct(GenDb& db) override;
+    bool supportsAppendBuffer() const override;
 
 private:
     const bool isProvenance;
     const bool hasErase;
+    const bool isLattice;
+    // whether the indexes are sorted arrays, see SortedDeltaAnalysis
+    const bool isSorted;
+    // whether the index is a hash set, see IndexAnalysis::isHashRelation
+    const bool isHash;
+    // whether the indexes are packed arrays, storing a compressed relation
+    const bool isPacked;
+    // whether the leaves of btree indexes of wide relations share common prefixes (--compress-leaves)
+    const bool compressLeaves;
     IndexInfo indexInfo;
 };
 
@@ -22,6 +22,7 @@
 #include "RelationTag.h"
 #include "config.h"
 #include "ram/AbstractParallel.h"
+#include "ram/AdaptiveQuery.h"
 #include "ram/Aggregate.h"
 #include "ram/Aggregator.h"
 #include "ram/AutoIncrement.h"
@@ -40,6 +41,7 @@
 #include "ram/False.h"
 #include "ram/Filter.h"
 #include "ram/FloatConstant.h"
+#include "ram/HashJoin.h"
 #include "ram/IO.h"
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
@@ -47,10 +49,13 @@
 #include "ram/IndexScan.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicOperator.h"
+#include "ram/LeapfrogInput.h"
+#include "ram/LeapfrogJoin.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
@@ -87,6 +92,8 @@
 #include "ram/UnsignedConstant.h"
 #include "ram/UserDefinedAggregator.h"
 #include "ram/UserDefinedOperator.h"
+#include "ram/analysis/AppendOnly.h"
+#include "ram/analysis/SortedDelta.h"
 #include "ram/analysis/Index.h"
 #include "ram/utility/Utils.h"
 #include "ram/utility/Visitor.h"
@@ -201,6 +208,8 @@ ram::RelationSet Synthesiser::getReferencedRelations(const Operation& op) {
             res.insert(lookup(agg->getRelation()));
         } else if (auto exists = as<ExistenceCheck>(node)) {
             res.insert(lookup(exists->getRelation()));
+        } else if (auto input = as<LeapfrogInput>(node)) {
+            res.insert(lookup(input->getRelation()));
         } else if (auto provExists = as<ProvenanceExistenceCheck>(node)) {
             res.insert(lookup(provExists->getRelation()));
         } else if (auto insert = as<Insert>(node)) {
@@ -312,6 +321,13 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             };
         }
 
+        /** Seals the given relation, inserting its buffered tuples, if insertions into it are buffered */
+        void emitSeal(const std::string& relation, std::ostream& out) {
+            if (contains(synthesiser.bufferedRelations, relation)) {
+                out << synthesiser.getRelationName(synthesiser.lookup(relation)) << "->seal();\n";
+            }
+        }
+
         std::pair<std::stringstream, std::stringstream> getPaddedRangeBounds(const ram::Relation& rel,
                 const std::vector<Expression*>& rangePatternLower,
                 const std::vector<Expression*>& rangePatternUpper) {
@@ -424,10 +440,8 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 out << R"_(else if (!outputDirectory.empty()) {)_";
                 out << R"_(directiveMap["output-dir"] = outputDirectory;)_";
                 out << "}\n";
-                out << "IOSystem::getInstance().getWriter(";
-                out << "directiveMap, symTable, recordTable";
-                out << ")->writeAll(*" << synthesiser.getRelationName(synthesiser.lookup(io.getRelation()))
-                    << ");\n";
+                out << "backgroundWriter.writeAll(directiveMap, symTable, recordTable, *"
+                    << synthesiser.getRelationName(synthesiser.lookup(io.getRelation())) << ");\n";
                 out << "} catch (std::exception& e) {std::cerr << e.what();exit(1);}\n";
             } else {
                 assert("Wrong i/o operation");
@@ -487,6 +501,15 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             // enclose operation in its own scope
             out << "{\n";
 
+            // build the hash tables of hash joins, shared by all threads
+            visit(*next, [&](const HashJoin& hashJoin) {
+                const auto* rel = synthesiser.lookup(hashJoin.getRelation());
+                out << "HashJoinTable hashJoin" << hashJoin.getTupleId() << "(" << rel->getArity() << ",{"
+                    << join(hashJoin.getKeyColumns(), ",") << "});\n";
+                out << "hashJoin" << hashJoin.getTupleId() << ".build("
+                    << synthesiser.getRelationName(rel) << "->partition());\n";
+            });
+
             // check whether loop nest can be parallelized
             bool isParallel = visitExists(
                     *next, [&](const Node& n) { return as<AbstractParallel, AllowCrossCast>(n); });
@@ -572,6 +595,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
 
         void visit_(type_identity<LogSize>, const LogSize& size, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
+            emitSeal(size.getRelation(), out);
             out << "ProfileEventSingleton::instance().makeQuantityEvent( R\"(";
             out << size.getMessage() << ")\",";
             out << synthesiser.getRelationName(synthesiser.lookup(size.getRelation())) << "->size(),iter);";
@@ -588,6 +612,42 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<AdaptiveQuery>, const AdaptiveQuery& adaptive, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            auto stmts = adaptive.getStatements();
+            const auto& plans = adaptive.getPlans();
+
+            // execute the alternative with the least estimated cost for the current relation sizes
+            out << "{\n";
+            out << "std::size_t best = 0;\n";
+            out << "double bestCost = std::numeric_limits<double>::infinity();\n";
+            for (std::size_t i = 0; i < plans.size(); ++i) {
+                out << "{\n";
+                out << "double cost = 0;\n";
+                out << "double tuples = 1;\n";
+                for (const auto& [relation, exponent] : plans[i]) {
+                    out << "tuples *= std::pow(static_cast<double>("
+                        << synthesiser.getRelationName(synthesiser.lookup(relation)) << "->size()), "
+                        << exponent << ");\n";
+                    out << "cost += tuples;\n";
+                }
+                out << "if (cost < bestCost) {\n";
+                out << "best = " << i << ";\n";
+                out << "bestCost = cost;\n";
+                out << "}\n";
+                out << "}\n";
+            }
+            out << "switch (best) {\n";
+            for (std::size_t i = 0; i < stmts.size(); ++i) {
+                out << "case " << i << ": {\n";
+                dispatch(*stmts[i], out);
+                out << "} break;\n";
+            }
+            out << "}\n";
+            out << "}\n";
+            PRINT_END_COMMENT(out);
+        }
+
         void visit_(type_identity<Parallel>, const Parallel& parallel, std::ostream& out) override {
             assert(!glb.config().has("eager-eval") && "Parallel");
 
@@ -646,10 +706,28 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             const std::string& newKnowledge =
                     synthesiser.getRelationName(synthesiser.lookup(swap.getSecondRelation()));
 
+            emitSeal(swap.getFirstRelation(), out);
+            emitSeal(swap.getSecondRelation(), out);
             out << "std::swap(" << deltaKnowledge << ", " << newKnowledge << ");\n";
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<Merge>, const Merge& merge, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            if (glb.config().has("eager-eval") && isPrefix("@delta_", merge.getTargetRelation())) {
+                // Delta relations are not populated with eager evaluation, see visit_(Query)
+                PRINT_END_COMMENT(out);
+                return;
+            }
+            emitSeal(merge.getSourceRelation(), out);
+            emitSeal(merge.getTargetRelation(), out);
+            out << synthesiser.getRelationName(synthesiser.lookup(merge.getTargetRelation())) << "->"
+                << "insertAll("
+                << "*" << synthesiser.getRelationName(synthesiser.lookup(merge.getSourceRelation()))
+                << ");\n";
+            PRINT_END_COMMENT(out);
+        }
+
         void visit_(type_identity<MergeExtend>, const MergeExtend& extend, std::ostream& out) override {
             assert(!glb.config().has("eager-eval") && "MergeExtend");
 
@@ -691,8 +769,9 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             const auto* rel = synthesiser.lookup(timer.getRelation());
             auto relName = synthesiser.getRelationName(rel);
 
-            out << "\tLogger logger(R\"_(" << timer.getMessage() << ")_\",iter, [&](){return " << relName
-                << "->size();});\n";
+            out << "\tLogger logger(R\"_(" << timer.getMessage() << ")_\",iter, [&](){";
+            emitSeal(timer.getRelation(), out);
+            out << "return " << relName << "->size();});\n";
             // insert statement to be measured
             dispatch(timer.getStatement(), out);
 
@@ -1303,6 +1382,100 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<HashJoin>, const HashJoin& hashJoin, std::ostream& out) override {
+            auto identifier = hashJoin.getTupleId();
+            PRINT_BEGIN_COMMENT(out);
+
+            // the hash table is built by the query
+            out << "const RamDomain hashKey" << identifier << "[] = {";
+            bool first = true;
+            for (auto* value : hashJoin.getKeyValues()) {
+                out << (first ? "" : ",") << "ramBitCast(";
+                dispatch(*value, out);
+                out << ")";
+                first = false;
+            }
+            out << "};\n";
+            out << "for(auto cursor" << identifier << " = hashJoin" << identifier << ".probe(hashKey"
+                << identifier << "); cursor" << identifier << "; ++cursor" << identifier << ") {\n";
+            out << "const RamDomain* env" << identifier << " = *cursor" << identifier << ";\n";
+
+            if (glb.config().has("record-work")) {
+                out << "work.local()++;\n";
+            }
+
+            visit_(type_identity<TupleOperation>(), hashJoin, out);
+
+            out << "}\n";
+            PRINT_END_COMMENT(out);
+        }
+
+        void visit_(type_identity<LeapfrogJoin>, const LeapfrogJoin& leapfrog, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            auto identifier = leapfrog.getTupleId();
+            auto inputs = leapfrog.getInputs();
+            auto value = "lfValue" + std::to_string(identifier);
+            auto seek = "lfSeek" + std::to_string(identifier);
+
+            // the order of the values follows the type of the intersected columns
+            const auto* first = synthesiser.lookup(inputs.front()->getRelation());
+            std::string minimum = "MIN_RAM_SIGNED";
+            std::string maximum = "MAX_RAM_SIGNED";
+            std::string successor = value + " + 1";
+            if (first->getAttributeTypes()[inputs.front()->getColumn()][0] == 'u') {
+                minimum = "ramBitCast<RamDomain>(MIN_RAM_UNSIGNED)";
+                maximum = "ramBitCast<RamDomain>(MAX_RAM_UNSIGNED)";
+                successor = "ramBitCast<RamDomain>(ramBitCast<RamUnsigned>(" + value + ") + 1)";
+            }
+
+            // seek the inputs in turn to the candidate value until all of them agree on it
+            out << "auto " << seek << " = [&](RamDomain& " << value << ") -> bool {\n";
+            out << "Tuple<RamDomain,1> env" << identifier << ";\n";
+            out << "std::size_t agree = 0;\n";
+            out << "for (std::size_t input = 0;; input = (input + 1) % " << inputs.size() << ") {\n";
+            out << "env" << identifier << "[0] = " << value << ";\n";
+            out << "RamDomain next = 0;\n";
+            out << "switch (input) {\n";
+            for (std::size_t i = 0; i < inputs.size(); ++i) {
+                const auto* input = inputs[i];
+                const auto* rel = synthesiser.lookup(input->getRelation());
+                auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(*rel) + ")";
+                auto keys = isa->getSearchSignature(input);
+
+                // the column is bounded from below by the candidate value
+                auto rangePatternLower = input->getValues();
+                auto rangePatternUpper = input->getValues();
+                TupleElement candidate(identifier, 0);
+                rangePatternLower[input->getColumn()] = &candidate;
+                auto rangeBounds = getPaddedRangeBounds(*rel, rangePatternLower, rangePatternUpper);
+
+                out << "case " << i << ": {\n";
+                out << "auto range = " << synthesiser.getRelationName(rel) << "->lowerUpperRange_" << keys
+                    << "(" << rangeBounds.first.str() << "," << rangeBounds.second.str() << "," << ctxName
+                    << ");\n";
+                out << "if (range.empty()) return false;\n";
+                out << "next = (*range.begin())[" << input->getColumn() << "];\n";
+                out << "break;\n";
+                out << "}\n";
+            }
+            out << "}\n";
+            out << "agree = (next == " << value << ") ? agree + 1 : 1;\n";
+            out << value << " = next;\n";
+            out << "if (agree == " << inputs.size() << ") return true;\n";
+            out << "}\n";
+            out << "};\n";
+
+            out << "RamDomain " << value << " = " << minimum << ";\n";
+            out << "for (bool found = " << seek << "(" << value << "); found; found = " << value
+                << " != " << maximum << " && " << seek << "(" << value << " = " << successor << ")) {\n";
+            out << "const Tuple<RamDomain,1> env" << identifier << "{{" << value << "}};\n";
+
+            visit_(type_identity<TupleOperation>(), leapfrog, out);
+
+            out << "}\n";
+            PRINT_END_COMMENT(out);
+        }
+
         std::string initValue(const Aggregator& aggregator) {
             if (const auto* ia = as<ram::IntrinsicAggregator>(aggregator)) {
                 switch (ia->getFunction()) {
@@ -1610,7 +1783,8 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             const auto* tupleElem = as<TupleElement>(aggregate.getExpression());
             return tupleElem && tupleElem->getTupleId() == identifier &&
                    keys[tupleElem->getElement()] != ram::analysis::AttributeConstraint::None &&
-                   (repr == RelationRepresentation::BTREE || repr == RelationRepresentation::DEFAULT);
+                   (repr == RelationRepresentation::BTREE || repr == RelationRepresentation::DEFAULT ||
+                           repr == RelationRepresentation::COMPRESSED);
         }
 
         void visit_(
@@ -1995,6 +2169,8 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     out << "tg.run([&, tuple] { " << p.first << "(tg, tuple); });\n";
                 }
                 out << "}\n";
+            } else if (contains(synthesiser.bufferedRelations, insert.getRelation())) {
+                out << relName << "->append(tuple);\n";
             } else {
                 out << relName << "->"
                     << "insert(tuple," << ctxName << ");\n";
@@ -2160,16 +2336,25 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         void visit_(
                 type_identity<EmptinessCheck>, const EmptinessCheck& emptiness, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
-            out << synthesiser.getRelationName(synthesiser.lookup(emptiness.getRelation())) << "->"
-                << "empty()";
+            const auto relName = synthesiser.getRelationName(synthesiser.lookup(emptiness.getRelation()));
+            if (contains(synthesiser.bufferedRelations, emptiness.getRelation())) {
+                out << "(" << relName << "->seal(), " << relName << "->empty())";
+            } else {
+                out << relName << "->"
+                    << "empty()";
+            }
             PRINT_END_COMMENT(out);
         }
 
         void visit_(type_identity<RelationSize>, const RelationSize& size, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
-            out << "(RamDomain)" << synthesiser.getRelationName(synthesiser.lookup(size.getRelation()))
-                << "->"
-                << "size()";
+            const auto relName = synthesiser.getRelationName(synthesiser.lookup(size.getRelation()));
+            if (contains(synthesiser.bufferedRelations, size.getRelation())) {
+                out << "(RamDomain)(" << relName << "->seal(), " << relName << "->size())";
+            } else {
+                out << "(RamDomain)" << relName << "->"
+                    << "size()";
+            }
             PRINT_END_COMMENT(out);
         }
 
@@ -2692,8 +2877,16 @@ std::set<std::string> Synthesiser::accessedRelations(const Statement& stmt) {
     visit(stmt, [&](const RelationOperation& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const RelationStatement& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const AbstractExistenceCheck& node) { accessed.insert(node.getRelation()); });
+    visit(stmt, [&](const LeapfrogInput& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const EmptinessCheck& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const RelationSize& node) { accessed.insert(node.getRelation()); });
+    visit(stmt, [&](const AdaptiveQuery& node) {
+        for (const auto& plan : node.getPlans()) {
+            for (const auto& step : plan) {
+                accessed.insert(step.first);
+            }
+        }
+    });
     visit(stmt, [&](const BinRelationStatement& node) {
         accessed.insert(node.getFirstRelation());
         accessed.insert(node.getSecondRelation());
@@ -2805,6 +2998,8 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     // ---------------------------------------------------------------
     const Program& prog = translationUnit.getProgram();
     auto& idxAnalysis = translationUnit.getAnalysis<IndexAnalysis>();
+    const auto& appendOnly = translationUnit.getAnalysis<ram::analysis::AppendOnlyAnalysis>();
+    const auto& sortedDelta = translationUnit.getAnalysis<ram::analysis::SortedDeltaAnalysis>();
     // ---------------------------------------------------------------
     //                      Code Generation
     // ---------------------------------------------------------------
@@ -2949,7 +3144,15 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     for (auto rel : prog.getRelations()) {
         auto relationType =
                 Relation::getSynthesiserRelation(*rel, idxAnalysis.getIndexSelection(rel->getName()),
-                        indexInfo[rel->getName()], glb.config().has("eager-eval"));
+                        indexInfo[rel->getName()], glb.config().has("eager-eval"),
+                        sortedDelta.isSortedDelta(rel->getName()),
+                        idxAnalysis.isHashRelation(rel->getName()), glb.config().has("compress-leaves"));
+
+        // the tuples of relations only written while computed are buffered until sealed
+        if (!glb.config().has("eager-eval") && relationType->supportsAppendBuffer() &&
+                appendOnly.isAppendOnly(rel->getName())) {
+            bufferedRelations.insert(rel->getName());
+        }
 
         std::string typeName = relationType->getTypeName();
         generateRelationTypeStruct(db, std::move(relationType));
@@ -2992,6 +3195,7 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
 
         gen.addInclude("\"souffle/SouffleInterface.h\"");
         gen.addInclude("\"souffle/SignalHandler.h\"");
+        gen.addInclude("\"souffle/io/BackgroundWriter.h\"");
 
         GenFunction& constructor = gen.addConstructor(Visibility::Public);
 
@@ -3007,6 +3211,7 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         args.push_back(std::make_tuple(Reference, "ctr", "std::atomic<RamDomain>"));
         args.push_back(std::make_tuple(Reference, "inputDirectory", "std::string"));
         args.push_back(std::make_tuple(Reference, "outputDirectory", "std::string"));
+        args.push_back(std::make_tuple(Reference, "backgroundWriter", "BackgroundWriter"));
         for (std::string rel : accessedRels) {
             std::string name = getRelationName(lookup(rel));
             std::string tyname = relationTypes[name];
@@ -3173,7 +3378,9 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         const std::string& cppName = getRelationName(*rel);
 
         auto relationType = Relation::getSynthesiserRelation(*rel, idxAnalysis.getIndexSelection(datalogName),
-                indexInfo[datalogName], glb.config().has("eager-eval"));
+                indexInfo[datalogName], glb.config().has("eager-eval"),
+                sortedDelta.isSortedDelta(datalogName), idxAnalysis.isHashRelation(datalogName),
+                glb.config().has("compress-leaves"));
         const std::string& type = relationType->getTypeName();
 
         // defining table
@@ -3204,6 +3411,9 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         }
     }
 
+    // the writer of output relations finishes its writes before the relations are destroyed
+    mainClass.addField("BackgroundWriter", "backgroundWriter", Visibility::Private);
+
     for (auto [name, value] : subroutineInits) {
         std::string clName = convertStratumIdent("Stratum_" + name);
         std::string fName = convertStratumIdent("stratum_" + name);
@@ -3252,6 +3462,7 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     // if this is not set, and omp is used, the default omp setting of number of cores is used.
 #if defined(_OPENMP)
     if (0 < getNumThreads()) { omp_set_num_threads(static_cast<int>(getNumThreads())); }
+    backgroundWriter.setNumThreads(omp_get_max_threads());
 #endif
 
     signalHandler->set();
@@ -3290,11 +3501,20 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     // emit code
     currentClass = &mainClass;
     emitCode(runFunction.body(), prog.getMain());
+    // wait for the outputs written in the background
+    runFunction.body() << "try {backgroundWriter.wait();} "
+                          "catch (std::exception& e) {std::cerr << e.what();exit(1);}\n";
 
     if (glb.config().has("profile")) {
         runFunction.body() << "}\n"
                            << "ProfileEventSingleton::instance().stopTimer();\n"
                            << "dumpFreqs();\n";
+        // Store the memory held by the nodes of indexes
+        for (const char* stat : {"PeakBytes", "Slabs", "HugeSlabs"}) {
+            runFunction.body() << "ProfileEventSingleton::instance().makeConfigRecord(\"nodeArena" << stat
+                               << "\", std::to_string(NodeArenaStatistics::instance().get" << stat
+                               << "()));\n";
+        }
     }
 
     // add code printing hint statistics
@@ -98,6 +98,9 @@ private:
     /** Output relations */
     std::set<std::string> storeRelations;
 
+    /** Relations whose insertions are appended to buffers, sealed before the relation is read */
+    std::set<std::string> bufferedRelations;
+
 protected:
     /** Convert RAM identifier */
     const std::string convertRamIdent(const std::string& name);
@@ -0,0 +1,97 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file append_buffer_test.cpp
+ *
+ * Test cases for the buffers of relations only written while computed.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/AppendBuffer.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+using key = std::array<int, 2>;
+
+TEST(AppendBuffer, Drain) {
+    AppendBuffer<key> buffer;
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_TRUE(buffer.drain(std::less<key>()).empty());
+
+    std::mt19937 generator(1);
+    std::set<key> reference;
+    for (int i = 0; i < 10000; ++i) {
+        key cur{static_cast<int>(generator() % 100), static_cast<int>(generator() % 100)};
+        buffer.append(cur);
+        reference.insert(cur);
+    }
+    EXPECT_FALSE(buffer.empty());
+    EXPECT_EQ(10000, buffer.size());
+
+    auto res = buffer.drain(std::less<key>());
+    EXPECT_TRUE(std::equal(res.begin(), res.end(), reference.begin(), reference.end()));
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(0, buffer.size());
+
+    // the buffer is reused once drained, and cleared without draining
+    buffer.append({1, 2});
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_TRUE(buffer.drain(std::less<key>()).empty());
+}
+
+TEST(AppendBuffer, Order) {
+    AppendBuffer<key> buffer;
+    for (int i = 0; i < 1000; ++i) {
+        buffer.append({i % 10, i});
+    }
+
+    // elements equivalent by the order are kept once
+    auto res = buffer.drain([](const key& a, const key& b) { return a[0] > b[0]; });
+    EXPECT_EQ(10, res.size());
+    for (std::size_t i = 0; i < res.size(); ++i) {
+        EXPECT_EQ(9 - static_cast<int>(i), res[i][0]);
+    }
+}
+
+TEST(AppendBuffer, ParallelAppend) {
+    AppendBuffer<key> buffer;
+    const int N = 100000;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < N; ++i) {
+        // each element is appended twice, by different iterations
+        buffer.append({i % (N / 2), -(i % (N / 2))});
+    }
+
+    auto res = buffer.drain(std::less<key>());
+    EXPECT_EQ(N / 2, res.size());
+    for (int i = 0; i < N / 2; ++i) {
+        EXPECT_EQ(i, res[i][0]);
+        EXPECT_EQ(-i, res[i][1]);
+    }
+    EXPECT_TRUE(buffer.empty());
+}
+
+}  // namespace test
+}  // end namespace souffle
@@ -0,0 +1,104 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file background_writer_test.cpp
+ *
+ * Tests writing output relations in the background.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/RecordTableImpl.h"
+#include "souffle/datastructure/SymbolTableImpl.h"
+#include "souffle/io/BackgroundWriter.h"
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace souffle::test {
+
+using Tuples = std::vector<std::array<RamDomain, 2>>;
+
+std::map<std::string, std::string> directives(const std::string& io, const std::filesystem::path& path) {
+    return {{"IO", io}, {"name", "test"}, {"filename", path.string()},
+            {"types", R"({"relation": {"arity": 2, "types": ["s:symbol", "i:number"]}})"}};
+}
+
+std::string contents(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+TEST(BackgroundWriter, WritesBeforeClearing) {
+    const auto dir = std::filesystem::temp_directory_path();
+    SymbolTableImpl symbolTable;
+    SpecializedRecordTable<0> recordTable;
+
+    std::vector<Tuples> relations(8);
+    std::string expected;
+    for (RamDomain i = 0; i < 100000; ++i) {
+        expected += "s" + std::to_string(i % 10) + "\t" + std::to_string(i) + "\n";
+        for (auto& relation : relations) {
+            relation.push_back({symbolTable.encode("s" + std::to_string(i % 10)), i});
+        }
+    }
+
+    BackgroundWriter writer(3);
+    for (std::size_t i = 0; i < relations.size(); ++i) {
+        const auto path = dir / ("souffle_background_writer_test" + std::to_string(i) + ".csv");
+        writer.writeAll(directives("file", path), symbolTable, recordTable, relations[i]);
+        // clearing the relation waits for its write
+        auto& relation = relations[i];
+        writer.afterWrites(&relation, [&relation]() { relation.clear(); });
+    }
+    writer.wait();
+
+    for (std::size_t i = 0; i < relations.size(); ++i) {
+        const auto path = dir / ("souffle_background_writer_test" + std::to_string(i) + ".csv");
+        EXPECT_EQ(expected, contents(path));
+        EXPECT_TRUE(relations[i].empty());
+        std::filesystem::remove(path);
+    }
+
+    // relations without pending writes are cleared at once
+    Tuples relation = {{0, 0}};
+    writer.afterWrites(&relation, [&relation]() { relation.clear(); });
+    EXPECT_TRUE(relation.empty());
+}
+
+TEST(BackgroundWriter, RaisesErrorsOnWait) {
+    const auto path =
+            std::filesystem::temp_directory_path() / "souffle_background_writer_missing" / "test.bin";
+    SymbolTableImpl symbolTable;
+    SpecializedRecordTable<0> recordTable;
+    Tuples relation = {{symbolTable.encode("a"), 1}};
+
+    BackgroundWriter writer;
+    writer.writeAll(directives("binary", path), symbolTable, recordTable, relation);
+    std::string error;
+    try {
+        writer.wait();
+    } catch (std::invalid_argument& e) {
+        error = e.what();
+    }
+    EXPECT_EQ("Cannot write binary fact file " + path.string() + "\n", error);
+
+    // the error is raised once
+    writer.wait();
+}
+
+}  // namespace souffle::test
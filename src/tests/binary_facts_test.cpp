@@ -0,0 +1,193 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file binary_facts_test.cpp
+ *
+ * Tests writing and reading binary fact files.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/RecordTableImpl.h"
+#include "souffle/datastructure/SymbolTableImpl.h"
+#include "souffle/io/ReadStreamBinary.h"
+#include "souffle/io/WriteStreamBinary.h"
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace souffle::test {
+
+/** A relation collecting the tuples read. */
+struct Collector {
+    std::size_t arity;
+    std::vector<std::vector<RamDomain>> tuples;
+
+    void insert(const RamDomain* tuple) {
+        tuples.emplace_back(tuple, tuple + arity);
+    }
+};
+
+// a list of symbols, and a tree of numbers
+const std::string types = R"({
+    "relation": {"arity": 4, "types": ["s:symbol", "i:number", "r:List", "+:Tree"]},
+    "records": {"r:List": {"arity": 2, "types": ["s:symbol", "r:List"]}},
+    "ADTs": {"+:Tree": {"arity": 3, "enum": false, "branches": [
+        {"name": "Empty", "types": []},
+        {"name": "Leaf", "types": ["i:number"]},
+        {"name": "Node", "types": ["+:Tree", "+:Tree"]}]}}
+})";
+
+std::map<std::string, std::string> directives(
+        const std::filesystem::path& path, const std::string& relationTypes = types) {
+    return {{"IO", "binary"}, {"name", "test"}, {"filename", path.string()}, {"types", relationTypes},
+            {"auxArity", "1"}};
+}
+
+std::vector<std::vector<RamDomain>> read(const std::map<std::string, std::string>& rwOperation,
+        SymbolTable& symbolTable, RecordTable& recordTable) {
+    ReadFileBinary reader(rwOperation, symbolTable, recordTable);
+    Collector collector{5, {}};
+    reader.readAll(collector);
+    return collector.tuples;
+}
+
+template <typename T>
+void write(const std::map<std::string, std::string>& rwOperation, const T& relation,
+        const SymbolTable& symbolTable, const RecordTable& recordTable) {
+    WriteFileBinary writer(rwOperation, symbolTable, recordTable);
+    writer.writeAll(relation);
+}
+
+/** Returns the error reading the given file, if any. */
+std::string readError(const std::map<std::string, std::string>& rwOperation) {
+    SymbolTableImpl symbolTable;
+    SpecializedRecordTable<0> recordTable;
+    try {
+        read(rwOperation, symbolTable, recordTable);
+    } catch (std::invalid_argument& e) {
+        return e.what();
+    }
+    return "";
+}
+
+std::string contents(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+TEST(BinaryFacts, Roundtrip) {
+    const auto path = std::filesystem::temp_directory_path() / "souffle_binary_facts_test.bin";
+    const auto rwOperation = directives(path);
+
+    SymbolTableImpl symbolTable;
+    SpecializedRecordTable<0> recordTable;
+    std::vector<std::array<RamDomain, 5>> relation;
+    const RamDomain empty = recordTable.pack({0, recordTable.pack({}, 0)});
+    for (RamDomain i = 0; i < 10000; ++i) {
+        const RamDomain symbol = symbolTable.encode("s" + std::to_string(i % 100));
+        const RamDomain list = recordTable.pack({symbol, recordTable.pack({symbol, 0})});
+        const RamDomain leaf = recordTable.pack({1, i});
+        const RamDomain tree = recordTable.pack({2, recordTable.pack({leaf, i % 2 == 0 ? empty : leaf})});
+        relation.push_back({symbol, -i, i % 3 == 0 ? 0 : list, tree, 42});
+    }
+    write(rwOperation, relation, symbolTable, recordTable);
+
+    // read into tables holding other symbols and records, such that their ids differ
+    SymbolTableImpl otherSymbolTable({"x", "y", "z"});
+    SpecializedRecordTable<0> otherRecordTable;
+    otherRecordTable.pack({7, 7});
+    const auto tuples = read(rwOperation, otherSymbolTable, otherRecordTable);
+
+    EXPECT_EQ(10000, tuples.size());
+    for (std::size_t i = 0; i < tuples.size(); ++i) {
+        const auto& tuple = tuples[i];
+        EXPECT_EQ("s" + std::to_string(i % 100), otherSymbolTable.decode(tuple[0]));
+        EXPECT_EQ(-static_cast<RamDomain>(i), tuple[1]);
+        if (i % 3 == 0) {
+            EXPECT_EQ(0, tuple[2]);
+        } else {
+            const RamDomain* list = otherRecordTable.unpack(tuple[2], 2);
+            EXPECT_EQ(tuple[0], list[0]);
+            const RamDomain* tail = otherRecordTable.unpack(list[1], 2);
+            EXPECT_EQ(tuple[0], tail[0]);
+            EXPECT_EQ(0, tail[1]);
+        }
+        const RamDomain* tree = otherRecordTable.unpack(tuple[3], 2);
+        EXPECT_EQ(2, tree[0]);
+        const RamDomain* children = otherRecordTable.unpack(tree[1], 2);
+        const RamDomain* leaf = otherRecordTable.unpack(children[0], 2);
+        EXPECT_EQ(1, leaf[0]);
+        EXPECT_EQ(static_cast<RamDomain>(i), leaf[1]);
+        EXPECT_EQ(i % 2 == 0 ? 0 : 1, otherRecordTable.unpack(children[1], 2)[0]);
+        // auxiliary columns are not stored
+        EXPECT_EQ(0, tuple[4]);
+    }
+
+    // writing what was read reproduces the file
+    const std::string written = contents(path);
+    write(rwOperation, tuples, otherSymbolTable, otherRecordTable);
+    EXPECT_EQ(written, contents(path));
+    std::filesystem::remove(path);
+}
+
+TEST(BinaryFacts, Nullary) {
+    const auto path = std::filesystem::temp_directory_path() / "souffle_binary_facts_nullary_test.bin";
+    std::map<std::string, std::string> rwOperation = {{"IO", "binary"}, {"name", "test"},
+            {"filename", path.string()}, {"types", R"({"relation": {"arity": 0, "types": []}})"}};
+
+    SymbolTableImpl symbolTable;
+    SpecializedRecordTable<0> recordTable;
+    for (std::size_t size : {0, 1}) {
+        write(rwOperation, std::vector<std::array<RamDomain, 0>>(size), symbolTable, recordTable);
+        ReadFileBinary reader(rwOperation, symbolTable, recordTable);
+        Collector collector{0, {}};
+        reader.readAll(collector);
+        EXPECT_EQ(size, collector.tuples.size());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(BinaryFacts, TypeMismatch) {
+    const auto path = std::filesystem::temp_directory_path() / "souffle_binary_facts_mismatch_test.bin";
+
+    SymbolTableImpl symbolTable;
+    SpecializedRecordTable<0> recordTable;
+    const RamDomain leaf = recordTable.pack({1, 5});
+    std::vector<std::array<RamDomain, 5>> relation = {{symbolTable.encode("a"), 1, 0, leaf, 0}};
+    write(directives(path), relation, symbolTable, recordTable);
+
+    // reading the symbol column as numbers fails
+    const std::string numbers = R"({
+        "relation": {"arity": 4, "types": ["i:number", "i:number", "r:List", "+:Tree"]},
+        "records": {"r:List": {"arity": 2, "types": ["s:symbol", "r:List"]}},
+        "ADTs": {"+:Tree": {"arity": 3, "enum": false, "branches": []}}
+    })";
+    EXPECT_EQ("Cannot read binary fact file souffle_binary_facts_mismatch_test.bin: "
+              "type mismatch in column 1\n",
+            readError(directives(path, numbers)));
+
+    // as does reading a truncated file
+    const std::string written = contents(path);
+    std::ofstream(path, std::ios::binary) << written.substr(0, written.size() - 1);
+    EXPECT_EQ("Cannot read binary fact file souffle_binary_facts_mismatch_test.bin: symbols out of bounds\n",
+            readError(directives(path)));
+    std::filesystem::remove(path);
+}
+
+}  // namespace souffle::test
@@ -464,20 +464,20 @@ TEST(SparseArray, MemoryUsage) {
         // an empty one should be small
         EXPECT_TRUE(a.empty());
         // EXPECT_EQ(56, a.getMemoryUsage());
-        EXPECT_EQ(40, a.getMemoryUsage());
+        EXPECT_EQ(56, a.getMemoryUsage());
 
         // a single element should have the same size as an empty one
         a.update(12, 15);
         EXPECT_FALSE(a.empty());
         // EXPECT_EQ(56, a.getMemoryUsage());
-        EXPECT_EQ(560, a.getMemoryUsage());
+        EXPECT_EQ(576, a.getMemoryUsage());
 
         // more than one => there are nodes
         a.update(14, 18);
         EXPECT_FALSE(a.empty());
 
         // EXPECT_EQ(576, a.getMemoryUsage());
-        EXPECT_EQ(560, a.getMemoryUsage());
+        EXPECT_EQ(576, a.getMemoryUsage());
     } else {
         SparseArray<int> a;
 
@@ -1796,4 +1796,33 @@ TEST(Trie, Parallel) {
     }
 }
 
+TEST(Trie, ClearReleasesArena) {
+    Trie<3> a;
+    for (RamDomain i = 0; i < 1000; ++i) {
+        a.insert({i, i % 7, i % 13});
+    }
+
+    // nested tries are held by the arena of the outermost trie, ...
+    const auto& arena = a.getStore().getArena();
+    EXPECT_TRUE(a.getStore().ownsArena());
+    EXPECT_LT(0, arena.getMemoryUsage());
+
+    // ... copies hold their own ...
+    Trie<3> b(a);
+    EXPECT_NE(&arena, &b.getStore().getArena());
+    EXPECT_EQ(1000, b.size());
+
+    // ... and clearing releases all its slabs
+    a.clear();
+    EXPECT_EQ(0, arena.getMemoryUsage());
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(1000, b.size());
+
+    // the trie stays usable
+    a.insertAll(b);
+    a.insert({2000, 1, 2});
+    EXPECT_EQ(1001, a.size());
+    EXPECT_TRUE(a.contains({999, 999 % 7, 999 % 13}));
+}
+
 }  // namespace souffle
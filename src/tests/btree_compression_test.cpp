@@ -0,0 +1,198 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file btree_compression_test.cpp
+ *
+ * Test cases for B-trees with prefix-compressed leaves.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/BTree.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+template <std::size_t N>
+using key = std::array<std::int32_t, N>;
+
+template <std::size_t N>
+using compression = detail::prefix_compression<key<N>>;
+
+template <std::size_t N>
+using compressed_set = btree_set<key<N>, detail::comparator<key<N>>, std::allocator<key<N>>, 256,
+        typename detail::default_strategy<key<N>>::type, detail::comparator<key<N>>,
+        detail::updater<key<N>>, detail::no_statistics<key<N>>, compression<N>>;
+
+template <std::size_t N>
+using compressed_multiset = btree_multiset<key<N>, detail::comparator<key<N>>, std::allocator<key<N>>, 256,
+        typename detail::default_strategy<key<N>>::type, detail::comparator<key<N>>,
+        detail::updater<key<N>>, detail::no_statistics<key<N>>, compression<N>>;
+
+// random keys with few distinct values in the leading columns, as of wide relations
+template <std::size_t N>
+std::vector<key<N>> getKeys(std::size_t size, std::mt19937& generator) {
+    std::vector<key<N>> res(size);
+    for (auto& cur : res) {
+        for (std::size_t i = 0; i < N; ++i) {
+            cur[i] = static_cast<std::int32_t>(generator() % (2u << (2 * i))) - (1 << (2 * i));
+        }
+    }
+    return res;
+}
+
+TEST(PrefixCompression, Codec) {
+    std::mt19937 generator(3);
+    std::array<key<4>, 8> storage{};
+    for (std::size_t n = 0; n < 16; ++n) {
+        auto keys = getKeys<4>(n, generator);
+        std::sort(keys.begin(), keys.end());
+        auto shared = compression<4>::common(keys.data(), n);
+        if (compression<4>::capacity(shared, storage.size()) < n) {
+            continue;
+        }
+        compression<4>::encode(storage.data(), shared, keys.data(), n);
+        EXPECT_TRUE(compression<4>::storage(shared, n) <= storage.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(keys[i], compression<4>::decode(storage.data(), storage.size(), shared, i));
+        }
+        // keys differing in a shared component require a new encoding
+        if (n > 0 && (shared & 1)) {
+            key<4> other = keys[0];
+            other[0] += 1;
+            EXPECT_EQ(shared & ~std::uint64_t(1), compression<4>::agreeing(storage.data(), shared, other));
+            EXPECT_EQ(shared, compression<4>::agreeing(storage.data(), shared, keys[0]));
+        }
+    }
+
+    // equal components are stored once
+    std::vector<key<4>> keys;
+    for (std::int32_t i = 0; i < 29; ++i) {
+        keys.push_back({7, 8, 9, i});
+    }
+    auto shared = compression<4>::common(keys.data(), keys.size());
+    EXPECT_EQ(7u, shared);
+    EXPECT_EQ(29u, compression<4>::capacity(shared, storage.size()));
+    compression<4>::encode(storage.data(), shared, keys.data(), keys.size());
+    EXPECT_EQ(keys.back(), compression<4>::decode(storage.data(), storage.size(), shared, 28));
+}
+
+// whether a set agrees with a std::set of the same keys
+template <typename Set, typename Reference, std::size_t N>
+bool checkSet(std::size_t size) {
+    std::mt19937 generator(N);
+    auto data = getKeys<N>(size, generator);
+    Set set;
+    Reference reference;
+    for (std::size_t i = 0; i < data.size(); i += 2) {
+        set.insert(data[i]);
+        reference.insert(data[i]);
+    }
+    if (!set.check() || set.size() != reference.size() ||
+            !std::equal(set.begin(), set.end(), reference.begin(), reference.end())) {
+        return false;
+    }
+    for (const auto& k : data) {
+        auto lower = set.lower_bound(k);
+        auto upper = set.upper_bound(k);
+        auto referenceLower = reference.lower_bound(k);
+        auto referenceUpper = reference.upper_bound(k);
+        if (set.contains(k) != (reference.count(k) > 0) ||
+                (lower == set.end()) != (referenceLower == reference.end()) ||
+                (upper == set.end()) != (referenceUpper == reference.end())) {
+            return false;
+        }
+        if ((lower != set.end() && *lower != *referenceLower) ||
+                (upper != set.end() && *upper != *referenceUpper)) {
+            return false;
+        }
+        if (set.contains(k) && *set.find(k) != k) {
+            return false;
+        }
+    }
+
+    // copies and bulk-loaded sets hold the same keys
+    Set copy(set);
+    std::vector<key<N>> sorted(reference.begin(), reference.end());
+    auto loaded = Set::load(sorted.begin(), sorted.end());
+    Set built;
+    built.bulk_load(sorted.begin(), sorted.end());
+    return copy.check() && loaded.check() && built.check() &&
+           std::equal(copy.begin(), copy.end(), reference.begin(), reference.end()) &&
+           std::equal(loaded.begin(), loaded.end(), reference.begin(), reference.end()) &&
+           std::equal(built.begin(), built.end(), reference.begin(), reference.end());
+}
+
+TEST(PrefixCompression, Set) {
+    EXPECT_TRUE((checkSet<compressed_set<2>, std::set<key<2>>, 2>(5000)));
+    EXPECT_TRUE((checkSet<compressed_set<6>, std::set<key<6>>, 6>(50000)));
+    EXPECT_TRUE((checkSet<compressed_set<8>, std::set<key<8>>, 8>(50000)));
+}
+
+TEST(PrefixCompression, MultiSet) {
+    EXPECT_TRUE((checkSet<compressed_multiset<2>, std::multiset<key<2>>, 2>(5000)));
+    EXPECT_TRUE((checkSet<compressed_multiset<6>, std::multiset<key<6>>, 6>(50000)));
+
+    // many equal keys share all of their components
+    compressed_multiset<6> set;
+    for (int i = 0; i < 10000; ++i) {
+        set.insert({1, 2, 3, 4, 5, 6});
+    }
+    EXPECT_TRUE(set.check());
+    EXPECT_EQ(10000, set.size());
+    EXPECT_EQ(set.begin(), set.lower_bound({1, 2, 3, 4, 5, 6}));
+    EXPECT_EQ(set.end(), set.upper_bound({1, 2, 3, 4, 5, 6}));
+}
+
+TEST(PrefixCompression, Memory) {
+    std::mt19937 generator(6);
+    auto data = getKeys<6>(100000, generator);
+    btree_set<key<6>> plain;
+    compressed_set<6> compressed;
+    for (const auto& cur : data) {
+        plain.insert(cur);
+        compressed.insert(cur);
+    }
+    EXPECT_EQ(plain.size(), compressed.size());
+    EXPECT_LT(compressed.getMemoryUsage(), plain.getMemoryUsage());
+    std::cout << "plain: " << plain.getMemoryUsage() << " bytes, compressed: " << compressed.getMemoryUsage()
+              << " bytes\n";
+}
+
+TEST(PrefixCompression, ParallelInsert) {
+    std::mt19937 generator(8);
+    auto data = getKeys<8>(100000, generator);
+    compressed_set<8> set;
+    std::set<key<8>> reference(data.begin(), data.end());
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < static_cast<int>(data.size()); ++i) {
+        set.insert(data[i]);
+    }
+
+    EXPECT_TRUE(set.check());
+    EXPECT_EQ(reference.size(), set.size());
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(), reference.end()));
+}
+
+}  // namespace test
+}  // end namespace souffle
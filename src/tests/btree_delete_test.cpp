@@ -0,0 +1,150 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file btree_delete_test.cpp
+ *
+ * Test cases for B-trees supporting the removal of elements.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/BTreeDelete.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+using key = std::array<int, 2>;
+using delete_set = btree_delete_set<key>;
+
+// random keys with a few distinct values in the leading column
+std::vector<key> getKeys(std::size_t size, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::vector<key> res(size);
+    for (auto& cur : res) {
+        cur = {static_cast<int>(generator() % 100), static_cast<int>(generator() % 100000)};
+    }
+    return res;
+}
+
+TEST(BTreeDelete, Erase) {
+    auto data = getKeys(50000, 1);
+    delete_set set;
+    std::set<key> reference;
+    for (const auto& cur : data) {
+        set.insert(cur);
+        reference.insert(cur);
+    }
+
+    for (std::size_t i = 0; i < data.size(); i += 3) {
+        EXPECT_EQ(reference.erase(data[i]), set.erase(data[i]));
+    }
+    EXPECT_TRUE(set.check());
+    EXPECT_EQ(reference.size(), set.size());
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(), reference.end()));
+
+    for (const auto& cur : data) {
+        set.erase(cur);
+    }
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(BTreeDelete, ReverseIteration) {
+    delete_set set;
+    std::set<key> reference;
+    for (const auto& cur : getKeys(50000, 4)) {
+        set.insert(cur);
+        reference.insert(cur);
+    }
+
+    // decrementing crosses leaf boundaries to the separator left of the child
+    std::vector<key> reversed;
+    auto it = set.find(*reference.rbegin());
+    while (it != set.begin()) {
+        reversed.push_back(*it);
+        --it;
+    }
+    reversed.push_back(*it);
+    EXPECT_TRUE(std::equal(reversed.begin(), reversed.end(), reference.rbegin(), reference.rend()));
+}
+
+TEST(BTreeDelete, ParallelErase) {
+    auto data = getKeys(100000, 2);
+    delete_set set;
+    std::set<key> reference(data.begin(), data.end());
+    set.insert(data.begin(), data.end());
+
+    // erase every other key concurrently
+    std::vector<key> erased;
+    for (std::size_t i = 0; i < data.size(); i += 2) {
+        erased.push_back(data[i]);
+        reference.erase(data[i]);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < static_cast<int>(erased.size()); ++i) {
+        set.erase(erased[i]);
+    }
+
+    EXPECT_TRUE(set.check());
+    EXPECT_EQ(reference.size(), set.size());
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(), reference.end()));
+}
+
+TEST(BTreeDelete, ParallelEraseInsert) {
+    auto present = getKeys(100000, 3);
+    auto added = getKeys(100000, 4);
+    delete_set set;
+    set.insert(present.begin(), present.end());
+
+    std::set<key> reference(present.begin(), present.end());
+    for (const auto& cur : present) {
+        reference.erase(cur);
+    }
+    reference.insert(added.begin(), added.end());
+
+    // keys erased and inserted by different threads at the same time
+    std::set<key> erasedOnly;
+    for (const auto& cur : present) {
+        if (reference.count(cur) == 0) {
+            erasedOnly.insert(cur);
+        }
+    }
+    std::vector<key> erased(erasedOnly.begin(), erasedOnly.end());
+    std::shuffle(erased.begin(), erased.end(), std::mt19937(5));
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < static_cast<int>(std::max(erased.size(), added.size())); ++i) {
+        if (static_cast<std::size_t>(i) < erased.size()) {
+            set.erase(erased[i]);
+        }
+        if (static_cast<std::size_t>(i) < added.size()) {
+            set.insert(added[i]);
+        }
+    }
+
+    EXPECT_TRUE(set.check());
+    EXPECT_EQ(reference.size(), set.size());
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(), reference.end()));
+}
+
+}  // namespace test
+}  // end namespace souffle
@@ -365,6 +365,31 @@ TEST(BTreeMultiSet, Load) {
     }
 }
 
+TEST(BTreeMultiSet, BulkLoad) {
+    using test_set = btree_multiset<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    for (int N = 0; N < 200; N += 7) {
+        // every number twice
+        std::vector<int> data;
+        for (int i = 0; i < N; i++) {
+            data.push_back(i);
+            data.push_back(i);
+        }
+        test_set t;
+        t.bulk_load(data.begin(), data.end(), 0.8);
+        EXPECT_EQ(data.size(), t.size());
+        EXPECT_TRUE(t.check());
+
+        // duplicates of present elements are retained when merging
+        std::multiset<int> reference(data.begin(), data.end());
+        reference.insert(data.begin(), data.end());
+        t.bulk_load(data.begin(), data.end());
+        EXPECT_EQ(reference.size(), t.size());
+        EXPECT_TRUE(t.check());
+        EXPECT_TRUE(std::equal(t.begin(), t.end(), reference.begin(), reference.end()));
+    }
+}
+
 TEST(BTreeMultiSet, Clear) {
     using test_set = btree_multiset<int, detail::comparator<int>, std::allocator<int>, 16>;
 
@@ -20,11 +20,13 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdlib>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <random>
 #include <set>
@@ -484,6 +486,43 @@ TEST(BTreeSet, Load) {
     }
 }
 
+TEST(BTreeSet, BulkLoad) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    for (double fill : {1.0, 0.7, 0.1}) {
+        for (int N = 0; N < 200; N += 7) {
+            // odd numbers are loaded into an empty set
+            std::vector<int> odd;
+            for (int i = 1; i < 2 * N; i += 2) {
+                odd.push_back(i);
+            }
+            test_set t;
+            t.bulk_load(odd.begin(), odd.end(), fill);
+            EXPECT_EQ(odd.size(), t.size());
+            EXPECT_TRUE(t.check());
+
+            // even numbers and duplicates are merged into the populated set
+            std::vector<int> all;
+            for (int i = 0; i < 2 * N; i++) {
+                all.push_back(i);
+            }
+            t.bulk_load(all.begin(), all.end(), fill);
+            EXPECT_EQ(all.size(), t.size());
+            EXPECT_TRUE(t.check());
+            EXPECT_TRUE(std::equal(t.begin(), t.end(), all.begin(), all.end()));
+
+            // small ranges are inserted
+            std::vector<int> more = {-2, 2 * N + 1};
+            t.bulk_load(more.begin(), more.end(), fill);
+            EXPECT_EQ(all.size() + 2, t.size());
+            EXPECT_TRUE(t.check());
+            for (int i = -2; i <= 2 * N + 1; i++) {
+                EXPECT_EQ(i != -1 && i != 2 * N, t.contains(i));
+            }
+        }
+    }
+}
+
 TEST(BTreeSet, Clear) {
     using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
 
@@ -501,6 +540,127 @@ TEST(BTreeSet, Clear) {
     EXPECT_TRUE(t.empty());
 }
 
+TEST(BTreeSet, PrefixStatistics) {
+    using key = std::array<int, 3>;
+    using test_set = btree_set<key, detail::comparator<key>, std::allocator<key>, 16,
+            typename detail::default_strategy<key>::type, detail::comparator<key>, detail::updater<key>,
+            detail::prefix_statistics<key>>;
+
+    std::vector<key> data;
+    for (int a = 0; a < 10; a++) {
+        for (int b = 0; b < 5; b++) {
+            for (int c = 0; c < 4; c++) {
+                data.push_back({a, b, c});
+            }
+        }
+    }
+
+    // nothing is maintained unless enabled
+    auto t = test_set::load(data.begin(), data.end());
+    EXPECT_FALSE(t.hasPrefixStatistics());
+    EXPECT_EQ(0, t.getDistinctPrefixes(3));
+
+    // enabling accounts for the present elements, which see all their neighbours
+    t.enablePrefixStatistics();
+    EXPECT_TRUE(t.hasPrefixStatistics());
+    EXPECT_EQ(0, t.getDistinctPrefixes(0));
+    EXPECT_EQ(10, t.getDistinctPrefixes(1));
+    EXPECT_EQ(50, t.getDistinctPrefixes(2));
+    EXPECT_EQ(200, t.getDistinctPrefixes(3));
+
+    // copies carry their statistics along
+    test_set c(t);
+    EXPECT_EQ(50, c.getDistinctPrefixes(2));
+
+    // duplicates are not counted
+    t.insert({3, 3, 3});
+    EXPECT_EQ(200, t.getDistinctPrefixes(3));
+
+    t.clear();
+    EXPECT_EQ(0, t.getDistinctPrefixes(3));
+
+    // incremental insertion may overestimate across leaf boundaries
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    std::shuffle(data.begin(), data.end(), generator);
+    for (const auto& cur : data) {
+        t.insert(cur);
+    }
+    for (std::size_t length = 1; length <= 3; length++) {
+        std::size_t exact = (length == 1) ? 10 : (length == 2) ? 50 : 200;
+        EXPECT_TRUE(exact <= t.getDistinctPrefixes(length));
+        EXPECT_TRUE(t.getDistinctPrefixes(length) <= t.size());
+    }
+    EXPECT_EQ(200, t.getDistinctPrefixes(3));
+
+    // concurrent insertions count per thread and are summed up
+    test_set p;
+    p.enablePrefixStatistics();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < static_cast<int>(data.size()); ++i) {
+        p.insert(data[i]);
+    }
+    EXPECT_TRUE(10 <= p.getDistinctPrefixes(1));
+    EXPECT_TRUE(p.getDistinctPrefixes(2) <= p.size());
+    EXPECT_EQ(200, p.getDistinctPrefixes(3));
+}
+
+TEST(BTreeSet, SelectiveUpdater) {
+    using key = std::array<int, 2>;
+    // keys are weakly equal by their first component, keeping the least second one
+    struct first_comparator {
+        int operator()(const key& a, const key& b) const {
+            return (a[0] > b[0]) - (a[0] < b[0]);
+        }
+        bool less(const key& a, const key& b) const {
+            return a[0] < b[0];
+        }
+        bool equal(const key& a, const key& b) const {
+            return a[0] == b[0];
+        }
+    };
+    struct min_updater {
+        bool updates(const key& old_k, const key& new_k) const {
+            return new_k[1] < old_k[1];
+        }
+        void update(key& old_k, const key& new_k) {
+            old_k[1] = new_k[1];
+        }
+    };
+    using test_set = btree_set<key, detail::comparator<key>, std::allocator<key>, 16,
+            typename detail::default_strategy<key>::type, first_comparator, min_updater>;
+
+    std::vector<key> data;
+    for (int a = 0; a < 100; a++) {
+        for (int b = 0; b < 20; b++) {
+            data.push_back({a, (a * 7 + b * 13) % 50});
+        }
+    }
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    std::shuffle(data.begin(), data.end(), generator);
+
+    std::map<int, int> reference;
+    test_set t;
+    for (const auto& cur : data) {
+        auto pos = reference.find(cur[0]);
+        bool improves = pos == reference.end() || cur[1] < pos->second;
+        if (improves) {
+            reference[cur[0]] = cur[1];
+        }
+        EXPECT_EQ(improves, t.insert(cur));
+    }
+
+    EXPECT_TRUE(t.check());
+    EXPECT_EQ(reference.size(), t.size());
+    for (const auto& cur : reference) {
+        EXPECT_TRUE(t.contains({cur.first, cur.second}));
+        EXPECT_FALSE(t.contains({cur.first, cur.second + 1}));
+    }
+}
+
 TEST(BTreeSet, ChunkSplit) {
     using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
 
@@ -0,0 +1,266 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file btree_simd_search_test.cpp
+ *
+ * Test cases for the SIMD search strategy of B-trees.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/BTree.h"
+#include "souffle/datastructure/BTreeDelete.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+template <std::size_t N>
+using key = std::array<std::int32_t, N>;
+
+// lexicographical order on all components, as of the comparators of interpreter and synthesiser
+template <std::size_t N>
+struct lex_comparator {
+    static constexpr std::size_t lexicographic_signed_arity = N;
+
+    int operator()(const key<N>& a, const key<N>& b) const {
+        return (a > b) - (a < b);
+    }
+    bool less(const key<N>& a, const key<N>& b) const {
+        return a < b;
+    }
+    bool equal(const key<N>& a, const key<N>& b) const {
+        return a == b;
+    }
+};
+
+// order on the first component only, as of weak comparators of provenance
+template <std::size_t N>
+struct first_comparator {
+    static constexpr std::size_t lexicographic_signed_arity = 1;
+
+    int operator()(const key<N>& a, const key<N>& b) const {
+        return (a[0] > b[0]) - (a[0] < b[0]);
+    }
+    bool less(const key<N>& a, const key<N>& b) const {
+        return a[0] < b[0];
+    }
+    bool equal(const key<N>& a, const key<N>& b) const {
+        return a[0] == b[0];
+    }
+};
+
+// random keys with small components, to obtain equal prefixes, and extreme ones
+template <std::size_t N>
+std::vector<key<N>> getKeys(std::size_t size, std::mt19937& generator) {
+    const std::vector<std::int32_t> extremes = {std::numeric_limits<std::int32_t>::min(),
+            std::numeric_limits<std::int32_t>::min() + 1, -1, 0, 1,
+            std::numeric_limits<std::int32_t>::max() - 1, std::numeric_limits<std::int32_t>::max()};
+    std::uniform_int_distribution<std::int32_t> small(-3, 3);
+    std::uniform_int_distribution<std::size_t> pick(0, extremes.size() - 1);
+    std::vector<key<N>> res(size);
+    for (auto& cur : res) {
+        for (auto& component : cur) {
+            component = (generator() % 2 == 0) ? small(generator) : extremes[pick(generator)];
+        }
+    }
+    return res;
+}
+
+// whether the SIMD search agrees with the binary search on sorted ranges of any size
+template <std::size_t N, template <std::size_t> typename Comp>
+bool checkSearch() {
+    std::mt19937 generator(N);
+    const detail::simd_search simd;
+    const detail::binary_search binary;
+    Comp<N> comp;
+    for (std::size_t size = 0; size < 70; size++) {
+        auto keys = getKeys<N>(size, generator);
+        std::sort(keys.begin(), keys.end(),
+                [&](const key<N>& a, const key<N>& b) { return comp.less(a, b); });
+        const key<N>* a = keys.data();
+        const key<N>* b = keys.data() + size;
+        for (const auto& k : getKeys<N>(50, generator)) {
+            auto lower = binary.lower_bound(k, a, b, comp);
+            auto upper = binary.upper_bound(k, a, b, comp);
+            if (simd.lower_bound(k, a, b, comp) != lower || simd.upper_bound(k, a, b, comp) != upper) {
+                return false;
+            }
+            // any equal element, or the lower bound if there is none
+            auto pos = simd(k, a, b, comp);
+            if (lower == upper ? pos != lower : (pos < lower || upper <= pos)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST(SimdSearch, Bounds) {
+    EXPECT_TRUE((checkSearch<1, lex_comparator>()));
+    EXPECT_TRUE((checkSearch<2, lex_comparator>()));
+    EXPECT_TRUE((checkSearch<3, lex_comparator>()));
+    EXPECT_TRUE((checkSearch<4, lex_comparator>()));
+}
+
+TEST(SimdSearch, PartialComparator) {
+    // comparators ordering only some components are not vectorized
+    EXPECT_TRUE((checkSearch<2, first_comparator>()));
+    EXPECT_TRUE((checkSearch<3, first_comparator>()));
+}
+
+// whether lookups in a set agree with a std::set of the same keys
+template <typename Set, std::size_t N>
+bool checkSet() {
+    std::mt19937 generator(N);
+    auto data = getKeys<N>(20000, generator);
+    Set set;
+    std::set<key<N>> reference;
+    for (std::size_t i = 0; i < data.size(); i += 2) {
+        set.insert(data[i]);
+        reference.insert(data[i]);
+    }
+    if (set.size() != reference.size()) {
+        return false;
+    }
+    for (const auto& k : data) {
+        auto lower = set.lower_bound(k);
+        auto upper = set.upper_bound(k);
+        auto referenceLower = reference.lower_bound(k);
+        auto referenceUpper = reference.upper_bound(k);
+        if (set.contains(k) != (reference.count(k) > 0) ||
+                (lower == set.end()) != (referenceLower == reference.end()) ||
+                (upper == set.end()) != (referenceUpper == reference.end())) {
+            return false;
+        }
+        if ((lower != set.end() && *lower != *referenceLower) ||
+                (upper != set.end() && *upper != *referenceUpper)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(SimdSearch, BTree) {
+    EXPECT_TRUE((checkSet<btree_set<key<1>, lex_comparator<1>>, 1>()));
+    EXPECT_TRUE((checkSet<btree_set<key<2>, lex_comparator<2>>, 2>()));
+    EXPECT_TRUE((checkSet<btree_set<key<3>, lex_comparator<3>>, 3>()));
+    EXPECT_TRUE((checkSet<btree_set<key<4>, lex_comparator<4>>, 4>()));
+}
+
+TEST(SimdSearch, BTreeDelete) {
+    EXPECT_TRUE((checkSet<btree_delete_set<key<1>, lex_comparator<1>>, 1>()));
+    EXPECT_TRUE((checkSet<btree_delete_set<key<2>, lex_comparator<2>>, 2>()));
+    EXPECT_TRUE((checkSet<btree_delete_set<key<3>, lex_comparator<3>>, 3>()));
+    EXPECT_TRUE((checkSet<btree_delete_set<key<4>, lex_comparator<4>>, 4>()));
+}
+
+using time_point = std::chrono::high_resolution_clock::time_point;
+
+time_point now() {
+    return std::chrono::high_resolution_clock::now();
+}
+
+int64_t duration(const time_point& start, const time_point& end) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+template <typename Op>
+int64_t time(const std::string& name, const Op& operation) {
+    std::cout << "\t" << std::setw(30) << std::setiosflags(std::ios::left) << name
+              << std::resetiosflags(std::ios::left) << " ... " << std::flush;
+    auto a = now();
+    operation();
+    auto b = now();
+    int64_t time = duration(a, b);
+    std::cout << " done [" << std::setw(5) << time << "ms]\n";
+    return time;
+}
+
+/**
+ * Times the lookups of an existence check, as of IndexIfExists operations,
+ * searching for tuples by all columns and by the first column only.
+ */
+template <typename Set, std::size_t N>
+void checkPerformance(const std::string& name) {
+    const int range = 1 << 16;
+    std::mt19937 generator(N);
+    std::uniform_int_distribution<std::int32_t> value(-range, range);
+
+    Set set;
+    std::vector<key<N>> probes;
+    for (int i = 0; i < (1 << 19); i++) {
+        key<N> cur;
+        for (auto& component : cur) {
+            component = value(generator);
+        }
+        if (i % 2 == 0) {
+            set.insert(cur);
+        }
+        probes.push_back(cur);
+    }
+
+    std::cout << "Testing: " << name << " ..\n";
+    std::size_t found = 0;
+    time("full existence check", [&]() {
+        for (int round = 0; round < 2; round++) {
+            for (const auto& cur : probes) {
+                found += set.contains(cur);
+            }
+        }
+    });
+    std::size_t foundPrefix = 0;
+    time("prefix existence check", [&]() {
+        for (int round = 0; round < 2; round++) {
+            for (const auto& cur : probes) {
+                key<N> low = cur;
+                key<N> high = cur;
+                for (std::size_t i = 1; i < N; i++) {
+                    low[i] = std::numeric_limits<std::int32_t>::min();
+                    high[i] = std::numeric_limits<std::int32_t>::max();
+                }
+                foundPrefix += set.lower_bound(low) != set.upper_bound(high);
+            }
+        }
+    });
+    std::cout << "\t" << found << " of " << foundPrefix << " prefixes found\n\n";
+}
+
+template <std::size_t N>
+void checkPerformance() {
+    using binary_set =
+            btree_set<key<N>, lex_comparator<N>, std::allocator<key<N>>, 256, detail::binary_search>;
+    using simd_set = btree_set<key<N>, lex_comparator<N>, std::allocator<key<N>>, 256, detail::simd_search>;
+    checkPerformance<binary_set, N>("souffle btree_set - arity " + std::to_string(N) + " - binary");
+    checkPerformance<simd_set, N>("souffle btree_set - arity " + std::to_string(N) + " - simd");
+}
+
+TEST(Performance, IndexIfExists) {
+    checkPerformance<1>();
+    checkPerformance<2>();
+    checkPerformance<3>();
+    checkPerformance<4>();
+}
+
+}  // namespace test
+}  // end namespace souffle
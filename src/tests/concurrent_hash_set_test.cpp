@@ -0,0 +1,162 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file concurrent_hash_set_test.cpp
+ *
+ * Test cases for unordered sets of tuples supporting concurrent insertions.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/ConcurrentHashSet.h"
+#include <array>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+using key = std::array<int, 2>;
+using hash_set = concurrent_hash_set<key>;
+
+// random keys, including duplicates and negative values
+std::vector<key> getKeys(std::size_t size, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::vector<key> res(size);
+    for (auto& cur : res) {
+        cur = {static_cast<int>(generator() % 200) - 100, static_cast<int>(generator() % 1000)};
+    }
+    return res;
+}
+
+// whether a set holds exactly the keys of a reference set, each once
+bool matches(const hash_set& set, const std::set<key>& reference) {
+    std::multiset<key> keys(set.begin(), set.end());
+    if (set.size() != reference.size() || keys.size() != reference.size()) {
+        return false;
+    }
+    for (const auto& cur : reference) {
+        if (keys.count(cur) != 1 || !set.contains(cur)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(ConcurrentHashSet, Basic) {
+    hash_set set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.begin() == set.end());
+
+    EXPECT_TRUE(set.insert({1, 2}));
+    EXPECT_TRUE(set.insert({2, 1}));
+    EXPECT_FALSE(set.insert({1, 2}));
+    EXPECT_EQ(2, set.size());
+
+    EXPECT_TRUE(set.contains({1, 2}));
+    EXPECT_TRUE(set.contains({2, 1}));
+    EXPECT_FALSE(set.contains({1, 1}));
+    EXPECT_TRUE(set.find({1, 1}) == set.end());
+    EXPECT_EQ((key{2, 1}), *set.find({2, 1}));
+
+    auto found = set.equal_range({1, 2});
+    EXPECT_EQ(1, std::distance(found.begin(), found.end()));
+    EXPECT_EQ((key{1, 2}), *found.begin());
+    EXPECT_TRUE(set.equal_range({3, 3}).empty());
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains({1, 2}));
+}
+
+TEST(ConcurrentHashSet, Growth) {
+    auto data = getKeys(100000, 1);
+    hash_set set;
+    std::set<key> reference;
+    for (const auto& cur : data) {
+        EXPECT_EQ(reference.insert(cur).second, set.insert(cur));
+    }
+    EXPECT_TRUE(matches(set, reference));
+
+    for (const auto& cur : getKeys(1000, 2)) {
+        EXPECT_EQ(reference.count(cur) == 1, set.contains(cur));
+    }
+}
+
+TEST(ConcurrentHashSet, ParallelInsert) {
+    auto data = getKeys(200000, 3);
+    std::set<key> reference(data.begin(), data.end());
+    hash_set set;
+
+    // each key is inserted by several threads, and counted once
+    std::size_t inserted = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : inserted)
+#endif
+    for (int i = 0; i < static_cast<int>(2 * data.size()); ++i) {
+        if (set.insert(data[static_cast<std::size_t>(i) % data.size()])) {
+            ++inserted;
+        }
+    }
+
+    EXPECT_EQ(reference.size(), inserted);
+    EXPECT_TRUE(matches(set, reference));
+}
+
+TEST(ConcurrentHashSet, ParallelLookup) {
+    auto present = getKeys(20000, 5);
+    auto inserted = getKeys(200000, 6);
+    hash_set set;
+    set.insert(present.begin(), present.end());
+
+    // lookups do not lock, and find the keys present before while insertions grow the table
+    std::size_t found = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : found)
+#endif
+    for (int i = 0; i < static_cast<int>(inserted.size()); ++i) {
+        const auto& cur = present[static_cast<std::size_t>(i) % present.size()];
+        auto pos = set.find(cur);
+        if (pos != set.end() && *pos == cur) {
+            ++found;
+        }
+        set.insert(inserted[static_cast<std::size_t>(i)]);
+    }
+
+    EXPECT_EQ(inserted.size(), found);
+    std::set<key> reference(present.begin(), present.end());
+    reference.insert(inserted.begin(), inserted.end());
+    EXPECT_TRUE(matches(set, reference));
+}
+
+TEST(ConcurrentHashSet, Partition) {
+    auto data = getKeys(50000, 4);
+    std::set<key> reference(data.begin(), data.end());
+    hash_set set;
+    set.insert(data.begin(), data.end());
+
+    for (std::size_t num : {1, 7, 400, 1000000}) {
+        std::multiset<key> keys;
+        for (const auto& chunk : set.partition(num)) {
+            EXPECT_FALSE(chunk.empty());
+            keys.insert(chunk.begin(), chunk.end());
+        }
+        EXPECT_TRUE(std::set<key>(keys.begin(), keys.end()) == reference);
+        EXPECT_EQ(reference.size(), keys.size());
+    }
+    EXPECT_TRUE(hash_set().partition(10).empty());
+}
+
+}  // namespace test
+}  // end namespace souffle
@@ -0,0 +1,95 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file hash_join_table_test.cpp
+ *
+ * Test cases for the hash table of hash joins.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/HashJoinTable.h"
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+using tuple = std::vector<RamDomain>;
+
+template <typename C>
+std::set<tuple> probe(const HashJoinTable& table, const C& key) {
+    std::set<tuple> res;
+    for (auto cursor = table.probe(key.data()); cursor; ++cursor) {
+        res.insert(tuple(*cursor, *cursor + 3));
+    }
+    return res;
+}
+
+TEST(HashJoinTable, Empty) {
+    HashJoinTable table(3, {1});
+    table.build(std::vector<std::vector<tuple>>());
+    EXPECT_EQ(0, table.size());
+
+    tuple key = {1};
+    EXPECT_TRUE(probe(table, key).empty());
+}
+
+TEST(HashJoinTable, Probe) {
+    // tuples (i, i % 7, i % 5) in several chunks
+    std::vector<std::vector<tuple>> chunks(5);
+    for (RamDomain i = 0; i < 1000; ++i) {
+        chunks[i % 5].push_back({i, i % 7, i % 5});
+    }
+
+    HashJoinTable table(3, {2, 1});
+    table.build(chunks);
+    EXPECT_EQ(1000, table.size());
+
+    for (RamDomain a = 0; a < 7; ++a) {
+        for (RamDomain b = 0; b < 5; ++b) {
+            std::set<tuple> expected;
+            for (RamDomain i = 0; i < 1000; ++i) {
+                if (i % 7 == a && i % 5 == b) {
+                    expected.insert({i, a, b});
+                }
+            }
+            tuple key = {b, a};
+            EXPECT_EQ(expected, probe(table, key));
+        }
+    }
+
+    tuple missing = {5, 0};
+    EXPECT_TRUE(probe(table, missing).empty());
+}
+
+TEST(HashJoinTable, NegativeKeys) {
+    std::vector<std::vector<tuple>> chunks(1);
+    for (RamDomain i = -100; i < 100; ++i) {
+        chunks[0].push_back({i, -i, i / 10});
+    }
+
+    HashJoinTable table(3, {0});
+    table.build(chunks);
+    EXPECT_EQ(200, table.size());
+
+    for (RamDomain i = -100; i < 100; ++i) {
+        tuple key = {i};
+        std::set<tuple> expected = {{i, -i, i / 10}};
+        EXPECT_EQ(expected, probe(table, key));
+    }
+}
+
+}  // namespace test
+}  // end namespace souffle
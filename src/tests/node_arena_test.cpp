@@ -0,0 +1,118 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file node_arena_test.cpp
+ *
+ * Test cases for the arena allocator of index nodes.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/BTree.h"
+#include "souffle/datastructure/NodeArena.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+TEST(NodeArena, Allocate) {
+    NodeArena arena;
+    EXPECT_EQ(0, arena.getMemoryUsage());
+
+    std::set<void*> nodes;
+    for (int i = 0; i < 10000; ++i) {
+        void* ptr = arena.allocate(200, 64);
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(ptr) % 64);
+        nodes.insert(ptr);
+    }
+    EXPECT_EQ(10000, nodes.size());
+    EXPECT_TRUE(10000 * 256 <= arena.getMemoryUsage());
+
+    // released nodes are recycled
+    void* first = *nodes.begin();
+    arena.deallocate(first, 200, 64);
+    EXPECT_EQ(first, arena.allocate(200, 64));
+
+    arena.clear();
+    EXPECT_EQ(0, arena.getMemoryUsage());
+}
+
+TEST(NodeArena, Statistics) {
+    const auto& stats = NodeArenaStatistics::instance();
+    const std::size_t reserved = stats.getReservedBytes();
+    const std::size_t slabs = stats.getSlabs();
+    {
+        NodeArena arena;
+        for (int i = 0; i < 100000; ++i) {
+            arena.allocate(64, 8);
+        }
+        EXPECT_EQ(reserved + arena.getMemoryUsage(), stats.getReservedBytes());
+        EXPECT_TRUE(reserved + arena.getMemoryUsage() <= stats.getPeakBytes());
+        EXPECT_LT(slabs, stats.getSlabs());
+    }
+    EXPECT_EQ(reserved, stats.getReservedBytes());
+}
+
+TEST(NodeArena, ParallelAllocate) {
+    NodeArena arena;
+    const int N = 100000;
+    std::vector<std::int32_t*> nodes(N);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < N; ++i) {
+        nodes[i] = static_cast<std::int32_t*>(arena.allocate(sizeof(std::int32_t[16]), 8));
+        std::fill(nodes[i], nodes[i] + 16, i);
+    }
+
+    for (int i = 0; i < N; ++i) {
+        EXPECT_EQ(i, nodes[i][0]);
+        EXPECT_EQ(i, nodes[i][15]);
+    }
+}
+
+TEST(NodeArena, BTreeClear) {
+    using set = btree_set<int>;
+    const std::size_t reserved = NodeArenaStatistics::instance().getReservedBytes();
+
+    set a;
+    for (int i = 0; i < 100000; ++i) {
+        a.insert(i);
+    }
+    set b(a);
+    set c = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(b.size(), c.size());
+    EXPECT_TRUE(std::equal(b.begin(), b.end(), c.begin(), c.end()));
+
+    // trees remain usable after releasing their nodes
+    c.clear();
+    EXPECT_TRUE(c.empty());
+    c.insert(12);
+    EXPECT_EQ(1, c.size());
+    a = b;
+    EXPECT_EQ(b.size(), a.size());
+    b.clear();
+    EXPECT_TRUE(a.check());
+
+    a.clear();
+    c.clear();
+    EXPECT_EQ(reserved, NodeArenaStatistics::instance().getReservedBytes());
+}
+
+}  // namespace test
+}  // end namespace souffle
@@ -0,0 +1,172 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file packed_array_test.cpp
+ *
+ * Test cases for ordered sets stored in sorted arrays of narrowed columns.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/PackedArray.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+using key = std::array<int, 2>;
+
+// random keys with a few distinct values in the leading column, including negative ones
+std::vector<key> getKeys(std::size_t size, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::vector<key> res(size);
+    for (auto& cur : res) {
+        cur = {static_cast<int>(generator() % 100) - 50, static_cast<int>(generator() % 1000)};
+    }
+    return res;
+}
+
+// whether all searches on a set agree with a reference set, for keys present and absent
+template <typename Set>
+bool matches(const Set& set, const std::set<key>& reference) {
+    if (set.size() != reference.size() ||
+            !std::equal(set.begin(), set.end(), reference.begin(), reference.end())) {
+        return false;
+    }
+    for (int i = -51; i <= 50; ++i) {
+        for (int j = -1; j <= 1000; j += 7) {
+            key k = {i, j};
+            if (std::distance(reference.begin(), reference.lower_bound(k)) !=
+                            std::distance(set.begin(), set.lower_bound(k)) ||
+                    std::distance(reference.begin(), reference.upper_bound(k)) !=
+                            std::distance(set.begin(), set.upper_bound(k)) ||
+                    (reference.count(k) == 1) != set.contains(k)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST(PackedArray, Basic) {
+    packed_array_set<key> set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert({3, 30}));
+    EXPECT_TRUE(set.insert({1, 10}));
+    EXPECT_FALSE(set.insert({3, 30}));
+    EXPECT_EQ(2, set.size());
+    EXPECT_TRUE(set.contains({1, 10}));
+    EXPECT_FALSE(set.contains({1, 20}));
+    EXPECT_EQ((key{3, 30}), *set.lower_bound({2, 0}));
+    EXPECT_EQ(set.end(), set.upper_bound({3, 30}));
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.end(), set.lower_bound({1, 10}));
+}
+
+TEST(PackedArray, BulkLoad) {
+    auto data = getKeys(20000, 1);
+    std::set<key> reference(data.begin(), data.end());
+    packed_array_set<key> set;
+    set.insert(data.begin(), data.end());
+    EXPECT_TRUE(matches(set, reference));
+
+    // loading merges with the keys present
+    auto more = getKeys(5000, 2);
+    reference.insert(more.begin(), more.end());
+    std::sort(more.begin(), more.end());
+    set.bulk_load(more.begin(), more.end());
+    EXPECT_TRUE(matches(set, reference));
+}
+
+TEST(PackedArray, Layout) {
+    // a constant column takes no space, and a column of 100 consecutive values a single byte
+    std::vector<key> data;
+    for (int i = 0; i < 1000; ++i) {
+        data.push_back({7, 1000 + i % 100});
+    }
+    packed_array_set<key> set(data.begin(), data.end());
+    EXPECT_EQ(1, set.getRowSize());
+    EXPECT_EQ(100, set.size());
+    EXPECT_EQ((key{7, 1000}), *set.begin());
+
+    // a few distinct values spread over the whole domain are coded by dictionary
+    const int min = std::numeric_limits<int>::min();
+    const int max = std::numeric_limits<int>::max();
+    std::vector<key> spread = {{min, 0}, {max, 0}, {0, 0}, {-1, 70000}};
+    set.insert(spread.begin(), spread.end());
+    EXPECT_EQ(2, set.getRowSize());
+    std::set<key> reference(data.begin(), data.end());
+    reference.insert(spread.begin(), spread.end());
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(), reference.end()));
+    EXPECT_TRUE(set.contains({min, 0}));
+    EXPECT_TRUE(set.contains({max, 0}));
+    EXPECT_FALSE(set.contains({1, 0}));
+}
+
+TEST(PackedArray, Multiset) {
+    // keys ordered by their first component only
+    struct first_comparator {
+        bool less(const key& a, const key& b) const {
+            return a[0] < b[0];
+        }
+        bool equal(const key& a, const key& b) const {
+            return a[0] == b[0];
+        }
+    };
+    auto data = getKeys(5000, 4);
+    packed_array_multiset<key, first_comparator> set(data.begin(), data.begin() + 2500);
+    std::vector<key> sorted(data.begin() + 2500, data.end());
+    std::sort(sorted.begin(), sorted.end());
+    set.bulk_load(sorted.begin(), sorted.end());
+    EXPECT_TRUE(set.insert(data[0]));
+    EXPECT_EQ(5001, set.size());
+
+    std::multiset<int> reference;
+    for (const auto& cur : data) {
+        reference.insert(cur[0]);
+    }
+    reference.insert(data[0][0]);
+    for (int i = -50; i < 50; ++i) {
+        key k = {i, 0};
+        EXPECT_EQ(static_cast<std::ptrdiff_t>(reference.count(i)),
+                std::distance(set.lower_bound(k), set.upper_bound(k)));
+    }
+}
+
+TEST(PackedArray, Partition) {
+    auto data = getKeys(10000, 3);
+    packed_array_set<key> set(data.begin(), data.end());
+
+    for (std::size_t num : {1, 7, 400, 100000}) {
+        auto chunks = set.partition(num);
+        EXPECT_TRUE(chunks.size() <= num);
+        std::vector<key> scanned;
+        for (const auto& chunk : chunks) {
+            EXPECT_FALSE(chunk.empty());
+            scanned.insert(scanned.end(), chunk.begin(), chunk.end());
+        }
+        EXPECT_TRUE(std::equal(set.begin(), set.end(), scanned.begin(), scanned.end()));
+    }
+
+    EXPECT_TRUE(packed_array_set<key>().partition(4).empty());
+}
+
+}  // namespace test
+}  // end namespace souffle
@@ -0,0 +1,225 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file read_stream_csv_test.cpp
+ *
+ * Tests the chunked and mapped reading of CSV input.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/RecordTableImpl.h"
+#include "souffle/datastructure/SymbolTableImpl.h"
+#include "souffle/io/ReadStreamCSV.h"
+#include "souffle/utility/json11.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace souffle::test {
+
+/** A CSV reader parsing its input one tuple at a time, as a reference. */
+template <typename Reader>
+class Sequential : public Reader {
+public:
+    using Reader::Reader;
+
+protected:
+    std::size_t readNextTuples(RamDomain* tuples, std::size_t count) override {
+        return ReadStream::readNextTuples(tuples, count);
+    }
+};
+
+using SequentialReadStreamCSV = Sequential<ReadStreamCSV>;
+
+/** A relation collecting the tuples read. */
+struct Collector {
+    std::size_t arity;
+    std::vector<std::vector<RamDomain>> tuples;
+
+    void insert(const RamDomain* tuple) {
+        tuples.emplace_back(tuple, tuple + arity);
+    }
+};
+
+std::map<std::string, std::string> directives(
+        const std::vector<std::string>& types, std::map<std::string, std::string> extra = {}) {
+    json11::Json json = json11::Json::object{{"relation",
+            json11::Json::object{{"arity", static_cast<long long>(types.size())},
+                    {"types", json11::Json::array(types.begin(), types.end())}}}};
+    extra["types"] = json.dump();
+    return extra;
+}
+
+template <typename Reader>
+std::vector<std::vector<RamDomain>> read(const std::string& input,
+        const std::map<std::string, std::string>& rwOperation, std::size_t arity, SymbolTable& symbolTable) {
+    SpecializedRecordTable<0> recordTable;
+    std::istringstream stream(input);
+    Reader reader(stream, rwOperation, symbolTable, recordTable);
+    Collector collector{arity, {}};
+    reader.readAll(collector);
+    return collector.tuples;
+}
+
+template <typename Reader>
+std::vector<std::vector<RamDomain>> readFile(
+        const std::map<std::string, std::string>& rwOperation, std::size_t arity, SymbolTable& symbolTable) {
+    SpecializedRecordTable<0> recordTable;
+    Reader reader(rwOperation, symbolTable, recordTable);
+    Collector collector{arity, {}};
+    reader.readAll(collector);
+    return collector.tuples;
+}
+
+TEST(ReadStreamCSV, Chunks) {
+    std::stringstream input;
+    for (int i = 0; i < 400000; ++i) {
+        input << "s" << (i % 1000) << "\t" << i << "\n";
+    }
+    // a last line without a newline
+    input << "last\t-1";
+
+    const auto rwOperation = directives({"s:symbol", "i:number"});
+    SymbolTableImpl symbolTable;
+    const auto tuples = read<ReadStreamCSV>(input.str(), rwOperation, 2, symbolTable);
+    const auto expected = read<SequentialReadStreamCSV>(input.str(), rwOperation, 2, symbolTable);
+
+    EXPECT_EQ(400001, tuples.size());
+    EXPECT_EQ(expected, tuples);
+    EXPECT_EQ("s999", symbolTable.decode(tuples[999999 % 400000][0]));
+    EXPECT_EQ(-1, tuples.back()[1]);
+}
+
+TEST(ReadStreamCSV, ChunksOfQuotedFields) {
+    // quoted fields spanning lines, containing delimiters and doubled quotes
+    std::stringstream input;
+    for (int i = 0; i < 200000; ++i) {
+        if (i % 7 == 0) {
+            input << "\"multi\nline, \"\"" << i << "\"\"\r\n\"," << i << "\r\n";
+        } else {
+            input << "plain" << i << "," << i << "\n";
+        }
+    }
+
+    const auto rwOperation = directives({"s:symbol", "i:number"}, {{"rfc4180", "true"}});
+    SymbolTableImpl symbolTable;
+    const auto tuples = read<ReadStreamCSV>(input.str(), rwOperation, 2, symbolTable);
+    const auto expected = read<SequentialReadStreamCSV>(input.str(), rwOperation, 2, symbolTable);
+
+    EXPECT_EQ(200000, tuples.size());
+    EXPECT_EQ(expected, tuples);
+    EXPECT_EQ("multi\nline, \"7\"\r\n", symbolTable.decode(tuples[7][0]));
+    EXPECT_EQ(7, tuples[7][1]);
+}
+
+TEST(ReadStreamCSV, ChunksOfSelectedColumns) {
+    std::stringstream input;
+    for (int i = 0; i < 200000; ++i) {
+        input << i << "|ignored|" << -i << "\n";
+    }
+
+    const auto rwOperation = directives({"i:number", "i:number"}, {{"delimiter", "|"}, {"columns", "2:0"}});
+    SymbolTableImpl symbolTable;
+    const auto tuples = read<ReadStreamCSV>(input.str(), rwOperation, 2, symbolTable);
+
+    EXPECT_EQ(200000, tuples.size());
+    for (std::size_t i = 0; i < tuples.size(); ++i) {
+        EXPECT_EQ(-static_cast<RamDomain>(i), tuples[i][0]);
+        EXPECT_EQ(static_cast<RamDomain>(i), tuples[i][1]);
+    }
+}
+
+TEST(ReadStreamCSV, ChunksReportLines) {
+    std::stringstream input;
+    for (int i = 0; i < 300000; ++i) {
+        input << (i == 250000 ? "nan" : std::to_string(i)) << "\n";
+    }
+
+    const auto rwOperation = directives({"i:number"});
+    SymbolTableImpl symbolTable;
+    std::string error;
+    try {
+        read<ReadStreamCSV>(input.str(), rwOperation, 1, symbolTable);
+    } catch (std::invalid_argument& e) {
+        error = e.what();
+    }
+    EXPECT_EQ("Error converting <nan> in column 1 in line 250001; ", error);
+}
+
+/** A relation recording the number of tuples of each batch handed over. */
+struct BatchCollector {
+    std::vector<std::size_t> batches;
+
+    void insert(const RamDomain*) {}
+
+    void insertBatch(const RamDomain*, std::size_t count) {
+        batches.push_back(count);
+    }
+};
+
+TEST(ReadStreamCSV, GrowingBatches) {
+    std::stringstream input;
+    for (int i = 0; i < 1000000; ++i) {
+        input << i << "\n";
+    }
+
+    SymbolTableImpl symbolTable;
+    SpecializedRecordTable<0> recordTable;
+    ReadStreamCSV reader(input, directives({"i:number"}), symbolTable, recordTable);
+    BatchCollector relation;
+    reader.readAll(relation);
+
+    // each batch but the first and the last holds as many tuples as were read before it
+    std::size_t numRead = 0;
+    for (std::size_t i = 0; i < relation.batches.size(); ++i) {
+        if (0 < i && i + 1 < relation.batches.size()) {
+            EXPECT_EQ(numRead, relation.batches[i]);
+        }
+        numRead += relation.batches[i];
+    }
+    EXPECT_EQ(1000000, numRead);
+    EXPECT_LT(relation.batches.size(), 10);
+}
+
+TEST(ReadFileCSV, Mapped) {
+    const auto path = std::filesystem::temp_directory_path() / "souffle_read_stream_csv_test.facts";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "header\tline\r\n";
+        for (int i = 0; i < 300000; ++i) {
+            file << "s" << (i % 100) << "\t" << i << (i % 2 == 0 ? "\r\n" : "\n");
+        }
+    }
+
+    auto rwOperation = directives({"s:symbol", "i:number"},
+            {{"name", "test"}, {"filename", path.string()}, {"headers", "true"}});
+    SymbolTableImpl symbolTable;
+    const auto tuples = readFile<ReadFileCSV>(rwOperation, 2, symbolTable);
+    const auto sequential = readFile<Sequential<ReadFileCSV>>(rwOperation, 2, symbolTable);
+    rwOperation["mmap"] = "false";
+    const auto streamed = readFile<ReadFileCSV>(rwOperation, 2, symbolTable);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(300000, tuples.size());
+    EXPECT_EQ(streamed, tuples);
+    EXPECT_EQ(sequential, tuples);
+    EXPECT_EQ("s42", symbolTable.decode(tuples[142][0]));
+    EXPECT_EQ(142, tuples[142][1]);
+}
+
+}  // namespace souffle::test
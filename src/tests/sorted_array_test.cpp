@@ -0,0 +1,163 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2022, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file sorted_array_test.cpp
+ *
+ * Test cases for ordered sets stored in sorted arrays.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/SortedArray.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle {
+
+namespace test {
+
+using key = std::array<int, 2>;
+
+// random keys with a few distinct values in the leading column
+std::vector<key> getKeys(std::size_t size, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::vector<key> res(size);
+    for (auto& cur : res) {
+        cur = {static_cast<int>(generator() % 100), static_cast<int>(generator() % 1000)};
+    }
+    return res;
+}
+
+// whether all searches on a set agree with a reference set, for keys present and absent
+template <typename Set>
+bool matches(const Set& set, const std::set<key>& reference) {
+    if (set.size() != reference.size() ||
+            !std::equal(set.begin(), set.end(), reference.begin(), reference.end())) {
+        return false;
+    }
+    for (int i = -1; i <= 100; ++i) {
+        for (int j = -1; j <= 1000; j += 7) {
+            key k = {i, j};
+            if (std::distance(reference.begin(), reference.lower_bound(k)) !=
+                            std::distance(set.begin(), set.lower_bound(k)) ||
+                    std::distance(reference.begin(), reference.upper_bound(k)) !=
+                            std::distance(set.begin(), set.upper_bound(k)) ||
+                    (reference.count(k) == 1) != set.contains(k)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST(SortedArray, Basic) {
+    sorted_array_set<int> set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert(3));
+    EXPECT_TRUE(set.insert(1));
+    EXPECT_FALSE(set.insert(3));
+    EXPECT_EQ(2, set.size());
+    EXPECT_TRUE(set.contains(1));
+    EXPECT_FALSE(set.contains(2));
+    EXPECT_EQ(3, *set.lower_bound(2));
+    EXPECT_EQ(set.end(), set.upper_bound(3));
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.end(), set.lower_bound(1));
+}
+
+TEST(SortedArray, BulkLoad) {
+    auto data = getKeys(20000, 1);
+    std::set<key> reference(data.begin(), data.end());
+    sorted_array_set<key> set;
+    set.insert(data.begin(), data.end());
+    EXPECT_TRUE(matches(set, reference));
+
+    // loading merges with the keys present
+    auto more = getKeys(5000, 2);
+    reference.insert(more.begin(), more.end());
+    std::sort(more.begin(), more.end());
+    set.bulk_load(more.begin(), more.end());
+    EXPECT_TRUE(matches(set, reference));
+}
+
+TEST(SortedArray, Layout) {
+    // sets small enough to skip the search tree, and sets with complete and partial last blocks
+    for (std::size_t size : {1, 20, 33, 512, 1000, 4096}) {
+        std::vector<key> data;
+        for (std::size_t i = 0; i < size; ++i) {
+            data.push_back({static_cast<int>(i % 100), static_cast<int>(i * 3 % 1000)});
+        }
+        std::set<key> reference(data.begin(), data.end());
+
+        sorted_array_set<key> eytzinger(data.begin(), data.end());
+        EXPECT_TRUE(matches(eytzinger, reference));
+
+        sorted_array_set<key, detail::comparator<key>, false> sorted(data.begin(), data.end());
+        EXPECT_TRUE(matches(sorted, reference));
+    }
+}
+
+TEST(SortedArray, Multiset) {
+    // keys ordered by their first component only
+    struct first_comparator {
+        bool less(const key& a, const key& b) const {
+            return a[0] < b[0];
+        }
+        bool equal(const key& a, const key& b) const {
+            return a[0] == b[0];
+        }
+    };
+    auto data = getKeys(5000, 4);
+    sorted_array_multiset<key, first_comparator> set(data.begin(), data.begin() + 2500);
+    std::vector<key> sorted(data.begin() + 2500, data.end());
+    std::sort(sorted.begin(), sorted.end());
+    set.bulk_load(sorted.begin(), sorted.end());
+    EXPECT_TRUE(set.insert(data[0]));
+    EXPECT_EQ(5001, set.size());
+
+    std::multiset<int> reference;
+    for (const auto& cur : data) {
+        reference.insert(cur[0]);
+    }
+    reference.insert(data[0][0]);
+    for (int i = 0; i < 100; ++i) {
+        key k = {i, 0};
+        EXPECT_EQ(static_cast<std::ptrdiff_t>(reference.count(i)),
+                std::distance(set.lower_bound(k), set.upper_bound(k)));
+    }
+}
+
+TEST(SortedArray, Partition) {
+    auto data = getKeys(10000, 3);
+    sorted_array_set<key> set(data.begin(), data.end());
+
+    for (std::size_t num : {1, 7, 400, 100000}) {
+        auto chunks = set.partition(num);
+        EXPECT_TRUE(chunks.size() <= num);
+        std::vector<key> scanned;
+        for (const auto& chunk : chunks) {
+            EXPECT_FALSE(chunk.empty());
+            scanned.insert(scanned.end(), chunk.begin(), chunk.end());
+        }
+        EXPECT_TRUE(std::equal(set.begin(), set.end(), scanned.begin(), scanned.end()));
+    }
+
+    EXPECT_TRUE(sorted_array_set<key>().partition(4).empty());
+}
+
+}  // namespace test
+}  // end namespace souffle